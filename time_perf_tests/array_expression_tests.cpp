@@ -0,0 +1,58 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/array_expression.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using vox::geometry::Array1;
+using vox::geometry::kZeroSize;
+
+class ArrayExpression : public ::benchmark::Fixture {
+public:
+  Array1<double> a;
+  Array1<double> b;
+  Array1<double> c;
+  Array1<double> d;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto n = static_cast<size_t>(state.range(0));
+
+    a.resize(n);
+    b.resize(n);
+    c.resize(n);
+    d.resize(n);
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<> dist(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+      b[i] = dist(rng);
+      c[i] = dist(rng);
+      d[i] = dist(rng);
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(ArrayExpression, SeparateLoops)(benchmark::State &state) {
+  Array1<double> temp(a.length());
+  while (state.KeepRunning()) {
+    vox::geometry::parallelFor(kZeroSize, a.length(), [&](size_t i) { temp[i] = 0.5 * c[i]; });
+    vox::geometry::parallelFor(kZeroSize, a.length(), [&](size_t i) { temp[i] += b[i]; });
+    vox::geometry::parallelFor(kZeroSize, a.length(), [&](size_t i) { a[i] = temp[i] - d[i]; });
+  }
+}
+
+BENCHMARK_REGISTER_F(ArrayExpression, SeparateLoops)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24);
+
+BENCHMARK_DEFINE_F(ArrayExpression, Fused)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    a = b + 0.5 * c - d;
+  }
+}
+
+BENCHMARK_REGISTER_F(ArrayExpression, Fused)->Arg(1 << 16)->Arg(1 << 20)->Arg(1 << 24);
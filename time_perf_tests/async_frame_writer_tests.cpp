@@ -0,0 +1,70 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/async_frame_writer.h"
+#include "../vox.geometry/particle_system_data.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+using vox::geometry::AsyncFrameWriter;
+using vox::geometry::ParticleSystemData3;
+using vox::geometry::SnapshotPool;
+
+class FrameOutput : public ::benchmark::Fixture {
+protected:
+  static constexpr size_t kNumberOfFrames = 8;
+
+  const std::string filename = "frame_output_benchmark.bin";
+  ParticleSystemData3 particles;
+
+  void SetUp(const ::benchmark::State &) override { particles.resize(1 << 18); }
+
+  void TearDown(const ::benchmark::State &) override { std::remove(filename.c_str()); }
+
+  // Stands in for the solver
+  void advance() {
+    auto x = particles.positions();
+    auto v = particles.velocities();
+    for (size_t n = 0; n < 8; ++n) {
+      for (size_t i = 0; i < x.length(); ++i) {
+        v[i].y += 1e-3 * std::sin(x[i].x);
+        x[i] += 1e-3 * v[i];
+      }
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(FrameOutput, Synchronous)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    for (size_t f = 0; f < kNumberOfFrames; ++f) {
+      advance();
+      vox::geometry::serializeToFile(&particles, filename);
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(FrameOutput, Synchronous)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_DEFINE_F(FrameOutput, Asynchronous)(benchmark::State &state) {
+  AsyncFrameWriter writer;
+  SnapshotPool<ParticleSystemData3> snapshots;
+  while (state.KeepRunning()) {
+    for (size_t f = 0; f < kNumberOfFrames; ++f) {
+      advance();
+      writer.submit([&]() -> AsyncFrameWriter::Job {
+        auto snapshot = snapshots.acquire(particles);
+        return [this, snapshot]() { vox::geometry::serializeToFile(snapshot.get(), filename); };
+      });
+    }
+    writer.flush();
+  }
+}
+
+BENCHMARK_REGISTER_F(FrameOutput, Asynchronous)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include "../vox.geometry/query_engines/bvh.h"
+#include "../vox.geometry/query_engines/wide_bvh.h"
 #include "../vox.geometry/surfaces/triangle_mesh3.h"
 
 #include <benchmark/benchmark.h>
@@ -23,6 +24,8 @@ public:
   std::mt19937 rng{0};
   std::uniform_real_distribution<> dist{0.0, 1.0};
   TriangleMesh3 triMesh;
+  vox::geometry::Array1<Triangle3> triangles;
+  vox::geometry::Array1<BoundingBox3D> bounds;
   vox::geometry::Bvh3<Triangle3> queryEngine{};
 
   void SetUp(const ::benchmark::State &) override {
@@ -33,8 +36,6 @@ public:
       file.close();
     }
 
-    vox::geometry::Array1<Triangle3> triangles;
-    vox::geometry::Array1<BoundingBox3D> bounds;
     for (size_t i = 0; i < triMesh.numberOfTriangles(); ++i) {
       auto tri = triMesh.triangle(i);
       triangles.append(tri);
@@ -44,11 +45,66 @@ public:
     queryEngine.build(triangles, bounds);
   }
 
+  // Queries of the 32^3 grid points, one at a time
+  template <typename QueryEngine> void nearestGrid(const QueryEngine &engine, benchmark::State &state) const {
+    const auto points = makeGridPoints();
+    for (auto _ : state) {
+      for (const Vector3D &pt : points) {
+        benchmark::DoNotOptimize(engine.nearest(pt, distanceFunc));
+      }
+    }
+  }
+
+  // Queries of the 64^2 camera rays, one at a time
+  template <typename QueryEngine>
+  void closestIntersectionCamera(const QueryEngine &engine, benchmark::State &state) const {
+    const auto rays = makeCameraRays();
+    for (auto _ : state) {
+      for (const Ray3D &ray : rays) {
+        benchmark::DoNotOptimize(engine.closestIntersection(ray, closestIntersectionFunc));
+      }
+    }
+  }
+
   Vector3D makeVec() { return Vector3D(dist(rng), dist(rng), dist(rng)); }
 
   static double distanceFunc(const Triangle3 &tri, const Vector3D &pt) { return tri.closestDistance(pt); }
 
   static bool intersectsFunc(const Triangle3 &tri, const Ray3D &ray) { return tri.intersects(ray); }
+
+  static double closestIntersectionFunc(const Triangle3 &tri, const Ray3D &ray) {
+    return tri.closestIntersection(ray).distance;
+  }
+
+  // Coherent queries: the 32^3 grid points over the mesh bounds, x-first
+  vox::geometry::Array1<Vector3D> makeGridPoints() const {
+    const BoundingBox3D box = queryEngine.boundingBox();
+    vox::geometry::Array1<Vector3D> points;
+    for (size_t k = 0; k < 32; ++k) {
+      for (size_t j = 0; j < 32; ++j) {
+        for (size_t i = 0; i < 32; ++i) {
+          const Vector3D t = (Vector3D(i, j, k) + Vector3D(0.5, 0.5, 0.5)) / 32.0;
+          points.append(box.lowerCorner + elemMul(t, box.upperCorner - box.lowerCorner));
+        }
+      }
+    }
+    return points;
+  }
+
+  // Coherent rays: 64^2 rays from a pinhole in front of the mesh
+  vox::geometry::Array1<Ray3D> makeCameraRays() const {
+    const BoundingBox3D box = queryEngine.boundingBox();
+    const Vector3D eye = box.midPoint() - Vector3D(0, 0, 2.0 * box.depth());
+    vox::geometry::Array1<Ray3D> rays;
+    for (size_t j = 0; j < 64; ++j) {
+      for (size_t i = 0; i < 64; ++i) {
+        const Vector3D target(box.lowerCorner.x + box.width() * (i + 0.5) / 64.0,
+                              box.lowerCorner.y + box.height() * (j + 0.5) / 64.0, box.midPoint().z);
+        rays.append(Ray3D(eye, (target - eye).normalized()));
+      }
+    }
+    return rays;
+  }
 };
 
 BENCHMARK_DEFINE_F(Bvh3, Nearest)(benchmark::State &state) {
@@ -66,3 +122,121 @@ BENCHMARK_DEFINE_F(Bvh3, RayIntersects)(benchmark::State &state) {
 }
 
 BENCHMARK_REGISTER_F(Bvh3, RayIntersects);
+
+BENCHMARK_DEFINE_F(Bvh3, NearestGrid)(benchmark::State &state) { nearestGrid(queryEngine, state); }
+
+BENCHMARK_REGISTER_F(Bvh3, NearestGrid)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, NearestGridBatched)(benchmark::State &state) {
+  const auto points = makeGridPoints();
+  vox::geometry::Array1<vox::geometry::NearestNeighborQueryResult3<Triangle3>> results(points.length());
+  for (auto _ : state) {
+    queryEngine.nearest(points, distanceFunc, results);
+    benchmark::DoNotOptimize(results.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, NearestGridBatched)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, ClosestIntersectionCamera)(benchmark::State &state) {
+  closestIntersectionCamera(queryEngine, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, ClosestIntersectionCamera)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, ClosestIntersectionCameraBatched)(benchmark::State &state) {
+  const auto rays = makeCameraRays();
+  vox::geometry::Array1<vox::geometry::ClosestIntersectionQueryResult3<Triangle3>> results(rays.length());
+  for (auto _ : state) {
+    queryEngine.closestIntersection(rays, closestIntersectionFunc, results);
+    benchmark::DoNotOptimize(results.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, ClosestIntersectionCameraBatched)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, Build)(benchmark::State &state) {
+  for (auto _ : state) {
+    vox::geometry::Bvh3<Triangle3> bvh;
+    bvh.build(triangles, bounds);
+    benchmark::DoNotOptimize(bvh.numberOfNodes());
+  }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, Build)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, BuildBinnedSah)(benchmark::State &state) {
+  for (auto _ : state) {
+    vox::geometry::Bvh3<Triangle3> bvh(true);
+    bvh.build(triangles, bounds);
+    benchmark::DoNotOptimize(bvh.numberOfNodes());
+  }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, BuildBinnedSah)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, NearestGridBinnedSah)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh(true);
+  bvh.build(triangles, bounds);
+  nearestGrid(bvh, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, NearestGridBinnedSah)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, NearestGridWide4)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh(true);
+  bvh.build(triangles, bounds);
+  vox::geometry::WideBvh3x4<Triangle3> wideBvh;
+  wideBvh.build(bvh);
+  nearestGrid(wideBvh, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, NearestGridWide4)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, NearestGridWide8)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh(true);
+  bvh.build(triangles, bounds);
+  vox::geometry::WideBvh3x8<Triangle3> wideBvh;
+  wideBvh.build(bvh);
+  nearestGrid(wideBvh, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, NearestGridWide8)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, ClosestIntersectionCameraBinnedSah)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh(true);
+  bvh.build(triangles, bounds);
+  closestIntersectionCamera(bvh, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, ClosestIntersectionCameraBinnedSah)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, ClosestIntersectionCameraWide4)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh(true);
+  bvh.build(triangles, bounds);
+  vox::geometry::WideBvh3x4<Triangle3> wideBvh;
+  wideBvh.build(bvh);
+  closestIntersectionCamera(wideBvh, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, ClosestIntersectionCameraWide4)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, ClosestIntersectionCameraWide8)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh(true);
+  bvh.build(triangles, bounds);
+  vox::geometry::WideBvh3x8<Triangle3> wideBvh;
+  wideBvh.build(bvh);
+  closestIntersectionCamera(wideBvh, state);
+}
+
+BENCHMARK_REGISTER_F(Bvh3, ClosestIntersectionCameraWide8)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Bvh3, Refit)(benchmark::State &state) {
+  vox::geometry::Bvh3<Triangle3> bvh;
+  bvh.build(triangles, bounds);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(bvh.refit(bounds));
+  }
+}
+
+BENCHMARK_REGISTER_F(Bvh3, Refit)->Unit(benchmark::kMillisecond);
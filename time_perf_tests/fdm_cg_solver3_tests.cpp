@@ -0,0 +1,86 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/fdm_solvers/fdm_cg_solver3.h"
+
+#include <benchmark/benchmark.h>
+
+using vox::geometry::FdmCgSolver3;
+using vox::geometry::FdmLinearSystem3;
+
+// Pressure-like Poisson system with Neumann boundaries everywhere except for a
+// single weakly pinned cell, so the constant mode is nearly singular. The
+// arguments are the grid resolution, the s-step size and whether the constant
+// mode is deflated. "Iterations" is the number of CG iterations and
+// "Reductions" the number of global synchronizations per solve.
+class FdmCgSolver3Poisson : public ::benchmark::Fixture {
+public:
+  FdmLinearSystem3 system;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto dim = static_cast<size_t>(state.range(0));
+    system.resize({dim, dim, dim});
+  }
+
+  void reset() {
+    system.A.fill({});
+    system.b.fill(0.0);
+    system.x.fill(0.0);
+
+    forEachIndex(system.A.size(), [&](size_t i, size_t j, size_t k) {
+      auto &row = system.A(i, j, k);
+      if (i + 1 < system.A.width()) {
+        row.center += 1.0;
+        row.right -= 1.0;
+        system.A(i + 1, j, k).center += 1.0;
+      }
+      if (j + 1 < system.A.height()) {
+        row.center += 1.0;
+        row.up -= 1.0;
+        system.A(i, j + 1, k).center += 1.0;
+      }
+      if (k + 1 < system.A.depth()) {
+        row.center += 1.0;
+        row.front -= 1.0;
+        system.A(i, j, k + 1).center += 1.0;
+      }
+
+      // Compatible source: a dipole along x
+      const double x = (static_cast<double>(i) + 0.5) / static_cast<double>(system.A.width());
+      system.b(i, j, k) = (x < 0.5) ? 1.0 : -1.0;
+    });
+
+    system.A(0, 0, 0).center += 1e-3;
+  }
+};
+
+BENCHMARK_DEFINE_F(FdmCgSolver3Poisson, Solve)(benchmark::State &state) {
+  const auto sStepSize = static_cast<unsigned int>(state.range(1));
+  const bool deflate = state.range(2) != 0;
+  FdmCgSolver3 solver(10000, 1e-6, false, sStepSize, deflate);
+
+  while (state.KeepRunning()) {
+    state.PauseTiming();
+    reset();
+    state.ResumeTiming();
+
+    solver.solve(&system);
+  }
+
+  const unsigned int iterations = solver.lastNumberOfIterations();
+  state.counters["Iterations"] = iterations;
+  state.counters["Reductions"] = (sStepSize > 1) ? (iterations + sStepSize - 1) / sStepSize : 2 * iterations;
+}
+
+BENCHMARK_REGISTER_F(FdmCgSolver3Poisson, Solve)
+    ->ArgNames({"dim", "s", "deflate"})
+    ->Args({32, 1, 0})
+    ->Args({32, 4, 0})
+    ->Args({32, 1, 1})
+    ->Args({64, 1, 0})
+    ->Args({64, 4, 0})
+    ->Args({64, 1, 1})
+    ->Unit(benchmark::kMillisecond);
@@ -17,6 +17,7 @@ using vox::geometry::FdmMatrix2;
 using vox::geometry::FdmMatrix3;
 using vox::geometry::FdmVector2;
 using vox::geometry::FdmVector3;
+using vox::geometry::MatrixSellD;
 using vox::geometry::Vector3UZ;
 
 class FdmBlas2 : public ::benchmark::Fixture {
@@ -152,6 +153,17 @@ public:
   }
 };
 
+class FdmCompressedSellBlas3 : public FdmCompressedBlas3 {
+public:
+  MatrixSellD sell;
+
+  void SetUp(const ::benchmark::State &state) override {
+    FdmCompressedBlas3::SetUp(state);
+
+    sell.set(system.A);
+  }
+};
+
 BENCHMARK_DEFINE_F(FdmBlas2, Mvm)(benchmark::State &state) {
   while (state.KeepRunning()) {
     vox::geometry::FdmBlas2::mvm(m, a, &b);
@@ -175,3 +187,19 @@ BENCHMARK_DEFINE_F(FdmCompressedBlas3, Mvm)(benchmark::State &state) {
 }
 
 BENCHMARK_REGISTER_F(FdmCompressedBlas3, Mvm)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmCompressedSellBlas3, Mvm)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    vox::geometry::FdmCompressedBlas3::mvm(sell, system.b, &system.x);
+  }
+}
+
+BENCHMARK_REGISTER_F(FdmCompressedSellBlas3, Mvm)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmBlas3, Axpy)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    vox::geometry::FdmBlas3::axpy(0.5, a, a, &b);
+  }
+}
+
+BENCHMARK_REGISTER_F(FdmBlas3, Axpy)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
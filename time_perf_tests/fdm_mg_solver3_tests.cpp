@@ -0,0 +1,109 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/fdm_mg_linear_system3.h"
+#include "../vox.geometry/fdm_solvers/fdm_gauss_seidel_solver3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using vox::geometry::FdmBlas3;
+using vox::geometry::FdmGaussSeidelSolver3;
+using vox::geometry::FdmMatrix3;
+using vox::geometry::FdmMgUtils3;
+using vox::geometry::FdmVector3;
+using vox::geometry::Vector3UZ;
+
+// The fixtures report two counters. "Bytes" is the logical data the kernel
+// touches (matrix, RHS and solution per cell for every pass), so its rate is
+// the effective bandwidth. "GridPasses" is the number of times the kernel
+// streams the grid from memory when the grid does not fit in cache. The
+// blocked kernels touch the same data with fewer passes, which shows up as an
+// effective bandwidth higher than the machine's DRAM bandwidth.
+class FdmMgSmoothing3 : public ::benchmark::Fixture {
+public:
+  static constexpr unsigned int kNumberOfIterations = 4;
+
+  FdmMatrix3 A;
+  FdmVector3 x;
+  FdmVector3 b;
+  FdmVector3 r;
+  FdmVector3 coarser;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto dim = static_cast<size_t>(state.range(0));
+
+    A.resize({dim, dim, dim});
+    x.resize({dim, dim, dim});
+    b.resize({dim, dim, dim});
+    r.resize({dim, dim, dim});
+    coarser.resize({dim / 2, dim / 2, dim / 2});
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    forEachIndex(A.size(), [&](size_t i, size_t j, size_t k) {
+      A(i, j, k).center = 6.0;
+      A(i, j, k).right = (i + 1 < dim) ? -1.0 : 0.0;
+      A(i, j, k).up = (j + 1 < dim) ? -1.0 : 0.0;
+      A(i, j, k).front = (k + 1 < dim) ? -1.0 : 0.0;
+      x(i, j, k) = d(rng);
+      b(i, j, k) = d(rng);
+    });
+  }
+
+  void setCounters(benchmark::State &state, size_t bytesPerCell, double gridPasses) const {
+    const auto numberOfCells = static_cast<int64_t>(A.length());
+    state.SetBytesProcessed(state.iterations() * numberOfCells * static_cast<int64_t>(bytesPerCell));
+    state.counters["GridPasses"] = gridPasses;
+  }
+};
+
+// A + b + x, read, and x written back
+static constexpr size_t kRelaxBytesPerCell = sizeof(vox::geometry::FdmMatrixRow3) + 3 * sizeof(double);
+
+BENCHMARK_DEFINE_F(FdmMgSmoothing3, RelaxRedBlack)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    for (unsigned int iter = 0; iter < kNumberOfIterations; ++iter) {
+      FdmGaussSeidelSolver3::relaxRedBlack(A, b, 1.5, &x);
+    }
+  }
+  setCounters(state, 2 * kNumberOfIterations * kRelaxBytesPerCell, 2 * kNumberOfIterations);
+}
+
+BENCHMARK_REGISTER_F(FdmMgSmoothing3, RelaxRedBlack)->Arg(1 << 6)->Arg(1 << 7)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmMgSmoothing3, RelaxRedBlackWavefront)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    FdmGaussSeidelSolver3::relaxRedBlackWavefront(A, b, kNumberOfIterations, 1.5, &x);
+  }
+  setCounters(state, 2 * kNumberOfIterations * kRelaxBytesPerCell, 1);
+}
+
+BENCHMARK_REGISTER_F(FdmMgSmoothing3, RelaxRedBlackWavefront)->Arg(1 << 6)->Arg(1 << 7)->Arg(1 << 8);
+
+// A + b + x read, r written and read back by the restriction
+static constexpr size_t kResidualRestrictBytesPerCell = sizeof(vox::geometry::FdmMatrixRow3) + 4 * sizeof(double);
+
+BENCHMARK_DEFINE_F(FdmMgSmoothing3, ResidualThenRestrict)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    FdmBlas3::residual(A, x, b, &r);
+    FdmMgUtils3::restrict(r, &coarser);
+  }
+  setCounters(state, kResidualRestrictBytesPerCell, 2);
+}
+
+BENCHMARK_REGISTER_F(FdmMgSmoothing3, ResidualThenRestrict)->Arg(1 << 6)->Arg(1 << 7)->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmMgSmoothing3, ResidualRestrict)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    FdmMgUtils3::residualRestrict(A, x, b, &coarser);
+  }
+  setCounters(state, kResidualRestrictBytesPerCell, 1);
+}
+
+BENCHMARK_REGISTER_F(FdmMgSmoothing3, ResidualRestrict)->Arg(1 << 6)->Arg(1 << 7)->Arg(1 << 8);
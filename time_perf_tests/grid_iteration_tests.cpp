@@ -0,0 +1,68 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/grids/face_centered_grid.h"
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+
+using vox::geometry::CellCenteredScalarGrid3;
+using vox::geometry::FaceCenteredGrid3;
+using vox::geometry::Vector3D;
+using vox::geometry::Vector3UZ;
+
+class GridIteration3 : public ::benchmark::Fixture {
+protected:
+  CellCenteredScalarGrid3 scalarGrid;
+  FaceCenteredGrid3 faceGrid;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto n = static_cast<size_t>(state.range(0));
+    scalarGrid.resize(Vector3UZ::makeConstant(n), Vector3D::makeConstant(1.0 / static_cast<double>(n)));
+    faceGrid.resize(Vector3UZ::makeConstant(n), Vector3D::makeConstant(1.0 / static_cast<double>(n)));
+  }
+};
+
+// The type-erased callbacks reproduce the calls before the templated overloads
+BENCHMARK_DEFINE_F(GridIteration3, FillTypeErased)(benchmark::State &state) {
+  const std::function<double(const Vector3D &)> func = [](const Vector3D &x) { return x.x + 2.0 * x.y - x.z; };
+  while (state.KeepRunning()) {
+    scalarGrid.fill(func);
+  }
+}
+
+BENCHMARK_REGISTER_F(GridIteration3, FillTypeErased)->Arg(128)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GridIteration3, FillInlined)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    scalarGrid.fill([](const Vector3D &x) { return x.x + 2.0 * x.y - x.z; });
+  }
+}
+
+BENCHMARK_REGISTER_F(GridIteration3, FillInlined)->Arg(128)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GridIteration3, ForEachUIndexTypeErased)(benchmark::State &state) {
+  auto u = faceGrid.uView();
+  const std::function<void(size_t, size_t, size_t)> func = [&u](size_t i, size_t j, size_t k) {
+    u(i, j, k) = 0.5 * u(i, j, k);
+  };
+  while (state.KeepRunning()) {
+    faceGrid.parallelForEachUIndex(func);
+  }
+}
+
+BENCHMARK_REGISTER_F(GridIteration3, ForEachUIndexTypeErased)->Arg(128)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GridIteration3, ForEachUIndexInlined)(benchmark::State &state) {
+  auto u = faceGrid.uView();
+  while (state.KeepRunning()) {
+    faceGrid.parallelForEachUIndex([&u](size_t i, size_t j, size_t k) { u(i, j, k) = 0.5 * u(i, j, k); });
+  }
+}
+
+BENCHMARK_REGISTER_F(GridIteration3, ForEachUIndexInlined)->Arg(128)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,92 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/grids/face_centered_grid.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using vox::geometry::Array1;
+using vox::geometry::CellCenteredScalarGrid3;
+using vox::geometry::ExecutionPolicy;
+using vox::geometry::FaceCenteredGrid3;
+using vox::geometry::ScalarGrid3;
+using vox::geometry::Vector3D;
+using vox::geometry::VectorGrid3;
+
+class GridSampling3 : public ::benchmark::Fixture {
+protected:
+  CellCenteredScalarGrid3 scalarGrid;
+  FaceCenteredGrid3 faceGrid;
+  Array1<Vector3D> points;
+  Array1<double> scalars;
+  Array1<Vector3D> vectors;
+
+  // Random positions as in semi-Lagrangian advection
+  void SetUp(const ::benchmark::State &state) override {
+    std::mt19937 rng{0};
+    std::uniform_real_distribution<> dist{0.0, 1.0};
+
+    const auto n = static_cast<size_t>(state.range(0));
+    scalarGrid.resize(vox::geometry::Vector3UZ::makeConstant(64), Vector3D::makeConstant(1.0 / 64.0));
+    faceGrid.resize(vox::geometry::Vector3UZ::makeConstant(64), Vector3D::makeConstant(1.0 / 64.0));
+    scalarGrid.fill([](const Vector3D &x) { return x.length(); });
+    faceGrid.fill([](const Vector3D &x) { return Vector3D(x.y, -x.x, x.z); });
+
+    points.resize(n);
+    scalars.resize(n);
+    vectors.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      points[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(GridSampling3, ScalarVirtual)(benchmark::State &state) {
+  const ScalarGrid3 &grid = scalarGrid;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < points.length(); ++i) {
+      scalars[i] = grid.sample(points[i]);
+    }
+    benchmark::DoNotOptimize(scalars.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(GridSampling3, ScalarVirtual)->Arg(1 << 18);
+
+BENCHMARK_DEFINE_F(GridSampling3, ScalarBatched)(benchmark::State &state) {
+  const ScalarGrid3 &grid = scalarGrid;
+  while (state.KeepRunning()) {
+    grid.sample(points, scalars, ExecutionPolicy::kSerial);
+    benchmark::DoNotOptimize(scalars.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(GridSampling3, ScalarBatched)->Arg(1 << 18);
+
+BENCHMARK_DEFINE_F(GridSampling3, FaceCenteredVirtual)(benchmark::State &state) {
+  const VectorGrid3 &grid = faceGrid;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < points.length(); ++i) {
+      vectors[i] = grid.sample(points[i]);
+    }
+    benchmark::DoNotOptimize(vectors.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(GridSampling3, FaceCenteredVirtual)->Arg(1 << 18);
+
+BENCHMARK_DEFINE_F(GridSampling3, FaceCenteredBatched)(benchmark::State &state) {
+  const VectorGrid3 &grid = faceGrid;
+  while (state.KeepRunning()) {
+    grid.sample(points, vectors, ExecutionPolicy::kSerial);
+    benchmark::DoNotOptimize(vectors.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(GridSampling3, FaceCenteredBatched)->Arg(1 << 18);
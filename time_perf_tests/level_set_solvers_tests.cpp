@@ -0,0 +1,88 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/levelset_solvers/fast_sweeping_level_set_solver3.h"
+#include "../vox.geometry/levelset_solvers/fmm_level_set_solver3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+using vox::geometry::CellCenteredScalarGrid3;
+using vox::geometry::FastSweepingLevelSetSolver3;
+using vox::geometry::FmmLevelSetSolver3;
+using vox::geometry::Vector3D;
+using vox::geometry::Vector3UZ;
+
+// Distorted sphere SDF on a dim^3 unit-size grid, reinitialized over the whole
+// domain or within a band of a few cells
+class LevelSetReinitialize : public ::benchmark::Fixture {
+public:
+  static constexpr double kBandWidthInCells = 5.0;
+
+  CellCenteredScalarGrid3 sdf;
+  CellCenteredScalarGrid3 output;
+  double bandWidth = 0.0;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto dim = static_cast<size_t>(state.range(0));
+    const double h = 1.0 / static_cast<double>(dim);
+    bandWidth = kBandWidthInCells * h;
+
+    sdf.resize(Vector3UZ(dim, dim, dim), Vector3D(h, h, h));
+    output.resize(Vector3UZ(dim, dim, dim), Vector3D(h, h, h));
+    sdf.fill([](const Vector3D &x) {
+      const double phi = x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.3;
+      return phi * (2.0 + std::sin(10.0 * x.x) * std::cos(10.0 * x.z));
+    });
+  }
+};
+
+BENCHMARK_DEFINE_F(LevelSetReinitialize, Fmm)(benchmark::State &state) {
+  FmmLevelSetSolver3 solver;
+  while (state.KeepRunning()) {
+    solver.reinitialize(sdf, 1.0, &output);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sdf.dataSize().x * sdf.dataSize().y *
+                                                                    sdf.dataSize().z));
+}
+
+BENCHMARK_REGISTER_F(LevelSetReinitialize, Fmm)->Arg(1 << 6)->Arg(1 << 7)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetReinitialize, FastSweeping)(benchmark::State &state) {
+  FastSweepingLevelSetSolver3 solver;
+  while (state.KeepRunning()) {
+    solver.reinitialize(sdf, 1.0, &output);
+  }
+  state.counters["Iterations"] = solver.lastNumberOfIterations();
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sdf.dataSize().x * sdf.dataSize().y *
+                                                                    sdf.dataSize().z));
+}
+
+BENCHMARK_REGISTER_F(LevelSetReinitialize, FastSweeping)->Arg(1 << 6)->Arg(1 << 7)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetReinitialize, FmmBand)(benchmark::State &state) {
+  FmmLevelSetSolver3 solver;
+  while (state.KeepRunning()) {
+    solver.reinitialize(sdf, bandWidth, &output);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sdf.dataSize().x * sdf.dataSize().y *
+                                                                    sdf.dataSize().z));
+}
+
+BENCHMARK_REGISTER_F(LevelSetReinitialize, FmmBand)->Arg(1 << 6)->Arg(1 << 7)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetReinitialize, FmmNarrowBand)(benchmark::State &state) {
+  FmmLevelSetSolver3 solver(true);
+  while (state.KeepRunning()) {
+    solver.reinitialize(sdf, bandWidth, &output);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(sdf.dataSize().x * sdf.dataSize().y *
+                                                                    sdf.dataSize().z));
+}
+
+BENCHMARK_REGISTER_F(LevelSetReinitialize, FmmNarrowBand)->Arg(1 << 6)->Arg(1 << 7)->Unit(benchmark::kMillisecond);
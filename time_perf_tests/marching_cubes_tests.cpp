@@ -0,0 +1,117 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/array.h"
+#include "../vox.geometry/marching_cubes.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+
+using vox::geometry::Array3;
+using vox::geometry::TriangleMesh3;
+using vox::geometry::Vector3D;
+
+// Signed distance of a bumpy sphere sampled on a dim^3 grid
+class MarchingCubes : public ::benchmark::Fixture {
+public:
+  Array3<double> grid;
+  Vector3D gridSpacing;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto dim = static_cast<size_t>(state.range(0));
+    const double h = 1.0 / static_cast<double>(dim);
+    gridSpacing = Vector3D(h, h, h);
+
+    grid.resize({dim, dim, dim});
+    forEachIndex(grid.size(), [&](size_t i, size_t j, size_t k) {
+      const Vector3D x = h * Vector3D(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+      grid(i, j, k) = x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.35 + 0.02 * std::sin(20.0 * x.x) * std::cos(17.0 * x.z);
+    });
+  }
+
+  void setCounters(benchmark::State &state, const TriangleMesh3 &mesh) const {
+    state.counters["Triangles"] = static_cast<double>(mesh.numberOfTriangles());
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(grid.length()));
+  }
+};
+
+BENCHMARK_DEFINE_F(MarchingCubes, Serial)(benchmark::State &state) {
+  TriangleMesh3 mesh;
+  while (state.KeepRunning()) {
+    mesh.clear();
+    vox::geometry::marchingCubes(grid, gridSpacing, Vector3D(), &mesh);
+  }
+  setCounters(state, mesh);
+}
+
+BENCHMARK_REGISTER_F(MarchingCubes, Serial)->Arg(1 << 6)->Arg(1 << 7)->Arg(1 << 8)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(MarchingCubes, Parallel)(benchmark::State &state) {
+  TriangleMesh3 mesh;
+  while (state.KeepRunning()) {
+    mesh.clear();
+    vox::geometry::marchingCubesParallel(grid, gridSpacing, Vector3D(), &mesh);
+  }
+  setCounters(state, mesh);
+}
+
+BENCHMARK_REGISTER_F(MarchingCubes, Parallel)->Arg(1 << 6)->Arg(1 << 7)->Arg(1 << 8)->Unit(benchmark::kMillisecond);
+
+// Narrow-band SDF of a sphere whose radius is fixed in cells, so the surface
+// area stays the same while the grid volume grows with dim^3. The dense
+// meshers scale with the volume, the sparse one with the surface plus a cheap
+// occupancy pass.
+class MarchingCubesNarrowBand : public ::benchmark::Fixture {
+public:
+  static constexpr double kRadius = 24.0;
+  static constexpr double kBandWidth = 3.0;
+
+  Array3<double> grid;
+
+  void SetUp(const ::benchmark::State &state) override {
+    const auto dim = static_cast<size_t>(state.range(0));
+    const double center = 0.5 * static_cast<double>(dim);
+
+    grid.resize({dim, dim, dim});
+    forEachIndex(grid.size(), [&](size_t i, size_t j, size_t k) {
+      const Vector3D x(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+      const double phi = x.distanceTo(Vector3D(center, center, center)) - kRadius;
+      grid(i, j, k) = std::clamp(phi, -kBandWidth, kBandWidth);
+    });
+  }
+};
+
+BENCHMARK_DEFINE_F(MarchingCubesNarrowBand, Parallel)(benchmark::State &state) {
+  TriangleMesh3 mesh;
+  while (state.KeepRunning()) {
+    mesh.clear();
+    vox::geometry::marchingCubesParallel(grid, Vector3D(1, 1, 1), Vector3D(), &mesh, 0, vox::geometry::kDirectionNone);
+  }
+  state.counters["Triangles"] = static_cast<double>(mesh.numberOfTriangles());
+}
+
+BENCHMARK_REGISTER_F(MarchingCubesNarrowBand, Parallel)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7)
+    ->Arg(1 << 8)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(MarchingCubesNarrowBand, Sparse)(benchmark::State &state) {
+  TriangleMesh3 mesh;
+  while (state.KeepRunning()) {
+    mesh.clear();
+    vox::geometry::marchingCubesSparse(grid, Vector3D(1, 1, 1), Vector3D(), &mesh, 0, vox::geometry::kDirectionNone);
+  }
+  state.counters["Triangles"] = static_cast<double>(mesh.numberOfTriangles());
+}
+
+BENCHMARK_REGISTER_F(MarchingCubesNarrowBand, Sparse)
+    ->Arg(1 << 6)
+    ->Arg(1 << 7)
+    ->Arg(1 << 8)
+    ->Unit(benchmark::kMillisecond);
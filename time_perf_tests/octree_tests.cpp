@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "../vox.geometry/query_engines/linear_octree.h"
 #include "../vox.geometry/query_engines/octree.h"
 #include "../vox.geometry/surfaces/triangle_mesh3.h"
 
@@ -23,9 +24,19 @@ public:
   std::mt19937 rng{0};
   std::uniform_real_distribution<> dist{0.0, 1.0};
   TriangleMesh3 triMesh;
+  std::vector<Triangle3> triangles;
+  vox::geometry::Array1<BoundingBox3D> bounds;
+  BoundingBox3D bound;
   vox::geometry::Octree<Triangle3> queryEngine;
+  vox::geometry::LinearOctree<Triangle3> linearQueryEngine;
 
   void SetUp(const ::benchmark::State &) override {
+    // The fixture is reused across the benchmarks, and the inputs are appended to
+    triMesh.clear();
+    triangles.clear();
+    bounds.clear();
+    bound.reset();
+
     std::ifstream file("../models/bunny.obj");
 
     if (file) {
@@ -33,20 +44,23 @@ public:
       file.close();
     }
 
-    std::vector<Triangle3> triangles;
-    BoundingBox3D bound;
     for (size_t i = 0; i < triMesh.numberOfTriangles(); ++i) {
       auto tri = triMesh.triangle(i);
       triangles.push_back(tri);
+      bounds.append(tri.boundingBox());
       bound.merge(tri.boundingBox());
     }
 
-    const auto triBoxTestFunc = [](const Triangle3 &tri, const BoundingBox3D &box) {
-      // TODO: Implement actual intersecting test
-      return tri.boundingBox().overlaps(box);
-    };
-
     queryEngine.build(triangles, bound, triBoxTestFunc, 6);
+    linearQueryEngine.build(vox::geometry::ConstArrayView1<Triangle3>(triangles.data(), triangles.size()), bounds,
+                            kLinearMaxDepth);
+  }
+
+  static constexpr size_t kLinearMaxDepth = 10;
+
+  static bool triBoxTestFunc(const Triangle3 &tri, const BoundingBox3D &box) {
+    // TODO: Implement actual intersecting test
+    return tri.boundingBox().overlaps(box);
   }
 
   Vector3D makeVec() { return Vector3D(dist(rng), dist(rng), dist(rng)); }
@@ -71,3 +85,40 @@ BENCHMARK_DEFINE_F(Octree, RayIntersects)(benchmark::State &state) {
 }
 
 BENCHMARK_REGISTER_F(Octree, RayIntersects);
+
+BENCHMARK_DEFINE_F(Octree, Build)(benchmark::State &state) {
+  for (auto _ : state) {
+    vox::geometry::Octree<Triangle3> octree;
+    octree.build(triangles, bound, triBoxTestFunc, 6);
+    benchmark::DoNotOptimize(octree.numberOfNodes());
+  }
+}
+
+BENCHMARK_REGISTER_F(Octree, Build)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Octree, LinearBuild)(benchmark::State &state) {
+  for (auto _ : state) {
+    vox::geometry::LinearOctree<Triangle3> octree;
+    octree.build(vox::geometry::ConstArrayView1<Triangle3>(triangles.data(), triangles.size()), bounds,
+                 kLinearMaxDepth);
+    benchmark::DoNotOptimize(octree.numberOfNodes());
+  }
+}
+
+BENCHMARK_REGISTER_F(Octree, LinearBuild)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(Octree, LinearNearest)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(linearQueryEngine.nearest(makeVec(), distanceFunc));
+  }
+}
+
+BENCHMARK_REGISTER_F(Octree, LinearNearest);
+
+BENCHMARK_DEFINE_F(Octree, LinearRayIntersects)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(linearQueryEngine.intersects(Ray3D(makeVec(), makeVec().normalized()), intersectsFunc));
+  }
+}
+
+BENCHMARK_REGISTER_F(Octree, LinearRayIntersects);
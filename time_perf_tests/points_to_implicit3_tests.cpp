@@ -0,0 +1,83 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/points_to_implicits/anisotropic_points_to_implicit3.h"
+#include "../vox.geometry/points_to_implicits/sph_points_to_implicit3.h"
+#include "../vox.geometry/points_to_implicits/zhu_bridson_points_to_implicit3.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using vox::geometry::Array1;
+using vox::geometry::CellCenteredScalarGrid3;
+using vox::geometry::Vector3D;
+
+class PointsToImplicit3 : public ::benchmark::Fixture {
+protected:
+  static constexpr size_t kResolution = 64;
+  static constexpr double kParticleSpacing = 1.0 / 96.0;
+  static constexpr double kKernelRadius = 2.0 * kParticleSpacing;
+
+  Array1<Vector3D> points;
+  CellCenteredScalarGrid3 grid;
+
+  // Jittered lattice of particles filling a ball in the lower half of the
+  // domain, so that most of the grid is empty space as in a typical frame.
+  void SetUp(const ::benchmark::State &) override {
+    std::mt19937 rng{0};
+    std::uniform_real_distribution<> dist{-0.1 * kParticleSpacing, 0.1 * kParticleSpacing};
+
+    const Vector3D center{0.5, 0.3, 0.5};
+    const double radius = 0.25;
+    const auto n = static_cast<int>(radius / kParticleSpacing);
+
+    points.clear();
+    for (int k = -n; k <= n; ++k) {
+      for (int j = -n; j <= n; ++j) {
+        for (int i = -n; i <= n; ++i) {
+          const Vector3D x =
+              center + kParticleSpacing * Vector3D(i, j, k) + Vector3D(dist(rng), dist(rng), dist(rng));
+          if (x.distanceTo(center) < radius) {
+            points.append(x);
+          }
+        }
+      }
+    }
+
+    const double h = 1.0 / static_cast<double>(kResolution);
+    grid.resize(vox::geometry::Vector3UZ::makeConstant(kResolution), Vector3D::makeConstant(h));
+  }
+};
+
+BENCHMARK_DEFINE_F(PointsToImplicit3, Sph)(benchmark::State &state) {
+  const vox::geometry::SphPointsToImplicit3 converter(kKernelRadius, 0.5, false, state.range(0) != 0);
+  while (state.KeepRunning()) {
+    converter.convert(points, &grid);
+  }
+}
+
+BENCHMARK_REGISTER_F(PointsToImplicit3, Sph)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(PointsToImplicit3, ZhuBridson)(benchmark::State &state) {
+  const vox::geometry::ZhuBridsonPointsToImplicit3 converter(kKernelRadius, 0.25, false, state.range(0) != 0);
+  while (state.KeepRunning()) {
+    converter.convert(points, &grid);
+  }
+}
+
+BENCHMARK_REGISTER_F(PointsToImplicit3, ZhuBridson)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(PointsToImplicit3, Anisotropic)(benchmark::State &state) {
+  const vox::geometry::AnisotropicPointsToImplicit3 converter(kKernelRadius, 0.5, 0.5, 25, false,
+                                                              state.range(0) != 0);
+  while (state.KeepRunning()) {
+    converter.convert(points, &grid);
+  }
+}
+
+BENCHMARK_REGISTER_F(PointsToImplicit3, Anisotropic)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
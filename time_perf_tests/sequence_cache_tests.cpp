@@ -0,0 +1,95 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/sequence_cache.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using vox::geometry::ParticleSystemData3;
+using vox::geometry::SequenceCacheReader;
+using vox::geometry::SequenceCacheWriter;
+
+class SequenceCache : public ::benchmark::Fixture {
+protected:
+  static constexpr size_t kNumberOfFrames = 8;
+
+  const std::string filename = "sequence_cache_benchmark.bin";
+  ParticleSystemData3 frames[kNumberOfFrames];
+
+  // Particles in a swirling flow, advected between the frames
+  void SetUp(const ::benchmark::State &) override {
+    std::mt19937 rng{0};
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    const size_t n = 1 << 18;
+    for (size_t f = 0; f < kNumberOfFrames; ++f) {
+      frames[f].resize(n);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      const double r = 0.1 + 0.3 * d(rng);
+      const double theta = 6.28 * d(rng);
+      const double z = d(rng);
+      for (size_t f = 0; f < kNumberOfFrames; ++f) {
+        const double angle = theta + 0.01 * static_cast<double>(f) / r;
+        frames[f].positions()[i] = {0.5 + r * std::cos(angle), 0.5 + r * std::sin(angle), z};
+        frames[f].velocities()[i] = {-0.01 * std::sin(angle), 0.01 * std::cos(angle), 0.0};
+      }
+    }
+  }
+
+  void TearDown(const ::benchmark::State &) override { std::remove(filename.c_str()); }
+};
+
+BENCHMARK_DEFINE_F(SequenceCache, Write)(benchmark::State &state) {
+  size_t bytes = 0;
+  while (state.KeepRunning()) {
+    SequenceCacheWriter writer(filename);
+    for (const auto &frame : frames) {
+      writer.append(frame);
+    }
+    writer.finish();
+    bytes = writer.bytesWritten();
+  }
+  state.counters["BytesPerParticle"] =
+      static_cast<double>(bytes) / static_cast<double>(kNumberOfFrames * frames[0].numberOfParticles());
+}
+
+BENCHMARK_REGISTER_F(SequenceCache, Write)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(SequenceCache, Read)(benchmark::State &state) {
+  {
+    SequenceCacheWriter writer(filename);
+    for (const auto &frame : frames) {
+      writer.append(frame);
+    }
+  }
+
+  ParticleSystemData3 particles;
+  while (state.KeepRunning()) {
+    SequenceCacheReader reader(filename);
+    for (size_t f = 0; f < reader.numberOfFrames(); ++f) {
+      reader.load(f, &particles);
+    }
+    benchmark::DoNotOptimize(particles.positions().data());
+  }
+}
+
+BENCHMARK_REGISTER_F(SequenceCache, Read)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(SequenceCache, SerializeToFile)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    for (const auto &frame : frames) {
+      vox::geometry::serializeToFile(&frame, filename);
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(SequenceCache, SerializeToFile)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,78 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/array.h"
+#include "../vox.geometry/svd.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using vox::geometry::Array1;
+using vox::geometry::ExecutionPolicy;
+using vox::geometry::Matrix3x3D;
+using vox::geometry::Vector3D;
+
+class Svd3x3 : public ::benchmark::Fixture {
+protected:
+  Array1<Matrix3x3D> covs;
+  Array1<Matrix3x3D> us;
+  Array1<Matrix3x3D> ws;
+  Array1<Vector3D> vs;
+
+  // Covariance matrices as in the anisotropic surfacing
+  void SetUp(const ::benchmark::State &state) override {
+    std::mt19937 rng{0};
+    std::uniform_real_distribution<> dist{-1.0, 1.0};
+
+    const auto n = static_cast<size_t>(state.range(0));
+    covs.resize(n);
+    us.resize(n);
+    ws.resize(n);
+    vs.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+      Matrix3x3D cov = Matrix3x3D::makeScaleMatrix(0.01, 0.01, 0.01);
+      for (size_t j = 0; j < 30; ++j) {
+        const Vector3D r{dist(rng), 0.5 * dist(rng), 0.1 * dist(rng)};
+        for (size_t k = 0; k < 9; ++k) {
+          cov[k] += r[k / 3] * r[k % 3];
+        }
+      }
+      covs[i] = cov / 30.0;
+    }
+  }
+};
+
+BENCHMARK_DEFINE_F(Svd3x3, Svd)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < covs.length(); ++i) {
+      vox::geometry::svd(covs[i], us[i], vs[i], ws[i]);
+    }
+    benchmark::DoNotOptimize(vs.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(Svd3x3, Svd)->Arg(1 << 16);
+
+BENCHMARK_DEFINE_F(Svd3x3, SymmetricEigen)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < covs.length(); ++i) {
+      vox::geometry::symmetricEigen(covs[i], us[i], vs[i]);
+    }
+    benchmark::DoNotOptimize(vs.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(Svd3x3, SymmetricEigen)->Arg(1 << 16);
+
+BENCHMARK_DEFINE_F(Svd3x3, SymmetricEigenBatched)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    vox::geometry::symmetricEigen<double>(covs, us, vs, ExecutionPolicy::kSerial);
+    benchmark::DoNotOptimize(vs.data());
+  }
+}
+
+BENCHMARK_REGISTER_F(Svd3x3, SymmetricEigenBatched)->Arg(1 << 16);
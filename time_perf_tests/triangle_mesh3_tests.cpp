@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "../vox.geometry/ray.h"
 #include "../vox.geometry/surfaces/triangle_mesh3.h"
 
 #include <benchmark/benchmark.h>
@@ -46,3 +47,12 @@ BENCHMARK_DEFINE_F(TriangleMesh3, IsInside)(benchmark::State &state) {
 }
 
 BENCHMARK_REGISTER_F(TriangleMesh3, IsInside);
+
+BENCHMARK_DEFINE_F(TriangleMesh3, ClosestIntersection)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    vox::geometry::Ray3D ray(makeVec(), (makeVec() - Vector3D(0.5, 0.5, 0.5)).normalized());
+    benchmark::DoNotOptimize(triMesh.closestIntersection(ray));
+  }
+}
+
+BENCHMARK_REGISTER_F(TriangleMesh3, ClosestIntersection);
@@ -44,3 +44,12 @@ BENCHMARK_DEFINE_F(TriangleMeshToSDF, Call)(benchmark::State &state) {
 }
 
 BENCHMARK_REGISTER_F(TriangleMeshToSDF, Call)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(TriangleMeshToSDF, NarrowBand)(benchmark::State &state) {
+  const double bandWidth = 3.0 * grid.gridSpacing().x;
+  while (state.KeepRunning()) {
+    vox::geometry::triangleMeshToSdf(triMesh, bandWidth, &grid);
+  }
+}
+
+BENCHMARK_REGISTER_F(TriangleMeshToSDF, NarrowBand)->Unit(benchmark::kMillisecond);
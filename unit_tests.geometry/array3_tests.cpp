@@ -216,3 +216,42 @@ TEST(Array3, View) {
     EXPECT_FLOAT_EQ((float)i + 1.f, arr2[i]);
   }
 }
+
+TEST(Array3, AlignedAllocator) {
+  Array<float, 3, CacheAlignedAllocator<float>> arr1(Vector3UZ(5, 3, 7), 2.f);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr1.data()) % kDefaultArrayAlignment);
+  EXPECT_EQ(Vector3UZ(5, 3, 7), arr1.size());
+  arr1.forEach([](float val) { EXPECT_FLOAT_EQ(2.f, val); });
+
+  arr1(4, 2, 6) = 3.f;
+  arr1.resize(Vector3UZ(6, 3, 7), 1.f);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr1.data()) % kDefaultArrayAlignment);
+  EXPECT_FLOAT_EQ(3.f, arr1(4, 2, 6));
+  EXPECT_FLOAT_EQ(1.f, arr1(5, 2, 6));
+
+  // Copies between the allocators and views work as with the default one
+  Array3<float> arr2(arr1);
+  Array<float, 3, NumaAwareAllocator<float>> arr3(arr2.view());
+  ArrayView3<const float> view = arr3;
+  forEachIndex(arr1.size(), [&](size_t i, size_t j, size_t k) { EXPECT_EQ(arr1(i, j, k), view(i, j, k)); });
+
+  Array<float, 3, NumaAwareAllocator<float>> arr4;
+  arr4.swap(arr3);
+  EXPECT_EQ(Vector3UZ(), arr3.size());
+  EXPECT_FLOAT_EQ(3.f, arr4(4, 2, 6));
+}
+
+TEST(Array3, HugePageAllocator) {
+  // Large enough to be aligned to the huge pages
+  Array<double, 3, HugePageAllocator<double>> arr(Vector3UZ(64, 64, 80), 1.0);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(arr.data()) % kHugePageSize);
+
+  arr.parallelForEachIndex([&](size_t i, size_t j, size_t k) { arr(i, j, k) += static_cast<double>(i + j + k); });
+  EXPECT_DOUBLE_EQ(1.0, arr(0, 0, 0));
+  EXPECT_DOUBLE_EQ(64.0 + 63.0 + 79.0, arr(63, 63, 79));
+
+  // Small arrays only use the regular alignment
+  Array<double, 3, HugePageAllocator<double>> small(Vector3UZ(4, 4, 4));
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(small.data()) % kDefaultArrayAlignment);
+  EXPECT_DOUBLE_EQ(0.0, small(3, 3, 3));
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/array_expression.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace vox;
+using namespace geometry;
+
+TEST(ArrayExpression, Arithmetic) {
+  Array1<double> b = {1.0, 2.0, 3.0, 4.0};
+  Array1<double> c = {5.0, 6.0, 7.0, 8.0};
+  Array1<double> d = {0.5, 0.5, 1.0, 1.0};
+  const double s = 2.0;
+
+  Array1<double> a;
+  a = b + s * c - d;
+  ASSERT_EQ(4u, a.length());
+  for (size_t i = 0; i < a.length(); ++i) {
+    EXPECT_DOUBLE_EQ(b[i] + s * c[i] - d[i], a[i]);
+  }
+
+  // Views and the result itself can be operands
+  ConstArrayView1<double> bView(b);
+  a = -a + bView * 3.0 / s;
+  for (size_t i = 0; i < a.length(); ++i) {
+    EXPECT_DOUBLE_EQ(-(b[i] + s * c[i] - d[i]) + b[i] * 3.0 / s, a[i]);
+  }
+
+  Array1<double> evaluated = (c - b).eval();
+  Array1<double> constructed = 0.5 * (b + c);
+  for (size_t i = 0; i < b.length(); ++i) {
+    EXPECT_EQ(4.0, evaluated[i]);
+    EXPECT_EQ(3.0 + static_cast<double>(i), constructed[i]);
+  }
+
+  Array1<double> shorter = {1.0, 2.0};
+  EXPECT_THROW(static_cast<void>(b + shorter), std::invalid_argument);
+}
+
+TEST(ArrayExpression, Vectors) {
+  Array3<double> x(4, 3, 2, 1.0);
+  Array3<double> y(4, 3, 2);
+  y.forEachIndex([&](size_t i, size_t j, size_t k) { y(i, j, k) = static_cast<double>(i + 2 * j + 3 * k); });
+
+  Array3<double> result(2, 2, 2);
+  result = 0.5 * x + y;
+  EXPECT_EQ(y.size(), result.size());
+  result.forEachIndex([&](size_t i, size_t j, size_t k) { EXPECT_DOUBLE_EQ(0.5 + y(i, j, k), result(i, j, k)); });
+
+  Array1<Vector3D> positions = {{0.0, 1.0, 2.0}, {3.0, 4.0, 5.0}};
+  Array1<Vector3D> velocities = {{1.0, 0.0, 0.0}, {0.0, -2.0, 1.0}};
+  Array1<Vector3D> newPositions(2);
+  (positions + 0.5 * velocities).evalTo(newPositions.view());
+  EXPECT_EQ(Vector3D(0.5, 1.0, 2.0), newPositions[0]);
+  EXPECT_EQ(Vector3D(3.0, 3.0, 5.5), newPositions[1]);
+
+  Array1<Vector3D> tooSmall(1);
+  EXPECT_THROW((positions - velocities).evalTo(tooSmall.view()), std::invalid_argument);
+}
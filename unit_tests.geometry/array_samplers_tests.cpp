@@ -70,6 +70,12 @@ TEST(LinearArraySampler1, Sample) {
     double s1 = sampler({-0.7});
     EXPECT_LT(std::fabs(s1 - 1.6), 1e-9);
   }
+  {
+    Array1<double> grid;
+    LinearArraySampler1<double> sampler(grid.view(), {1.0}, {0.0});
+
+    EXPECT_EQ(0.0, sampler({0.5}));
+  }
 }
 
 TEST(CubicArraySampler1, Sample) {
@@ -266,6 +272,26 @@ TEST(LinearArraySampler2, GetCoordinatesAndGradientWeights) {
   }
 }
 
+TEST(LinearArraySampler3, SampleFlatAxis) {
+  // Single layer along y, which should be sampled as a 2-D array
+  Array3<double> grid(Vector3UZ(3, 1, 2));
+  grid(0, 0, 0) = 1.0;
+  grid(1, 0, 0) = 2.0;
+  grid(2, 0, 0) = 4.0;
+  grid(0, 0, 1) = 3.0;
+  grid(1, 0, 1) = 4.0;
+  grid(2, 0, 1) = 6.0;
+  LinearArraySampler3<double> sampler(grid.view(), Vector3D(1.0, 1.0, 1.0), Vector3D());
+
+  EXPECT_NEAR(2.5, sampler(Vector3D(0.5, 0.0, 0.5)), kEps);
+  EXPECT_NEAR(2.5, sampler(Vector3D(0.5, 7.0, 0.5)), kEps);
+  EXPECT_NEAR(5.0, sampler(Vector3D(1.5, -3.0, 1.0)), kEps);
+
+  // Clamped outside of the array
+  EXPECT_NEAR(1.0, sampler(Vector3D(-2.0, 0.0, -1.0)), kEps);
+  EXPECT_NEAR(6.0, sampler(Vector3D(5.0, 0.0, 3.0)), kEps);
+}
+
 TEST(CubicArraySampler2, Sample) {
   Array2<double> grid(
       {{1.0, 2.0, 3.0, 4.0}, {2.0, 3.0, 4.0, 5.0}, {3.0, 4.0, 5.0, 6.0}, {4.0, 5.0, 6.0, 7.0}, {5.0, 6.0, 7.0, 8.0}});
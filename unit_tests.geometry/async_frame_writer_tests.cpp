@@ -0,0 +1,101 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/array.h"
+#include "../vox.geometry/async_frame_writer.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+
+using namespace vox;
+using namespace geometry;
+
+TEST(AsyncFrameWriter, Constructors) {
+  AsyncFrameWriter writer;
+  EXPECT_EQ(AsyncFrameWriter::kDefaultMaxPendingFrames, writer.maxPendingFrames());
+  EXPECT_EQ(1u, writer.numberOfWorkers());
+  EXPECT_EQ(0u, writer.numberOfPendingFrames());
+
+  AsyncFrameWriter writer2(4, 3);
+  EXPECT_EQ(4u, writer2.maxPendingFrames());
+  EXPECT_EQ(3u, writer2.numberOfWorkers());
+
+  EXPECT_THROW(AsyncFrameWriter(0), std::invalid_argument);
+}
+
+TEST(AsyncFrameWriter, BackPressure) {
+  AsyncFrameWriter writer(2);
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> numberOfWrittenFrames{0};
+
+  const auto blockedJob = [&]() -> AsyncFrameWriter::Job {
+    return [&, released]() {
+      released.wait();
+      ++numberOfWrittenFrames;
+    };
+  };
+
+  writer.submit(blockedJob);
+  writer.submit(blockedJob);
+  EXPECT_EQ(2u, writer.numberOfPendingFrames());
+
+  // The third frame has to wait until one of the first two is written
+  std::atomic<bool> isSnapshotTaken{false};
+  auto third = std::async(std::launch::async, [&]() {
+    writer.submit([&]() -> AsyncFrameWriter::Job {
+      isSnapshotTaken = true;
+      return [&]() { ++numberOfWrittenFrames; };
+    });
+  });
+  EXPECT_EQ(std::future_status::timeout, third.wait_for(std::chrono::milliseconds(50)));
+  EXPECT_FALSE(isSnapshotTaken);
+
+  release.set_value();
+  third.get();
+  EXPECT_TRUE(isSnapshotTaken);
+
+  writer.flush();
+  EXPECT_EQ(3, numberOfWrittenFrames);
+  EXPECT_EQ(0u, writer.numberOfPendingFrames());
+}
+
+TEST(AsyncFrameWriter, Errors) {
+  AsyncFrameWriter writer(2, 2);
+  writer.submit([]() -> AsyncFrameWriter::Job { return []() { throw std::runtime_error("disk full"); }; });
+  EXPECT_THROW(writer.flush(), std::runtime_error);
+
+  // The error is reported once
+  writer.flush();
+
+  EXPECT_THROW(writer.submit([]() -> AsyncFrameWriter::Job { throw std::logic_error("snapshot"); }),
+               std::logic_error);
+  EXPECT_EQ(0u, writer.numberOfPendingFrames());
+}
+
+TEST(SnapshotPool, Acquire) {
+  SnapshotPool<Array1<double>> pool;
+  Array1<double> state(100, 1.0);
+
+  auto snapshot = pool.acquire(state);
+  const double *storage = snapshot->data();
+  EXPECT_EQ(1.0, (*snapshot)[99]);
+  EXPECT_EQ(0u, pool.numberOfAvailableSnapshots());
+
+  snapshot.reset();
+  EXPECT_EQ(1u, pool.numberOfAvailableSnapshots());
+
+  // The released copy and its storage are reused
+  state.fill(2.0);
+  snapshot = pool.acquire(state);
+  EXPECT_EQ(storage, snapshot->data());
+  EXPECT_EQ(2.0, (*snapshot)[99]);
+  EXPECT_EQ(0u, pool.numberOfAvailableSnapshots());
+}
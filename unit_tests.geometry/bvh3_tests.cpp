@@ -88,6 +88,42 @@ TEST(Bvh3, Nearest) {
   EXPECT_EQ(answerIdx, nearest.item - &bvh.item(0));
 }
 
+TEST(Bvh3, NearestBatched) {
+  Bvh3<Vector3D> bvh;
+
+  auto distanceFunc = [](const Vector3D &a, const Vector3D &b) { return a.distanceTo(b); };
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  Array1<Vector3D> points(numSamples / 2);
+  std::copy(getSamplePoints3(), getSamplePoints3() + numSamples / 2, points.begin());
+
+  Array1<BoundingBox3D> bounds(points.size());
+  size_t i = 0;
+  std::generate(bounds.begin(), bounds.end(), [&]() {
+    auto c = points[i++];
+    BoundingBox3D box(c, c);
+    box.expand(0.1);
+    return box;
+  });
+
+  bvh.build(points, bounds);
+
+  // Not a multiple of the packet size
+  Array1<Vector3D> queries(numSamples / 2 - 3);
+  std::copy(getSamplePoints3() + numSamples / 2, getSamplePoints3() + numSamples - 3, queries.begin());
+
+  Array1<NearestNeighborQueryResult3<Vector3D>> results(queries.length());
+  bvh.nearest(queries, distanceFunc, results);
+  for (i = 0; i < queries.length(); ++i) {
+    auto expected = bvh.nearest(queries[i], distanceFunc);
+    EXPECT_EQ(expected.item, results[i].item);
+    EXPECT_DOUBLE_EQ(expected.distance, results[i].distance);
+  }
+
+  Array1<NearestNeighborQueryResult3<Vector3D>> wrongSize(queries.length() + 1);
+  EXPECT_THROW(bvh.nearest(queries, distanceFunc, wrongSize), std::invalid_argument);
+}
+
 TEST(Bvh3, BBoxIntersects) {
   Bvh3<Vector3D> bvh;
 
@@ -208,6 +244,43 @@ TEST(Bvh3, ClosestIntersection) {
   }
 }
 
+TEST(Bvh3, ClosestIntersectionBatched) {
+  Bvh3<BoundingBox3D> bvh;
+
+  auto intersectsFunc = [](const BoundingBox3D &a, const Ray3D &ray) {
+    auto bboxResult = a.closestIntersection(ray);
+    if (bboxResult.isIntersecting) {
+      return bboxResult.tNear;
+    } else {
+      return kMaxD;
+    }
+  };
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  Array1<BoundingBox3D> items(numSamples / 2);
+  size_t i = 0;
+  std::generate(items.begin(), items.end(), [&]() {
+    auto c = getSamplePoints3()[i++];
+    BoundingBox3D box(c, c);
+    box.expand(0.1);
+    return box;
+  });
+
+  bvh.build(items, items);
+
+  Array1<Ray3D> rays(numSamples / 2);
+  for (i = 0; i < numSamples / 2; ++i) {
+    rays[i] = Ray3D(getSamplePoints3()[i + numSamples / 2], getSampleDirs3()[i + numSamples / 2]);
+  }
+
+  Array1<ClosestIntersectionQueryResult3<BoundingBox3D>> results(rays.length());
+  bvh.closestIntersection(rays, intersectsFunc, results);
+  for (i = 0; i < rays.length(); ++i) {
+    auto expected = bvh.closestIntersection(rays[i], intersectsFunc);
+    EXPECT_DOUBLE_EQ(expected.distance, results[i].distance);
+  }
+}
+
 TEST(Bvh3, ForEachOverlappingItems) {
   Bvh3<Vector3D> bvh;
 
@@ -242,3 +315,135 @@ TEST(Bvh3, ForEachOverlappingItems) {
 
   EXPECT_EQ(numOverlaps, measured);
 }
+
+TEST(Bvh3, BinnedSah) {
+  Bvh3<Vector3D> bvh(true);
+  EXPECT_TRUE(bvh.useBinnedSah());
+
+  auto distanceFunc = [](const Vector3D &a, const Vector3D &b) { return a.distanceTo(b); };
+  auto overlapsFunc = [](const Vector3D &pt, const BoundingBox3D &bbox) { return bbox.contains(pt); };
+
+  // Enough points for the subtrees to be built in parallel, clustered so
+  // that the SAH splits differ from the midpoint splits.
+  const size_t numSamples = getNumberOfSamplePoints3();
+  Array1<Vector3D> points(10000);
+  Array1<BoundingBox3D> bounds(points.length());
+  for (size_t i = 0; i < points.length(); ++i) {
+    const Vector3D c = getSamplePoints3()[i % numSamples];
+    const double scale = 1.0 + static_cast<double>(i / numSamples) * 0.01;
+    points[i] = (i % 3 == 0) ? Vector3D(c * scale) : Vector3D(c * 0.1 * scale);
+    bounds[i] = BoundingBox3D(points[i], points[i]);
+    bounds[i].expand(0.01);
+  }
+
+  bvh.build(points, bounds);
+  EXPECT_EQ(points.length(), bvh.numberOfItems());
+  EXPECT_EQ(2 * points.length() - 1, bvh.numberOfNodes());
+
+  // Every item is reachable from the root and bounded by its ancestors
+  size_t numberOfLeaves = 0;
+  std::vector<size_t> todo{0};
+  while (!todo.empty()) {
+    const size_t node = todo.back();
+    todo.pop_back();
+    if (bvh.isLeaf(node)) {
+      ++numberOfLeaves;
+      continue;
+    }
+    for (size_t child : {bvh.children(node).first, bvh.children(node).second}) {
+      BoundingBox3D merged = bvh.nodeBound(node);
+      merged.merge(bvh.nodeBound(child));
+      EXPECT_BOUNDING_BOX3_EQ(bvh.nodeBound(node), merged);
+      todo.push_back(child);
+    }
+  }
+  EXPECT_EQ(points.length(), numberOfLeaves);
+
+  for (size_t i = 0; i < numSamples; i += 10) {
+    const Vector3D testPt = getSampleDirs3()[i];
+    const auto nearest = bvh.nearest(testPt, distanceFunc);
+    double bestDist = kMaxD;
+    for (const Vector3D &pt : points) {
+      bestDist = std::min(bestDist, testPt.distanceTo(pt));
+    }
+    EXPECT_DOUBLE_EQ(bestDist, nearest.distance);
+  }
+
+  BoundingBox3D testBox({0.03, 0.02, 0.01}, {0.06, 0.05, 0.04});
+  size_t numOverlaps = 0;
+  for (const Vector3D &pt : points) {
+    numOverlaps += overlapsFunc(pt, testBox);
+  }
+  size_t measured = 0;
+  bvh.forEachIntersectingItem(testBox, overlapsFunc, [&](const Vector3D &) { ++measured; });
+  EXPECT_EQ(numOverlaps, measured);
+}
+
+TEST(Bvh3, Refit) {
+  Bvh3<Vector3D> bvh;
+
+  auto distanceFunc = [](const Vector3D &a, const Vector3D &b) { return a.distanceTo(b); };
+
+  // Enough items for the subtrees to be refitted in parallel
+  const size_t numSamples = getNumberOfSamplePoints3();
+  Array1<Vector3D> points(10000);
+  Array1<BoundingBox3D> bounds(points.length());
+  for (size_t i = 0; i < points.length(); ++i) {
+    points[i] = getSamplePoints3()[i % numSamples] + 0.001 * static_cast<double>(i / numSamples) * Vector3D(1, 1, 1);
+    bounds[i] = BoundingBox3D(points[i], points[i]);
+    bounds[i].expand(0.01);
+  }
+  bvh.build(points, bounds);
+  const double builtCost = bvh.surfaceAreaCost();
+  EXPECT_GT(builtCost, 1.0);
+
+  // Refitting to the same bounds keeps the tree
+  EXPECT_TRUE(bvh.refit(bounds));
+  EXPECT_DOUBLE_EQ(builtCost, bvh.surfaceAreaCost());
+
+  // Small motion is refitted
+  Array1<Vector3D> moved(points.length());
+  for (size_t i = 0; i < points.length(); ++i) {
+    moved[i] = points[i] + 0.01 * getSampleDirs3()[i % numSamples];
+    bounds[i] = BoundingBox3D(moved[i], moved[i]);
+    bounds[i].expand(0.01);
+  }
+  EXPECT_TRUE(bvh.refit(bounds));
+
+  BoundingBox3D rootBound;
+  for (const BoundingBox3D &bound : bounds) {
+    rootBound.merge(bound);
+  }
+  EXPECT_BOUNDING_BOX3_EQ(rootBound, bvh.boundingBox());
+  for (size_t node = 0; node < bvh.numberOfNodes(); ++node) {
+    if (bvh.isLeaf(node)) {
+      EXPECT_BOUNDING_BOX3_EQ(bounds[bvh.itemOfNode(node) - bvh.begin()], bvh.nodeBound(node));
+    } else {
+      BoundingBox3D merged = bvh.nodeBound(bvh.children(node).first);
+      merged.merge(bvh.nodeBound(bvh.children(node).second));
+      EXPECT_BOUNDING_BOX3_EQ(merged, bvh.nodeBound(node));
+    }
+  }
+
+  // The items keep their values, so compare with the moved positions
+  auto movedDistanceFunc = [&](const Vector3D &item, const Vector3D &pt) {
+    return moved[static_cast<size_t>(&item - &bvh.item(0))].distanceTo(pt);
+  };
+  for (size_t i = 0; i < numSamples; i += 10) {
+    const Vector3D testPt = getSampleDirs3()[i];
+    double bestDist = kMaxD;
+    for (const Vector3D &pt : moved) {
+      bestDist = std::min(bestDist, distanceFunc(pt, testPt));
+    }
+    EXPECT_DOUBLE_EQ(bestDist, bvh.nearest(testPt, movedDistanceFunc).distance);
+  }
+
+  // Scrambled items degrade the tree, which is rebuilt
+  for (size_t i = 0; i < points.length(); ++i) {
+    const Vector3D &pt = points[(i * 7919) % points.length()];
+    bounds[i] = BoundingBox3D(pt, pt);
+    bounds[i].expand(0.01);
+  }
+  EXPECT_FALSE(bvh.refit(bounds));
+  EXPECT_LT(bvh.surfaceAreaCost(), Bvh3<Vector3D>::kDefaultMaxRefitCostRatio * builtCost);
+}
@@ -6,6 +6,10 @@
 
 #include "../vox.geometry/grids/cell_centered_scalar_grid.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <system_error>
 #include <vector>
 
 using namespace vox;
@@ -252,6 +256,26 @@ TEST(CellCenteredScalarGrid3, Fill) {
   }
 }
 
+TEST(CellCenteredScalarGrid3, SampleBatched) {
+  CellCenteredScalarGrid3 grid({5, 4, 6}, {1.0, 2.0, 0.5}, {1.0, -1.0, 0.0});
+  grid.fill([](const Vector3D &x) { return x.x * x.y + x.z; });
+
+  Array1<Vector3D> points;
+  for (size_t i = 0; i < 50; ++i) {
+    const double t = static_cast<double>(i) / 49.0;
+    points.append(Vector3D(-1.0 + 8.0 * t, 9.0 - 12.0 * t, 4.0 * t * t - 0.5));
+  }
+
+  Array1<double> values(points.length());
+  grid.sample(points, values);
+
+  for (size_t i = 0; i < points.length(); ++i) {
+    EXPECT_EQ(grid.sample(points[i]), values[i]);
+  }
+
+  EXPECT_THROW(grid.sample(points, Array1<double>(2).view()), std::invalid_argument);
+}
+
 TEST(CellCenteredScalarGrid3, GradientAtDataPoint) {
   CellCenteredScalarGrid3 grid({5, 8, 6}, {2.0, 3.0, 1.5});
 
@@ -352,3 +376,33 @@ TEST(CellCenteredScalarGrid3, Serialization) {
   EXPECT_DOUBLE_EQ(1.0, grid2.gridSpacing().y);
   EXPECT_DOUBLE_EQ(1.0, grid2.gridSpacing().z);
 }
+
+TEST(CellCenteredScalarGrid3, SerializationToFile) {
+  CellCenteredScalarGrid3 grid1({5, 4, 3}, {1.0, 2.0, 3.0}, {-5.0, 3.0, 1.0});
+  grid1.fill([&](const Vector3D &pt) { return pt.x + pt.y + pt.z; });
+
+  const std::string filename = ::testing::TempDir() + "cell_centered_scalar_grid3.bin";
+  serializeToFile(&grid1, filename);
+
+  // The file holds the same flat buffer as the in-memory serialization
+  std::vector<uint8_t> buffer;
+  grid1.serialize(&buffer);
+  const MappedFile file(filename);
+  ASSERT_EQ(buffer.size(), file.size());
+  EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), file.data()));
+
+  // The data can be read in place
+  auto view = CellCenteredScalarGrid3::mappedDataView(file.view());
+  EXPECT_EQ(grid1.dataSize(), view.size());
+  grid1.forEachDataPointIndex([&](size_t i, size_t j, size_t k) { EXPECT_EQ(grid1(i, j, k), view(i, j, k)); });
+
+  CellCenteredScalarGrid3 grid2({1, 2, 4}, {0.5, 1.0, 2.0}, {0.5, 2.0, -3.0});
+  deserializeFromFile(filename, &grid2);
+  EXPECT_EQ(grid1.resolution(), grid2.resolution());
+  EXPECT_EQ(grid1.gridSpacing(), grid2.gridSpacing());
+  EXPECT_EQ(grid1.origin(), grid2.origin());
+  grid1.forEachDataPointIndex([&](size_t i, size_t j, size_t k) { EXPECT_EQ(grid1(i, j, k), grid2(i, j, k)); });
+
+  std::remove(filename.c_str());
+  EXPECT_THROW(deserializeFromFile(filename, &grid2), std::system_error);
+}
@@ -308,6 +308,33 @@ TEST(CellCenteredVectorGrid3, Fill) {
   }
 }
 
+TEST(CellCenteredVectorGrid3, SampleBatched) {
+  CellCenteredVectorGrid3 grid({5, 4, 6}, {1.0, 2.0, 0.5}, {1.0, -1.0, 0.0});
+  grid.fill([](const Vector3D &x) { return Vector3D(x.sum(), x.x * x.y, -x.z); });
+
+  Array1<Vector3D> points;
+  for (size_t i = 0; i < 50; ++i) {
+    const double t = static_cast<double>(i) / 49.0;
+    points.append(Vector3D(-1.0 + 8.0 * t, 9.0 - 12.0 * t, 4.0 * t * t - 0.5));
+  }
+
+  Array1<Vector3D> values(points.length());
+  grid.sample(points, values, ExecutionPolicy::kSerial);
+
+  for (size_t i = 0; i < points.length(); ++i) {
+    EXPECT_EQ(grid.sample(points[i]), values[i]);
+  }
+
+  // Linear fields are reproduced between the data points
+  Array1<Vector3D> inside{{2.2, 0.5, 1.1}, {4.9, 4.1, 2.6}};
+  Array1<Vector3D> insideValues(inside.length());
+  grid.sample(inside, insideValues);
+  for (size_t i = 0; i < inside.length(); ++i) {
+    EXPECT_NEAR(inside[i].sum(), insideValues[i].x, 1e-12);
+    EXPECT_NEAR(-inside[i].z, insideValues[i].z, 1e-12);
+  }
+}
+
 TEST(CellCenteredVectorGrid3, DivergenceAtDataPoint) {
   CellCenteredVectorGrid3 grid({5, 8, 6});
 
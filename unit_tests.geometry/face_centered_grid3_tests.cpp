@@ -6,6 +6,8 @@
 
 #include "../vox.geometry/grids/face_centered_grid.h"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
 #include <vector>
 
 using namespace vox;
@@ -165,6 +167,49 @@ TEST(FaceCenteredGrid3, Fill) {
   }
 }
 
+TEST(FaceCenteredGrid3, FillThroughBase) {
+  FaceCenteredGrid3 expected({5, 4, 6}, {0.5, 1.0, 2.0}, {1.0, -2.0, 0.5});
+  FaceCenteredGrid3 actual({5, 4, 6}, {0.5, 1.0, 2.0}, {1.0, -2.0, 0.5});
+  auto func = [](const Vector3D &x) { return Vector3D(x.y * x.z, std::sin(x.x), x.x - x.z); };
+
+  // Type-erased virtual call and the inlined template should agree exactly
+  VectorGrid3 &base = expected;
+  base.fill(func);
+  actual.fill(func);
+
+  expected.forEachUIndex([&](size_t i, size_t j, size_t k) { EXPECT_EQ(expected.u(i, j, k), actual.u(i, j, k)); });
+  expected.forEachVIndex([&](const Vector3UZ &idx) { EXPECT_EQ(expected.v(idx), actual.v(idx)); });
+  expected.forEachWIndex([&](size_t i, size_t j, size_t k) { EXPECT_EQ(expected.w(i, j, k), actual.w(i, j, k)); });
+}
+
+TEST(FaceCenteredGrid3, ForEachIndex) {
+  FaceCenteredGrid3 grid({5, 4, 6});
+
+  // Serial iteration is i-first
+  size_t n = 0;
+  grid.forEachUIndex([&](const Vector3UZ &idx) {
+    EXPECT_EQ(n, idx.x + 6 * (idx.y + 4 * idx.z));
+    ++n;
+  });
+  EXPECT_EQ(6u * 4u * 6u, n);
+
+  std::atomic<size_t> count{0};
+  grid.parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+    EXPECT_LT(i, grid.uSize().x);
+    EXPECT_LT(j, grid.uSize().y);
+    EXPECT_LT(k, grid.uSize().z);
+    ++count;
+  });
+  EXPECT_EQ(6u * 4u * 6u, count);
+
+  count = 0;
+  grid.parallelForEachCellIndex([&](const Vector3UZ &idx) {
+    EXPECT_LT(idx.x, 5u);
+    ++count;
+  });
+  EXPECT_EQ(5u * 4u * 6u, count);
+}
+
 TEST(FaceCenteredGrid3, DivergenceAtCellCenter) {
   FaceCenteredGrid3 grid({5, 8, 6});
 
@@ -249,6 +294,28 @@ TEST(FaceCenteredGrid3, Sample) {
   });
 }
 
+TEST(FaceCenteredGrid3, SampleBatched) {
+  FaceCenteredGrid3 grid({5, 8, 6}, {2.0, 3.0, 1.5});
+  grid.fill([&](const Vector3D &x) { return Vector3D(3.0 * x.y + 1.0, 5.0 * x.z + 7.0, -1.0 * x.x - 9.0); });
+
+  // Cell centers, and points outside of the domain which are clamped
+  Array1<Vector3D> points;
+  auto pos = grid.cellCenterPosition();
+  grid.forEachCellIndex([&](const Vector3UZ &idx) { points.append(pos(idx) + Vector3D(0.3, -0.7, 0.2)); });
+  points.append(Vector3D(-4.0, 30.0, 2.0));
+  points.append(Vector3D(12.0, -1.0, 100.0));
+
+  Array1<Vector3D> values(points.length());
+  const VectorGrid3 &base = grid;
+  base.sample(points, values);
+
+  for (size_t i = 0; i < points.length(); ++i) {
+    EXPECT_EQ(grid.sample(points[i]), values[i]);
+  }
+
+  EXPECT_THROW(grid.sample(points, Array1<Vector3D>(1).view()), std::invalid_argument);
+}
+
 TEST(FaceCenteredGrid3, Builder) {
   {
     auto builder = FaceCenteredGrid3::builder();
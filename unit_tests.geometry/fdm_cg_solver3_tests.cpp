@@ -32,3 +32,85 @@ TEST(FdmCgSolver3, SolveCompressed) {
 
   EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmCgSolver3, SolveCompressedSell) {
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {3, 3, 3});
+
+  FdmCgSolver3 solver(100, 1e-9, true);
+  EXPECT_TRUE(solver.useSellFormat());
+
+  solver.solveCompressed(&system);
+
+  EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmCgSolver3, SolveSStep) {
+  FdmLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {8, 8, 8});
+  system.A(0, 0, 0).center += 1e-3;
+
+  FdmCgSolver3 solver(1000, 1e-9, false, 4);
+  EXPECT_EQ(4u, solver.sStepSize());
+
+  EXPECT_TRUE(solver.solve(&system));
+  EXPECT_GT(solver.tolerance(), solver.lastResidual());
+
+  FdmVector3 residual(system.x.size());
+  FdmBlas3::residual(system.A, system.x, system.b, &residual);
+  EXPECT_GT(solver.tolerance(), FdmBlas3::l2Norm(residual));
+}
+
+TEST(FdmCgSolver3, SolveCompressedSStep) {
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {8, 8, 8});
+
+  FdmCgSolver3 solver(1000, 1e-9, true, 3);
+  EXPECT_TRUE(solver.solveCompressed(&system));
+
+  VectorND residual(system.x.rows());
+  FdmCompressedBlas3::residual(system.A, system.x, system.b, &residual);
+  EXPECT_GT(solver.tolerance(), FdmCompressedBlas3::l2Norm(residual));
+}
+
+TEST(FdmCgSolver3, SolveConstantModeDeflation) {
+  // Nearly singular system: the constant mode is only weakly pinned.
+  FdmLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {16, 16, 16});
+  system.A(0, 0, 0).center += 1e-3;
+  FdmLinearSystem3 copy = system;
+
+  FdmCgSolver3 plainSolver(1000, 1e-8);
+  EXPECT_TRUE(plainSolver.solve(&system));
+
+  FdmCgSolver3 deflatedSolver(1000, 1e-8, false, 1, true);
+  EXPECT_TRUE(deflatedSolver.useConstantModeDeflation());
+  EXPECT_TRUE(deflatedSolver.solve(&copy));
+
+  EXPECT_LT(4 * deflatedSolver.lastNumberOfIterations(), plainSolver.lastNumberOfIterations());
+
+  FdmVector3 residual(copy.x.size());
+  FdmBlas3::residual(copy.A, copy.x, copy.b, &residual);
+  EXPECT_GT(deflatedSolver.tolerance(), FdmBlas3::l2Norm(residual));
+}
+
+TEST(FdmCgSolver3, SolveConstantModeDeflationSingular) {
+  // Pure Neumann problem with an incompatible RHS. The constant component is
+  // projected out, so the residual is that component and x has zero mean.
+  FdmLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {8, 8, 8});
+  system.b(2, 3, 4) += 1.0;
+
+  FdmCgSolver3 solver(1000, 1e-9, false, 1, true);
+  EXPECT_TRUE(solver.solve(&system));
+
+  double mean = 0.0;
+  system.x.forEach([&](double v) { mean += v; });
+  EXPECT_NEAR(0.0, mean / static_cast<double>(system.x.length()), 1e-9);
+
+  FdmVector3 residual(system.x.size());
+  FdmBlas3::residual(system.A, system.x, system.b, &residual);
+  const double offset = 1.0 / static_cast<double>(system.x.length());
+  EXPECT_NEAR(offset, residual(0, 0, 0), 1e-8);
+  EXPECT_NEAR(offset, residual(2, 3, 4), 1e-8);
+}
@@ -80,6 +80,111 @@ TEST(FdmGaussSeidelSolver3, RelaxRedBlack) {
   }
 }
 
+TEST(FdmGaussSeidelSolver3, RelaxRedBlackMatchesReference) {
+  for (const Vector3UZ &size : {Vector3UZ{32, 32, 32}, Vector3UZ{7, 5, 9}, Vector3UZ{2, 3, 4}}) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, size);
+    forEachIndex(size,
+                 [&](size_t i, size_t j, size_t k) { system.x(i, j, k) = 0.01 * static_cast<double>(i + j * k); });
+
+    FdmVector3 expected = system.x;
+    const FdmMatrix3 &A = system.A;
+    const FdmVector3 &b = system.b;
+    const double sorFactor = 1.5;
+
+    // Serial two-pass red-black sweep
+    for (size_t color = 0; color < 2; ++color) {
+      forEachIndex(size, [&](size_t i, size_t j, size_t k) {
+        if ((i + j + k) % 2 != color) {
+          return;
+        }
+        double r = ((i > 0) ? A(i - 1, j, k).right * expected(i - 1, j, k) : 0.0) +
+                   ((i + 1 < size.x) ? A(i, j, k).right * expected(i + 1, j, k) : 0.0) +
+                   ((j > 0) ? A(i, j - 1, k).up * expected(i, j - 1, k) : 0.0) +
+                   ((j + 1 < size.y) ? A(i, j, k).up * expected(i, j + 1, k) : 0.0) +
+                   ((k > 0) ? A(i, j, k - 1).front * expected(i, j, k - 1) : 0.0) +
+                   ((k + 1 < size.z) ? A(i, j, k).front * expected(i, j, k + 1) : 0.0);
+        expected(i, j, k) = (1.0 - sorFactor) * expected(i, j, k) + sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+      });
+    }
+
+    FdmGaussSeidelSolver3::relaxRedBlack(A, b, sorFactor, &system.x);
+
+    forEachIndex(size, [&](size_t i, size_t j, size_t k) { EXPECT_NEAR(expected(i, j, k), system.x(i, j, k), 1e-12); });
+  }
+}
+
+TEST(FdmGaussSeidelSolver3, RelaxRedBlackWavefront) {
+  for (const Vector3UZ &size : {Vector3UZ{32, 32, 32}, Vector3UZ{7, 5, 9}, Vector3UZ{5, 4, 1}}) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, size);
+    forEachIndex(size,
+                 [&](size_t i, size_t j, size_t k) { system.x(i, j, k) = 0.01 * static_cast<double>(i + j * k); });
+
+    FdmVector3 expected = system.x;
+    for (int iter = 0; iter < 3; ++iter) {
+      FdmGaussSeidelSolver3::relaxRedBlack(system.A, system.b, 1.5, &expected);
+    }
+
+    FdmGaussSeidelSolver3::relaxRedBlackWavefront(system.A, system.b, 3, 1.5, &system.x);
+
+    forEachIndex(size,
+                 [&](size_t i, size_t j, size_t k) { EXPECT_DOUBLE_EQ(expected(i, j, k), system.x(i, j, k)); });
+  }
+}
+
+TEST(FdmGaussSeidelSolver3, MulticolorOrdering) {
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {8, 7, 6});
+
+  FdmGaussSeidelSolver3::MulticolorOrdering ordering;
+  ordering.build(system.A);
+
+  // 7-point stencil is two-colorable
+  EXPECT_EQ(2u, ordering.numberOfColors());
+  EXPECT_EQ(system.A.rows(), ordering.rows.size());
+
+  std::vector<size_t> colors(system.A.rows());
+  for (size_t c = 0; c < ordering.numberOfColors(); ++c) {
+    for (size_t ii = ordering.colorPointers[c]; ii < ordering.colorPointers[c + 1]; ++ii) {
+      colors[ordering.rows[ii]] = c;
+    }
+  }
+
+  for (size_t i = 0; i < system.A.rows(); ++i) {
+    for (size_t jj = system.A.rowPointer(i); jj < system.A.rowPointer(i + 1); ++jj) {
+      const size_t j = system.A.columnIndex(jj);
+      if (i != j) {
+        EXPECT_NE(colors[i], colors[j]);
+      }
+    }
+  }
+}
+
+TEST(FdmGaussSeidelSolver3, RelaxMulticolor) {
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {32, 32, 32});
+
+  FdmGaussSeidelSolver3::MulticolorOrdering ordering;
+  ordering.build(system.A);
+
+  auto buffer = system.x;
+  FdmCompressedBlas3::residual(system.A, system.x, system.b, &buffer);
+  double norm0 = FdmCompressedBlas3::l2Norm(buffer);
+
+  for (int i = 0; i < 200; ++i) {
+    FdmGaussSeidelSolver3::relaxMulticolor(system.A, system.b, ordering, 1.0, &system.x);
+
+    FdmCompressedBlas3::residual(system.A, system.x, system.b, &buffer);
+    double norm = FdmCompressedBlas3::l2Norm(buffer);
+    if (i > 0) {
+      EXPECT_LT(norm, norm0);
+    }
+
+    norm0 = norm;
+  }
+}
+
 TEST(FdmGaussSeidelSolver3, SolveCompressedLowRes) {
   FdmCompressedLinearSystem3 system;
   FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {3, 3, 3});
@@ -106,3 +211,13 @@ TEST(FdmGaussSeidelSolver3, SolveCompressed) {
 
   EXPECT_LT(norm1, norm0);
 }
+
+TEST(FdmGaussSeidelSolver3, SolveCompressedMulticolor) {
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {3, 3, 3});
+
+  FdmGaussSeidelSolver3 solver(100, 10, 1e-9, 1.0, true);
+  solver.solveCompressed(&system);
+
+  EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
@@ -42,3 +42,15 @@ TEST(FdmIccgSolver3, SolveCompressed) {
 
   EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmIccgSolver3, SolveCompressedSell) {
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {3, 3, 3});
+
+  FdmIccgSolver3 solver(100, 1e-4, true);
+  EXPECT_TRUE(solver.useSellFormat());
+
+  solver.solveCompressed(&system);
+
+  EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
@@ -32,3 +32,30 @@ TEST(FdmJacobiSolver3, SolveCompressed) {
 
   EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmJacobiSolver3, RelaxChebyshev) {
+  FdmLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {32, 32, 32});
+
+  auto buffer = system.x;
+  FdmBlas3::residual(system.A, system.x, system.b, &buffer);
+  const double norm0 = FdmBlas3::l2Norm(buffer);
+
+  // Same number of stencil passes with plain Jacobi
+  FdmVector3 xJacobi = system.x;
+  FdmVector3 xTemp = system.x;
+  for (int i = 0; i < 10; ++i) {
+    FdmJacobiSolver3::relax(system.A, system.b, &xJacobi, &xTemp);
+    xTemp.swap(xJacobi);
+  }
+  FdmBlas3::residual(system.A, xJacobi, system.b, &buffer);
+  const double normJacobi = FdmBlas3::l2Norm(buffer);
+
+  FdmVector3 d;
+  FdmJacobiSolver3::relaxChebyshev(system.A, system.b, 10, &system.x, &d);
+  FdmBlas3::residual(system.A, system.x, system.b, &buffer);
+  const double normChebyshev = FdmBlas3::l2Norm(buffer);
+
+  EXPECT_LT(normChebyshev, norm0);
+  EXPECT_LT(normChebyshev, normJacobi);
+}
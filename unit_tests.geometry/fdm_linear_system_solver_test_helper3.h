@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include "../vox.geometry/fdm_linear_system_solver3.h"
+#include "../vox.geometry/fdm_mg_linear_system3.h"
 
 namespace vox {
 namespace geometry {
@@ -116,6 +117,50 @@ public:
 
     system->x.resize(system->b.rows(), 0.0);
   }
+
+  static void buildTestMgLinearSystem(FdmMgLinearSystem3 *system, size_t levels) {
+    system->resizeWithCoarsest({4, 4, 4}, levels);
+
+    // Simple Poisson eq.
+    for (size_t l = 0; l < system->numberOfLevels(); ++l) {
+      double invdx = pow(0.5, l);
+      FdmMatrix3 &A = system->A[l];
+      FdmVector3 &b = system->b[l];
+
+      system->x[l].fill(0.0);
+
+      forEachIndex(A.size(), [&](size_t i, size_t j, size_t k) {
+        if (i > 0) {
+          A(i, j, k).center += invdx * invdx;
+        }
+        if (i < A.width() - 1) {
+          A(i, j, k).center += invdx * invdx;
+          A(i, j, k).right -= invdx * invdx;
+        }
+
+        if (j > 0) {
+          A(i, j, k).center += invdx * invdx;
+        } else {
+          b(i, j, k) += invdx;
+        }
+
+        if (j < A.height() - 1) {
+          A(i, j, k).center += invdx * invdx;
+          A(i, j, k).up -= invdx * invdx;
+        } else {
+          b(i, j, k) -= invdx;
+        }
+
+        if (k > 0) {
+          A(i, j, k).center += invdx * invdx;
+        }
+        if (k < A.depth() - 1) {
+          A(i, j, k).center += invdx * invdx;
+          A(i, j, k).front -= invdx * invdx;
+        }
+      });
+    }
+  }
 };
 
 } // namespace geometry
@@ -4,6 +4,8 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "fdm_linear_system_solver_test_helper3.h"
+
 #include "../vox.geometry/fdm_solvers/fdm_mg_solver3.h"
 
 #include <gtest/gtest.h>
@@ -68,3 +70,57 @@ TEST(FdmMgSolver3, Solve) {
 
   EXPECT_LT(norm1, norm0);
 }
+
+TEST(FdmMgSolver3, SolveChebyshev) {
+  size_t levels = 6;
+  FdmMgLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestMgLinearSystem(&system, levels);
+
+  auto buffer = system.x[0];
+  FdmBlas3::residual(system.A[0], system.x[0], system.b[0], &buffer);
+  double norm0 = FdmBlas3::l2Norm(buffer);
+
+  FdmMgSolver3 solver(levels, 5, 5, 20, 20, 1e-9, 1.5, false, true);
+  EXPECT_TRUE(solver.useChebyshevSmoothing());
+  solver.solve(&system);
+
+  FdmBlas3::residual(system.A[0], system.x[0], system.b[0], &buffer);
+  double norm1 = FdmBlas3::l2Norm(buffer);
+
+  EXPECT_LT(norm1, norm0);
+}
+
+TEST(FdmMgSolver3, SolveCacheBlocking) {
+  size_t levels = 6;
+  FdmMgLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestMgLinearSystem(&system, levels);
+  FdmMgLinearSystem3 expected = system;
+
+  FdmMgSolver3 reference(levels, 5, 5, 20, 20, 1e-9, 1.5, true);
+  reference.solve(&expected);
+
+  FdmMgSolver3 solver(levels, 5, 5, 20, 20, 1e-9, 1.5, true, false, true);
+  EXPECT_TRUE(solver.useCacheBlocking());
+  solver.solve(&system);
+
+  forEachIndex(system.x[0].size(),
+               [&](size_t i, size_t j, size_t k) { EXPECT_NEAR(expected.x[0](i, j, k), system.x[0](i, j, k), 1e-12); });
+}
+
+TEST(FdmMgUtils3, ResidualRestrict) {
+  FdmMgLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestMgLinearSystem(&system, 3);
+  forEachIndex(system.x[0].size(),
+               [&](size_t i, size_t j, size_t k) { system.x[0](i, j, k) = std::sin(0.1 * i + 0.2 * j + 0.3 * k); });
+
+  FdmVector3 r = system.x[0];
+  FdmVector3 expected = system.x[1];
+  FdmBlas3::residual(system.A[0], system.x[0], system.b[0], &r);
+  FdmMgUtils3::restrict(r, &expected);
+
+  FdmVector3 actual = system.x[1];
+  FdmMgUtils3::residualRestrict(system.A[0], system.x[0], system.b[0], &actual);
+
+  forEachIndex(actual.size(),
+               [&](size_t i, size_t j, size_t k) { EXPECT_DOUBLE_EQ(expected(i, j, k), actual(i, j, k)); });
+}
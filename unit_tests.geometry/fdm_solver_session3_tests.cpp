@@ -0,0 +1,114 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper3.h"
+
+#include "../vox.geometry/fdm_solvers/fdm_cg_solver3.h"
+#include "../vox.geometry/fdm_solvers/fdm_iccg_solver3.h"
+#include "../vox.geometry/fdm_solvers/fdm_mgpcg_solver3.h"
+#include "../vox.geometry/fdm_solvers/fdm_solver_session3.h"
+
+#include <gtest/gtest.h>
+
+using namespace vox;
+using namespace geometry;
+
+TEST(FdmSolverSession3, Constructors) {
+  auto solver = std::make_shared<FdmIccgSolver3>(100, 1e-6);
+  FdmSolverSession3 session(solver);
+
+  EXPECT_EQ(solver, session.solver());
+  EXPECT_FALSE(session.wasMatrixUnchanged());
+  EXPECT_EQ(0u, session.numberOfSolves());
+
+  EXPECT_THROW(FdmSolverSession3(nullptr), std::invalid_argument);
+}
+
+TEST(FdmSolverSession3, Solve) {
+  auto solver = std::make_shared<FdmIccgSolver3>(100, 1e-6);
+  FdmSolverSession3 session(solver);
+
+  FdmLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {16, 16, 16});
+
+  EXPECT_TRUE(session.solve(&system));
+  EXPECT_FALSE(session.wasMatrixUnchanged());
+
+  // The flags of the solver are only changed during the solves of the session
+  EXPECT_FALSE(solver->useWarmStart());
+  EXPECT_FALSE(solver->isMatrixUnchanged());
+  const unsigned int coldIterations = solver->lastNumberOfIterations();
+
+  // Slightly different RHS with the same matrix, e.g. the next frame
+  FdmLinearSystem3 next;
+  FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&next, {16, 16, 16});
+  next.b(8, 8, 8) += 1e-3;
+  next.b(9, 8, 8) -= 1e-3;
+
+  EXPECT_TRUE(session.solve(&next));
+  EXPECT_TRUE(session.wasMatrixUnchanged());
+  EXPECT_FALSE(solver->isMatrixUnchanged());
+  EXPECT_LT(solver->lastNumberOfIterations(), coldIterations);
+  EXPECT_EQ(2u, session.numberOfSolves());
+
+  FdmVector3 residual(next.x.size());
+  FdmBlas3::residual(next.A, next.x, next.b, &residual);
+  EXPECT_LT(FdmBlas3::l2Norm(residual), 1e-5);
+
+  // Changing the matrix must rebuild the preconditioner
+  next.A(4, 4, 4).center += 1.0;
+  EXPECT_TRUE(session.solve(&next));
+  EXPECT_FALSE(session.wasMatrixUnchanged());
+
+  FdmBlas3::residual(next.A, next.x, next.b, &residual);
+  EXPECT_LT(FdmBlas3::l2Norm(residual), 1e-5);
+
+  session.reset();
+  EXPECT_EQ(0u, session.numberOfSolves());
+  EXPECT_TRUE(session.solve(&next));
+  EXPECT_FALSE(session.wasMatrixUnchanged());
+}
+
+TEST(FdmSolverSession3, SolveCompressed) {
+  auto solver = std::make_shared<FdmCgSolver3>(200, 1e-9, true);
+  FdmSolverSession3 session(solver);
+
+  FdmCompressedLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(&system, {8, 8, 8});
+
+  EXPECT_TRUE(session.solveCompressed(&system));
+  EXPECT_FALSE(session.wasMatrixUnchanged());
+  const unsigned int coldIterations = solver->lastNumberOfIterations();
+
+  system.x.fill(0.0);
+  EXPECT_TRUE(session.solveCompressed(&system));
+  EXPECT_TRUE(session.wasMatrixUnchanged());
+  EXPECT_LT(solver->lastNumberOfIterations(), coldIterations);
+
+  VectorND residual(system.x.rows());
+  FdmCompressedBlas3::residual(system.A, system.x, system.b, &residual);
+  EXPECT_LT(FdmCompressedBlas3::l2Norm(residual), 1e-8);
+}
+
+TEST(FdmSolverSession3, SolveMultigrid) {
+  size_t levels = 3;
+  FdmMgLinearSystem3 system;
+  FdmLinearSystemSolverTestHelper3::buildTestMgLinearSystem(&system, levels);
+
+  auto solver = std::make_shared<FdmMgpcgSolver3>(50, levels, 5, 5, 10, 10, 1e-4, 1.5, false);
+  FdmSolverSession3 session(solver);
+
+  EXPECT_TRUE(session.solve(&system));
+  const unsigned int coldIterations = solver->lastNumberOfIterations();
+
+  system.x.finest().fill(0.0);
+  EXPECT_TRUE(session.solve(&system));
+  EXPECT_TRUE(session.wasMatrixUnchanged());
+  EXPECT_LT(solver->lastNumberOfIterations(), coldIterations);
+
+  FdmSolverSession3 nonMgSession(std::make_shared<FdmCgSolver3>(10, 1e-4));
+  EXPECT_THROW(nonMgSession.solve(&system), std::invalid_argument);
+}
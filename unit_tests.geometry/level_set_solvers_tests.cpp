@@ -9,6 +9,7 @@
 #include "../vox.geometry/grids/cell_centered_scalar_grid.h"
 #include "../vox.geometry/levelset_solvers/eno_level_set_solver2.h"
 #include "../vox.geometry/levelset_solvers/eno_level_set_solver3.h"
+#include "../vox.geometry/levelset_solvers/fast_sweeping_level_set_solver3.h"
 #include "../vox.geometry/levelset_solvers/fmm_level_set_solver2.h"
 #include "../vox.geometry/levelset_solvers/fmm_level_set_solver3.h"
 #include "../vox.geometry/levelset_solvers/upwind_level_set_solver2.h"
@@ -172,6 +173,41 @@ TEST(FmmLevelSetSolver2, Reinitialize) {
   }
 }
 
+TEST(FmmLevelSetSolver2, ReinitializeNarrowBand) {
+  CellCenteredScalarGrid2 sdf({40, 30}), distorted({40, 30});
+  CellCenteredScalarGrid2 fullResult({40, 30}), bandResult({40, 30});
+
+  sdf.fill([](const Vector2D &x) { return (x - Vector2D(20, 20)).length() - 8.0; });
+  distorted.fill([](const Vector2D &x) { return 3.0 * ((x - Vector2D(20, 20)).length() - 8.0); });
+
+  FmmLevelSetSolver2 fullSolver;
+  fullSolver.reinitialize(distorted, 3.0, &fullResult);
+
+  FmmLevelSetSolver2 bandSolver(true);
+  EXPECT_TRUE(bandSolver.useNarrowBand());
+  bandSolver.reinitialize(distorted, 3.0, &bandResult);
+
+  double fullError = 0.0;
+  double bandError = 0.0;
+  for (size_t j = 0; j < 30; ++j) {
+    for (size_t i = 0; i < 40; ++i) {
+      if (std::fabs(sdf(i, j)) < 3.0) {
+        EXPECT_NEAR(sdf(i, j), bandResult(i, j), 0.6);
+      }
+      if (std::fabs(sdf(i, j)) < 2.0) {
+        fullError = std::max(fullError, std::fabs(sdf(i, j) - fullResult(i, j)));
+        bandError = std::max(bandError, std::fabs(sdf(i, j) - bandResult(i, j)));
+      } else if (std::fabs(sdf(i, j)) > 5.0) {
+        EXPECT_DOUBLE_EQ(distorted(i, j), bandResult(i, j));
+      }
+    }
+  }
+
+  // The cells next to the interface are kept fixed in the narrow-band mode,
+  // which changes the solution but not its accuracy
+  EXPECT_LT(bandError, 1.5 * fullError);
+}
+
 TEST(FmmLevelSetSolver2, Extrapolate) {
   CellCenteredScalarGrid2 sdf({40, 30}), temp({40, 30});
   CellCenteredScalarGrid2 field({40, 30});
@@ -207,6 +243,43 @@ TEST(FmmLevelSetSolver3, Reinitialize) {
   }
 }
 
+TEST(FmmLevelSetSolver3, ReinitializeNarrowBand) {
+  CellCenteredScalarGrid3 sdf({40, 30, 50}), distorted({40, 30, 50});
+  CellCenteredScalarGrid3 fullResult({40, 30, 50}), bandResult({40, 30, 50});
+
+  sdf.fill([](const Vector3D &x) { return (x - Vector3D(20, 20, 20)).length() - 8.0; });
+  distorted.fill([](const Vector3D &x) { return 3.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0); });
+
+  FmmLevelSetSolver3 fullSolver;
+  fullSolver.reinitialize(distorted, 3.0, &fullResult);
+
+  FmmLevelSetSolver3 bandSolver(true);
+  EXPECT_TRUE(bandSolver.useNarrowBand());
+  bandSolver.reinitialize(distorted, 3.0, &bandResult);
+
+  double fullError = 0.0;
+  double bandError = 0.0;
+  for (size_t k = 0; k < 50; ++k) {
+    for (size_t j = 0; j < 30; ++j) {
+      for (size_t i = 0; i < 40; ++i) {
+        if (std::fabs(sdf(i, j, k)) < 3.0) {
+          EXPECT_NEAR(sdf(i, j, k), bandResult(i, j, k), 0.9) << i << ", " << j << ", " << k;
+        }
+        if (std::fabs(sdf(i, j, k)) < 2.0) {
+          fullError = std::max(fullError, std::fabs(sdf(i, j, k) - fullResult(i, j, k)));
+          bandError = std::max(bandError, std::fabs(sdf(i, j, k) - bandResult(i, j, k)));
+        } else if (std::fabs(sdf(i, j, k)) > 5.0) {
+          EXPECT_DOUBLE_EQ(distorted(i, j, k), bandResult(i, j, k)) << i << ", " << j << ", " << k;
+        }
+      }
+    }
+  }
+
+  // The cells next to the interface are kept fixed in the narrow-band mode,
+  // which changes the solution but not its accuracy
+  EXPECT_LT(bandError, 1.5 * fullError);
+}
+
 TEST(FmmLevelSetSolver3, Extrapolate) {
   CellCenteredScalarGrid3 sdf({40, 30, 50}), temp({40, 30, 50});
   CellCenteredScalarGrid3 field({40, 30, 50});
@@ -226,3 +299,98 @@ TEST(FmmLevelSetSolver3, Extrapolate) {
     }
   }
 }
+
+TEST(FastSweepingLevelSetSolver3, Reinitialize) {
+  CellCenteredScalarGrid3 sdf({40, 30, 50}), temp({40, 30, 50});
+
+  sdf.fill([](const Vector3D &x) { return (x - Vector3D(20, 20, 20)).length() - 8.0; });
+
+  FastSweepingLevelSetSolver3 solver;
+  solver.reinitialize(sdf, 5.0, &temp);
+
+  EXPECT_LE(solver.lastNumberOfIterations(), solver.maxNumberOfIterations());
+
+  for (size_t k = 0; k < 50; ++k) {
+    for (size_t j = 0; j < 30; ++j) {
+      for (size_t i = 0; i < 40; ++i) {
+        EXPECT_NEAR(sdf(i, j, k), temp(i, j, k), 0.9) << i << ", " << j << ", " << k;
+      }
+    }
+  }
+}
+
+TEST(FastSweepingLevelSetSolver3, ReinitializeDistorted) {
+  CellCenteredScalarGrid3 sdf({40, 30, 50}), distorted({40, 30, 50});
+  CellCenteredScalarGrid3 fmmResult({40, 30, 50}), fsmResult({40, 30, 50});
+
+  sdf.fill([](const Vector3D &x) { return (x - Vector3D(20, 20, 20)).length() - 8.0; });
+  distorted.fill([](const Vector3D &x) {
+    const double phi = (x - Vector3D(20, 20, 20)).length() - 8.0;
+    return phi * (2.0 + std::sin(x.x) * std::cos(x.z));
+  });
+
+  FmmLevelSetSolver3 fmmSolver;
+  fmmSolver.reinitialize(distorted, 5.0, &fmmResult);
+
+  FastSweepingLevelSetSolver3 solver;
+  solver.reinitialize(distorted, 5.0, &fsmResult);
+
+  // Both solve the same upwind discretization. The cells next to the
+  // interface are initialized differently, so only the errors are compared.
+  double fmmError = 0.0;
+  double fsmError = 0.0;
+  for (size_t k = 0; k < 50; ++k) {
+    for (size_t j = 0; j < 30; ++j) {
+      for (size_t i = 0; i < 40; ++i) {
+        if (std::fabs(sdf(i, j, k)) < 4.0) {
+          EXPECT_NEAR(sdf(i, j, k), fsmResult(i, j, k), 0.9) << i << ", " << j << ", " << k;
+          fmmError = std::max(fmmError, std::fabs(sdf(i, j, k) - fmmResult(i, j, k)));
+          fsmError = std::max(fsmError, std::fabs(sdf(i, j, k) - fsmResult(i, j, k)));
+        }
+      }
+    }
+  }
+  EXPECT_LE(fsmError, fmmError);
+}
+
+TEST(FastSweepingLevelSetSolver3, Extrapolate) {
+  CellCenteredScalarGrid3 sdf({40, 30, 50}), temp({40, 30, 50});
+  CellCenteredScalarGrid3 field({40, 30, 50});
+
+  sdf.fill([](const Vector3D &x) { return (x - Vector3D(20, 20, 20)).length() - 8.0; });
+  field.fill(5.0);
+
+  FastSweepingLevelSetSolver3 solver;
+  solver.extrapolate(field, sdf, 5.0, &temp);
+
+  for (size_t k = 0; k < 50; ++k) {
+    for (size_t j = 0; j < 30; ++j) {
+      for (size_t i = 0; i < 40; ++i) {
+        EXPECT_NEAR(5.0, temp(i, j, k), 1e-12) << i << ", " << j << ", " << k;
+      }
+    }
+  }
+
+  // A field that is constant along the normals stays so
+  field.fill([](const Vector3D &x) {
+    const Vector3D r = x - Vector3D(20, 20, 20);
+    return r.z / r.length();
+  });
+  solver.extrapolate(field, sdf, 5.0, &temp);
+
+  for (size_t k = 0; k < 50; ++k) {
+    for (size_t j = 0; j < 30; ++j) {
+      for (size_t i = 0; i < 40; ++i) {
+        const double phi = sdf(i, j, k);
+        if (phi > 0.0 && phi < 5.0) {
+          EXPECT_NEAR(field(i, j, k), temp(i, j, k), 0.2) << i << ", " << j << ", " << k;
+        }
+      }
+    }
+  }
+
+  // Empty grids are left as they are
+  CellCenteredScalarGrid3 empty, emptyOutput;
+  solver.extrapolate(empty, sdf, 5.0, &emptyOutput);
+  EXPECT_EQ(0u, solver.lastNumberOfIterations());
+}
@@ -0,0 +1,198 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "unit_tests_utils.h"
+
+#include "../vox.geometry/query_engines/linear_octree.h"
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+// Boxes of various sizes so that the items land on different levels
+Array1<BoundingBox3D> makeSampleBoxes(size_t count) {
+  Array1<BoundingBox3D> boxes(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3D c = getSamplePoints3()[i];
+    boxes[i] = BoundingBox3D(c, c);
+    boxes[i].expand(0.001 * static_cast<double>(1 << (i % 8)));
+  }
+  return boxes;
+}
+
+} // namespace
+
+TEST(LinearOctree, Constructors) {
+  LinearOctree<Vector3D> octree;
+  EXPECT_EQ(octree.begin(), octree.end());
+  EXPECT_EQ(0u, octree.numberOfNodes());
+}
+
+TEST(LinearOctree, Build) {
+  LinearOctree<BoundingBox3D> octree;
+
+  // Single point
+  Array1<BoundingBox3D> single{BoundingBox3D({0.2, 0.7, 0.3}, {0.2, 0.7, 0.3})};
+  octree.build(single, single, 3);
+  EXPECT_EQ(3u, octree.maxDepth());
+  EXPECT_EQ(4u, octree.numberOfNodes());
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(i, octree.nodeLevel(i));
+    EXPECT_EQ(4u, octree.subtreeEnd(i));
+  }
+  EXPECT_EQ(std::make_pair(kZeroSize, kOneSize), octree.itemRange(3));
+
+  EXPECT_THROW(octree.build(single, single, LinearOctree<BoundingBox3D>::kMaxDepth + 1), std::invalid_argument);
+
+  // Many items
+  const size_t numSamples = getNumberOfSamplePoints3();
+  const Array1<BoundingBox3D> boxes = makeSampleBoxes(numSamples);
+  octree.build(boxes, boxes, 8);
+  EXPECT_EQ(numSamples, octree.numberOfItems());
+
+  std::vector<size_t> itemCounts(numSamples, 0);
+  std::vector<size_t> levelCounts(9, 0);
+  for (size_t i = 0; i < octree.numberOfNodes(); ++i) {
+    // Pre-order of the cells
+    if (i > 0) {
+      EXPECT_LE(octree.nodeCode(i - 1), octree.nodeCode(i));
+    }
+    EXPECT_GT(octree.subtreeEnd(i), i);
+
+    // The children are one level deeper and within the parent
+    for (size_t child = i + 1; child < octree.subtreeEnd(i); child = octree.subtreeEnd(child)) {
+      EXPECT_EQ(octree.nodeLevel(i) + 1, octree.nodeLevel(child));
+      EXPECT_LE(octree.subtreeEnd(child), octree.subtreeEnd(i));
+      BoundingBox3D merged = octree.nodeBound(i);
+      merged.merge(octree.nodeBound(child));
+      EXPECT_BOUNDING_BOX3_EQ(octree.nodeBound(i), merged);
+    }
+
+    // The items fit in the loose bound
+    const auto range = octree.itemRange(i);
+    for (size_t j = range.first; j < range.second; ++j) {
+      ++itemCounts[j];
+      ++levelCounts[octree.nodeLevel(i)];
+      BoundingBox3D merged = octree.nodeBound(i);
+      merged.merge(octree.item(j));
+      EXPECT_BOUNDING_BOX3_EQ(octree.nodeBound(i), merged);
+    }
+  }
+
+  for (size_t count : itemCounts) {
+    EXPECT_EQ(1u, count);
+  }
+  EXPECT_GT(levelCounts[8], 0u);
+  EXPECT_GT(levelCounts[5], 0u);
+}
+
+TEST(LinearOctree, Nearest) {
+  LinearOctree<Vector3D> octree;
+
+  auto distanceFunc = [](const Vector3D &a, const Vector3D &b) { return a.distanceTo(b); };
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  Array1<Vector3D> points(numSamples);
+  Array1<BoundingBox3D> bounds(numSamples);
+  for (size_t i = 0; i < numSamples; ++i) {
+    points[i] = getSamplePoints3()[i];
+    bounds[i] = BoundingBox3D(points[i], points[i]);
+  }
+
+  octree.build(points, bounds, 5);
+
+  for (size_t i = 0; i < numSamples; i += 7) {
+    const Vector3D testPt = getSampleDirs3()[i];
+    double bestDist = kMaxD;
+    for (const Vector3D &pt : points) {
+      bestDist = std::min(bestDist, testPt.distanceTo(pt));
+    }
+
+    auto nearest = octree.nearest(testPt, distanceFunc);
+    EXPECT_DOUBLE_EQ(bestDist, nearest.distance);
+    EXPECT_DOUBLE_EQ(bestDist, testPt.distanceTo(*nearest.item));
+  }
+}
+
+TEST(LinearOctree, BBoxIntersects) {
+  LinearOctree<BoundingBox3D> octree;
+
+  auto overlapsFunc = [](const BoundingBox3D &a, const BoundingBox3D &bbox) { return bbox.overlaps(a); };
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  const Array1<BoundingBox3D> boxes = makeSampleBoxes(numSamples);
+  octree.build(boxes, boxes, 6);
+
+  for (const BoundingBox3D &testBox :
+       {BoundingBox3D({0.25, 0.15, 0.3}, {0.5, 0.6, 0.4}), BoundingBox3D({0.3, 0.2, 0.1}, {0.31, 0.21, 0.11})}) {
+    size_t numOverlaps = 0;
+    for (const BoundingBox3D &box : boxes) {
+      numOverlaps += overlapsFunc(box, testBox);
+    }
+
+    EXPECT_EQ(numOverlaps > 0, octree.intersects(testBox, overlapsFunc));
+
+    size_t measured = 0;
+    octree.forEachIntersectingItem(testBox, overlapsFunc, [&](const BoundingBox3D &box) {
+      EXPECT_TRUE(overlapsFunc(box, testBox));
+      ++measured;
+    });
+    EXPECT_EQ(numOverlaps, measured);
+  }
+}
+
+TEST(LinearOctree, RayIntersects) {
+  LinearOctree<BoundingBox3D> octree;
+
+  auto intersectsFunc = [](const BoundingBox3D &a, const Ray3D &ray) { return a.intersects(ray); };
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  const Array1<BoundingBox3D> items = makeSampleBoxes(numSamples / 2);
+  octree.build(items, items, 6);
+
+  for (size_t i = 0; i < numSamples / 2; ++i) {
+    Ray3D ray(getSamplePoints3()[i + numSamples / 2], getSampleDirs3()[i + numSamples / 2]);
+    size_t numIntersections = 0;
+    for (const BoundingBox3D &item : items) {
+      numIntersections += intersectsFunc(item, ray);
+    }
+
+    EXPECT_EQ(numIntersections > 0, octree.intersects(ray, intersectsFunc));
+
+    size_t measured = 0;
+    octree.forEachIntersectingItem(ray, intersectsFunc, [&](const BoundingBox3D &) { ++measured; });
+    EXPECT_EQ(numIntersections, measured);
+  }
+}
+
+TEST(LinearOctree, ClosestIntersection) {
+  LinearOctree<BoundingBox3D> octree;
+
+  auto intersectsFunc = [](const BoundingBox3D &a, const Ray3D &ray) {
+    auto bboxResult = a.closestIntersection(ray);
+    if (bboxResult.isIntersecting) {
+      return bboxResult.tNear;
+    } else {
+      return kMaxD;
+    }
+  };
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  const Array1<BoundingBox3D> items = makeSampleBoxes(numSamples / 2);
+  octree.build(items, items, 6);
+
+  for (size_t i = 0; i < numSamples / 2; ++i) {
+    Ray3D ray(getSamplePoints3()[i + numSamples / 2], getSampleDirs3()[i + numSamples / 2]);
+    double ansDist = kMaxD;
+    for (const BoundingBox3D &item : items) {
+      ansDist = std::min(ansDist, intersectsFunc(item, ray));
+    }
+
+    auto octInts = octree.closestIntersection(ray, intersectsFunc);
+    EXPECT_DOUBLE_EQ(ansDist, octInts.distance);
+  }
+}
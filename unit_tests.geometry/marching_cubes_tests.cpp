@@ -3,11 +3,53 @@
 //
 
 #include "../vox.geometry/array.h"
+#include "../vox.geometry/grids/sparse_scalar_grid3.h"
 #include "../vox.geometry/marching_cubes.h"
 #include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <vector>
 using namespace vox;
 using namespace geometry;
 
+namespace {
+
+// Triangles as point coordinates, rotated to start with the smallest point and
+// sorted, to compare meshes regardless of their vertex and triangle order.
+std::vector<std::array<double, 9>> sortedTriangles(const TriangleMesh3 &mesh) {
+  std::vector<std::array<double, 9>> result;
+  for (size_t t = 0; t < mesh.numberOfTriangles(); ++t) {
+    const Vector3UZ &face = mesh.pointIndex(t);
+    auto key = [&](size_t c) {
+      const Vector3D &p = mesh.point(face[c]);
+      return std::make_tuple(p.x, p.y, p.z);
+    };
+
+    size_t first = 0;
+    for (size_t c = 1; c < 3; ++c) {
+      if (key(c) < key(first)) {
+        first = c;
+      }
+    }
+
+    std::array<double, 9> triangle{};
+    for (size_t c = 0; c < 3; ++c) {
+      const Vector3D &p = mesh.point(face[(first + c) % 3]);
+      triangle[3 * c] = p.x;
+      triangle[3 * c + 1] = p.y;
+      triangle[3 * c + 2] = p.z;
+    }
+    result.push_back(triangle);
+  }
+
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+} // namespace
+
 TEST(MarchingCubes, Connectivity) {
   TriangleMesh3 triMesh;
 
@@ -52,3 +94,93 @@ TEST(MarchingCubes, Connectivity) {
   marchingCubes(grid, Vector3D(1, 1, 1), Vector3D(), &triMesh, 0, kDirectionAll, kDirectionAll);
   EXPECT_EQ(8u, triMesh.numberOfPoints());
 }
+
+TEST(MarchingCubes, Parallel) {
+  // Sphere crossing the left, down and back boundaries, with enough layers
+  // for several slabs.
+  Array3<double> grid{23, 19, 37};
+  forEachIndex(grid.size(), [&](size_t i, size_t j, size_t k) {
+    const Vector3D x = 0.1 * Vector3D(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+    grid(i, j, k) = x.distanceTo(Vector3D(0.5, 0.4, 1.2)) - 1.3;
+  });
+
+  for (int bndClose : {kDirectionNone, kDirectionAll, kDirectionLeft | kDirectionFront}) {
+    for (int bndConnectivity : {kDirectionNone, kDirectionAll, kDirectionBack | kDirectionDown}) {
+      TriangleMesh3 expected;
+      marchingCubes(grid, Vector3D(0.1, 0.1, 0.1), Vector3D(), &expected, 0, bndClose, bndConnectivity);
+
+      TriangleMesh3 actual;
+      marchingCubesParallel(grid, Vector3D(0.1, 0.1, 0.1), Vector3D(), &actual, 0, bndClose, bndConnectivity);
+
+      ASSERT_EQ(expected.numberOfPoints(), actual.numberOfPoints());
+      ASSERT_EQ(expected.numberOfTriangles(), actual.numberOfTriangles());
+      EXPECT_LT(0u, actual.numberOfTriangles());
+
+      for (size_t i = 0; i < expected.numberOfPoints(); ++i) {
+        EXPECT_EQ(expected.point(i), actual.point(i));
+        EXPECT_EQ(expected.normal(i), actual.normal(i));
+      }
+      for (size_t i = 0; i < expected.numberOfTriangles(); ++i) {
+        EXPECT_EQ(expected.pointIndex(i), actual.pointIndex(i));
+      }
+    }
+  }
+}
+
+TEST(MarchingCubes, Sparse) {
+  // Narrow-band SDF of a sphere crossing the left, down and back boundaries
+  Array3<double> grid{23, 19, 37};
+  forEachIndex(grid.size(), [&](size_t i, size_t j, size_t k) {
+    const Vector3D x = 0.1 * Vector3D(static_cast<double>(i), static_cast<double>(j), static_cast<double>(k));
+    grid(i, j, k) = std::clamp(x.distanceTo(Vector3D(0.5, 0.4, 1.2)) - 1.3, -0.3, 0.3);
+  });
+
+  for (size_t brickSize : {1, 3, 8, 64}) {
+    for (int bndConnectivity : {kDirectionNone, kDirectionAll, kDirectionBack | kDirectionDown}) {
+      TriangleMesh3 expected;
+      marchingCubes(grid, Vector3D(0.1, 0.1, 0.1), Vector3D(), &expected, 0, kDirectionAll, bndConnectivity);
+
+      TriangleMesh3 actual;
+      marchingCubesSparse(grid, Vector3D(0.1, 0.1, 0.1), Vector3D(), &actual, 0, kDirectionAll, bndConnectivity,
+                          brickSize);
+
+      ASSERT_EQ(expected.numberOfPoints(), actual.numberOfPoints());
+      ASSERT_EQ(expected.numberOfTriangles(), actual.numberOfTriangles());
+      EXPECT_EQ(sortedTriangles(expected), sortedTriangles(actual));
+    }
+  }
+
+  TriangleMesh3 mesh;
+  EXPECT_THROW(marchingCubesSparse(grid, Vector3D(0.1, 0.1, 0.1), Vector3D(), &mesh, 0, kDirectionAll,
+                                   kDirectionNone, 0),
+               std::invalid_argument);
+}
+
+TEST(MarchingCubes, SparseGrid) {
+  // Narrow-band SDF of a sphere crossing the left, down and back boundaries
+  SparseScalarGrid3 sparse(Vector3UZ(23, 19, 37), Vector3D(0.1, 0.1, 0.1), Vector3D(-0.05, -0.05, -0.05));
+  sparse.fill([](const Vector3D &x) { return x.distanceTo(Vector3D(0.5, 0.4, 1.2)) - 1.3; }, 0.3);
+  EXPECT_LT(sparse.numberOfAllocatedDataPoints(), 23u * 19u * 37u);
+
+  Array3<double> grid{23, 19, 37};
+  forEachIndex(grid.size(), [&](size_t i, size_t j, size_t k) { grid(i, j, k) = sparse(i, j, k); });
+
+  TriangleMesh3 expected;
+  marchingCubes(grid, Vector3D(0.1, 0.1, 0.1), Vector3D(), &expected, 0, kDirectionNone);
+
+  TriangleMesh3 actual;
+  marchingCubes(sparse, &actual);
+
+  ASSERT_EQ(expected.numberOfPoints(), actual.numberOfPoints());
+  ASSERT_EQ(expected.numberOfTriangles(), actual.numberOfTriangles());
+  // The positions are computed from the leaf origins, so compare them rounded
+  auto roundedTriangles = [](const TriangleMesh3 &mesh) {
+    TriangleMesh3 rounded(mesh);
+    for (size_t p = 0; p < rounded.numberOfPoints(); ++p) {
+      Vector3D &x = rounded.point(p);
+      x = Vector3D(std::round(x.x * 1e9), std::round(x.y * 1e9), std::round(x.z * 1e9));
+    }
+    return sortedTriangles(rounded);
+  };
+  EXPECT_EQ(roundedTriangles(expected), roundedTriangles(actual));
+}
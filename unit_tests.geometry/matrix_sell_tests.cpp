@@ -0,0 +1,127 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/matrix_csr.h"
+#include "../vox.geometry/matrix_sell.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+MatrixCsrD makeRandomCsr(size_t rows, size_t cols) {
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<> d(-1.0, 1.0);
+  std::uniform_int_distribution<size_t> len(0, 9);
+  std::uniform_int_distribution<size_t> col(0, cols - 1);
+
+  MatrixCsrD mat;
+  for (size_t i = 0; i < rows; ++i) {
+    std::vector<double> nnz;
+    std::vector<size_t> ci;
+    const size_t n = len(rng);
+    for (size_t k = 0; k < n; ++k) {
+      size_t j = col(rng);
+      if (std::find(ci.begin(), ci.end(), j) == ci.end()) {
+        ci.push_back(j);
+        nnz.push_back(d(rng));
+      }
+    }
+    mat.addRow(nnz, ci);
+  }
+  return mat;
+}
+
+} // namespace
+
+TEST(MatrixSell, Constructors) {
+  const MatrixSellD emptyMat;
+  EXPECT_EQ(0u, emptyMat.rows());
+  EXPECT_EQ(0u, emptyMat.cols());
+  EXPECT_EQ(0u, emptyMat.numberOfChunks());
+  EXPECT_EQ(0u, emptyMat.numberOfNonZeros());
+  EXPECT_EQ(0u, emptyMat.numberOfStoredElements());
+
+  const MatrixCsrD csr = {{1.0, 0.0, 0.0, -3.0}, {0.0, 3.0, -5.0, 1.0}, {-4.0, 0.0, 1.0, 5.0}};
+  const MatrixSellD mat(csr, 2, 1);
+  EXPECT_EQ(3u, mat.rows());
+  EXPECT_EQ(4u, mat.cols());
+  EXPECT_EQ(2u, mat.chunkSize());
+  EXPECT_EQ(1u, mat.sortingScope());
+  EXPECT_EQ(2u, mat.numberOfChunks());
+  EXPECT_EQ(8u, mat.numberOfNonZeros());
+
+  // Chunk 0: rows of length 2 and 3 -> 2 * 3, chunk 1: one row of 3 -> 2 * 3
+  EXPECT_EQ(12u, mat.numberOfStoredElements());
+
+  EXPECT_THROW(MatrixSellD(csr, 0), std::invalid_argument);
+}
+
+TEST(MatrixSell, Mvm) {
+  const MatrixCsrD csr = {{1.0, 0.0, 0.0, -3.0}, {0.0, 3.0, -5.0, 1.0}, {-4.0, 0.0, 1.0, 5.0}};
+  const VectorND v = {1.0, 2.0, 3.0, 4.0};
+  const VectorND expected = csr * v;
+
+  for (size_t chunkSize : {1, 2, 3, 4, 8, 16}) {
+    const MatrixSellD mat(csr, chunkSize);
+
+    VectorND result(3, 0.0);
+    mat.mvm(v, &result);
+    EXPECT_TRUE(result.isSimilar(expected)) << "chunkSize = " << chunkSize;
+  }
+}
+
+TEST(MatrixSell, MvmRandom) {
+  const MatrixCsrD csr = makeRandomCsr(1000, 700);
+
+  VectorND v(700);
+  std::mt19937 rng(1);
+  std::uniform_real_distribution<> d(-1.0, 1.0);
+  for (size_t i = 0; i < v.rows(); ++i) {
+    v[i] = d(rng);
+  }
+
+  const VectorND expected = csr * v;
+
+  for (size_t chunkSize : {4, 5, 8, 16}) {
+    for (size_t sortingScope : {1, 32, 1000}) {
+      const MatrixSellD mat(csr, chunkSize, sortingScope);
+      EXPECT_EQ(csr.numberOfNonZeros(), mat.numberOfNonZeros());
+      EXPECT_LE(csr.numberOfNonZeros(), mat.numberOfStoredElements());
+
+      VectorND result(1000, 0.0);
+      mat.mvm(v, &result);
+      EXPECT_TRUE(result.isSimilar(expected, 1e-12));
+    }
+  }
+
+  // Sorting within the whole matrix should not pad more than natural order.
+  EXPECT_LE(MatrixSellD(csr, 8, 1000).numberOfStoredElements(), MatrixSellD(csr, 8, 1).numberOfStoredElements());
+}
+
+TEST(MatrixSell, Residual) {
+  const MatrixCsrD csr = makeRandomCsr(123, 123);
+
+  VectorND x(123);
+  VectorND b(123);
+  for (size_t i = 0; i < 123; ++i) {
+    x[i] = 0.5 * static_cast<double>(i);
+    b[i] = 1.0 - static_cast<double>(i);
+  }
+
+  const VectorND ax = csr * x;
+  const VectorND expected = b - ax;
+
+  const MatrixSellD mat(csr);
+  VectorND result(123, 0.0);
+  mat.residual(x, b, &result);
+  EXPECT_TRUE(result.isSimilar(expected, 1e-12));
+}
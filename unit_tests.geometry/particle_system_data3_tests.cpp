@@ -8,6 +8,8 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
 #include <vector>
 
 using namespace vox;
@@ -44,6 +46,33 @@ TEST(ParticleSystemData3, Constructors) {
   }
 }
 
+TEST(ParticleSystemData3, Set) {
+  ParticleSystemData3 source(5);
+  size_t s0 = source.addScalarData(2.0);
+  size_t v0 = source.addVectorData({1.0, -3.0, 5.0});
+
+  ParticleSystemData3 particleSystem(10);
+  particleSystem.addScalarData(7.0);
+  particleSystem.addScalarData(8.0);
+  particleSystem.addVectorData({4.0, 4.0, 4.0});
+  particleSystem.addVectorData({6.0, 6.0, 6.0});
+
+  // The data layers of the other system replace the existing ones
+  particleSystem.set(source);
+  EXPECT_EQ(5u, particleSystem.numberOfParticles());
+  EXPECT_EQ(source.numberOfScalarData(), particleSystem.numberOfScalarData());
+  EXPECT_EQ(source.numberOfVectorData(), particleSystem.numberOfVectorData());
+
+  auto as0 = particleSystem.scalarDataAt(s0);
+  auto av0 = particleSystem.vectorDataAt(v0);
+  ASSERT_EQ(5u, as0.length());
+  ASSERT_EQ(5u, av0.length());
+  for (size_t i = 0; i < 5; ++i) {
+    EXPECT_DOUBLE_EQ(2.0, as0[i]);
+    EXPECT_EQ(Vector3D(1.0, -3.0, 5.0), av0[i]);
+  }
+}
+
 TEST(ParticleSystemData3, Resize) {
   ParticleSystemData3 particleSystem;
   particleSystem.resize(12);
@@ -271,3 +300,59 @@ TEST(ParticleSystemData3, Serialization) {
     }
   }
 }
+
+TEST(ParticleSystemData3, SerializationToFile) {
+  ParticleSystemData3 particleSystem;
+
+  ParticleSystemData3::VectorData positions = {{0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6},
+                                               {0.6, 0.3, 0.8}, {0.1, 0.6, 0.0}, {0.5, 1.0, 0.2}, {0.6, 0.7, 0.8}};
+  particleSystem.addParticles(positions);
+
+  size_t a0 = particleSystem.addScalarData(2.0);
+  size_t a1 = particleSystem.addVectorData({1.0, -3.0, 5.0});
+  particleSystem.buildNeighborSearcher(0.4);
+  particleSystem.buildNeighborLists(0.4);
+
+  const std::string filename = ::testing::TempDir() + "particle_system_data3.bin";
+  serializeToFile(&particleSystem, filename);
+
+  {
+    // The arrays can be read in place
+    const MappedFile file(filename);
+    auto mappedPositions = ParticleSystemData3::mappedPositions(file.view());
+    ASSERT_EQ(positions.length(), mappedPositions.length());
+    for (size_t i = 0; i < positions.length(); ++i) {
+      EXPECT_EQ(positions[i], mappedPositions[i]);
+    }
+
+    auto mappedScalars = ParticleSystemData3::mappedScalarDataAt(file.view(), a0);
+    auto mappedVectors = ParticleSystemData3::mappedVectorDataAt(file.view(), a1);
+    ASSERT_EQ(positions.length(), mappedScalars.length());
+    ASSERT_EQ(positions.length(), mappedVectors.length());
+    for (size_t i = 0; i < positions.length(); ++i) {
+      EXPECT_EQ(2.0, mappedScalars[i]);
+      EXPECT_EQ(Vector3D(1.0, -3.0, 5.0), mappedVectors[i]);
+    }
+  }
+
+  ParticleSystemData3 particleSystem2;
+  deserializeFromFile(filename, &particleSystem2);
+  std::remove(filename.c_str());
+
+  EXPECT_EQ(positions.length(), particleSystem2.numberOfParticles());
+  for (size_t i = 0; i < positions.length(); ++i) {
+    EXPECT_EQ(positions[i], particleSystem2.positions()[i]);
+    EXPECT_EQ(2.0, particleSystem2.scalarDataAt(a0)[i]);
+    EXPECT_EQ(Vector3D(1.0, -3.0, 5.0), particleSystem2.vectorDataAt(a1)[i]);
+  }
+
+  const auto &neighborLists = particleSystem.neighborLists();
+  const auto &neighborLists2 = particleSystem2.neighborLists();
+  ASSERT_EQ(neighborLists.length(), neighborLists2.length());
+  for (size_t i = 0; i < neighborLists.length(); ++i) {
+    ASSERT_EQ(neighborLists[i].length(), neighborLists2[i].length());
+    for (size_t j = 0; j < neighborLists[i].length(); ++j) {
+      EXPECT_EQ(neighborLists[i][j], neighborLists2[i][j]);
+    }
+  }
+}
@@ -30,3 +30,37 @@ TEST(PciSphSolver3, Parameters) {
   solver.setMaxNumberOfIterations(10);
   EXPECT_DOUBLE_EQ(10, solver.maxNumberOfIterations());
 }
+
+TEST(PciSphSolver3, Checkpoint) {
+  PciSphSolver3 solver;
+  solver.setMaxDensityErrorRatio(0.02);
+  solver.setMaxNumberOfIterations(3);
+
+  auto particles = solver.sphSystemData();
+  Array1<Vector3D> positions = {{0.0, 0.0, 0.0}, {0.05, 0.0, 0.0}, {0.0, 0.05, 0.0}};
+  particles->addParticles(positions);
+  particles->addScalarData(1.0);
+
+  solver.update(Frame(0, 0.01));
+  SolverCheckpoint checkpoint;
+  solver.saveCheckpoint(&checkpoint);
+
+  PciSphSolver3 restarted;
+  restarted.loadCheckpoint(checkpoint);
+  EXPECT_DOUBLE_EQ(0.02, restarted.maxDensityErrorRatio());
+  EXPECT_EQ(3u, restarted.maxNumberOfIterations());
+
+  // The custom data layer is added back
+  auto restartedParticles = restarted.sphSystemData();
+  EXPECT_EQ(particles->numberOfScalarData(), restartedParticles->numberOfScalarData());
+  EXPECT_EQ(particles->mass(), restartedParticles->mass());
+  EXPECT_EQ(particles->kernelRadius(), restartedParticles->kernelRadius());
+
+  solver.update(Frame(1, 0.01));
+  restarted.update(Frame(1, 0.01));
+  ASSERT_EQ(3u, restartedParticles->numberOfParticles());
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(particles->positions()[i], restartedParticles->positions()[i]);
+    EXPECT_EQ(particles->pressures()[i], restartedParticles->pressures()[i]);
+  }
+}
@@ -4,10 +4,14 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "../vox.geometry/array.h"
 #include "../vox.geometry/physics_animation.h"
 
 #include <gtest/gtest.h>
 
+#include <mutex>
+#include <vector>
+
 using namespace vox;
 using namespace geometry;
 
@@ -17,6 +21,19 @@ protected:
   void onAdvanceTimeStep(double timeIntervalInSeconds) override { (void)timeIntervalInSeconds; }
 };
 
+class CountingPhysicsAnimation : public PhysicsAnimation {
+public:
+  Array1<double> state = Array1<double>(1000, 0.0);
+
+protected:
+  void onAdvanceTimeStep(double timeIntervalInSeconds) override {
+    (void)timeIntervalInSeconds;
+    for (double &value : state) {
+      value += 1.0;
+    }
+  }
+};
+
 TEST(PhysicsAnimation, Constructors) {
   CustomPhysicsAnimation pa;
   EXPECT_EQ(-1, pa.currentFrame().index);
@@ -55,3 +72,44 @@ TEST(PhysicsAnimation, Updates) {
 
   EXPECT_DOUBLE_EQ(pa2.currentFrame().timeIntervalInSeconds * 15.0, pa2.currentTimeInSeconds());
 }
+
+TEST(PhysicsAnimation, FrameWriter) {
+  CountingPhysicsAnimation pa;
+  pa.setNumberOfFixedSubTimeSteps(2);
+  EXPECT_EQ(nullptr, pa.frameWriter());
+
+  auto writer = std::make_shared<AsyncFrameWriter>(2);
+  SnapshotPool<Array1<double>> snapshots;
+  std::mutex mutex;
+  std::vector<int> frames;
+  std::vector<double> values;
+  pa.setFrameWriter(writer, [&](const Frame &frame) -> AsyncFrameWriter::Job {
+    auto snapshot = snapshots.acquire(pa.state);
+    return [&, snapshot, frame]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      frames.push_back(frame.index);
+      values.push_back((*snapshot)[999]);
+    };
+  });
+  EXPECT_EQ(writer, pa.frameWriter());
+
+  for (int i = 0; i < 10; ++i) {
+    pa.advanceSingleFrame();
+  }
+  // Advances frames 10 to 12 at once
+  pa.update(Frame(12, 1.0 / 60.0));
+  writer->flush();
+
+  // The snapshots are reused instead of allocating one per frame
+  EXPECT_GE(2u, snapshots.numberOfAvailableSnapshots());
+
+  ASSERT_EQ(13u, frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(i), frames[i]);
+    EXPECT_EQ(2.0 * static_cast<double>(i + 1), values[i]);
+  }
+
+  pa.setFrameWriter(nullptr, nullptr);
+  pa.advanceSingleFrame();
+  EXPECT_EQ(13u, frames.size());
+}
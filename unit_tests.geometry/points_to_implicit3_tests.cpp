@@ -0,0 +1,140 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "unit_tests_utils.h"
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/grids/vertex_centered_scalar_grid.h"
+#include "../vox.geometry/points_to_implicits/anisotropic_points_to_implicit3.h"
+#include "../vox.geometry/points_to_implicits/point_splatting.h"
+#include "../vox.geometry/points_to_implicits/sph_points_to_implicit3.h"
+#include "../vox.geometry/points_to_implicits/zhu_bridson_points_to_implicit3.h"
+
+#include <random>
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+// Jittered lattice inside a sphere, which is partially outside of the grids
+Array1<Vector3D> makeSampleBlob() {
+  std::mt19937 rng{0};
+  std::uniform_real_distribution<> d(-0.01, 0.01);
+
+  Array1<Vector3D> points;
+  const Vector3D center{0.45, 0.5, 0.55};
+  for (int k = -8; k <= 8; ++k) {
+    for (int j = -8; j <= 8; ++j) {
+      for (int i = -8; i <= 8; ++i) {
+        const Vector3D x = center + 0.05 * Vector3D(i, j, k) + Vector3D(d(rng), d(rng), d(rng));
+        if (x.distanceTo(center) < 0.42) {
+          points.append(x);
+        }
+      }
+    }
+  }
+  return points;
+}
+
+void expectSameData(const ScalarGrid3 &expected, const ScalarGrid3 &actual) {
+  ASSERT_EQ(expected.dataSize(), actual.dataSize());
+  expected.forEachDataPointIndex(
+      [&](const Vector3UZ &idx) { EXPECT_NEAR(expected(idx), actual(idx), 1e-9) << idx.x << idx.y << idx.z; });
+}
+
+} // namespace
+
+TEST(PointSplatting, SplatPoints) {
+  Array1<Vector3D> points{{0.1, 0.1, 0.1}, {1.5, 0.2, 0.3}, {0.9, 0.5, 0.4}, {-1.0, -1.0, -1.0}};
+  const double radius = 0.35;
+  const Vector3D support = Vector3D::makeConstant(radius);
+
+  Array3<double> counts(Vector3UZ(20, 13, 11));
+  const Vector3D origin{0.05, 0.05, 0.05};
+  const Vector3D spacing = Vector3D::makeConstant(0.1);
+  splatPoints(
+      points.length(), origin, spacing,
+      [&](size_t i) { return BoundingBox3D(points[i] - support, points[i] + support); },
+      [&](size_t i, const Vector3D &x, double &count) {
+        if (x.distanceTo(points[i]) <= radius) {
+          count += 1.0;
+        }
+      },
+      counts.view());
+
+  forEachIndex(counts.size(), [&](size_t i, size_t j, size_t k) {
+    const Vector3D x = origin + 0.1 * Vector3D(i, j, k);
+    double expected = 0.0;
+    for (const auto &pt : points) {
+      if (x.distanceTo(pt) <= radius) {
+        expected += 1.0;
+      }
+    }
+    EXPECT_EQ(expected, counts(i, j, k));
+  });
+}
+
+TEST(SphPointsToImplicit3, Scatter) {
+  const Array1<Vector3D> points = makeSampleBlob();
+
+  SphPointsToImplicit3 gather(0.1, 0.5, false);
+  SphPointsToImplicit3 scatter(0.1, 0.5, false, true);
+  EXPECT_FALSE(gather.useScatter());
+  EXPECT_TRUE(scatter.useScatter());
+
+  CellCenteredScalarGrid3 expected({20, 20, 20}, {0.05, 0.05, 0.05});
+  CellCenteredScalarGrid3 actual({20, 20, 20}, {0.05, 0.05, 0.05});
+  gather.convert(points, &expected);
+  scatter.convert(points, &actual);
+
+  expectSameData(expected, actual);
+  EXPECT_GT(0.0, actual(10, 10, 10));
+  EXPECT_LT(0.0, actual(0, 0, 0));
+}
+
+TEST(ZhuBridsonPointsToImplicit3, Scatter) {
+  const Array1<Vector3D> points = makeSampleBlob();
+
+  ZhuBridsonPointsToImplicit3 gather(0.1, 0.25, false);
+  ZhuBridsonPointsToImplicit3 scatter(0.1, 0.25, false, true);
+  EXPECT_TRUE(scatter.useScatter());
+
+  VertexCenteredScalarGrid3 expected({21, 19, 20}, {0.05, 0.05, 0.05}, {-0.02, 0.01, 0.0});
+  VertexCenteredScalarGrid3 actual({21, 19, 20}, {0.05, 0.05, 0.05}, {-0.02, 0.01, 0.0});
+  gather.convert(points, &expected);
+  scatter.convert(points, &actual);
+
+  expectSameData(expected, actual);
+  EXPECT_GT(0.0, actual(10, 10, 10));
+  EXPECT_LT(0.0, actual(0, 0, 0));
+}
+
+TEST(AnisotropicPointsToImplicit3, Scatter) {
+  const Array1<Vector3D> points = makeSampleBlob();
+
+  AnisotropicPointsToImplicit3 gather(0.1, 0.5, 0.5, 25, false);
+  AnisotropicPointsToImplicit3 scatter(0.1, 0.5, 0.5, 25, false, true);
+  EXPECT_FALSE(gather.useScatter());
+  EXPECT_TRUE(scatter.useScatter());
+
+  CellCenteredScalarGrid3 expected({20, 20, 20}, {0.05, 0.05, 0.05});
+  CellCenteredScalarGrid3 actual({20, 20, 20}, {0.05, 0.05, 0.05});
+  gather.convert(points, &expected);
+  scatter.convert(points, &actual);
+
+  expectSameData(expected, actual);
+  EXPECT_GT(0.0, actual(10, 10, 10));
+  EXPECT_LT(0.0, actual(0, 0, 0));
+
+  // The reinitialized outputs should agree as well
+  AnisotropicPointsToImplicit3 gatherSdf(0.1, 0.5, 0.5, 25, true);
+  AnisotropicPointsToImplicit3 scatterSdf(0.1, 0.5, 0.5, 25, true, true);
+  gatherSdf.convert(points, &expected);
+  scatterSdf.convert(points, &actual);
+
+  expectSameData(expected, actual);
+}
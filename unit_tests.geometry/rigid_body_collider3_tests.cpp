@@ -7,6 +7,7 @@
 #include "../vox.geometry/colliders/rigid_body_collider.h"
 #include "../vox.geometry/implicit_surfaces/implicit_surface_set.h"
 #include "../vox.geometry/surfaces/plane.h"
+#include "../vox.geometry/surfaces/triangle_mesh3.h"
 
 #include <gtest/gtest.h>
 
@@ -140,3 +141,22 @@ TEST(RigidBodyCollider3, Empty) {
   EXPECT_DOUBLE_EQ(0.0, newVelocity.y);
   EXPECT_DOUBLE_EQ(0.0, newVelocity.z);
 }
+
+TEST(RigidBodyCollider3, RefitSurface) {
+  // A single triangle in the xz-plane
+  auto mesh = TriangleMesh3::builder()
+                  .withPoints({{-1, 0, -1}, {1, 0, -1}, {0, 0, 1}})
+                  .withPointIndices({{0, 1, 2}})
+                  .makeShared();
+  RigidBodyCollider3 collider(mesh);
+  collider.update(0.0, 0.01);
+  EXPECT_DOUBLE_EQ(1.0, collider.surface()->closestDistance({0, 1, 0}));
+
+  // Raise it in place, as an animated mesh would
+  for (size_t i = 0; i < mesh->numberOfPoints(); ++i) {
+    mesh->point(i).y += 0.5;
+  }
+  collider.refitSurface();
+  EXPECT_DOUBLE_EQ(0.5, collider.surface()->closestDistance({0, 1, 0}));
+  EXPECT_DOUBLE_EQ(0.5, collider.surface()->boundingBox().lowerCorner.y);
+}
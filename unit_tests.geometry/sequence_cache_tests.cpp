@@ -0,0 +1,172 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/grids/vertex_centered_scalar_grid.h"
+#include "../vox.geometry/sequence_cache.h"
+#include "../vox.geometry/sph_system_data.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+// Particles orbiting around the center of the unit box
+void makeFrame(size_t frame, ParticleSystemData3 *particles) {
+  std::mt19937 rng{0};
+  std::uniform_real_distribution<> d(0.0, 1.0);
+
+  auto positions = particles->positions();
+  auto velocities = particles->velocities();
+  auto temperatures = particles->scalarDataAt(0);
+  for (size_t i = 0; i < particles->numberOfParticles(); ++i) {
+    const double r = 0.1 + 0.3 * d(rng);
+    const double theta = 6.0 * d(rng) + 0.01 * static_cast<double>(frame);
+    const double z = d(rng);
+    positions[i] = {0.5 + r * std::cos(theta), 0.5 + r * std::sin(theta), z};
+    velocities[i] = {-0.01 * r * std::sin(theta), 0.01 * r * std::cos(theta), 0.0};
+    temperatures[i] = 300.0 + static_cast<double>(frame);
+  }
+}
+
+} // namespace
+
+TEST(SequenceCache, EncodeWords) {
+  std::mt19937_64 rng{0};
+  Array1<uint64_t> words(internal::kSequenceCacheChunkSize * 2 + 123);
+  for (size_t i = 0; i < words.length(); ++i) {
+    // Mix of small values, zero runs and full 64-bit values
+    words[i] = (i % 7 == 0) ? rng() : (i % 3 == 0) ? 0 : rng() % 1000;
+  }
+
+  std::vector<uint8_t> buffer{42};
+  internal::encodeSequenceCacheWords(words, &buffer);
+  EXPECT_LT(buffer.size(), sizeof(uint64_t) * words.length() * 3 / 4);
+
+  Array1<uint64_t> decoded;
+  const size_t size =
+      internal::decodeSequenceCacheWords(ConstArrayView1<uint8_t>(buffer.data() + 1, buffer.size() - 1), &decoded);
+  EXPECT_EQ(buffer.size() - 1, size);
+  ASSERT_EQ(words.length(), decoded.length());
+  for (size_t i = 0; i < words.length(); ++i) {
+    EXPECT_EQ(words[i], decoded[i]);
+  }
+
+  // Truncated data
+  EXPECT_THROW(internal::decodeSequenceCacheWords(ConstArrayView1<uint8_t>(buffer.data() + 1, size / 2), &decoded),
+               std::invalid_argument);
+}
+
+TEST(SequenceCache, Particles) {
+  const std::string filename = ::testing::TempDir() + "sequence_cache_particles.bin";
+  const size_t numberOfFrames = 10;
+
+  SphSystemData3 particles(1000);
+  particles.addScalarData(0.0);
+  particles.setTargetSpacing(0.05);
+
+  {
+    SequenceCacheWriter writer(filename, 20, 4);
+    for (size_t frame = 0; frame < numberOfFrames; ++frame) {
+      makeFrame(frame, &particles);
+      writer.append(particles);
+    }
+    EXPECT_EQ(numberOfFrames, writer.numberOfFrames());
+    writer.finish();
+
+    // Much smaller than the raw doubles of positions, velocities, forces and temperatures
+    EXPECT_LT(writer.bytesWritten(), numberOfFrames * particles.numberOfParticles() * sizeof(double) * 10 / 3);
+  }
+
+  SequenceCacheReader reader(filename);
+  ASSERT_EQ(numberOfFrames, reader.numberOfFrames());
+  for (size_t frame = 0; frame < numberOfFrames; ++frame) {
+    EXPECT_EQ(SequenceCacheFrameType::kParticles, reader.frameType(frame));
+    EXPECT_EQ(frame % 4 == 0, reader.isKeyframe(frame));
+  }
+
+  // Random access, including going backward within a keyframe interval. The
+  // positions are within half the quantization step of the unit extent.
+  const double tolerance = 0.5 / ((1 << 20) - 1) + 1e-15;
+  for (size_t frame : {6, 2, 3, 9, 5, 5, 0}) {
+    ParticleSystemData3 loaded;
+    reader.load(frame, &loaded);
+    makeFrame(frame, &particles);
+
+    ASSERT_EQ(particles.numberOfParticles(), loaded.numberOfParticles());
+    ASSERT_EQ(particles.numberOfScalarData(), loaded.numberOfScalarData());
+    ASSERT_EQ(particles.numberOfVectorData(), loaded.numberOfVectorData());
+    EXPECT_EQ(particles.radius(), loaded.radius());
+    EXPECT_EQ(particles.mass(), loaded.mass());
+    for (size_t i = 0; i < particles.numberOfParticles(); ++i) {
+      EXPECT_NEAR(particles.positions()[i].x, loaded.positions()[i].x, tolerance);
+      EXPECT_NEAR(particles.positions()[i].y, loaded.positions()[i].y, tolerance);
+      EXPECT_NEAR(particles.positions()[i].z, loaded.positions()[i].z, tolerance);
+      EXPECT_EQ(particles.velocities()[i], loaded.velocities()[i]);
+      EXPECT_EQ(particles.scalarDataAt(0)[i], loaded.scalarDataAt(0)[i]);
+    }
+  }
+
+  ScalarGrid3Ptr grid = std::make_shared<CellCenteredScalarGrid3>();
+  EXPECT_THROW(reader.load(0, grid.get()), std::invalid_argument);
+
+  std::remove(filename.c_str());
+}
+
+TEST(SequenceCache, MixedFrames) {
+  const std::string filename = ::testing::TempDir() + "sequence_cache_mixed.bin";
+
+  CellCenteredScalarGrid3 grid({8, 6, 4}, {0.1, 0.1, 0.1});
+  VertexCenteredScalarGrid3 vertexGrid({3, 3, 3}, {0.5, 0.5, 0.5}, {1.0, 2.0, 3.0});
+  ParticleSystemData3 particles;
+  particles.addParticles(Array1<Vector3D>{{0.0, 0.0, 0.0}, {1.0, 2.0, 3.0}});
+
+  {
+    SequenceCacheWriter writer(filename);
+    for (size_t frame = 0; frame < 3; ++frame) {
+      grid.fill([&](const Vector3D &x) { return x.length() + static_cast<double>(frame); });
+      writer.append(grid);
+    }
+    writer.append(particles);
+    writer.append(vertexGrid);
+  }
+
+  SequenceCacheReader reader(filename);
+  ASSERT_EQ(5u, reader.numberOfFrames());
+  EXPECT_TRUE(reader.isKeyframe(0));
+  EXPECT_FALSE(reader.isKeyframe(2));
+  EXPECT_TRUE(reader.isKeyframe(3));
+  EXPECT_TRUE(reader.isKeyframe(4));
+  EXPECT_EQ(SequenceCacheFrameType::kScalarGrid, reader.frameType(2));
+  EXPECT_EQ(SequenceCacheFrameType::kParticles, reader.frameType(3));
+
+  CellCenteredScalarGrid3 loaded;
+  reader.load(2, &loaded);
+  EXPECT_EQ(grid.resolution(), loaded.resolution());
+  grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) { EXPECT_EQ(grid(i, j, k), loaded(i, j, k)); });
+
+  ParticleSystemData3 loadedParticles;
+  reader.load(3, &loadedParticles);
+  ASSERT_EQ(2u, loadedParticles.numberOfParticles());
+  EXPECT_EQ(Vector3D(1.0, 2.0, 3.0), loadedParticles.positions()[1]);
+
+  VertexCenteredScalarGrid3 loadedVertexGrid;
+  reader.load(4, &loadedVertexGrid);
+  EXPECT_EQ(vertexGrid.dataSize(), loadedVertexGrid.dataSize());
+  EXPECT_EQ(vertexGrid.origin(), loadedVertexGrid.origin());
+  EXPECT_THROW(reader.load(4, &loaded), std::invalid_argument);
+
+  std::remove(filename.c_str());
+  EXPECT_THROW(SequenceCacheReader{filename}, std::system_error);
+}
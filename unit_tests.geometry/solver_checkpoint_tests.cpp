@@ -0,0 +1,121 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/array.h"
+#include "../vox.geometry/solver_checkpoint.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+using namespace vox;
+using namespace geometry;
+
+TEST(SolverCheckpoint, Channels) {
+  SolverCheckpoint checkpoint;
+  EXPECT_EQ(0u, checkpoint.numberOfChannels());
+  EXPECT_FALSE(checkpoint.isIncremental());
+
+  Array1<Vector3D> positions = {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}};
+  checkpoint.setValue("time", 1.5);
+  checkpoint.setValues<Vector3D>("positions", positions);
+  checkpoint.setText("rng", "5489 1 2 3");
+
+  EXPECT_EQ(3u, checkpoint.numberOfChannels());
+  EXPECT_EQ(3u, checkpoint.numberOfStoredChannels());
+  EXPECT_TRUE(checkpoint.hasChannel("time"));
+  EXPECT_FALSE(checkpoint.hasChannel("mass"));
+
+  EXPECT_EQ(1.5, checkpoint.value<double>("time"));
+  EXPECT_EQ("5489 1 2 3", checkpoint.text("rng"));
+
+  auto restoredPositions = checkpoint.values<Vector3D>("positions");
+  ASSERT_EQ(2u, restoredPositions.length());
+  EXPECT_EQ(positions[1], restoredPositions[1]);
+
+  EXPECT_THROW(static_cast<void>(checkpoint.value<double>("mass")), std::invalid_argument);
+  EXPECT_THROW(static_cast<void>(checkpoint.value<float>("time")), std::invalid_argument);
+}
+
+TEST(SolverCheckpoint, Incremental) {
+  SolverCheckpoint base;
+  base.setFrameIndex(10);
+  base.setValue("gravity", Vector3D(0.0, -9.8, 0.0));
+  base.setValue("time", 1.0);
+
+  SolverCheckpoint checkpoint;
+  checkpoint.setFrameIndex(20);
+  checkpoint.setValue("gravity", Vector3D(0.0, -9.8, 0.0));
+  checkpoint.setValue("time", 2.0);
+  checkpoint.setValue("count", 3);
+  checkpoint.removeUnchanged(base);
+
+  EXPECT_TRUE(checkpoint.isIncremental());
+  EXPECT_EQ(10, checkpoint.baseFrameIndex());
+  EXPECT_EQ(3u, checkpoint.numberOfChannels());
+  EXPECT_EQ(2u, checkpoint.numberOfStoredChannels());
+  EXPECT_TRUE(checkpoint.hasChannel("gravity"));
+  EXPECT_THROW(static_cast<void>(checkpoint.value<Vector3D>("gravity")), std::invalid_argument);
+
+  // The base has to be the checkpoint it was compared with
+  SolverCheckpoint otherBase = base;
+  otherBase.setFrameIndex(11);
+  SolverCheckpoint resolved = checkpoint;
+  EXPECT_THROW(resolved.resolve(otherBase), std::invalid_argument);
+
+  resolved.resolve(base);
+  EXPECT_FALSE(resolved.isIncremental());
+  EXPECT_EQ(3u, resolved.numberOfStoredChannels());
+  EXPECT_EQ(Vector3D(0.0, -9.8, 0.0), resolved.value<Vector3D>("gravity"));
+  EXPECT_EQ(2.0, resolved.value<double>("time"));
+  EXPECT_EQ(3, resolved.value<int>("count"));
+}
+
+TEST(SolverCheckpoint, Serialization) {
+  SolverCheckpoint base;
+  base.setFrameIndex(3);
+  base.setValue("time", 1.0);
+  base.setValue("mass", 0.5);
+  base.setChannel("empty", {});
+
+  SolverCheckpoint checkpoint;
+  checkpoint.setFrameIndex(7);
+  checkpoint.setValue("time", 2.0);
+  checkpoint.setValue("mass", 0.5);
+  checkpoint.setChannel("empty", {});
+  checkpoint.removeUnchanged(base);
+
+  std::vector<uint8_t> buffer;
+  checkpoint.serialize(&buffer);
+
+  SolverCheckpoint deserialized;
+  deserialized.deserialize(buffer);
+  EXPECT_EQ(7, deserialized.frameIndex());
+  EXPECT_TRUE(deserialized.isIncremental());
+  EXPECT_EQ(3, deserialized.baseFrameIndex());
+  EXPECT_EQ(3u, deserialized.numberOfChannels());
+  EXPECT_EQ(1u, deserialized.numberOfStoredChannels());
+  EXPECT_EQ(2.0, deserialized.value<double>("time"));
+
+  // Written channel by channel
+  const std::string filename = ::testing::TempDir() + "solver_checkpoint_test.bin";
+  serializeToFile(&base, filename);
+  SolverCheckpoint deserializedBase;
+  deserializeFromFile(filename, &deserializedBase);
+  std::remove(filename.c_str());
+
+  deserialized.resolve(deserializedBase);
+  EXPECT_EQ(0.5, deserialized.value<double>("mass"));
+  EXPECT_TRUE(deserialized.channel("empty").empty());
+
+  buffer[0] = 'X';
+  EXPECT_THROW(deserialized.deserialize(buffer), std::invalid_argument);
+  buffer.resize(buffer.size() - 1);
+  buffer[0] = 'V';
+  EXPECT_THROW(deserialized.deserialize(buffer), std::invalid_argument);
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/grids/cell_centered_scalar_grid.h"
+#include "../vox.geometry/grids/sparse_scalar_grid3.h"
+#include <gtest/gtest.h>
+
+using namespace vox;
+using namespace geometry;
+
+TEST(SparseScalarGrid3, Constructors) {
+  SparseScalarGrid3 grid1;
+  EXPECT_EQ(0u, grid1.resolution().x);
+  EXPECT_EQ(0u, grid1.numberOfLeaves());
+
+  SparseScalarGrid3 grid2({5, 4, 300}, {1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, 7.0);
+  EXPECT_EQ(Vector3UZ(5, 4, 300), grid2.dataSize());
+  EXPECT_DOUBLE_EQ(4.5, grid2.dataOrigin().x);
+  EXPECT_DOUBLE_EQ(6.0, grid2.dataOrigin().y);
+  EXPECT_DOUBLE_EQ(7.5, grid2.dataOrigin().z);
+  EXPECT_DOUBLE_EQ(7.0, grid2(4, 3, 299));
+  EXPECT_EQ(0u, grid2.numberOfLeaves());
+
+  grid2.setValue({1, 2, 200}, 3.0);
+  EXPECT_EQ(1u, grid2.numberOfLeaves());
+  EXPECT_EQ(5u * 4u * 8u, grid2.numberOfAllocatedDataPoints());
+  EXPECT_TRUE(grid2.isAllocated({0, 0, 207}));
+  EXPECT_FALSE(grid2.isAllocated({0, 0, 199}));
+  EXPECT_DOUBLE_EQ(3.0, grid2(1, 2, 200));
+  EXPECT_DOUBLE_EQ(7.0, grid2(1, 2, 201));
+
+  SparseScalarGrid3 grid3(grid2);
+  grid2.setValue({1, 2, 200}, 4.0);
+  EXPECT_EQ(1u, grid3.numberOfLeaves());
+  EXPECT_DOUBLE_EQ(3.0, grid3(1, 2, 200));
+
+  size_t count = 0;
+  grid3.forEachDataPointIndex([&](size_t, size_t, size_t k) {
+    EXPECT_LE(200u, k);
+    EXPECT_GT(208u, k);
+    ++count;
+  });
+  EXPECT_EQ(grid3.numberOfAllocatedDataPoints(), count);
+
+  grid3.fill(1.0);
+  EXPECT_EQ(0u, grid3.numberOfLeaves());
+  EXPECT_DOUBLE_EQ(1.0, grid3(1, 2, 200));
+}
+
+TEST(SparseScalarGrid3, FillNarrowBand) {
+  const Vector3D center(1.1, 0.9, 1.0);
+  auto sphere = [&](const Vector3D &x) { return x.distanceTo(center) - 0.7; };
+
+  const Vector3UZ resolution(150, 100, 110);
+  const Vector3D gridSpacing(0.015, 0.02, 0.02);
+  SparseScalarGrid3 sparse(resolution, gridSpacing);
+  sparse.fill(sphere, 0.1);
+  EXPECT_DOUBLE_EQ(0.1, sparse.background());
+  EXPECT_LT(sparse.numberOfAllocatedDataPoints(), resolution.x * resolution.y * resolution.z / 2);
+
+  CellCenteredScalarGrid3 dense(resolution, gridSpacing);
+  dense.fill(sphere);
+
+  dense.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+    const double expected = dense(i, j, k);
+    if (std::fabs(expected) <= 0.1) {
+      EXPECT_TRUE(sparse.isAllocated({i, j, k}));
+      EXPECT_DOUBLE_EQ(expected, sparse(i, j, k));
+    } else if (!sparse.isAllocated({i, j, k})) {
+      EXPECT_DOUBLE_EQ(expected < 0.0 ? -0.1 : 0.1, sparse(i, j, k));
+    } else {
+      EXPECT_DOUBLE_EQ(expected, sparse(i, j, k));
+    }
+  });
+
+  // Within the band, the sampling and the derivatives match the dense grid
+  const Vector3D samples[] = {{1.8, 0.9, 1.0}, {1.1, 0.21, 1.0}, {1.1, 0.9, 1.695}, {0.7, 0.6, 0.6}};
+  for (const Vector3D &x : samples) {
+    EXPECT_NEAR(dense.sample(x), sparse.sample(x), 1e-12);
+    EXPECT_NEAR(dense.gradient(x).x, sparse.gradient(x).x, 1e-9);
+    EXPECT_NEAR(dense.gradient(x).y, sparse.gradient(x).y, 1e-9);
+    EXPECT_NEAR(dense.gradient(x).z, sparse.gradient(x).z, 1e-9);
+    EXPECT_NEAR(dense.laplacian(x), sparse.laplacian(x), 1e-6);
+  }
+
+  // Out of the band, the samples are clamped
+  EXPECT_DOUBLE_EQ(-0.1, sparse.sample(center));
+  EXPECT_DOUBLE_EQ(0.1, sparse.sample({0.1, 0.1, 0.1}));
+}
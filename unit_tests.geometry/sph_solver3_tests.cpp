@@ -4,12 +4,53 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "../vox.geometry/colliders/rigid_body_collider.h"
+#include "../vox.geometry/particle_emitter/point_particle_emitter3.h"
 #include "../vox.geometry/particle_system_solvers/sph_solver3.h"
+#include "../vox.geometry/surfaces/box.h"
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
 using namespace vox;
 using namespace geometry;
 
+namespace {
+
+// Sets up the same scene for the original and the restarted simulation
+void setUpCheckpointScene(SphSolver3 *solver) {
+  solver->setPseudoViscosityCoefficient(0.0);
+
+  auto emitter = PointParticleEmitter3::builder()
+                     .withOrigin({0.0, 0.5, 0.0})
+                     .withDirection({0.0, -1.0, 0.0})
+                     .withSpeed(1.0)
+                     .withSpreadAngleInDegrees(45.0)
+                     .withMaxNumberOfNewParticlesPerSecond(2000)
+                     .withRandomSeed(7)
+                     .makeShared();
+  solver->setEmitter(emitter);
+
+  // The box moves up by integrating its velocity, so its transform is part of the state
+  auto box = Box3::builder()
+                 .withLowerCorner({-1.0, -1.0, -1.0})
+                 .withUpperCorner({1.0, 1.0, 1.0})
+                 .withIsNormalFlipped(true)
+                 .makeShared();
+  auto collider = std::make_shared<RigidBodyCollider3>(box);
+  collider->linearVelocity = Vector3D(0.0, 0.1, 0.0);
+  collider->setOnBeginUpdateCallback([](Collider3 *self, double, double timeIntervalInSeconds) {
+    auto rigidBody = static_cast<RigidBodyCollider3 *>(self);
+    self->surface()->transform.setTranslation(self->surface()->transform.translation() +
+                                              timeIntervalInSeconds * rigidBody->linearVelocity);
+  });
+  solver->setCollider(collider);
+}
+
+} // namespace
+
 TEST(SphSolver3, UpdateEmpty) {
   // Empty solver test
   SphSolver3 solver;
@@ -62,3 +103,77 @@ TEST(SphSolver3, Parameters) {
 
   EXPECT_TRUE(solver.sphSystemData() != nullptr);
 }
+
+TEST(SphSolver3, Checkpoint) {
+  SphSolver3 solver;
+  setUpCheckpointScene(&solver);
+
+  for (int i = 0; i < 3; ++i) {
+    solver.update(Frame(i, 0.01));
+  }
+  SolverCheckpoint checkpoint;
+  solver.saveCheckpoint(&checkpoint);
+  EXPECT_EQ(2, checkpoint.frameIndex());
+  EXPECT_FALSE(checkpoint.isIncremental());
+
+  for (int i = 3; i < 5; ++i) {
+    solver.update(Frame(i, 0.01));
+  }
+  SolverCheckpoint incremental;
+  solver.saveCheckpoint(&incremental, &checkpoint);
+  EXPECT_TRUE(incremental.isIncremental());
+  EXPECT_EQ(2, incremental.baseFrameIndex());
+  EXPECT_LT(incremental.numberOfStoredChannels(), incremental.numberOfChannels());
+  EXPECT_THROW(static_cast<void>(incremental.value<double>("solver.eosExponent")), std::invalid_argument);
+
+  const Array1<Array1<size_t>> neighborLists = solver.sphSystemData()->neighborLists();
+
+  // Restarts from the files as after a crash
+  const std::string filename = ::testing::TempDir() + "sph_solver3_checkpoint_test.bin";
+  const std::string incrementalFilename = ::testing::TempDir() + "sph_solver3_incremental_checkpoint_test.bin";
+  serializeToFile(&checkpoint, filename);
+  serializeToFile(&incremental, incrementalFilename);
+
+  SolverCheckpoint loadedCheckpoint;
+  SolverCheckpoint loadedIncremental;
+  deserializeFromFile(filename, &loadedCheckpoint);
+  deserializeFromFile(incrementalFilename, &loadedIncremental);
+  std::remove(filename.c_str());
+  std::remove(incrementalFilename.c_str());
+
+  SphSolver3 restarted;
+  setUpCheckpointScene(&restarted);
+  EXPECT_THROW(restarted.loadCheckpoint(loadedIncremental), std::invalid_argument);
+  restarted.loadCheckpoint(loadedIncremental, &loadedCheckpoint);
+  EXPECT_EQ(4, restarted.currentFrame().index);
+  EXPECT_EQ(solver.currentTimeInSeconds(), restarted.currentTimeInSeconds());
+
+  // The neighbor lists are restored rather than rebuilt
+  auto restartedParticles = restarted.sphSystemData();
+  ASSERT_EQ(neighborLists.length(), restartedParticles->neighborLists().length());
+  for (size_t i = 0; i < neighborLists.length(); ++i) {
+    ASSERT_EQ(neighborLists[i].length(), restartedParticles->neighborLists()[i].length());
+    for (size_t j = 0; j < neighborLists[i].length(); ++j) {
+      EXPECT_EQ(neighborLists[i][j], restartedParticles->neighborLists()[i][j]);
+    }
+  }
+  EXPECT_EQ(solver.sphSystemData()->neighborSearcher()->typeName(),
+            restartedParticles->neighborSearcher()->typeName());
+
+  // The emitter, the collider and the particles continue the same way
+  for (int i = 5; i < 7; ++i) {
+    solver.update(Frame(i, 0.01));
+    restarted.update(Frame(i, 0.01));
+  }
+
+  auto particles = solver.sphSystemData();
+  ASSERT_EQ(particles->numberOfParticles(), restartedParticles->numberOfParticles());
+  EXPECT_GT(particles->numberOfParticles(), 0u);
+  for (size_t i = 0; i < particles->numberOfParticles(); ++i) {
+    EXPECT_EQ(particles->positions()[i], restartedParticles->positions()[i]);
+    EXPECT_EQ(particles->velocities()[i], restartedParticles->velocities()[i]);
+    EXPECT_EQ(particles->densities()[i], restartedParticles->densities()[i]);
+  }
+  EXPECT_EQ(solver.collider()->surface()->transform.translation(),
+            restarted.collider()->surface()->transform.translation());
+}
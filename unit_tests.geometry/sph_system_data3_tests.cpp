@@ -123,3 +123,31 @@ TEST(SphSystemData3, Serialization) {
     }
   }
 }
+
+TEST(SphSystemData3, MappedData) {
+  SphSystemData3 data;
+  ParticleSystemData3::VectorData positions = {{0.7, 0.2, 0.2}, {0.7, 0.8, 1.0}, {0.9, 0.4, 0.0}, {0.5, 0.1, 0.6}};
+  data.addParticles(positions);
+  data.setTargetSpacing(0.3);
+  data.buildNeighborSearcher();
+  data.buildNeighborLists();
+  data.updateDensities();
+
+  std::vector<uint8_t> buffer;
+  data.serialize(&buffer);
+  const ConstArrayView1<uint8_t> view(buffer.data(), buffer.size());
+
+  auto mappedPositions = SphSystemData3::mappedPositions(view);
+  auto mappedDensities = SphSystemData3::mappedDensities(view);
+  ASSERT_EQ(positions.length(), mappedPositions.length());
+  ASSERT_EQ(positions.length(), mappedDensities.length());
+  for (size_t i = 0; i < positions.length(); ++i) {
+    EXPECT_EQ(positions[i], mappedPositions[i]);
+    EXPECT_EQ(data.densities()[i], mappedDensities[i]);
+  }
+
+  SphSystemData3 data2;
+  data2.deserializeFromMemory(view);
+  EXPECT_EQ(0.3, data2.targetSpacing());
+  EXPECT_EQ(positions.length(), data2.numberOfParticles());
+}
@@ -144,6 +144,21 @@ TEST(SurfaceToImplicit3, SignedDistance) {
   EXPECT_DOUBLE_EQ(-boxDist, s2iDist);
 }
 
+TEST(SurfaceToImplicit3, SignedDistances) {
+  BoundingBox3D bbox(Vector3D(1, 4, 3), Vector3D(5, 6, 9));
+
+  Box3Ptr box = std::make_shared<Box3>(bbox);
+  SurfaceToImplicit3 s2i(box);
+  s2i.isNormalFlipped = true;
+
+  Array1<Vector3D> points = {Vector3D(-1, 7, 8), Vector3D(2, 5, 4), Vector3D(5, 6, 9)};
+  Array1<double> distances(points.length());
+  s2i.signedDistances(points, distances);
+  for (size_t i = 0; i < points.length(); ++i) {
+    EXPECT_DOUBLE_EQ(s2i.signedDistance(points[i]), distances[i]);
+  }
+}
+
 TEST(SurfaceToImplicit3, ClosestNormal) {
   BoundingBox3D bbox(Vector3D(), Vector3D(1, 2, 3));
 
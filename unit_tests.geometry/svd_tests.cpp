@@ -4,10 +4,14 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include "../vox.geometry/array.h"
 #include "../vox.geometry/svd.h"
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 using namespace vox;
 using namespace geometry;
 
@@ -42,3 +46,111 @@ TEST(Svd, Double) {
   MatrixMxND aApprox = u * w2 * v.transposed();
   EXPECT_TRUE(a.isSimilar(aApprox, 1e-12));
 }
+
+namespace {
+
+void expectSymmetricEigen(const Matrix3x3D &a, const Matrix3x3D &v, const Vector3D &d) {
+  // Matrix::absmax compares squares, which overflow at the extreme scales
+  double scale = std::numeric_limits<double>::min();
+  for (size_t i = 0; i < 9; ++i) {
+    scale = std::max(scale, std::fabs(a[i]));
+  }
+  const double tol = 1e-13 * scale;
+
+  EXPECT_TRUE((v.transposed() * v).isSimilar(Matrix3x3D::makeIdentity(), 1e-14));
+  EXPECT_TRUE((v * Matrix3x3D::makeScaleMatrix(d) * v.transposed()).isSimilar(a, tol));
+  EXPECT_GE(d[0], d[1]);
+  EXPECT_GE(d[1], d[2]);
+}
+
+Array1<Matrix3x3D> makeSymmetricSamples() {
+  std::mt19937 rng{0};
+  std::uniform_real_distribution<> dist(-1.0, 1.0);
+
+  Array1<Matrix3x3D> samples;
+  samples.append(Matrix3x3D());
+  samples.append(Matrix3x3D::makeScaleMatrix(3.0, -1.0, 2.0));
+  samples.append(Matrix3x3D{{4.0, 1.0, 0.0}, {1.0, 4.0, 0.0}, {0.0, 0.0, 4.0}});
+
+  for (size_t i = 0; i < 100; ++i) {
+    const Vector3D axis = Vector3D(dist(rng), dist(rng), dist(rng)).normalized();
+    const Matrix3x3D r = Matrix3x3D::makeRotationMatrix(axis, kPiD * dist(rng));
+
+    // Random symmetric matrices
+    Matrix3x3D m;
+    for (size_t j = 0; j < 3; ++j) {
+      for (size_t k = j; k < 3; ++k) {
+        m(j, k) = m(k, j) = dist(rng);
+      }
+    }
+    samples.append(m);
+
+    // Covariance-like matrices with repeated and nearly repeated eigenvalues
+    const double e = std::fabs(dist(rng));
+    samples.append(r * Matrix3x3D::makeScaleMatrix(e, e, 1e-3 * e) * r.transposed());
+    samples.append(r * Matrix3x3D::makeScaleMatrix(e, e * (1.0 + 1e-9), 0.0) * r.transposed());
+
+    // Extreme scales
+    samples.append(1e-200 * m);
+    samples.append(1e200 * m);
+  }
+  return samples;
+}
+
+} // namespace
+
+TEST(SymmetricEigen, Decompose) {
+  Matrix3x3D v;
+  Vector3D d;
+
+  const Matrix3x3D a{{2.0, -1.0, 0.0}, {-1.0, 2.0, -1.0}, {0.0, -1.0, 2.0}};
+  symmetricEigen(a, v, d);
+  EXPECT_NEAR(2.0 + std::sqrt(2.0), d.x, 1e-14);
+  EXPECT_NEAR(2.0, d.y, 1e-14);
+  EXPECT_NEAR(2.0 - std::sqrt(2.0), d.z, 1e-14);
+  expectSymmetricEigen(a, v, d);
+
+  for (const Matrix3x3D &m : makeSymmetricSamples()) {
+    symmetricEigen(m, v, d);
+    expectSymmetricEigen(m, v, d);
+  }
+}
+
+TEST(SymmetricEigen, MatchesSvd) {
+  std::mt19937 rng{1};
+  std::uniform_real_distribution<> dist(-1.0, 1.0);
+
+  for (size_t i = 0; i < 100; ++i) {
+    // Positive semi-definite, where the singular values are the eigenvalues
+    Matrix3x3D b;
+    for (size_t j = 0; j < 9; ++j) {
+      b[j] = dist(rng);
+    }
+    const Matrix3x3D a = b * b.transposed();
+
+    Matrix3x3D u, w, v;
+    Vector3D s, d;
+    svd(a, u, s, w);
+    symmetricEigen(a, v, d);
+
+    std::sort(s.begin(), s.end(), std::greater<double>());
+    EXPECT_TRUE(d.isSimilar(s, 1e-12));
+  }
+}
+
+TEST(SymmetricEigen, Batched) {
+  const Array1<Matrix3x3D> samples = makeSymmetricSamples();
+  Array1<Matrix3x3D> vs(samples.length());
+  Array1<Vector3D> ds(samples.length());
+  symmetricEigen(samples.view(), vs.view(), ds.view());
+
+  for (size_t i = 0; i < samples.length(); ++i) {
+    Matrix3x3D v;
+    Vector3D d;
+    symmetricEigen(samples[i], v, d);
+    EXPECT_EQ(v, vs[i]);
+    EXPECT_EQ(d, ds[i]);
+  }
+
+  EXPECT_THROW(symmetricEigen(samples.view(), vs.view(), Array1<Vector3D>(3).view()), std::invalid_argument);
+}
@@ -120,6 +120,50 @@ TEST(TriangleMesh3, ClosestDistance) {
   }
 }
 
+TEST(TriangleMesh3, ClosestDistances) {
+  std::string objStr = getCubeTriMesh3x3x3Obj();
+  std::istringstream objStream(objStr);
+
+  TriangleMesh3 mesh;
+  mesh.readObj(&objStream);
+  mesh.transform = Transform3(Vector3D(1, 2, 3), Orientation<3>(QuaternionD()));
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  Array1<Vector3D> points(numSamples);
+  std::copy(getSamplePoints3(), getSamplePoints3() + numSamples, points.begin());
+
+  Array1<double> distances(numSamples);
+  mesh.closestDistances(points, distances);
+  for (size_t i = 0; i < numSamples; ++i) {
+    EXPECT_DOUBLE_EQ(mesh.closestDistance(points[i]), distances[i]);
+  }
+}
+
+TEST(TriangleMesh3, RefitQueryEngine) {
+  std::string objStr = getCubeTriMesh3x3x3Obj();
+  std::istringstream objStream(objStr);
+
+  TriangleMesh3 mesh;
+  mesh.readObj(&objStream);
+  mesh.updateQueryEngine();
+
+  // Squash the cube along y in place
+  for (size_t i = 0; i < mesh.numberOfPoints(); ++i) {
+    mesh.point(i).y *= 0.5;
+  }
+  mesh.refitQueryEngine();
+
+  TriangleMesh3 expected(mesh);
+  EXPECT_BOUNDING_BOX3_EQ(expected.boundingBox(), mesh.boundingBox());
+
+  size_t numSamples = getNumberOfSamplePoints3();
+  for (size_t i = 0; i < numSamples; ++i) {
+    const Vector3D pt = getSamplePoints3()[i];
+    EXPECT_DOUBLE_EQ(expected.closestDistance(pt), mesh.closestDistance(pt));
+    EXPECT_EQ(expected.isInside(pt), mesh.isInside(pt));
+  }
+}
+
 TEST(TriangleMesh3, Intersects) {
   std::string objStr = getCubeTriMesh3x3x3Obj();
   std::istringstream objStream(objStr);
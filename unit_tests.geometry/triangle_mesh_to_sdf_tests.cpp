@@ -12,6 +12,39 @@
 using namespace vox;
 using namespace geometry;
 
+namespace {
+
+TriangleMesh3 makeUnitCube() {
+  TriangleMesh3 mesh;
+
+  // Build a cube
+  mesh.addPoint({0.0, 0.0, 0.0});
+  mesh.addPoint({0.0, 0.0, 1.0});
+  mesh.addPoint({0.0, 1.0, 0.0});
+  mesh.addPoint({0.0, 1.0, 1.0});
+  mesh.addPoint({1.0, 0.0, 0.0});
+  mesh.addPoint({1.0, 0.0, 1.0});
+  mesh.addPoint({1.0, 1.0, 0.0});
+  mesh.addPoint({1.0, 1.0, 1.0});
+
+  mesh.addPointTriangle({0, 1, 3});
+  mesh.addPointTriangle({0, 3, 2});
+  mesh.addPointTriangle({4, 6, 7});
+  mesh.addPointTriangle({4, 7, 5});
+  mesh.addPointTriangle({0, 4, 5});
+  mesh.addPointTriangle({0, 5, 1});
+  mesh.addPointTriangle({2, 3, 7});
+  mesh.addPointTriangle({2, 7, 6});
+  mesh.addPointTriangle({0, 2, 6});
+  mesh.addPointTriangle({0, 6, 4});
+  mesh.addPointTriangle({1, 5, 7});
+  mesh.addPointTriangle({1, 7, 3});
+
+  return mesh;
+}
+
+} // namespace
+
 TEST(TriangleMeshToSdf, TriangleMeshToSdf) {
   TriangleMesh3 mesh;
 
@@ -52,3 +85,50 @@ TEST(TriangleMeshToSdf, TriangleMeshToSdf) {
     EXPECT_DOUBLE_EQ(ans, grid(i, j, k));
   });
 }
+
+TEST(TriangleMeshToSdf, NarrowBand) {
+  TriangleMesh3 mesh = makeUnitCube();
+
+  SparseScalarGrid3 grid({40, 40, 40}, {0.05, 0.05, 0.05}, {-0.5, -0.5, -0.5});
+
+  triangleMeshToSdf(mesh, 0.15, &grid);
+  EXPECT_LT(grid.numberOfAllocatedDataPoints(), 40u * 40u * 40u);
+
+  Box3 box(Vector3D(), Vector3D(1.0, 1.0, 1.0));
+
+  auto gridPos = grid.dataPosition();
+  forEachIndex(grid.dataSize(), [&](size_t i, size_t j, size_t k) {
+    auto pos = gridPos(i, j, k);
+    double ans = box.closestDistance(pos);
+    ans *= box.bound.contains(pos) ? -1.0 : 1.0;
+    if (grid.isAllocated({i, j, k})) {
+      EXPECT_DOUBLE_EQ(ans, grid(i, j, k));
+    } else {
+      EXPECT_LT(0.15, std::fabs(ans));
+      EXPECT_DOUBLE_EQ(ans < 0.0 ? -0.15 : 0.15, grid(i, j, k));
+    }
+  });
+}
+
+TEST(TriangleMeshToSdf, NarrowBandDenseGrid) {
+  TriangleMesh3 mesh = makeUnitCube();
+
+  CellCenteredScalarGrid3 grid({40, 40, 40}, {0.05, 0.05, 0.05}, {-0.5, -0.5, -0.5});
+
+  triangleMeshToSdf(mesh, 0.15, &grid);
+
+  Box3 box(Vector3D(), Vector3D(1.0, 1.0, 1.0));
+
+  auto gridPos = grid.dataPosition();
+  grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+    auto pos = gridPos(i, j, k);
+    double ans = std::min(box.closestDistance(pos), 0.15);
+    ans *= box.bound.contains(pos) ? -1.0 : 1.0;
+    EXPECT_DOUBLE_EQ(ans, grid(i, j, k));
+  });
+
+  // The band is at least as wide as the grid spacing
+  triangleMeshToSdf(mesh, 0.01, &grid);
+  EXPECT_DOUBLE_EQ(-0.05, grid(20, 20, 20));
+  EXPECT_DOUBLE_EQ(0.05, grid(0, 0, 0));
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../vox.geometry/untidy_priority_queue.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace vox;
+using namespace geometry;
+
+TEST(UntidyPriorityQueue, Constructors) {
+  UntidyPriorityQueue<int> queue(0.5, 4);
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(0u, queue.size());
+  EXPECT_DOUBLE_EQ(0.0, queue.currentPriority());
+
+  EXPECT_THROW(UntidyPriorityQueue<int>(0.0, 4), std::invalid_argument);
+  EXPECT_THROW(UntidyPriorityQueue<int>(0.5, 0), std::invalid_argument);
+}
+
+TEST(UntidyPriorityQueue, PushAndPop) {
+  const double bucketWidth = 0.1;
+  UntidyPriorityQueue<double> queue(bucketWidth, 12);
+
+  // Push values that stay within a unit of the last popped one, as in the
+  // fast marching method
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> d(0.0, 1.0);
+
+  for (int i = 0; i < 10; ++i) {
+    const double value = d(rng);
+    queue.push(value, value);
+  }
+
+  double lastPopped = 0.0;
+  size_t numberOfPops = 0;
+  while (!queue.empty()) {
+    const double priority = queue.currentPriority();
+    const double value = queue.pop();
+    ++numberOfPops;
+
+    // Values are popped in order up to the bucket width
+    EXPECT_GE(value, lastPopped - bucketWidth);
+    lastPopped = std::max(lastPopped, value);
+    EXPECT_LE(priority, queue.currentPriority());
+
+    if (numberOfPops < 1000) {
+      const double next = value + d(rng);
+      queue.push(next, next);
+    }
+  }
+
+  EXPECT_EQ(1009u, numberOfPops);
+  EXPECT_EQ(0u, queue.size());
+}
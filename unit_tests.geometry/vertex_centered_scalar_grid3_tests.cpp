@@ -310,3 +310,15 @@ TEST(VertexCenteredScalarGrid3, Serialization) {
   EXPECT_DOUBLE_EQ(1.0, grid2.gridSpacing().y);
   EXPECT_DOUBLE_EQ(1.0, grid2.gridSpacing().z);
 }
+
+TEST(VertexCenteredScalarGrid3, MappedDataView) {
+  VertexCenteredScalarGrid3 grid({5, 4, 3}, {1.0, 2.0, 3.0}, {-5.0, 3.0, 1.0});
+  grid.fill([&](const Vector3D &pt) { return pt.x + pt.y + pt.z; });
+
+  std::vector<uint8_t> buffer;
+  grid.serialize(&buffer);
+
+  auto view = VertexCenteredScalarGrid3::mappedDataView(ConstArrayView1<uint8_t>(buffer.data(), buffer.size()));
+  EXPECT_EQ(Vector3UZ(6, 5, 4), view.size());
+  grid.forEachDataPointIndex([&](size_t i, size_t j, size_t k) { EXPECT_EQ(grid(i, j, k), view(i, j, k)); });
+}
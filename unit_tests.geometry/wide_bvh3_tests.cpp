@@ -0,0 +1,141 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "unit_tests_utils.h"
+
+#include "../vox.geometry/query_engines/wide_bvh.h"
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+Array1<BoundingBox3D> makeSampleBoxes(size_t count) {
+  Array1<BoundingBox3D> boxes(count);
+  for (size_t i = 0; i < count; ++i) {
+    const Vector3D c = getSamplePoints3()[i];
+    boxes[i] = BoundingBox3D(c, c);
+    boxes[i].expand(0.1);
+  }
+  return boxes;
+}
+
+double intersectsFunc(const BoundingBox3D &a, const Ray3D &ray) {
+  auto bboxResult = a.closestIntersection(ray);
+  if (bboxResult.isIntersecting) {
+    return bboxResult.tNear;
+  } else {
+    return kMaxD;
+  }
+}
+
+template <size_t W> void testWideBvhQueries(bool useBinnedSah) {
+  const size_t numSamples = getNumberOfSamplePoints3();
+  const Array1<BoundingBox3D> items = makeSampleBoxes(numSamples / 2);
+
+  Bvh3<BoundingBox3D> bvh(useBinnedSah);
+  bvh.build(items, items);
+
+  WideBvh<BoundingBox3D, 3, W> wideBvh;
+  wideBvh.build(bvh);
+  EXPECT_EQ(items.length(), wideBvh.numberOfItems());
+  EXPECT_BOUNDING_BOX3_EQ(bvh.boundingBox(), wideBvh.boundingBox());
+  EXPECT_LT(wideBvh.numberOfNodes(), bvh.numberOfNodes() / 2);
+
+  auto distanceFunc = [](const BoundingBox3D &a, const Vector3D &pt) { return a.midPoint().distanceTo(pt); };
+  for (size_t i = 0; i < numSamples; i += 7) {
+    const Vector3D testPt = getSampleDirs3()[i];
+    const auto expected = bvh.nearest(testPt, distanceFunc);
+    const auto actual = wideBvh.nearest(testPt, distanceFunc);
+    EXPECT_DOUBLE_EQ(expected.distance, actual.distance);
+  }
+
+  for (size_t i = numSamples / 2; i < numSamples; ++i) {
+    const Ray3D ray(getSamplePoints3()[i], getSampleDirs3()[i]);
+    const auto expected = bvh.closestIntersection(ray, intersectsFunc);
+    const auto actual = wideBvh.closestIntersection(ray, intersectsFunc);
+    EXPECT_DOUBLE_EQ(expected.distance, actual.distance);
+
+    auto rayTestFunc = [](const BoundingBox3D &box, const Ray3D &r) { return box.intersects(r); };
+    EXPECT_EQ(bvh.intersects(ray, rayTestFunc), wideBvh.intersects(ray, rayTestFunc));
+
+    size_t expectedCount = 0;
+    size_t actualCount = 0;
+    bvh.forEachIntersectingItem(ray, rayTestFunc, [&](const BoundingBox3D &) { ++expectedCount; });
+    wideBvh.forEachIntersectingItem(ray, rayTestFunc, [&](const BoundingBox3D &) { ++actualCount; });
+    EXPECT_EQ(expectedCount, actualCount);
+  }
+
+  auto boxTestFunc = [](const BoundingBox3D &a, const BoundingBox3D &b) { return a.overlaps(b); };
+  const BoundingBox3D testBox({0.3, 0.2, 0.1}, {0.6, 0.5, 0.4});
+  EXPECT_EQ(bvh.intersects(testBox, boxTestFunc), wideBvh.intersects(testBox, boxTestFunc));
+
+  size_t numOverlaps = 0;
+  for (const BoundingBox3D &item : items) {
+    numOverlaps += boxTestFunc(item, testBox);
+  }
+  size_t measured = 0;
+  wideBvh.forEachIntersectingItem(testBox, boxTestFunc, [&](const BoundingBox3D &item) {
+    EXPECT_TRUE(boxTestFunc(item, testBox));
+    ++measured;
+  });
+  EXPECT_EQ(numOverlaps, measured);
+}
+
+} // namespace
+
+TEST(WideBvh3, Constructors) {
+  WideBvh3x4<Vector3D> bvh;
+  EXPECT_EQ(bvh.begin(), bvh.end());
+  EXPECT_EQ(0u, bvh.numberOfNodes());
+
+  auto distanceFunc = [](const Vector3D &a, const Vector3D &b) { return a.distanceTo(b); };
+  EXPECT_EQ(nullptr, bvh.nearest(Vector3D(), distanceFunc).item);
+}
+
+TEST(WideBvh3, BasicGetters) {
+  Array1<Vector3D> points{Vector3D{0, 0, 0}, Vector3D{1, 1, 1}, Vector3D{2, 2, 2}};
+  Array1<BoundingBox3D> bounds(points.length());
+  for (size_t i = 0; i < points.length(); ++i) {
+    bounds[i] = BoundingBox3D(points[i], points[i]);
+  }
+
+  Bvh3<Vector3D> bvh;
+  bvh.build(points, bounds);
+
+  // Three items fit in a single 4-wide node
+  WideBvh3x4<Vector3D> wideBvh;
+  wideBvh.build(bvh);
+  EXPECT_EQ(3u, wideBvh.numberOfItems());
+  EXPECT_EQ(1u, wideBvh.numberOfNodes());
+  for (size_t i = 0; i < points.length(); ++i) {
+    EXPECT_VECTOR3_EQ(bvh.item(i), wideBvh.item(i));
+  }
+
+  wideBvh.clear();
+  EXPECT_EQ(0u, wideBvh.numberOfItems());
+  EXPECT_EQ(0u, wideBvh.numberOfNodes());
+
+  // A single item is a root with one leaf
+  Array1<Vector3D> singlePoint{points[0]};
+  Array1<BoundingBox3D> singleBound{bounds[0]};
+  Bvh3<Vector3D> single;
+  single.build(singlePoint, singleBound);
+  wideBvh.build(single);
+  EXPECT_EQ(1u, wideBvh.numberOfNodes());
+  auto distanceFunc = [](const Vector3D &a, const Vector3D &b) { return a.distanceTo(b); };
+  EXPECT_DOUBLE_EQ(std::sqrt(3.0), wideBvh.nearest(Vector3D(1, 1, 1), distanceFunc).distance);
+}
+
+TEST(WideBvh3, Queries4) {
+  testWideBvhQueries<4>(false);
+  testWideBvhQueries<4>(true);
+}
+
+TEST(WideBvh3, Queries8) {
+  testWideBvhQueries<8>(false);
+  testWideBvhQueries<8>(true);
+}
@@ -14,7 +14,7 @@
 namespace vox {
 namespace geometry {
 
-template <typename T, size_t N> class Array;
+template <typename T, size_t N, typename Allocator> class Array;
 
 namespace internal {
 
@@ -61,7 +61,7 @@ template <typename T, size_t N> struct GetSizeFromInitList<T, N, 1> {
 };
 
 template <typename T, size_t N, size_t I> struct SetArrayFromInitList {
-  static void call(Array<T, N> &arr, NestedInitializerListsT<T, I> lst) {
+  template <typename A> static void call(Array<T, N, A> &arr, NestedInitializerListsT<T, I> lst) {
     size_t i = 0;
     for (auto subLst : lst) {
       JET_ASSERT(i < arr.size()[I - 1]);
@@ -70,8 +70,8 @@ template <typename T, size_t N, size_t I> struct SetArrayFromInitList {
     }
   }
 
-  template <typename... RemainingIndices>
-  static void call(Array<T, N> &arr, NestedInitializerListsT<T, I> lst, RemainingIndices... indices) {
+  template <typename A, typename... RemainingIndices>
+  static void call(Array<T, N, A> &arr, NestedInitializerListsT<T, I> lst, RemainingIndices... indices) {
     size_t i = 0;
     for (auto subLst : lst) {
       JET_ASSERT(i < arr.size()[I - 1]);
@@ -82,7 +82,7 @@ template <typename T, size_t N, size_t I> struct SetArrayFromInitList {
 };
 
 template <typename T, size_t N> struct SetArrayFromInitList<T, N, 1> {
-  static void call(Array<T, N> &arr, NestedInitializerListsT<T, 1> lst) {
+  template <typename A> static void call(Array<T, N, A> &arr, NestedInitializerListsT<T, 1> lst) {
     size_t i = 0;
     for (auto val : lst) {
       JET_ASSERT(i < arr.size()[0]);
@@ -91,8 +91,8 @@ template <typename T, size_t N> struct SetArrayFromInitList<T, N, 1> {
     }
   }
 
-  template <typename... RemainingIndices>
-  static void call(Array<T, N> &arr, NestedInitializerListsT<T, 1> lst, RemainingIndices... indices) {
+  template <typename A, typename... RemainingIndices>
+  static void call(Array<T, N, A> &arr, NestedInitializerListsT<T, 1> lst, RemainingIndices... indices) {
     size_t i = 0;
     for (auto val : lst) {
       JET_ASSERT(i < arr.size()[0]);
@@ -295,14 +295,15 @@ size_t ArrayBase<T, N, D>::_index(const Vector<size_t, N> &idx, std::index_seque
 // MARK: Array
 
 // CTOR
-template <typename T, size_t N> Array<T, N>::Array() : Base() {}
+template <typename T, size_t N, typename A> Array<T, N, A>::Array() : Base() {}
 
-template <typename T, size_t N> Array<T, N>::Array(const Vector<size_t, N> &size_, const T &initVal) : Array() {
+template <typename T, size_t N, typename A>
+Array<T, N, A>::Array(const Vector<size_t, N> &size_, const T &initVal) : Array() {
   _data.resize(product<size_t, N>(size_, 1), initVal);
   Base::setPtrAndSize(_data.data(), size_);
 }
 
-template <typename T, size_t N> template <typename... Args> Array<T, N>::Array(size_t nx, Args... args) {
+template <typename T, size_t N, typename A> template <typename... Args> Array<T, N, A>::Array(size_t nx, Args... args) {
   Vector<size_t, N> size_;
   T initVal;
   internal::GetSizeAndInitVal<T, N, N - 1>::call(size_, initVal, nx, args...);
@@ -310,7 +311,7 @@ template <typename T, size_t N> template <typename... Args> Array<T, N>::Array(s
   Base::setPtrAndSize(_data.data(), size_);
 }
 
-template <typename T, size_t N> Array<T, N>::Array(NestedInitializerListsT<T, N> lst) {
+template <typename T, size_t N, typename A> Array<T, N, A>::Array(NestedInitializerListsT<T, N> lst) {
   Vector<size_t, N> newSize{};
   internal::GetSizeFromInitList<T, N, N>::call(newSize, lst);
   _data.resize(product<size_t, N>(newSize, 1));
@@ -318,44 +319,68 @@ template <typename T, size_t N> Array<T, N>::Array(NestedInitializerListsT<T, N>
   internal::SetArrayFromInitList<T, N, N>::call(*this, lst);
 }
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename OtherDerived>
-Array<T, N>::Array(const ArrayBase<T, N, OtherDerived> &other) : Array() {
+Array<T, N, A>::Array(const ArrayBase<T, N, OtherDerived> &other) : Array() {
   copyFrom(other);
 }
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename OtherDerived>
-Array<T, N>::Array(const ArrayBase<const T, N, OtherDerived> &other) : Array() {
+Array<T, N, A>::Array(const ArrayBase<const T, N, OtherDerived> &other) : Array() {
   copyFrom(other);
 }
 
-template <typename T, size_t N> Array<T, N>::Array(const Array &other) : Array() { copyFrom(other); }
+template <typename T, size_t N, typename A> Array<T, N, A>::Array(const Array &other) : Array() { copyFrom(other); }
 
-template <typename T, size_t N> Array<T, N>::Array(Array &&other) noexcept : Array() { *this = std::move(other); }
+template <typename T, size_t N, typename A> Array<T, N, A>::Array(Array &&other) noexcept : Array() {
+  *this = std::move(other);
+}
+
+template <typename T, size_t N, typename A>
+template <typename E>
+Array<T, N, A>::Array(const ArrayExpression<T, N, E> &expression) : Array(expression.size()) {
+  expression.evalTo(view());
+}
 
-template <typename T, size_t N> template <typename D> void Array<T, N>::copyFrom(const ArrayBase<T, N, D> &other) {
+template <typename T, size_t N, typename A>
+template <typename D>
+void Array<T, N, A>::copyFrom(const ArrayBase<T, N, D> &other) {
   resize(other.size());
   forEachIndex(Vector<size_t, N>{}, other.size(), [&](auto... idx) { this->at(idx...) = other(idx...); });
 }
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename D>
-void Array<T, N>::copyFrom(const ArrayBase<const T, N, D> &other) {
+void Array<T, N, A>::copyFrom(const ArrayBase<const T, N, D> &other) {
   resize(other.size());
   forEachIndex(Vector<size_t, N>{}, other.size(), [&](auto... idx) { this->at(idx...) = other(idx...); });
 }
 
-template <typename T, size_t N> void Array<T, N>::fill(const T &val) { std::fill(_data.begin(), _data.end(), val); }
+template <typename T, size_t N, typename A> void Array<T, N, A>::fill(const T &val) {
+  std::fill(_data.begin(), _data.end(), val);
+}
+
+template <typename T, size_t N, typename A> void Array<T, N, A>::resize(Vector<size_t, N> size_, const T &initVal) {
+  // Keep the storage when the layout does not change, e.g. when reusing an array as a copy target
+  if (size_ == _size) {
+    return;
+  }
+  if constexpr (N == 1) {
+    _data.resize(size_.x, initVal);
+    Base::setPtrAndSize(_data.data(), size_);
+    return;
+  }
 
-template <typename T, size_t N> void Array<T, N>::resize(Vector<size_t, N> size_, const T &initVal) {
   Array newArray(size_, initVal);
   Vector<size_t, N> minSize = min(_size, newArray._size);
   forEachIndex(minSize, [&](auto... idx) { newArray(idx...) = (*this)(idx...); });
   *this = std::move(newArray);
 }
 
-template <typename T, size_t N> template <typename... Args> void Array<T, N>::resize(size_t nx, Args... args) {
+template <typename T, size_t N, typename A>
+template <typename... Args>
+void Array<T, N, A>::resize(size_t nx, Args... args) {
   Vector<size_t, N> size_;
   T initVal;
   internal::GetSizeAndInitVal<T, N, N - 1>::call(size_, initVal, nx, args...);
@@ -363,61 +388,63 @@ template <typename T, size_t N> template <typename... Args> void Array<T, N>::re
   resize(size_, initVal);
 }
 
-template <typename T, size_t N> template <size_t M> std::enable_if_t<(M == 1), void> Array<T, N>::append(const T &val) {
+template <typename T, size_t N, typename A>
+template <size_t M>
+std::enable_if_t<(M == 1), void> Array<T, N, A>::append(const T &val) {
   _data.push_back(val);
   Base::setPtrAndSize(_data.data(), _data.size());
 }
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename OtherDerived, size_t M>
-std::enable_if_t<(M == 1), void> Array<T, N>::append(const ArrayBase<T, N, OtherDerived> &extra) {
+std::enable_if_t<(M == 1), void> Array<T, N, A>::append(const ArrayBase<T, N, OtherDerived> &extra) {
   _data.insert(_data.end(), extra.begin(), extra.end());
   Base::setPtrAndSize(_data.data(), _data.size());
 }
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename OtherDerived, size_t M>
-std::enable_if_t<(M == 1), void> Array<T, N>::append(const ArrayBase<const T, N, OtherDerived> &extra) {
+std::enable_if_t<(M == 1), void> Array<T, N, A>::append(const ArrayBase<const T, N, OtherDerived> &extra) {
   _data.insert(_data.end(), extra.begin(), extra.end());
   Base::setPtrAndSize(_data.data(), _data.size());
 }
 
-template <typename T, size_t N> void Array<T, N>::clear() {
+template <typename T, size_t N, typename A> void Array<T, N, A>::clear() {
   Base::clearPtrAndSize();
   _data.clear();
 }
 
-template <typename T, size_t N> void Array<T, N>::swap(Array &other) {
+template <typename T, size_t N, typename A> void Array<T, N, A>::swap(Array &other) {
   Base::swapPtrAndSize(other);
   std::swap(_data, other._data);
 }
 
-template <typename T, size_t N> ArrayView<T, N> Array<T, N>::view() { return ArrayView<T, N>(*this); };
+template <typename T, size_t N, typename A> ArrayView<T, N> Array<T, N, A>::view() { return ArrayView<T, N>(*this); };
 
-template <typename T, size_t N> ArrayView<const T, N> Array<T, N>::view() const {
+template <typename T, size_t N, typename A> ArrayView<const T, N> Array<T, N, A>::view() const {
   return ArrayView<const T, N>(*this);
 };
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename OtherDerived>
-Array<T, N> &Array<T, N>::operator=(const ArrayBase<T, N, OtherDerived> &other) {
+Array<T, N, A> &Array<T, N, A>::operator=(const ArrayBase<T, N, OtherDerived> &other) {
   copyFrom(other);
   return *this;
 }
 
-template <typename T, size_t N>
+template <typename T, size_t N, typename A>
 template <typename OtherDerived>
-Array<T, N> &Array<T, N>::operator=(const ArrayBase<const T, N, OtherDerived> &other) {
+Array<T, N, A> &Array<T, N, A>::operator=(const ArrayBase<const T, N, OtherDerived> &other) {
   copyFrom(other);
   return *this;
 }
 
-template <typename T, size_t N> Array<T, N> &Array<T, N>::operator=(const Array &other) {
+template <typename T, size_t N, typename A> Array<T, N, A> &Array<T, N, A>::operator=(const Array &other) {
   copyFrom(other);
   return *this;
 }
 
-template <typename T, size_t N> Array<T, N> &Array<T, N>::operator=(Array &&other) {
+template <typename T, size_t N, typename A> Array<T, N, A> &Array<T, N, A>::operator=(Array &&other) {
   _data = std::move(other._data);
   Base::setPtrAndSize(other.data(), other.size());
   other.setPtrAndSize(nullptr, Vector<size_t, N>{});
@@ -425,6 +452,20 @@ template <typename T, size_t N> Array<T, N> &Array<T, N>::operator=(Array &&othe
   return *this;
 }
 
+template <typename T, size_t N, typename A>
+template <typename E>
+Array<T, N, A> &Array<T, N, A>::operator=(const ArrayExpression<T, N, E> &expression) {
+  if (expression.size() == _size) {
+    expression.evalTo(view());
+  } else {
+    // The expression can refer to this array, so it is not resized in place
+    Array result(expression);
+    swap(result);
+  }
+
+  return *this;
+}
+
 } // namespace vox
 } // namespace geometry
 
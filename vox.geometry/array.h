@@ -7,11 +7,13 @@
 #ifndef INCLUDE_JET_ARRAY_H_
 #define INCLUDE_JET_ARRAY_H_
 
+#include "array_allocator.h"
 #include "matrix.h"
 #include "nested_initializer_list.h"
 
 #include <algorithm>
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace vox {
@@ -194,8 +196,18 @@ private:
 
 template <typename T, size_t N> class ArrayView;
 
-template <typename T, size_t N> class Array final : public ArrayBase<T, N, Array<T, N>> {
-  using Base = ArrayBase<T, N, Array<T, N>>;
+template <typename T, size_t N, typename Derived> class ArrayExpression;
+
+//!
+//! \brief N-D array that owns its storage.
+//!
+//! The storage is allocated by \p Allocator. Use AlignedAllocator and its
+//! aliases (NumaAwareAllocator, HugePageAllocator) to control the alignment
+//! and the placement of the storage of large arrays.
+//!
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+class Array final : public ArrayBase<T, N, Array<T, N, Allocator>> {
+  using Base = ArrayBase<T, N, Array<T, N, Allocator>>;
   using Base::_size;
   using Base::at;
   using Base::clearPtrAndSize;
@@ -220,6 +232,9 @@ public:
 
   Array(Array &&other) noexcept;
 
+  //! Evaluates the array expression, see array_expression.h.
+  template <typename E> Array(const ArrayExpression<T, N, E> &expression);
+
   template <typename D> void copyFrom(const ArrayBase<T, N, D> &other);
 
   template <typename D> void copyFrom(const ArrayBase<const T, N, D> &other);
@@ -257,8 +272,11 @@ public:
 
   Array &operator=(Array &&other);
 
+  //! Evaluates the array expression in a single pass, see array_expression.h.
+  template <typename E> Array &operator=(const ArrayExpression<T, N, E> &expression);
+
 private:
-  std::vector<T> _data;
+  std::vector<T, Allocator> _data;
 };
 
 template <class T> using Array1 = Array<T, 1>;
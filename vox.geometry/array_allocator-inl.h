@@ -0,0 +1,57 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_ARRAY_ALLOCATOR_INL_H_
+#define INCLUDE_JET_DETAIL_ARRAY_ALLOCATOR_INL_H_
+
+#include "array_allocator.h"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+
+namespace vox {
+namespace geometry {
+
+template <typename T, size_t Alignment, bool ParallelFirstTouch, bool HugePages>
+size_t AlignedAllocator<T, Alignment, ParallelFirstTouch, HugePages>::alignment(size_t n) {
+  const size_t align = std::max(Alignment, alignof(T));
+  if (HugePages && n * sizeof(T) >= kHugePageSize) {
+    return std::max(align, kHugePageSize);
+  }
+  return align;
+}
+
+template <typename T, size_t Alignment, bool ParallelFirstTouch, bool HugePages>
+T *AlignedAllocator<T, Alignment, ParallelFirstTouch, HugePages>::allocate(size_t n) {
+  if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+    throw std::bad_array_new_length();
+  }
+
+  const size_t bytes = n * sizeof(T);
+  const size_t align = alignment(n);
+  void *ptr = ::operator new(bytes, std::align_val_t(align));
+
+  if (HugePages && align >= kHugePageSize) {
+    internal::adviseHugePages(ptr, bytes);
+  }
+
+  if (ParallelFirstTouch) {
+    internal::touchPagesInParallel(ptr, n, sizeof(T));
+  }
+
+  return static_cast<T *>(ptr);
+}
+
+template <typename T, size_t Alignment, bool ParallelFirstTouch, bool HugePages>
+void AlignedAllocator<T, Alignment, ParallelFirstTouch, HugePages>::deallocate(T *ptr, size_t n) {
+  ::operator delete(ptr, std::align_val_t(alignment(n)));
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_ARRAY_ALLOCATOR_INL_H_
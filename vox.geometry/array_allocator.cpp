@@ -0,0 +1,48 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "array_allocator.h"
+#include "constants.h"
+#include "parallel.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace vox {
+namespace geometry {
+
+namespace internal {
+
+void adviseHugePages(void *ptr, size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Only the advice, so a failure leaves the regular pages in place.
+  madvise(ptr, bytes, MADV_HUGEPAGE);
+#else
+  (void)ptr;
+  (void)bytes;
+#endif
+}
+
+void touchPagesInParallel(void *ptr, size_t n, size_t elementSize) {
+  // Smallest page size, so every page is written at least once
+  constexpr size_t kStride = 4096;
+  if (n * elementSize < kStride) {
+    return;
+  }
+
+  auto *bytes = static_cast<unsigned char *>(ptr);
+  parallelRangeFor(kZeroSize, n, [bytes, elementSize](size_t begin, size_t end) {
+    for (size_t offset = begin * elementSize; offset < end * elementSize; offset += kStride) {
+      bytes[offset] = 0;
+    }
+  });
+}
+
+} // namespace internal
+
+} // namespace vox
+} // namespace geometry
@@ -0,0 +1,108 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ARRAY_ALLOCATOR_H_
+#define INCLUDE_JET_ARRAY_ALLOCATOR_H_
+
+#include <cstddef>
+#include <type_traits>
+
+namespace vox {
+namespace geometry {
+
+//! Default alignment of AlignedAllocator, which is the size of a cache line.
+constexpr size_t kDefaultArrayAlignment = 64;
+
+//! Size of the huge pages used by AlignedAllocator.
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+//!
+//! \brief Allocator for the storage of Array with control over its placement.
+//!
+//! The storage is aligned to \p Alignment bytes, so the first element of an
+//! array starts a cache line and can be loaded with aligned vector loads.
+//!
+//! If \p ParallelFirstTouch is true, the pages of a new allocation are touched
+//! with parallelRangeFor over the elements before they are constructed. This
+//! is the same partitioning parallelFor uses for the elements, so on systems
+//! with the first-touch NUMA policy, each part of the array lives on the node
+//! of the thread that processes it later instead of the allocating thread.
+//!
+//! If \p HugePages is true, allocations of at least kHugePageSize bytes are
+//! aligned to kHugePageSize and advised to be backed by transparent huge
+//! pages, which reduces the TLB misses of large grids. The advice is only
+//! given on Linux and is ignored elsewhere.
+//!
+//! The allocator is stateless and all the instances compare equal.
+//!
+//! \tparam T                   Value type.
+//! \tparam Alignment           Alignment in bytes, a power of two.
+//! \tparam ParallelFirstTouch  True to touch the pages in parallel.
+//! \tparam HugePages           True to use huge pages for large allocations.
+//!
+template <typename T, size_t Alignment = kDefaultArrayAlignment, bool ParallelFirstTouch = false,
+          bool HugePages = false>
+class AlignedAllocator {
+public:
+  static_assert((Alignment & (Alignment - 1)) == 0, "Alignment should be a power of two.");
+
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  template <typename U> struct rebind {
+    using other = AlignedAllocator<U, Alignment, ParallelFirstTouch, HugePages>;
+  };
+
+  AlignedAllocator() = default;
+
+  template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment, ParallelFirstTouch, HugePages> &) {}
+
+  //! Allocates the storage for \p n elements.
+  T *allocate(size_t n);
+
+  //! Deallocates the storage for \p n elements allocated by allocate(n).
+  void deallocate(T *ptr, size_t n);
+
+  //! Returns the alignment of the storage for \p n elements in bytes.
+  static size_t alignment(size_t n);
+};
+
+template <typename T, typename U, size_t A, bool F, bool H>
+bool operator==(const AlignedAllocator<T, A, F, H> &, const AlignedAllocator<U, A, F, H> &) {
+  return true;
+}
+
+template <typename T, typename U, size_t A, bool F, bool H>
+bool operator!=(const AlignedAllocator<T, A, F, H> &, const AlignedAllocator<U, A, F, H> &) {
+  return false;
+}
+
+//! Allocator with cache line aligned storage.
+template <typename T> using CacheAlignedAllocator = AlignedAllocator<T>;
+
+//! Allocator with cache line aligned storage placed by parallel first touch.
+template <typename T> using NumaAwareAllocator = AlignedAllocator<T, kDefaultArrayAlignment, true>;
+
+//! Allocator with NUMA-aware storage backed by huge pages if large enough.
+template <typename T> using HugePageAllocator = AlignedAllocator<T, kDefaultArrayAlignment, true, true>;
+
+namespace internal {
+
+//! Advises the kernel to back the given range with huge pages.
+void adviseHugePages(void *ptr, size_t bytes);
+
+//! Touches the pages of \p n elements of \p elementSize bytes at \p ptr with
+//! the partitioning of parallelFor over the elements.
+void touchPagesInParallel(void *ptr, size_t n, size_t elementSize);
+
+} // namespace internal
+
+} // namespace vox
+} // namespace geometry
+
+#include "array_allocator-inl.h"
+
+#endif // INCLUDE_JET_ARRAY_ALLOCATOR_H_
@@ -0,0 +1,169 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_ARRAY_EXPRESSION_INL_H_
+#define INCLUDE_JET_DETAIL_ARRAY_EXPRESSION_INL_H_
+
+#include "macros.h"
+
+namespace vox {
+namespace geometry {
+
+// MARK: ArrayExpression
+
+template <typename T, size_t N, typename D> Vector<size_t, N> ArrayExpression<T, N, D>::size() const {
+  return derived().size();
+}
+
+template <typename T, size_t N, typename D> size_t ArrayExpression<T, N, D>::length() const {
+  return product<size_t, N>(derived().size(), 1);
+}
+
+template <typename T, size_t N, typename D> T ArrayExpression<T, N, D>::operator[](size_t i) const {
+  return derived()[i];
+}
+
+template <typename T, size_t N, typename D> Array<T, N> ArrayExpression<T, N, D>::eval() const {
+  Array<T, N> result(size());
+  evalTo(result.view());
+  return result;
+}
+
+template <typename T, size_t N, typename D>
+void ArrayExpression<T, N, D>::evalTo(ArrayView<T, N> result, ExecutionPolicy policy) const {
+  JET_THROW_INVALID_ARG_IF(result.size() != size());
+
+  const D &expression = derived();
+  T *data = result.data();
+
+  // The elements are visited by linear ranges so that the inner loop can be vectorized
+  parallelRangeFor(
+      kZeroSize, result.length(),
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          data[i] = expression[i];
+        }
+      },
+      policy);
+}
+
+template <typename T, size_t N, typename D> const D &ArrayExpression<T, N, D>::derived() const {
+  return static_cast<const D &>(*this);
+}
+
+// MARK: ArrayExpressionRef
+
+template <typename T, size_t N>
+template <typename U, typename D>
+ArrayExpressionRef<T, N>::ArrayExpressionRef(const ArrayBase<U, N, D> &array)
+    : _data(array.data()), _size(array.size()) {}
+
+template <typename T, size_t N> Vector<size_t, N> ArrayExpressionRef<T, N>::size() const { return _size; }
+
+template <typename T, size_t N> const T &ArrayExpressionRef<T, N>::operator[](size_t i) const { return _data[i]; }
+
+// MARK: ArrayUnaryOp
+
+template <typename T, size_t N, typename E, typename Op> Vector<size_t, N> ArrayUnaryOp<T, N, E, Op>::size() const {
+  return _e.size();
+}
+
+template <typename T, size_t N, typename E, typename Op> T ArrayUnaryOp<T, N, E, Op>::operator[](size_t i) const {
+  return _op(_e[i]);
+}
+
+// MARK: ArrayElemWiseBinaryOp
+
+template <typename T, size_t N, typename E1, typename E2, typename Op>
+ArrayElemWiseBinaryOp<T, N, E1, E2, Op>::ArrayElemWiseBinaryOp(const E1 &e1, const E2 &e2) : _e1(e1), _e2(e2) {
+  JET_THROW_INVALID_ARG_IF(e1.size() != e2.size());
+}
+
+template <typename T, size_t N, typename E1, typename E2, typename Op>
+Vector<size_t, N> ArrayElemWiseBinaryOp<T, N, E1, E2, Op>::size() const {
+  return _e1.size();
+}
+
+template <typename T, size_t N, typename E1, typename E2, typename Op>
+T ArrayElemWiseBinaryOp<T, N, E1, E2, Op>::operator[](size_t i) const {
+  return _op(_e1[i], _e2[i]);
+}
+
+// MARK: ArrayScalarBinaryOp
+
+template <typename T, size_t N, typename E, typename S, typename Op>
+Vector<size_t, N> ArrayScalarBinaryOp<T, N, E, S, Op>::size() const {
+  return _e.size();
+}
+
+template <typename T, size_t N, typename E, typename S, typename Op>
+T ArrayScalarBinaryOp<T, N, E, S, Op>::operator[](size_t i) const {
+  return _op(_e[i], _s);
+}
+
+// MARK: ScalarArrayBinaryOp
+
+template <typename T, size_t N, typename S, typename E, typename Op>
+Vector<size_t, N> ScalarArrayBinaryOp<T, N, S, E, Op>::size() const {
+  return _e.size();
+}
+
+template <typename T, size_t N, typename S, typename E, typename Op>
+T ScalarArrayBinaryOp<T, N, S, E, Op>::operator[](size_t i) const {
+  return _op(_s, _e[i]);
+}
+
+// MARK: Operand Traits
+
+template <typename T, size_t N, typename D>
+ArrayExpressionRef<std::remove_const_t<T>, N> makeArrayExpression(const ArrayBase<T, N, D> &array) {
+  return ArrayExpressionRef<std::remove_const_t<T>, N>(array);
+}
+
+template <typename T, size_t N, typename D> const D &makeArrayExpression(const ArrayExpression<T, N, D> &expression) {
+  return expression.derived();
+}
+
+// MARK: Operator Overloadings
+
+template <typename A, std::enable_if_t<IsArrayOperand<A>::value, int>> auto operator-(const A &a) {
+  using E = ArrayOperandExpression<A>;
+  return ArrayNegate<typename E::value_type, E::dimension, E>(makeArrayExpression(a));
+}
+
+template <typename A, typename B, EnableIfArrayOperands<A, B>> auto operator+(const A &a, const B &b) {
+  using E1 = ArrayOperandExpression<A>;
+  using E2 = ArrayOperandExpression<B>;
+  return ArrayElemWiseAdd<typename E1::value_type, E1::dimension, E1, E2>(makeArrayExpression(a),
+                                                                          makeArrayExpression(b));
+}
+
+template <typename A, typename B, EnableIfArrayOperands<A, B>> auto operator-(const A &a, const B &b) {
+  using E1 = ArrayOperandExpression<A>;
+  using E2 = ArrayOperandExpression<B>;
+  return ArrayElemWiseSub<typename E1::value_type, E1::dimension, E1, E2>(makeArrayExpression(a),
+                                                                          makeArrayExpression(b));
+}
+
+template <typename A, typename S, EnableIfArrayScalarOperands<A, S>> auto operator*(const A &a, const S &s) {
+  using E = ArrayOperandExpression<A>;
+  return ArrayScalarMul<typename E::value_type, E::dimension, E, S>(makeArrayExpression(a), s);
+}
+
+template <typename S, typename A, EnableIfArrayScalarOperands<A, S>> auto operator*(const S &s, const A &a) {
+  using E = ArrayOperandExpression<A>;
+  return ScalarArrayMul<typename E::value_type, E::dimension, S, E>(s, makeArrayExpression(a));
+}
+
+template <typename A, typename S, EnableIfArrayScalarOperands<A, S>> auto operator/(const A &a, const S &s) {
+  using E = ArrayOperandExpression<A>;
+  return ArrayScalarDiv<typename E::value_type, E::dimension, E, S>(makeArrayExpression(a), s);
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_ARRAY_EXPRESSION_INL_H_
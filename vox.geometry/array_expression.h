@@ -0,0 +1,255 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ARRAY_EXPRESSION_H_
+#define INCLUDE_JET_ARRAY_EXPRESSION_H_
+
+#include "array.h"
+#include "array_view.h"
+#include "parallel.h"
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace vox {
+namespace geometry {
+
+// MARK: ArrayExpression
+
+//!
+//! \brief Base class for lazy element-wise array expression.
+//!
+//! Arithmetic on arrays, such as a = b + s * c - d, only builds a tree of
+//! small objects that refer to the operands. The tree is evaluated when it is
+//! assigned to an Array or evaluated into an ArrayView, in a single parallel
+//! pass over the elements without temporary arrays. The result can be one of
+//! the operands, but must not partially overlap them.
+//!
+//! \tparam T       Element type.
+//! \tparam N       Dimension.
+//! \tparam Derived Subclass type.
+//!
+template <typename T, size_t N, typename Derived> class ArrayExpression {
+public:
+  using value_type = T;
+
+  static constexpr size_t dimension = N;
+
+  //! Returns the size of the expression.
+  Vector<size_t, N> size() const;
+
+  //! Returns the number of elements.
+  size_t length() const;
+
+  //! Returns the evaluated value for the linear index \p i.
+  T operator[](size_t i) const;
+
+  //! Evaluates the expression into a new array.
+  Array<T, N> eval() const;
+
+  //! Evaluates the expression into \p result, which has to have the same size.
+  void evalTo(ArrayView<T, N> result, ExecutionPolicy policy = ExecutionPolicy::kParallel) const;
+
+  //! Returns actual implementation (the subclass).
+  const Derived &derived() const;
+
+protected:
+  // Prohibits constructing this class instance.
+  ArrayExpression() = default;
+};
+
+// MARK: ArrayExpressionRef
+
+//! Array expression that refers to the elements of an array or array view.
+template <typename T, size_t N>
+class ArrayExpressionRef final : public ArrayExpression<T, N, ArrayExpressionRef<T, N>> {
+public:
+  template <typename U, typename D> ArrayExpressionRef(const ArrayBase<U, N, D> &array);
+
+  Vector<size_t, N> size() const;
+
+  const T &operator[](size_t i) const;
+
+private:
+  const T *_data;
+  Vector<size_t, N> _size;
+};
+
+// MARK: ArrayUnaryOp
+
+//!
+//! \brief Array expression for unary operation.
+//!
+//! \tparam T               Element type.
+//! \tparam N               Dimension.
+//! \tparam E               Input expression type.
+//! \tparam UnaryOperation  Unary operation.
+//!
+template <typename T, size_t N, typename E, typename UnaryOperation>
+class ArrayUnaryOp final : public ArrayExpression<T, N, ArrayUnaryOp<T, N, E, UnaryOperation>> {
+public:
+  explicit ArrayUnaryOp(const E &e) : _e(e) {}
+
+  Vector<size_t, N> size() const;
+
+  T operator[](size_t i) const;
+
+private:
+  E _e;
+  UnaryOperation _op;
+};
+
+//! Array expression for negation.
+template <typename T, size_t N, typename E> using ArrayNegate = ArrayUnaryOp<T, N, E, std::negate<T>>;
+
+// MARK: ArrayElemWiseBinaryOp
+
+//!
+//! \brief Array expression for element-wise binary operation.
+//!
+//! Throws std::invalid_argument if the sizes of the input expressions differ.
+//!
+//! \tparam T               Element type.
+//! \tparam N               Dimension.
+//! \tparam E1              First input expression type.
+//! \tparam E2              Second input expression type.
+//! \tparam BinaryOperation Binary operation.
+//!
+template <typename T, size_t N, typename E1, typename E2, typename BinaryOperation>
+class ArrayElemWiseBinaryOp final : public ArrayExpression<T, N, ArrayElemWiseBinaryOp<T, N, E1, E2, BinaryOperation>> {
+public:
+  ArrayElemWiseBinaryOp(const E1 &e1, const E2 &e2);
+
+  Vector<size_t, N> size() const;
+
+  T operator[](size_t i) const;
+
+private:
+  E1 _e1;
+  E2 _e2;
+  BinaryOperation _op;
+};
+
+//! Array expression for element-wise array-array addition.
+template <typename T, size_t N, typename E1, typename E2>
+using ArrayElemWiseAdd = ArrayElemWiseBinaryOp<T, N, E1, E2, std::plus<T>>;
+
+//! Array expression for element-wise array-array subtraction.
+template <typename T, size_t N, typename E1, typename E2>
+using ArrayElemWiseSub = ArrayElemWiseBinaryOp<T, N, E1, E2, std::minus<T>>;
+
+// MARK: ArrayScalarBinaryOp
+
+//!
+//! \brief Array expression for binary operation between array and scalar.
+//!
+//! \tparam T               Element type.
+//! \tparam N               Dimension.
+//! \tparam E               Input expression type.
+//! \tparam S               Scalar type.
+//! \tparam BinaryOperation Binary operation taking the element first.
+//!
+template <typename T, size_t N, typename E, typename S, typename BinaryOperation>
+class ArrayScalarBinaryOp final : public ArrayExpression<T, N, ArrayScalarBinaryOp<T, N, E, S, BinaryOperation>> {
+public:
+  ArrayScalarBinaryOp(const E &e, const S &s) : _e(e), _s(s) {}
+
+  Vector<size_t, N> size() const;
+
+  T operator[](size_t i) const;
+
+private:
+  E _e;
+  S _s;
+  BinaryOperation _op;
+};
+
+//! Array expression for array-scalar multiplication.
+template <typename T, size_t N, typename E, typename S>
+using ArrayScalarMul = ArrayScalarBinaryOp<T, N, E, S, std::multiplies<>>;
+
+//! Array expression for array-scalar division.
+template <typename T, size_t N, typename E, typename S>
+using ArrayScalarDiv = ArrayScalarBinaryOp<T, N, E, S, std::divides<>>;
+
+// MARK: ScalarArrayBinaryOp
+
+//!
+//! \brief Array expression for binary operation between scalar and array.
+//!
+//! \tparam T               Element type.
+//! \tparam N               Dimension.
+//! \tparam S               Scalar type.
+//! \tparam E               Input expression type.
+//! \tparam BinaryOperation Binary operation taking the scalar first.
+//!
+template <typename T, size_t N, typename S, typename E, typename BinaryOperation>
+class ScalarArrayBinaryOp final : public ArrayExpression<T, N, ScalarArrayBinaryOp<T, N, S, E, BinaryOperation>> {
+public:
+  ScalarArrayBinaryOp(const S &s, const E &e) : _s(s), _e(e) {}
+
+  Vector<size_t, N> size() const;
+
+  T operator[](size_t i) const;
+
+private:
+  S _s;
+  E _e;
+  BinaryOperation _op;
+};
+
+//! Array expression for scalar-array multiplication.
+template <typename T, size_t N, typename S, typename E>
+using ScalarArrayMul = ScalarArrayBinaryOp<T, N, S, E, std::multiplies<>>;
+
+// MARK: Operand Traits
+
+//! Returns the expression that refers to \p array.
+template <typename T, size_t N, typename D>
+ArrayExpressionRef<std::remove_const_t<T>, N> makeArrayExpression(const ArrayBase<T, N, D> &array);
+
+//! Returns \p expression as its subclass.
+template <typename T, size_t N, typename D> const D &makeArrayExpression(const ArrayExpression<T, N, D> &expression);
+
+//! Tells whether arrays, array views and array expressions of type \p X can be used in array expressions.
+template <typename X, typename = void> struct IsArrayOperand : std::false_type {};
+
+template <typename X>
+struct IsArrayOperand<X, std::void_t<decltype(makeArrayExpression(std::declval<const X &>()))>> : std::true_type {};
+
+//! Expression type for the operand type \p X.
+template <typename X>
+using ArrayOperandExpression = std::decay_t<decltype(makeArrayExpression(std::declval<const X &>()))>;
+
+//! Enables the operators for two operands of array expressions.
+template <typename A, typename B>
+using EnableIfArrayOperands = std::enable_if_t<IsArrayOperand<A>::value && IsArrayOperand<B>::value, int>;
+
+//! Enables the operators for an operand of array expressions and a scalar.
+template <typename A, typename S>
+using EnableIfArrayScalarOperands = std::enable_if_t<IsArrayOperand<A>::value && std::is_arithmetic<S>::value, int>;
+
+// MARK: Operator Overloadings
+
+template <typename A, std::enable_if_t<IsArrayOperand<A>::value, int> = 0> auto operator-(const A &a);
+
+template <typename A, typename B, EnableIfArrayOperands<A, B> = 0> auto operator+(const A &a, const B &b);
+
+template <typename A, typename B, EnableIfArrayOperands<A, B> = 0> auto operator-(const A &a, const B &b);
+
+template <typename A, typename S, EnableIfArrayScalarOperands<A, S> = 0> auto operator*(const A &a, const S &s);
+
+template <typename S, typename A, EnableIfArrayScalarOperands<A, S> = 0> auto operator*(const S &s, const A &a);
+
+template <typename A, typename S, EnableIfArrayScalarOperands<A, S> = 0> auto operator/(const A &a, const S &s);
+
+} // namespace vox
+} // namespace geometry
+
+#include "array_expression-inl.h"
+
+#endif // INCLUDE_JET_ARRAY_EXPRESSION_H_
@@ -34,6 +34,21 @@ template <typename T, size_t N> struct Lerp<T, N, 1> {
   }
 };
 
+template <typename T, size_t N, size_t I> struct FlatLerp {
+  template <typename ScalarType>
+  static T call(const T *data, const std::array<size_t, N> &steps, const Vector<ScalarType, N> &t, size_t index) {
+    using Next = FlatLerp<T, N, I - 1>;
+    return lerp(Next::call(data, steps, t, index), Next::call(data, steps, t, index + steps[I - 1]), t[I - 1]);
+  }
+};
+
+template <typename T, size_t N> struct FlatLerp<T, N, 1> {
+  template <typename ScalarType>
+  static T call(const T *data, const std::array<size_t, N> &steps, const Vector<ScalarType, N> &t, size_t index) {
+    return lerp(data[index], data[index + steps[0]], t[0]);
+  }
+};
+
 template <typename T, size_t N, size_t I> struct Cubic {
   using ScalarType = typename GetScalarType<T>::value;
 
@@ -196,16 +211,30 @@ LinearArraySampler<T, N> &LinearArraySampler<T, N>::operator=(const LinearArrayS
 }
 
 template <typename T, size_t N> T LinearArraySampler<T, N>::operator()(const VectorType &pt) const {
-  Vector<ssize_t, N> is;
+  // Same as getBarycentric followed by Lerp, but with clamps instead of
+  // branches and flat indices instead of view accessors, so that loops over
+  // many points inline and vectorize well.
+  const Vector<size_t, N> &size = _view.size();
+  if (_view.length() == 0) {
+    return T();
+  }
+
+  std::array<size_t, N> steps;
   Vector<ScalarType, N> ts;
-  VectorType npt = elemMul(pt - _gridOrigin, _invGridSpacing);
-  Vector<ssize_t, N> size = _view.size().template castTo<ssize_t>();
+  size_t index = 0;
+  size_t stride = 1;
 
   for (size_t i = 0; i < N; ++i) {
-    getBarycentric(npt[i], 0, size[i], is[i], ts[i]);
+    const ScalarType x = (pt[i] - _gridOrigin[i]) * _invGridSpacing[i];
+    const bool isFlat = size[i] < 2;
+    const ScalarType s = clamp(std::floor(x), ScalarType(0), static_cast<ScalarType>(isFlat ? 0 : size[i] - 2));
+    ts[i] = isFlat ? ScalarType(0) : clamp(x - s, ScalarType(0), ScalarType(1));
+    index += static_cast<size_t>(s) * stride;
+    steps[i] = isFlat ? 0 : stride;
+    stride *= size[i];
   }
 
-  return internal::Lerp<T, N, N>::call(_view, is, ts);
+  return internal::FlatLerp<T, N, N>::call(_view.data(), steps, ts, index);
 }
 
 template <typename T, size_t N>
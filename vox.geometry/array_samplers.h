@@ -122,7 +122,7 @@ public:
   //! Copy assignment operator.
   LinearArraySampler &operator=(const LinearArraySampler &other);
 
-  //! Returns sampled value at point \p pt.
+  //! Returns sampled value at point \p pt, or zero if the array is empty.
   T operator()(const VectorType &pt) const;
 
   //! Returns the indices of points and their sampling weight for given point.
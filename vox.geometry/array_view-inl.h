@@ -26,7 +26,11 @@ template <size_t M>
 ArrayView<T, N>::ArrayView(typename std::enable_if_t<(M == 1), T *> ptr, size_t size_)
     : ArrayView(ptr, Vector<size_t, N>{size_}) {}
 
-template <typename T, size_t N> ArrayView<T, N>::ArrayView(Array<T, N> &other) : ArrayView() { set(other); }
+template <typename T, size_t N>
+template <typename Allocator>
+ArrayView<T, N>::ArrayView(Array<T, N, Allocator> &other) : ArrayView() {
+  set(other);
+}
 
 template <typename T, size_t N> ArrayView<T, N>::ArrayView(const ArrayView &other) { set(other); }
 
@@ -34,7 +38,9 @@ template <typename T, size_t N> ArrayView<T, N>::ArrayView(ArrayView &&other) no
   *this = std::move(other);
 }
 
-template <typename T, size_t N> void ArrayView<T, N>::set(Array<T, N> &other) {
+template <typename T, size_t N>
+template <typename Allocator>
+void ArrayView<T, N>::set(Array<T, N, Allocator> &other) {
   Base::setPtrAndSize(other.data(), other.size());
 }
 
@@ -71,7 +77,11 @@ template <size_t M>
 ArrayView<const T, N>::ArrayView(typename std::enable_if_t<(M == 1), const T *> ptr, size_t size_)
     : ArrayView(ptr, Vector<size_t, N>{size_}) {}
 
-template <typename T, size_t N> ArrayView<const T, N>::ArrayView(const Array<T, N> &other) : ArrayView() { set(other); }
+template <typename T, size_t N>
+template <typename Allocator>
+ArrayView<const T, N>::ArrayView(const Array<T, N, Allocator> &other) : ArrayView() {
+  set(other);
+}
 
 template <typename T, size_t N> ArrayView<const T, N>::ArrayView(const ArrayView<T, N> &other) { set(other); }
 
@@ -81,7 +91,9 @@ template <typename T, size_t N> ArrayView<const T, N>::ArrayView(ArrayView &&oth
   *this = std::move(other);
 }
 
-template <typename T, size_t N> void ArrayView<const T, N>::set(const Array<T, N> &other) {
+template <typename T, size_t N>
+template <typename Allocator>
+void ArrayView<const T, N>::set(const Array<T, N, Allocator> &other) {
   Base::setPtrAndSize(other.data(), other.size());
 }
 
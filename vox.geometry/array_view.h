@@ -14,7 +14,7 @@ namespace geometry {
 
 template <typename T, size_t N, typename Derived> class ArrayBase;
 
-template <typename T, size_t N> class Array;
+template <typename T, size_t N, typename Allocator> class Array;
 
 // MARK: ArrayView
 
@@ -32,7 +32,7 @@ public:
 
   template <size_t M = N> ArrayView(typename std::enable_if_t<(M == 1), T *> ptr, size_t size_);
 
-  ArrayView(Array<T, N> &other);
+  template <typename Allocator> ArrayView(Array<T, N, Allocator> &other);
 
   ArrayView(const ArrayView &other);
 
@@ -40,7 +40,7 @@ public:
 
   // set
 
-  void set(Array<T, N> &other);
+  template <typename Allocator> void set(Array<T, N, Allocator> &other);
 
   void set(const ArrayView &other);
 
@@ -66,7 +66,7 @@ public:
 
   template <size_t M = N> ArrayView(typename std::enable_if_t<(M == 1), const T *> ptr, size_t size_);
 
-  ArrayView(const Array<T, N> &other);
+  template <typename Allocator> ArrayView(const Array<T, N, Allocator> &other);
 
   ArrayView(const ArrayView<T, N> &other);
 
@@ -76,7 +76,7 @@ public:
 
   // set
 
-  void set(const Array<T, N> &other);
+  template <typename Allocator> void set(const Array<T, N, Allocator> &other);
 
   void set(const ArrayView<T, N> &other);
 
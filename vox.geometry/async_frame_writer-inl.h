@@ -0,0 +1,49 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_ASYNC_FRAME_WRITER_INL_H_
+#define INCLUDE_JET_DETAIL_ASYNC_FRAME_WRITER_INL_H_
+
+#include <utility>
+
+namespace vox {
+namespace geometry {
+
+template <typename T> SnapshotPool<T>::SnapshotPool() : _state(std::make_shared<State>()) {}
+
+template <typename T> std::shared_ptr<const T> SnapshotPool<T>::acquire(const T &state) {
+  std::unique_ptr<T> snapshot;
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (!_state->snapshots.empty()) {
+      snapshot = std::move(_state->snapshots.back());
+      _state->snapshots.pop_back();
+    }
+  }
+
+  if (snapshot) {
+    *snapshot = state;
+  } else {
+    snapshot = std::make_unique<T>(state);
+  }
+
+  // The deleter keeps the pool state alive, so the pool can be destroyed before the snapshots
+  std::shared_ptr<State> poolState = _state;
+  return std::shared_ptr<const T>(snapshot.release(), [poolState](const T *released) {
+    std::lock_guard<std::mutex> lock(poolState->mutex);
+    poolState->snapshots.emplace_back(const_cast<T *>(released));
+  });
+}
+
+template <typename T> size_t SnapshotPool<T>::numberOfAvailableSnapshots() const {
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  return _state->snapshots.size();
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_ASYNC_FRAME_WRITER_INL_H_
@@ -0,0 +1,124 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "common.h"
+
+#include "async_frame_writer.h"
+
+#include <utility>
+
+namespace vox {
+namespace geometry {
+
+AsyncFrameWriter::AsyncFrameWriter(size_t maxPendingFrames, size_t numberOfWorkers)
+    : _maxPendingFrames(maxPendingFrames) {
+  JET_THROW_INVALID_ARG_IF(maxPendingFrames == 0);
+  JET_THROW_INVALID_ARG_IF(numberOfWorkers == 0);
+
+  for (size_t i = 0; i < numberOfWorkers; ++i) {
+    _workers.emplace_back([this]() { run(); });
+  }
+}
+
+AsyncFrameWriter::~AsyncFrameWriter() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _isStopping = true;
+  }
+  _jobQueued.notify_all();
+
+  // The workers finish the queued jobs before they exit
+  for (auto &worker : _workers) {
+    worker.join();
+  }
+}
+
+void AsyncFrameWriter::submit(const SnapshotFunc &snapshot) {
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _jobFinished.wait(lock, [this]() { return _numberOfPendingFrames < _maxPendingFrames || _error; });
+    rethrowError(lock);
+    ++_numberOfPendingFrames;
+  }
+
+  Job job;
+  try {
+    job = snapshot();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_numberOfPendingFrames;
+    _jobFinished.notify_all();
+    throw;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _jobs.push_back(std::move(job));
+  }
+  _jobQueued.notify_one();
+}
+
+void AsyncFrameWriter::flush() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  _jobFinished.wait(lock, [this]() { return _numberOfPendingFrames == 0; });
+  rethrowError(lock);
+}
+
+size_t AsyncFrameWriter::maxPendingFrames() const { return _maxPendingFrames; }
+
+size_t AsyncFrameWriter::numberOfWorkers() const { return _workers.size(); }
+
+size_t AsyncFrameWriter::numberOfPendingFrames() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _numberOfPendingFrames;
+}
+
+void AsyncFrameWriter::run() {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _jobQueued.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+      if (_jobs.empty()) {
+        return;
+      }
+      job = std::move(_jobs.front());
+      _jobs.pop_front();
+    }
+
+    std::exception_ptr error;
+    try {
+      if (job) {
+        job();
+      }
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    // Releases the snapshot held by the job before the frame stops being pending
+    job = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      if (error && !_error) {
+        _error = error;
+      }
+      --_numberOfPendingFrames;
+    }
+    _jobFinished.notify_all();
+  }
+}
+
+void AsyncFrameWriter::rethrowError(std::unique_lock<std::mutex> &lock) {
+  if (_error) {
+    std::exception_ptr error = std::exchange(_error, nullptr);
+    lock.unlock();
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace vox
+} // namespace geometry
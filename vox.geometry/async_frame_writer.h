@@ -0,0 +1,133 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ASYNC_FRAME_WRITER_H_
+#define INCLUDE_JET_ASYNC_FRAME_WRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief Writes simulation output on background threads.
+//!
+//! Each frame is submitted as a snapshot function, which copies the state on
+//! the simulation thread and returns the job that encodes and writes the copy.
+//! The jobs run on worker threads while the simulation computes the next
+//! frame. At most maxPendingFrames() snapshots exist at a time; submit()
+//! blocks until a job finishes when that many are pending, which bounds the
+//! memory and slows the simulation down to the speed of the output.
+//!
+//! With a single worker, the jobs run in the order they were submitted.
+//!
+class AsyncFrameWriter {
+public:
+  //! Job that encodes and writes a snapshot.
+  using Job = std::function<void()>;
+
+  //! Function that snapshots the state and returns the job writing it.
+  using SnapshotFunc = std::function<Job()>;
+
+  //! Default number of pending frames, which double-buffers the output.
+  static constexpr size_t kDefaultMaxPendingFrames = 2;
+
+  //! Starts \p numberOfWorkers threads which write up to \p maxPendingFrames frames.
+  explicit AsyncFrameWriter(size_t maxPendingFrames = kDefaultMaxPendingFrames, size_t numberOfWorkers = 1);
+
+  AsyncFrameWriter(const AsyncFrameWriter &) = delete;
+
+  //! Waits for the pending frames and stops the workers.
+  ~AsyncFrameWriter();
+
+  AsyncFrameWriter &operator=(const AsyncFrameWriter &) = delete;
+
+  //!
+  //! \brief Snapshots a frame and queues the job writing it.
+  //!
+  //! Blocks while maxPendingFrames() frames are pending, then calls
+  //! \p snapshot on the calling thread. If a previous job has thrown, the
+  //! exception is rethrown here instead.
+  //!
+  void submit(const SnapshotFunc &snapshot);
+
+  //! Waits for all the pending frames and rethrows the first exception of the jobs, if any.
+  void flush();
+
+  //! Returns the maximum number of frames being snapshotted, queued or written.
+  [[nodiscard]] size_t maxPendingFrames() const;
+
+  //! Returns the number of worker threads.
+  [[nodiscard]] size_t numberOfWorkers() const;
+
+  //! Returns the number of frames being snapshotted, queued or written.
+  [[nodiscard]] size_t numberOfPendingFrames() const;
+
+private:
+  size_t _maxPendingFrames;
+  size_t _numberOfPendingFrames = 0;
+  bool _isStopping = false;
+  std::deque<Job> _jobs;
+  std::exception_ptr _error;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _jobQueued;
+  std::condition_variable _jobFinished;
+  std::vector<std::thread> _workers;
+
+  void run();
+
+  void rethrowError(std::unique_lock<std::mutex> &lock);
+};
+
+//! Shared pointer type for the AsyncFrameWriter.
+using AsyncFrameWriterPtr = std::shared_ptr<AsyncFrameWriter>;
+
+//!
+//! \brief Reusable copies of a simulation state.
+//!
+//! The copies are returned to the pool when the last reference to them is
+//! released, so writing through an AsyncFrameWriter alternates between
+//! maxPendingFrames() copies instead of allocating one per frame. Copying
+//! into a released copy reuses the storage of its arrays, but members that
+//! are cloned on assignment are still allocated, such as the neighbor
+//! searcher of ParticleSystemData.
+//!
+//! \tparam T Copy-assignable state type, such as ParticleSystemData3 or CellCenteredScalarGrid3.
+//!
+template <typename T> class SnapshotPool {
+public:
+  //! Constructs an empty pool.
+  SnapshotPool();
+
+  //! Returns a copy of \p state, reusing a released copy if there is one.
+  std::shared_ptr<const T> acquire(const T &state);
+
+  //! Returns the number of released copies.
+  [[nodiscard]] size_t numberOfAvailableSnapshots() const;
+
+private:
+  struct State {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<T>> snapshots;
+  };
+
+  std::shared_ptr<State> _state;
+};
+
+} // namespace vox
+} // namespace geometry
+
+#include "async_frame_writer-inl.h"
+
+#endif // INCLUDE_JET_ASYNC_FRAME_WRITER_H_
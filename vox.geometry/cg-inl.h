@@ -8,11 +8,135 @@
 #define INCLUDE_JET_DETAIL_CG_INL_H_
 
 #include "constants.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <utility>
 
 namespace vox {
 namespace geometry {
 
+namespace internal {
+
+// Number of elements processed per pair in the fused dot-product kernel. The
+// blocks of all the vectors stay in cache while the pairs are accumulated.
+constexpr size_t kCgBlockDotSize = 1024;
+
+//
+// Computes the dot products of the given vector pairs with a single parallel
+// reduction and a single pass over memory. The vectors must store their
+// elements contiguously between begin() and end().
+//
+template <typename VectorType>
+std::vector<double> cgBlockDot(const std::vector<std::pair<const VectorType *, const VectorType *>> &pairs) {
+  const size_t numberOfPairs = pairs.size();
+  if (numberOfPairs == 0) {
+    return {};
+  }
+
+  const size_t n = static_cast<size_t>(pairs.front().first->end() - pairs.front().first->begin());
+  std::vector<std::pair<const double *, const double *>> data(numberOfPairs);
+  for (size_t p = 0; p < numberOfPairs; ++p) {
+    data[p] = {&*pairs[p].first->begin(), &*pairs[p].second->begin()};
+  }
+
+  return parallelReduce(
+      kZeroSize, n, std::vector<double>(numberOfPairs, 0.0),
+      [&](size_t begin, size_t end, std::vector<double> sums) {
+        for (size_t blockBegin = begin; blockBegin < end; blockBegin += kCgBlockDotSize) {
+          const size_t blockEnd = std::min(blockBegin + kCgBlockDotSize, end);
+          for (size_t p = 0; p < numberOfPairs; ++p) {
+            const double *a = data[p].first;
+            const double *b = data[p].second;
+            double sum = 0.0;
+            for (size_t i = blockBegin; i < blockEnd; ++i) {
+              sum += a[i] * b[i];
+            }
+            sums[p] += sum;
+          }
+        }
+        return sums;
+      },
+      [](std::vector<double> a, const std::vector<double> &b) {
+        for (size_t p = 0; p < a.size(); ++p) {
+          a[p] += b[p];
+        }
+        return a;
+      });
+}
+
+// In-place Cholesky factorization of the n x n row-major SPD matrix. Returns
+// false if the matrix is not numerically positive definite.
+inline bool cgCholesky(std::vector<double> *a, size_t n) {
+  std::vector<double> &l = *a;
+  for (size_t j = 0; j < n; ++j) {
+    double diag = l[j * n + j];
+    for (size_t k = 0; k < j; ++k) {
+      diag -= l[j * n + k] * l[j * n + k];
+    }
+    if (!(diag > kEpsilonD * std::fabs(l[j * n + j]))) {
+      return false;
+    }
+    l[j * n + j] = std::sqrt(diag);
+
+    for (size_t i = j + 1; i < n; ++i) {
+      double sum = l[i * n + j];
+      for (size_t k = 0; k < j; ++k) {
+        sum -= l[i * n + k] * l[j * n + k];
+      }
+      l[i * n + j] = sum / l[j * n + j];
+    }
+  }
+  return true;
+}
+
+// Solves L L^T x = b in-place with the factor from cgCholesky.
+inline void cgCholeskySolve(const std::vector<double> &l, size_t n, double *b) {
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t k = 0; k < i; ++k) {
+      b[i] -= l[i * n + k] * b[k];
+    }
+    b[i] /= l[i * n + i];
+  }
+  for (size_t i = n; i-- > 0;) {
+    for (size_t k = i + 1; k < n; ++k) {
+      b[i] -= l[k * n + i] * b[k];
+    }
+    b[i] /= l[i * n + i];
+  }
+}
+
+// Estimates the largest eigenvalue of A with a few power iterations from a
+// pseudo-random start vector.
+template <typename BlasType>
+double cgEstimateMaxEigenvalue(const typename BlasType::MatrixType &A, typename BlasType::VectorType *v,
+                               typename BlasType::VectorType *w) {
+  constexpr unsigned int kNumberOfPowerIterations = 10;
+
+  uint32_t seed = 12345u;
+  for (double &e : *v) {
+    seed = seed * 1664525u + 1013904223u;
+    e = static_cast<double>(seed >> 8) / static_cast<double>(1u << 24) - 0.5;
+  }
+
+  double lambda = 0.0;
+  for (unsigned int iter = 0; iter < kNumberOfPowerIterations; ++iter) {
+    const double norm = BlasType::l2Norm(*v);
+    if (norm <= 0.0) {
+      break;
+    }
+    BlasType::mvm(A, *v, w);
+    lambda = BlasType::dot(*v, *w) / (norm * norm);
+    std::swap(*v, *w);
+  }
+
+  return lambda;
+}
+
+} // namespace internal
+
 template <typename BlasType, typename PrecondType>
 void pcg(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &b,
          unsigned int maxNumberOfIterations, double tolerance, PrecondType *M, typename BlasType::VectorType *x,
@@ -94,6 +218,376 @@ void cg(const typename BlasType::MatrixType &A, const typename BlasType::VectorT
                              lastResidualNorm);
 }
 
+template <typename BlasType>
+void sStepCg(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &b,
+             unsigned int maxNumberOfIterations, double tolerance, unsigned int sStepSize,
+             typename BlasType::VectorType *x, typename BlasType::VectorType *r,
+             std::vector<typename BlasType::VectorType> *workspace, unsigned int *lastNumberOfIterations,
+             double *lastResidualNorm) {
+  using VectorType = typename BlasType::VectorType;
+  using Pairs = std::vector<std::pair<const VectorType *, const VectorType *>>;
+
+  size_t s = std::max(sStepSize, 1u);
+
+  // Workspace layout: basis V_0..V_s, previous directions Q, A * Q and the
+  // new A * P.
+  workspace->assign(4 * s + 1, b);
+  VectorType *v = workspace->data();
+  VectorType *q = v + s + 1;
+  VectorType *aq = q + s;
+  VectorType *ap = aq + s;
+
+  // The basis is the Chebyshev polynomials of A over [0, lambdaMax], which
+  // stays far better conditioned than the monomial one.
+  const double lambdaMax = 1.1 * internal::cgEstimateMaxEigenvalue<BlasType>(A, &v[0], &v[1]);
+  const double c = 0.5 * lambdaMax;
+  const double h = 0.5 * lambdaMax;
+
+  BlasType::residual(A, *x, b, r);
+
+  // Factor of W = Q^T A Q of the previous outer step
+  std::vector<double> wFactor;
+  size_t numberOfDirections = 0;
+
+  // Squared residual reduction that triggers a restart
+  constexpr double kRestartReduction = 1e-8;
+
+  unsigned int iter = 0;
+  unsigned int lastResidualUpdate = 0;
+  double sigma = 0.0;
+  double sigmaAtRestart = BlasType::dot(*r, *r);
+
+  while (true) {
+    const size_t sk = std::min(s, static_cast<size_t>(std::max(maxNumberOfIterations, iter + 1) - iter));
+
+    // Basis V_0..V_sk. Only matrix-vector products, no reductions.
+    BlasType::set(*r, &v[0]);
+    for (size_t j = 0; j < sk; ++j) {
+      BlasType::mvm(A, v[j], &v[j + 1]);
+      BlasType::axpy(-c, v[j], v[j + 1], &v[j + 1]);
+      if (j == 0) {
+        BlasType::axpy(1.0 / h - 1.0, v[1], v[1], &v[1]);
+      } else {
+        BlasType::axpy(2.0 / h - 1.0, v[j + 1], v[j + 1], &v[j + 1]);
+        BlasType::axpy(-1.0, v[j - 1], v[j + 1], &v[j + 1]);
+      }
+    }
+
+    // A * V_j = sum_i V_i T_ij for j < sk
+    const size_t m = sk + 1;
+    std::vector<double> t(m * sk, 0.0);
+    for (size_t j = 0; j < sk; ++j) {
+      t[j * sk + j] = c;
+      t[(j + 1) * sk + j] = (j == 0) ? h : 0.5 * h;
+      if (j > 0) {
+        t[(j - 1) * sk + j] = 0.5 * h;
+      }
+    }
+
+    // Single block reduction: Gram matrix of V and (A Q)^T V
+    Pairs pairs;
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = i; j < m; ++j) {
+        pairs.emplace_back(&v[i], &v[j]);
+      }
+    }
+    for (size_t i = 0; i < numberOfDirections; ++i) {
+      for (size_t j = 0; j < sk; ++j) {
+        pairs.emplace_back(&aq[i], &v[j]);
+      }
+    }
+    const std::vector<double> dots = internal::cgBlockDot<VectorType>(pairs);
+
+    std::vector<double> gram(m * m);
+    size_t idx = 0;
+    for (size_t i = 0; i < m; ++i) {
+      for (size_t j = i; j < m; ++j) {
+        gram[i * m + j] = gram[j * m + i] = dots[idx++];
+      }
+    }
+    std::vector<double> cq(dots.begin() + static_cast<std::ptrdiff_t>(idx), dots.end());
+
+    sigma = gram[0];
+    if (sigma <= square(tolerance) || iter >= maxNumberOfIterations) {
+      break;
+    }
+
+    // Rounding errors of the block update scale with the residual the
+    // directions were built from. Once the residual dropped by several orders
+    // of magnitude, replace it with the true one and restart the recurrence.
+    if (numberOfDirections > 0 && sigma < kRestartReduction * sigmaAtRestart) {
+      BlasType::residual(A, *x, b, r);
+      sigmaAtRestart = BlasType::dot(*r, *r);
+      lastResidualUpdate = iter;
+      numberOfDirections = 0;
+      continue;
+    }
+
+    // G = R^T A R and the moments R^T r
+    std::vector<double> g(sk * sk, 0.0);
+    std::vector<double> moments(sk);
+    for (size_t i = 0; i < sk; ++i) {
+      for (size_t j = 0; j < sk; ++j) {
+        for (size_t l = 0; l < m; ++l) {
+          g[i * sk + j] += gram[i * m + l] * t[l * sk + j];
+        }
+      }
+      moments[i] = gram[i * m];
+    }
+
+    // A-orthogonalize against the previous block: B = -W^-1 (A Q)^T R
+    std::vector<double> bq(numberOfDirections * sk);
+    for (size_t j = 0; j < sk; ++j) {
+      std::vector<double> col(numberOfDirections);
+      for (size_t i = 0; i < numberOfDirections; ++i) {
+        col[i] = cq[i * sk + j];
+      }
+      internal::cgCholeskySolve(wFactor, numberOfDirections, col.data());
+      for (size_t i = 0; i < numberOfDirections; ++i) {
+        bq[i * sk + j] = -col[i];
+      }
+    }
+
+    // W = G + ((A Q)^T R)^T B
+    std::vector<double> w = g;
+    for (size_t i = 0; i < sk; ++i) {
+      for (size_t j = 0; j < sk; ++j) {
+        for (size_t l = 0; l < numberOfDirections; ++l) {
+          w[i * sk + j] += cq[l * sk + i] * bq[l * sk + j];
+        }
+      }
+    }
+    for (size_t i = 0; i < sk; ++i) {
+      for (size_t j = 0; j < i; ++j) {
+        w[i * sk + j] = w[j * sk + i] = 0.5 * (w[i * sk + j] + w[j * sk + i]);
+      }
+    }
+
+    if (!internal::cgCholesky(&w, sk)) {
+      // The basis became numerically dependent. Restart from the true
+      // residual, and shrink the step if that does not help.
+      if (numberOfDirections == 0) {
+        if (s == 1) {
+          break;
+        }
+        --s;
+      }
+      BlasType::residual(A, *x, b, r);
+      sigmaAtRestart = BlasType::dot(*r, *r);
+      lastResidualUpdate = iter;
+      numberOfDirections = 0;
+      continue;
+    }
+
+    // P = R + Q B, A P = V T + A Q B
+    for (size_t j = 0; j < sk; ++j) {
+      BlasType::set(0.0, &ap[j]);
+      for (size_t l = 0; l < m; ++l) {
+        if (t[l * sk + j] != 0.0) {
+          BlasType::axpy(t[l * sk + j], v[l], ap[j], &ap[j]);
+        }
+      }
+      for (size_t i = 0; i < numberOfDirections; ++i) {
+        BlasType::axpy(bq[i * sk + j], aq[i], ap[j], &ap[j]);
+      }
+    }
+    for (size_t j = 0; j < sk; ++j) {
+      for (size_t i = 0; i < numberOfDirections; ++i) {
+        BlasType::axpy(bq[i * sk + j], q[i], v[j], &v[j]);
+      }
+    }
+
+    // a = W^-1 R^T r, x += P a, r -= A P a
+    internal::cgCholeskySolve(w, sk, moments.data());
+    for (size_t j = 0; j < sk; ++j) {
+      BlasType::axpy(moments[j], v[j], *x, x);
+      BlasType::axpy(-moments[j], ap[j], *r, r);
+    }
+
+    // The new directions become the previous block
+    for (size_t j = 0; j < sk; ++j) {
+      std::swap(q[j], v[j]);
+      std::swap(aq[j], ap[j]);
+    }
+    wFactor = std::move(w);
+    numberOfDirections = sk;
+    iter += static_cast<unsigned int>(sk);
+
+    // Refresh the recursively updated residual from time to time
+    if (iter - lastResidualUpdate >= 50) {
+      BlasType::residual(A, *x, b, r);
+      lastResidualUpdate = iter;
+    }
+  }
+
+  *lastNumberOfIterations = iter;
+  *lastResidualNorm = std::sqrt(std::fabs(sigma));
+}
+
+template <typename BlasType>
+void deflatedCg(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &b,
+                const std::vector<typename BlasType::VectorType> &modes, unsigned int maxNumberOfIterations,
+                double tolerance, typename BlasType::VectorType *x, typename BlasType::VectorType *r,
+                typename BlasType::VectorType *d, typename BlasType::VectorType *q,
+                std::vector<typename BlasType::VectorType> *workspace, unsigned int *lastNumberOfIterations,
+                double *lastResidualNorm) {
+  using VectorType = typename BlasType::VectorType;
+  using Pairs = std::vector<std::pair<const VectorType *, const VectorType *>>;
+
+  // Relative size of |A z| / |z| below which a mode is an exact null vector
+  constexpr double kNullModeTolerance = 1e-10;
+
+  // Workspace: projected RHS, null modes, deflation modes and A times them
+  const size_t numberOfModes = modes.size();
+  workspace->assign(1 + 3 * numberOfModes, b);
+  VectorType &rhs = (*workspace)[0];
+  VectorType *nullModes = workspace->data() + 1;
+  VectorType *defModes = nullModes + numberOfModes;
+  VectorType *aDefModes = defModes + numberOfModes;
+
+  // Scale of A seen from the RHS, used to detect the exact null modes
+  BlasType::mvm(A, b, q);
+  const double bNorm = BlasType::l2Norm(b);
+  const double aScale = (bNorm > 0.0) ? BlasType::l2Norm(*q) / bNorm : 0.0;
+
+  size_t numberOfNullModes = 0;
+  size_t numberOfDefModes = 0;
+  for (const VectorType &z : modes) {
+    const double zNorm = BlasType::l2Norm(z);
+    if (zNorm <= 0.0) {
+      continue;
+    }
+
+    BlasType::mvm(A, z, q);
+    if (BlasType::l2Norm(*q) <= kNullModeTolerance * aScale * zNorm) {
+      // Orthonormalize against the null modes found so far
+      VectorType &n = nullModes[numberOfNullModes];
+      BlasType::set(z, &n);
+      for (size_t k = 0; k < numberOfNullModes; ++k) {
+        BlasType::axpy(-BlasType::dot(nullModes[k], n), nullModes[k], n, &n);
+      }
+      const double nNorm = BlasType::l2Norm(n);
+      if (nNorm > kNullModeTolerance * zNorm) {
+        BlasType::axpy(1.0 / nNorm - 1.0, n, n, &n);
+        ++numberOfNullModes;
+      }
+    } else {
+      BlasType::set(z, &defModes[numberOfDefModes]);
+      BlasType::set(*q, &aDefModes[numberOfDefModes]);
+      ++numberOfDefModes;
+    }
+  }
+
+  auto project = [&](VectorType *v) {
+    for (size_t k = 0; k < numberOfNullModes; ++k) {
+      BlasType::axpy(-BlasType::dot(nullModes[k], *v), nullModes[k], *v, v);
+    }
+  };
+
+  // Coarse operator E = Z^T A Z
+  const size_t nd = numberOfDefModes;
+  std::vector<double> eFactor(nd * nd);
+  {
+    Pairs pairs;
+    for (size_t i = 0; i < nd; ++i) {
+      for (size_t j = 0; j < nd; ++j) {
+        pairs.emplace_back(&defModes[i], &aDefModes[j]);
+      }
+    }
+    const std::vector<double> e = internal::cgBlockDot<VectorType>(pairs);
+    for (size_t i = 0; i < nd; ++i) {
+      for (size_t j = 0; j < nd; ++j) {
+        eFactor[i * nd + j] = 0.5 * (e[i * nd + j] + e[j * nd + i]);
+      }
+    }
+  }
+  if (!internal::cgCholesky(&eFactor, nd)) {
+    // Dependent deflation modes, run without them
+    numberOfDefModes = 0;
+  }
+
+  // Returns E^-1 (A Z)^T v, given the dot products (A Z)^T v
+  auto coarseSolve = [&](std::vector<double> c) {
+    internal::cgCholeskySolve(eFactor, numberOfDefModes, c.data());
+    return c;
+  };
+
+  BlasType::set(b, &rhs);
+  project(&rhs);
+
+  // x = x + Z E^-1 Z^T r so that Z^T r = 0
+  BlasType::residual(A, *x, rhs, r);
+  if (numberOfDefModes > 0) {
+    Pairs pairs;
+    for (size_t i = 0; i < numberOfDefModes; ++i) {
+      pairs.emplace_back(&defModes[i], r);
+    }
+    const std::vector<double> mu = coarseSolve(internal::cgBlockDot<VectorType>(pairs));
+    for (size_t i = 0; i < numberOfDefModes; ++i) {
+      BlasType::axpy(mu[i], defModes[i], *x, x);
+    }
+    BlasType::residual(A, *x, rhs, r);
+  }
+  project(r);
+
+  // Fused reduction of r.r and (A Z)^T r. Returns r.r.
+  std::vector<double> mu;
+  auto reduceResidual = [&]() {
+    Pairs pairs{{r, r}};
+    for (size_t i = 0; i < numberOfDefModes; ++i) {
+      pairs.emplace_back(&aDefModes[i], r);
+    }
+    std::vector<double> dots = internal::cgBlockDot<VectorType>(pairs);
+    const double rr = dots[0];
+    dots.erase(dots.begin());
+    mu = coarseSolve(std::move(dots));
+    return rr;
+  };
+
+  // d = r - Z E^-1 (A Z)^T r
+  double sigmaNew = reduceResidual();
+  BlasType::set(*r, d);
+  for (size_t i = 0; i < numberOfDefModes; ++i) {
+    BlasType::axpy(-mu[i], defModes[i], *d, d);
+  }
+
+  unsigned int iter = 0;
+  while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
+    // q = Ad
+    BlasType::mvm(A, *d, q);
+
+    // alpha = sigmaNew/d.q
+    double alpha = sigmaNew / BlasType::dot(*d, *q);
+
+    BlasType::axpy(alpha, *d, *x, x);
+
+    if (iter % 50 == 0 && iter > 0) {
+      BlasType::residual(A, *x, rhs, r);
+      project(r);
+    } else {
+      BlasType::axpy(-alpha, *q, *r, r);
+    }
+
+    double sigmaOld = sigmaNew;
+    sigmaNew = reduceResidual();
+
+    // d = beta * d + r - Z mu
+    double beta = sigmaNew / sigmaOld;
+    BlasType::axpy(beta, *d, *r, d);
+    for (size_t i = 0; i < numberOfDefModes; ++i) {
+      BlasType::axpy(-mu[i], defModes[i], *d, d);
+    }
+
+    ++iter;
+  }
+
+  // Minimum-norm solution with respect to the null modes
+  project(x);
+
+  *lastNumberOfIterations = iter;
+  *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
+}
+
 } // namespace vox
 } // namespace geometry
 
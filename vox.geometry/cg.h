@@ -9,6 +9,8 @@
 
 #include "blas.h"
 
+#include <vector>
+
 namespace vox {
 namespace geometry {
 
@@ -42,6 +44,56 @@ void pcg(const typename BlasType::MatrixType &A, const typename BlasType::Vector
          typename BlasType::VectorType *r, typename BlasType::VectorType *d, typename BlasType::VectorType *q,
          typename BlasType::VectorType *s, unsigned int *lastNumberOfIterations, double *lastResidualNorm);
 
+//!
+//! \brief Solves s-step (communication-avoiding) conjugate gradient.
+//!
+//! Each outer iteration builds a Krylov basis of degree s from the residual
+//! with s matrix-vector products and computes all the inner products it needs
+//! in a single fused reduction, instead of two reductions per CG step. The
+//! basis uses Chebyshev polynomials over an estimate of the spectrum, but its
+//! conditioning still grows with s, so \p sStepSize should be kept small (2
+//! to 5). The outer iteration restarts from the true residual whenever the
+//! residual dropped by several orders of magnitude, and falls back to a
+//! smaller step size if the basis becomes numerically dependent. The method
+//! trades extra vector updates for fewer global synchronizations, which pays
+//! off when reductions are expensive (many threads or distributed memory).
+//!
+//! \param workspace Work vectors. Resized to 4 * sStepSize + 1 vectors shaped
+//!                  like \p b.
+//! \param lastNumberOfIterations Number of CG steps, i.e. s per outer step.
+//!
+template <typename BlasType>
+void sStepCg(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &b,
+             unsigned int maxNumberOfIterations, double tolerance, unsigned int sStepSize,
+             typename BlasType::VectorType *x, typename BlasType::VectorType *r,
+             std::vector<typename BlasType::VectorType> *workspace, unsigned int *lastNumberOfIterations,
+             double *lastResidualNorm);
+
+//!
+//! \brief Solves deflated conjugate gradient.
+//!
+//! The given \p modes span a subspace of (near) null-space vectors, such as
+//! the constant vector for the pressure Poisson equation in a closed domain.
+//! Modes with A z ~ 0 are exact null-space vectors: they are projected out of
+//! the RHS and the residual so that CG converges to the minimum-norm solution
+//! even when the RHS is slightly inconsistent. The other modes are deflated
+//! with the coarse operator E = Z^T A Z, which removes the small eigenvalues
+//! they carry from the spectrum seen by CG. The deflation inner products are
+//! fused with the residual norm, so an iteration still has two reductions.
+//!
+//! \see Saad, Yousef, et al. "A deflated version of the conjugate gradient
+//!      algorithm." SIAM Journal on Scientific Computing 21.5 (2000).
+//!
+//! \param workspace Work vectors. Resized as needed.
+//!
+template <typename BlasType>
+void deflatedCg(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &b,
+                const std::vector<typename BlasType::VectorType> &modes, unsigned int maxNumberOfIterations,
+                double tolerance, typename BlasType::VectorType *x, typename BlasType::VectorType *r,
+                typename BlasType::VectorType *d, typename BlasType::VectorType *q,
+                std::vector<typename BlasType::VectorType> *workspace, unsigned int *lastNumberOfIterations,
+                double *lastResidualNorm);
+
 } // namespace vox
 } // namespace geometry
 
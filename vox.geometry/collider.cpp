@@ -7,6 +7,7 @@
 #include "common.h"
 
 #include "collider.h"
+#include "solver_checkpoint.h"
 
 #include <algorithm>
 
@@ -114,6 +115,28 @@ template <size_t N> void Collider<N>::setOnBeginUpdateCallback(const OnBeginUpda
   _onUpdateCallback = callback;
 }
 
+template <size_t N>
+void Collider<N>::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  checkpoint->setValue(prefix + "frictionCoefficient", _frictionCoefficient);
+
+  if (_surface != nullptr) {
+    checkpoint->setValue(prefix + "translation", _surface->transform.translation());
+    checkpoint->setValue(prefix + "rotation", _surface->transform.orientation().rotation());
+  }
+}
+
+template <size_t N> void Collider<N>::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  _frictionCoefficient = checkpoint.value<double>(prefix + "frictionCoefficient");
+
+  if (_surface != nullptr) {
+    using Rotation = std::decay_t<decltype(_surface->transform.orientation().rotation())>;
+
+    _surface->transform = Transform<N>(checkpoint.value<Vector<double, N>>(prefix + "translation"),
+                                       Orientation<N>(checkpoint.value<Rotation>(prefix + "rotation")));
+    _surface->updateQueryEngine();
+  }
+}
+
 template class Collider<2>;
 
 template class Collider<3>;
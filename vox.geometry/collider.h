@@ -10,10 +10,13 @@
 #include "surface.h"
 
 #include <functional>
+#include <string>
 
 namespace vox {
 namespace geometry {
 
+class SolverCheckpoint;
+
 //!
 //! \brief Abstract base class for generic collider object.
 //!
@@ -82,6 +85,17 @@ public:
   //!
   void setOnBeginUpdateCallback(const OnBeginUpdateCallback &callback);
 
+  //!
+  //! \brief Stores the transform of the surface and the friction into \p checkpoint.
+  //!
+  //! The channel names start with \p prefix. Colliders with their own state
+  //! override this function and call the one of the base class.
+  //!
+  virtual void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const;
+
+  //! Restores the state stored by saveState and updates the query engine of the surface.
+  virtual void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint);
+
 protected:
   //! Internal query result structure.
   struct ColliderQueryResult final {
@@ -6,6 +6,7 @@
 
 #include "../common.h"
 
+#include "../solver_checkpoint.h"
 #include "collider_set.h"
 
 namespace vox {
@@ -47,6 +48,26 @@ template <size_t N> size_t ColliderSet<N>::numberOfColliders() const { return _c
 
 template <size_t N> std::shared_ptr<Collider<N>> ColliderSet<N>::collider(size_t i) const { return _colliders[i]; }
 
+template <size_t N>
+void ColliderSet<N>::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  Collider<N>::saveState(prefix, checkpoint);
+
+  for (size_t i = 0; i < _colliders.length(); ++i) {
+    _colliders[i]->saveState(prefix + std::to_string(i) + ".", checkpoint);
+  }
+}
+
+template <size_t N> void ColliderSet<N>::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  Collider<N>::loadState(prefix, checkpoint);
+
+  for (size_t i = 0; i < _colliders.length(); ++i) {
+    _colliders[i]->loadState(prefix + std::to_string(i) + ".", checkpoint);
+  }
+
+  // The surface set bounds the moved surfaces of the colliders
+  surface()->updateQueryEngine();
+}
+
 template <size_t N> typename ColliderSet<N>::Builder ColliderSet<N>::builder() { return Builder(); }
 
 template <size_t N>
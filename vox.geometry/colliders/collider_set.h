@@ -40,6 +40,12 @@ public:
   //! Returns collider at index \p i.
   std::shared_ptr<Collider<N>> collider(size_t i) const;
 
+  //! Stores the state of the colliders into \p checkpoint, each with its own prefix.
+  void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state of the colliders stored by saveState.
+  void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) override;
+
   //! Returns builder fox ColliderSet.
   static Builder builder();
 
@@ -6,6 +6,7 @@
 
 #include "../common.h"
 
+#include "../solver_checkpoint.h"
 #include "rigid_body_collider.h"
 
 namespace vox {
@@ -28,6 +29,24 @@ template <size_t N> Vector<double, N> RigidBodyCollider<N>::velocityAt(const Vec
   return linearVelocity + angularVelocity.cross(r);
 }
 
+template <size_t N> void RigidBodyCollider<N>::refitSurface() { surface()->refitQueryEngine(); }
+
+template <size_t N>
+void RigidBodyCollider<N>::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  Collider<N>::saveState(prefix, checkpoint);
+
+  checkpoint->setValue(prefix + "linearVelocity", linearVelocity);
+  checkpoint->setValue(prefix + "angularVelocity", angularVelocity.value);
+}
+
+template <size_t N>
+void RigidBodyCollider<N>::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  Collider<N>::loadState(prefix, checkpoint);
+
+  linearVelocity = checkpoint.value<Vector<double, N>>(prefix + "linearVelocity");
+  angularVelocity.value = checkpoint.value<decltype(angularVelocity.value)>(prefix + "angularVelocity");
+}
+
 template <size_t N> typename RigidBodyCollider<N>::Builder RigidBodyCollider<N>::builder() { return Builder(); }
 
 template <size_t N>
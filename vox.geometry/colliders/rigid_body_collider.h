@@ -67,6 +67,22 @@ public:
   //! Returns the velocity of the collider at given \p point.
   Vector<double, N> velocityAt(const Vector<double, N> &point) const override;
 
+  //!
+  //! \brief Refits the query engine of the surface to its moved geometry.
+  //!
+  //! Rigid motion only needs the surface transform. Call this instead after
+  //! deforming the surface in place, such as the points of an animated
+  //! TriangleMesh3 in the update callback, so that its BVH is refitted
+  //! rather than rebuilt.
+  //!
+  void refitSurface();
+
+  //! Stores the state including the linear and angular velocities into \p checkpoint.
+  void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state stored by saveState.
+  void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) override;
+
   //! Returns builder fox RigidBodyCollider.
   static Builder builder();
 };
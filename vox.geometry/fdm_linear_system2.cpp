@@ -6,6 +6,7 @@
 
 #include "common.h"
 
+#include "array_expression.h"
 #include "array_utils.h"
 #include "fdm_linear_system2.h"
 #include "math_utils.h"
@@ -70,7 +71,7 @@ void FdmBlas2::axpy(double a, const FdmVector2 &x, const FdmVector2 &y, FdmVecto
   JET_THROW_INVALID_ARG_IF(size != y.size());
   JET_THROW_INVALID_ARG_IF(size != result->size());
 
-  parallelForEachIndex(size, [&](size_t i, size_t j) { (*result)(i, j) = a * x(i, j) + y(i, j); });
+  *result = a * x + y;
 }
 
 void FdmBlas2::mvm(const FdmMatrix2 &m, const FdmVector2 &v, FdmVector2 *result) {
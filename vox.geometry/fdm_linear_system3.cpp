@@ -6,6 +6,7 @@
 
 #include "common.h"
 
+#include "array_expression.h"
 #include "array_utils.h"
 #include "fdm_linear_system3.h"
 #include "math_utils.h"
@@ -72,7 +73,7 @@ void FdmBlas3::axpy(double a, const FdmVector3 &x, const FdmVector3 &y, FdmVecto
   JET_THROW_INVALID_ARG_IF(size != y.size());
   JET_THROW_INVALID_ARG_IF(size != result->size());
 
-  parallelForEachIndex(size, [&](size_t i, size_t j, size_t k) { (*result)(i, j, k) = a * x(i, j, k) + y(i, j, k); });
+  *result = a * x + y;
 }
 
 void FdmBlas3::mvm(const FdmMatrix3 &m, const FdmVector3 &v, FdmVector3 *result) {
@@ -161,6 +162,8 @@ void FdmCompressedBlas3::mvm(const MatrixCsrD &m, const VectorND &v, VectorND *r
   });
 }
 
+void FdmCompressedBlas3::mvm(const MatrixSellD &m, const VectorND &v, VectorND *result) { m.mvm(v, result); }
+
 void FdmCompressedBlas3::residual(const MatrixCsrD &a, const VectorND &x, const VectorND &b, VectorND *result) {
   const auto rp = a.rowPointersBegin();
   const auto ci = a.columnIndicesBegin();
@@ -181,6 +184,10 @@ void FdmCompressedBlas3::residual(const MatrixCsrD &a, const VectorND &x, const
   });
 }
 
+void FdmCompressedBlas3::residual(const MatrixSellD &a, const VectorND &x, const VectorND &b, VectorND *result) {
+  a.residual(x, b, result);
+}
+
 double FdmCompressedBlas3::l2Norm(const VectorND &v) { return std::sqrt(v.dot(v)); }
 
 double FdmCompressedBlas3::lInfNorm(const VectorND &v) { return std::fabs(v.absmax()); }
@@ -10,6 +10,7 @@
 #include "array.h"
 #include "matrix.h"
 #include "matrix_csr.h"
+#include "matrix_sell.h"
 
 namespace vox {
 namespace geometry {
@@ -134,9 +135,15 @@ struct FdmCompressedBlas3 {
   //! Performs matrix-vector multiplication.
   static void mvm(const MatrixType &m, const VectorType &v, VectorType *result);
 
+  //! Performs matrix-vector multiplication with SELL-C-sigma matrix.
+  static void mvm(const MatrixSellD &m, const VectorType &v, VectorType *result);
+
   //! Computes residual vector (b - ax).
   static void residual(const MatrixType &a, const VectorType &x, const VectorType &b, VectorType *result);
 
+  //! Computes residual vector (b - ax) with SELL-C-sigma matrix.
+  static void residual(const MatrixSellD &a, const VectorType &x, const VectorType &b, VectorType *result);
+
   //! Returns L2-norm of the given vector \p v.
   static ScalarType l2Norm(const VectorType &v);
 
@@ -144,6 +151,17 @@ struct FdmCompressedBlas3 {
   static ScalarType lInfNorm(const VectorType &v);
 };
 
+//!
+//! \brief BLAS operator wrapper for compressed 3-D finite differencing with
+//!        SELL-C-sigma system matrix.
+//!
+//! Vector operations are shared with FdmCompressedBlas3. Only the matrix type
+//! differs so that the CG-family solvers can run on the SIMD-friendly format.
+//!
+struct FdmCompressedSellBlas3 : public FdmCompressedBlas3 {
+  using MatrixType = MatrixSellD;
+};
+
 } // namespace vox
 } // namespace geometry
 
@@ -40,6 +40,35 @@ public:
 
   //! Solves the given compressed linear system.
   virtual bool solveCompressed(FdmCompressedLinearSystem3 *) { return false; }
+
+  //! Returns true if the solver starts from the solution vector passed in.
+  [[nodiscard]] bool useWarmStart() const { return _useWarmStart; }
+
+  //!
+  //! \brief Sets true to start from the solution vector passed in.
+  //!
+  //! Krylov solvers such as CG reset the solution vector to zero before the
+  //! iterations by default. With warm start, the given vector is used as the
+  //! initial guess instead. Relaxation solvers always start from the given
+  //! vector.
+  //!
+  void setUseWarmStart(bool useWarmStart) { _useWarmStart = useWarmStart; }
+
+  //! Returns true if the matrix is marked unchanged since the last solve.
+  [[nodiscard]] bool isMatrixUnchanged() const { return _isMatrixUnchanged; }
+
+  //!
+  //! \brief Marks the matrix as unchanged since the last solve.
+  //!
+  //! When set, solvers skip the setup that only depends on the matrix, such
+  //! as the incomplete Cholesky factorization or the matrix format
+  //! conversion, and reuse the one from the previous solve.
+  //!
+  void setMatrixUnchanged(bool isMatrixUnchanged) { _isMatrixUnchanged = isMatrixUnchanged; }
+
+protected:
+  bool _useWarmStart = false;
+  bool _isMatrixUnchanged = false;
 };
 
 //! Shared pointer type for the FdmLinearSystemSolver3.
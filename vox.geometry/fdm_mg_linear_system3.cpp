@@ -11,6 +11,33 @@
 using namespace vox;
 using namespace geometry;
 
+namespace {
+
+// --*--|--*--|--*--|--*--
+//  1/8   3/8   3/8   1/8
+//           to
+// -----|-----*-----|-----
+const std::array<double, 4> kRestrictionKernel = {{0.125, 0.375, 0.375, 0.125}};
+
+// Writes the residual of the k-th plane into the x-major buffer r.
+void computeResidualPlane(const FdmMatrix3 &a, const FdmVector3 &x, const FdmVector3 &b, size_t k, double *r) {
+  const Vector3UZ size = a.size();
+
+  for (size_t j = 0; j < size.y; ++j) {
+    for (size_t i = 0; i < size.x; ++i) {
+      r[i + size.x * j] = b(i, j, k) - a(i, j, k).center * x(i, j, k) -
+                          ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
+                          ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
+                          ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
+                          ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
+                          ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
+                          ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+    }
+  }
+}
+
+} // namespace
+
 //
 
 void FdmMgLinearSystem3::clear() {
@@ -38,12 +65,6 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
   JET_ASSERT(finer.size().y == 2 * coarser->size().y);
   JET_ASSERT(finer.size().z == 2 * coarser->size().z);
 
-  // --*--|--*--|--*--|--*--
-  //  1/8   3/8   3/8   1/8
-  //           to
-  // -----|-----*-----|-----
-  static const std::array<double, 4> kernel = {{0.125, 0.375, 0.375, 0.125}};
-
   const Vector3UZ n = coarser->size();
   parallelRangeFor(kZeroSize, n.x, kZeroSize, n.y, kZeroSize, n.z,
                    [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd, size_t kBegin, size_t kEnd) {
@@ -74,7 +95,7 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
                            for (size_t z = 0; z < 4; ++z) {
                              for (size_t y = 0; y < 4; ++y) {
                                for (size_t x = 0; x < 4; ++x) {
-                                 double w = kernel[x] * kernel[y] * kernel[z];
+                                 double w = kRestrictionKernel[x] * kRestrictionKernel[y] * kRestrictionKernel[z];
                                  sum += w * finer(iIndices[x], jIndices[y], kIndices[z]);
                                }
                              }
@@ -86,6 +107,72 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
                    });
 }
 
+void FdmMgUtils3::residualRestrict(const FdmMatrix3 &A, const FdmVector3 &x, const FdmVector3 &b,
+                                   FdmVector3 *coarser) {
+  JET_ASSERT(A.size() == x.size());
+  JET_ASSERT(A.size() == b.size());
+  JET_ASSERT(A.size().x == 2 * coarser->size().x);
+  JET_ASSERT(A.size().y == 2 * coarser->size().y);
+  JET_ASSERT(A.size().z == 2 * coarser->size().z);
+
+  const Vector3UZ fn = A.size();
+  const Vector3UZ n = coarser->size();
+  const size_t planeSize = fn.x * fn.y;
+
+  parallelRangeFor(kZeroSize, n.z, [&](size_t kBegin, size_t kEnd) {
+    // Coarse plane k reads the fine planes 2k-1 to 2k+2, which never collide
+    // modulo 4. Moving to k+1 only needs two new residual planes.
+    std::vector<double> planes(4 * planeSize);
+    std::array<size_t, 4> planeIndices{};
+    planeIndices.fill(kMaxSize);
+
+    auto residualPlane = [&](size_t fk) -> const double * {
+      double *r = planes.data() + (fk % 4) * planeSize;
+      if (planeIndices[fk % 4] != fk) {
+        computeResidualPlane(A, x, b, fk, r);
+        planeIndices[fk % 4] = fk;
+      }
+      return r;
+    };
+
+    std::array<const double *, 4> r{};
+    std::array<size_t, 4> jIndices{};
+    std::array<size_t, 4> iIndices{};
+
+    for (size_t k = kBegin; k < kEnd; ++k) {
+      r[0] = residualPlane((k > 0) ? 2 * k - 1 : 2 * k);
+      r[1] = residualPlane(2 * k);
+      r[2] = residualPlane(2 * k + 1);
+      r[3] = residualPlane((k + 1 < n.z) ? 2 * k + 2 : 2 * k + 1);
+
+      for (size_t j = 0; j < n.y; ++j) {
+        jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
+        jIndices[1] = 2 * j;
+        jIndices[2] = 2 * j + 1;
+        jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+
+        for (size_t i = 0; i < n.x; ++i) {
+          iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
+          iIndices[1] = 2 * i;
+          iIndices[2] = 2 * i + 1;
+          iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+
+          double sum = 0.0;
+          for (size_t dk = 0; dk < 4; ++dk) {
+            for (size_t dj = 0; dj < 4; ++dj) {
+              for (size_t di = 0; di < 4; ++di) {
+                double w = kRestrictionKernel[di] * kRestrictionKernel[dj] * kRestrictionKernel[dk];
+                sum += w * r[dk][iIndices[di] + fn.x * jIndices[dj]];
+              }
+            }
+          }
+          (*coarser)(i, j, k) = sum;
+        }
+      }
+    }
+  });
+}
+
 void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
   JET_ASSERT(finer->size().x == 2 * coarser.size().x);
   JET_ASSERT(finer->size().y == 2 * coarser.size().y);
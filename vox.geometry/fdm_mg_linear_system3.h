@@ -59,6 +59,16 @@ public:
   //! Restricts given finer grid to the coarser grid.
   static void restrict(const FdmVector3 &finer, FdmVector3 *coarser);
 
+  //!
+  //! \brief Computes the residual b - Ax and restricts it to the coarser grid.
+  //!
+  //! The result is the same as FdmBlas3::residual followed by restrict, but
+  //! the fine residual is never stored. It is computed plane by plane into a
+  //! small ring buffer that stays in cache while the coarse planes consume it,
+  //! which saves writing and re-reading one full fine-grid vector.
+  //!
+  static void residualRestrict(const FdmMatrix3 &A, const FdmVector3 &x, const FdmVector3 &b, FdmVector3 *coarser);
+
   //! Corrects given coarser grid to the finer grid.
   static void correct(const FdmVector3 &coarser, FdmVector3 *finer);
 
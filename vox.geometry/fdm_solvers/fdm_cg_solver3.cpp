@@ -12,9 +12,37 @@
 using namespace vox;
 using namespace geometry;
 
-FdmCgSolver3::FdmCgSolver3(unsigned int maxNumberOfIterations, double tolerance)
+namespace {
+
+// Runs the CG variant selected by the solver options.
+template <typename BlasType>
+void runCg(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &b,
+           unsigned int maxNumberOfIterations, double tolerance, unsigned int sStepSize, bool useConstantModeDeflation,
+           typename BlasType::VectorType *x, typename BlasType::VectorType *r, typename BlasType::VectorType *d,
+           typename BlasType::VectorType *q, typename BlasType::VectorType *s,
+           std::vector<typename BlasType::VectorType> *workspace, unsigned int *lastNumberOfIterations,
+           double *lastResidual) {
+  if (useConstantModeDeflation) {
+    std::vector<typename BlasType::VectorType> modes(1, b);
+    BlasType::set(1.0, &modes[0]);
+
+    deflatedCg<BlasType>(A, b, modes, maxNumberOfIterations, tolerance, x, r, d, q, workspace,
+                         lastNumberOfIterations, lastResidual);
+  } else if (sStepSize > 1) {
+    sStepCg<BlasType>(A, b, maxNumberOfIterations, tolerance, sStepSize, x, r, workspace, lastNumberOfIterations,
+                      lastResidual);
+  } else {
+    cg<BlasType>(A, b, maxNumberOfIterations, tolerance, x, r, d, q, s, lastNumberOfIterations, lastResidual);
+  }
+}
+
+} // namespace
+
+FdmCgSolver3::FdmCgSolver3(unsigned int maxNumberOfIterations, double tolerance, bool useSellFormat,
+                           unsigned int sStepSize, bool useConstantModeDeflation)
     : _maxNumberOfIterations(maxNumberOfIterations), _lastNumberOfIterations(0), _tolerance(tolerance),
-      _lastResidual(kMaxD) {}
+      _lastResidual(kMaxD), _useSellFormat(useSellFormat), _sStepSize(sStepSize),
+      _useConstantModeDeflation(useConstantModeDeflation) {}
 
 bool FdmCgSolver3::solve(FdmLinearSystem3 *system) {
   FdmMatrix3 &matrix = system->A;
@@ -32,14 +60,16 @@ bool FdmCgSolver3::solve(FdmLinearSystem3 *system) {
   _q.resize(size);
   _s.resize(size);
 
-  system->x.fill(0.0);
+  if (!_useWarmStart) {
+    system->x.fill(0.0);
+  }
   _r.fill(0.0);
   _d.fill(0.0);
   _q.fill(0.0);
   _s.fill(0.0);
 
-  cg<FdmBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance, &solution, &_r, &_d, &_q, &_s, &_lastNumberOfIterations,
-               &_lastResidual);
+  runCg<FdmBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance, _sStepSize, _useConstantModeDeflation, &solution,
+                  &_r, &_d, &_q, &_s, &_workspace, &_lastNumberOfIterations, &_lastResidual);
 
   return _lastResidual <= _tolerance || _lastNumberOfIterations < _maxNumberOfIterations;
 }
@@ -57,14 +87,27 @@ bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3 *system) {
   _qComp.resize(size);
   _sComp.resize(size);
 
-  system->x.fill(0.0);
+  if (!_useWarmStart) {
+    system->x.fill(0.0);
+  }
   _rComp.fill(0.0);
   _dComp.fill(0.0);
   _qComp.fill(0.0);
   _sComp.fill(0.0);
 
-  cg<FdmCompressedBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance, &solution, &_rComp, &_dComp, &_qComp, &_sComp,
-                         &_lastNumberOfIterations, &_lastResidual);
+  if (_useSellFormat) {
+    if (!_isMatrixUnchanged || _sellComp.rows() != matrix.rows()) {
+      _sellComp.set(matrix);
+    }
+
+    runCg<FdmCompressedSellBlas3>(_sellComp, rhs, _maxNumberOfIterations, _tolerance, _sStepSize,
+                                  _useConstantModeDeflation, &solution, &_rComp, &_dComp, &_qComp, &_sComp,
+                                  &_workspaceComp, &_lastNumberOfIterations, &_lastResidual);
+  } else {
+    runCg<FdmCompressedBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance, _sStepSize, _useConstantModeDeflation,
+                              &solution, &_rComp, &_dComp, &_qComp, &_sComp, &_workspaceComp,
+                              &_lastNumberOfIterations, &_lastResidual);
+  }
 
   return _lastResidual <= _tolerance || _lastNumberOfIterations < _maxNumberOfIterations;
 }
@@ -77,11 +120,18 @@ double FdmCgSolver3::tolerance() const { return _tolerance; }
 
 double FdmCgSolver3::lastResidual() const { return _lastResidual; }
 
+bool FdmCgSolver3::useSellFormat() const { return _useSellFormat; }
+
+unsigned int FdmCgSolver3::sStepSize() const { return _sStepSize; }
+
+bool FdmCgSolver3::useConstantModeDeflation() const { return _useConstantModeDeflation; }
+
 void FdmCgSolver3::clearUncompressedVectors() {
   _r.clear();
   _d.clear();
   _q.clear();
   _s.clear();
+  _workspace.clear();
 }
 
 void FdmCgSolver3::clearCompressedVectors() {
@@ -89,4 +139,6 @@ void FdmCgSolver3::clearCompressedVectors() {
   _dComp.clear();
   _qComp.clear();
   _sComp.clear();
+  _workspaceComp.clear();
+  _sellComp.clear();
 }
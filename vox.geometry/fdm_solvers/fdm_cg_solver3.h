@@ -16,8 +16,23 @@ namespace geometry {
 //!        gradient.
 class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
 public:
-  //! Constructs the solver with given parameters.
-  FdmCgSolver3(unsigned int maxNumberOfIterations, double tolerance);
+  //!
+  //! \brief Constructs the solver with given parameters.
+  //!
+  //! If \p useSellFormat is true, the compressed system matrix is converted to
+  //! SELL-C-sigma format before the iterations so that the matrix-vector
+  //! products run with SIMD-friendly chunks.
+  //!
+  //! If \p sStepSize is larger than one, the s-step CG variant is used, which
+  //! computes \p sStepSize matrix powers before a single block reduction.
+  //!
+  //! If \p useConstantModeDeflation is true, the constant vector is deflated
+  //! from the system, or projected out if it is an exact null vector such as
+  //! in a closed Neumann domain. Deflation takes precedence over the s-step
+  //! variant.
+  //!
+  FdmCgSolver3(unsigned int maxNumberOfIterations, double tolerance, bool useSellFormat = false,
+               unsigned int sStepSize = 1, bool useConstantModeDeflation = false);
 
   //! Solves the given linear system.
   bool solve(FdmLinearSystem3 *system) override;
@@ -37,23 +52,38 @@ public:
   //! Returns the last residual after the CG iterations.
   [[nodiscard]] double lastResidual() const;
 
+  //! Returns true if the compressed solve uses SELL-C-sigma matrix format.
+  [[nodiscard]] bool useSellFormat() const;
+
+  //! Returns the number of CG steps per block reduction.
+  [[nodiscard]] unsigned int sStepSize() const;
+
+  //! Returns true if the constant mode is deflated.
+  [[nodiscard]] bool useConstantModeDeflation() const;
+
 private:
   unsigned int _maxNumberOfIterations;
   unsigned int _lastNumberOfIterations;
   double _tolerance;
   double _lastResidual;
+  bool _useSellFormat;
+  unsigned int _sStepSize;
+  bool _useConstantModeDeflation;
 
   // Uncompressed vectors
   FdmVector3 _r;
   FdmVector3 _d;
   FdmVector3 _q;
   FdmVector3 _s;
+  std::vector<FdmVector3> _workspace;
 
   // Compressed vectors
   VectorND _rComp;
   VectorND _dComp;
   VectorND _qComp;
   VectorND _sComp;
+  std::vector<VectorND> _workspaceComp;
+  MatrixSellD _sellComp;
 
   void clearUncompressedVectors();
   void clearCompressedVectors();
@@ -9,6 +9,8 @@
 
 #include "../fdm_linear_system_solver3.h"
 
+#include <vector>
+
 namespace vox {
 namespace geometry {
 
@@ -16,6 +18,30 @@ namespace geometry {
 //!        method.
 class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
 public:
+  //!
+  //! \brief Partition of compressed matrix rows into colors.
+  //!
+  //! Rows with the same color do not refer to each other, so they can be
+  //! relaxed in parallel. The matrix is assumed to be structurally symmetric
+  //! which is the case for FDM systems.
+  //!
+  struct MulticolorOrdering {
+    //! Row indices sorted by color.
+    std::vector<size_t> rows;
+
+    //! Offset of the first row of each color (numberOfColors() + 1).
+    std::vector<size_t> colorPointers;
+
+    //! Builds greedy coloring of the given matrix.
+    void build(const MatrixCsrD &A);
+
+    //! Clears the ordering.
+    void clear();
+
+    //! Returns the number of colors.
+    [[nodiscard]] size_t numberOfColors() const;
+  };
+
   //! Constructs the solver with given parameters.
   FdmGaussSeidelSolver3(unsigned int maxNumberOfIterations, unsigned int residualCheckInterval, double tolerance,
                         double sorFactor = 1.0, bool useRedBlackOrdering = false);
@@ -41,7 +67,8 @@ public:
   //! Returns the SOR (Successive Over Relaxation) factor.
   [[nodiscard]] double sorFactor() const;
 
-  //! Returns true if red-black ordering is enabled.
+  //! Returns true if red-black (or multicolor for compressed system) ordering
+  //! is enabled.
   [[nodiscard]] bool useRedBlackOrdering() const;
 
   //! Performs single natural Gauss-Seidel relaxation step.
@@ -54,6 +81,25 @@ public:
   //! Performs single Red-Black Gauss-Seidel relaxation step.
   static void relaxRedBlack(const FdmMatrix3 &A, const FdmVector3 &b, double sorFactor, FdmVector3 *x);
 
+  //!
+  //! \brief Performs multiple Red-Black Gauss-Seidel relaxation steps with
+  //!        wavefront temporal blocking.
+  //!
+  //! The result is identical to calling relaxRedBlack \p numberOfIterations
+  //! times. Instead of sweeping the whole grid once per color, the half-sweeps
+  //! are pipelined along the z-axis so that the n-th half-sweep trails the
+  //! previous one by a single xy-plane. Each plane is then updated by all the
+  //! half-sweeps while it is still in cache, and the grid is streamed from
+  //! memory roughly once per call instead of 2 * \p numberOfIterations times.
+  //!
+  static void relaxRedBlackWavefront(const FdmMatrix3 &A, const FdmVector3 &b, unsigned int numberOfIterations,
+                                     double sorFactor, FdmVector3 *x);
+
+  //! \brief Performs single multicolor Gauss-Seidel relaxation step for
+  //!        compressed sys.
+  static void relaxMulticolor(const MatrixCsrD &A, const VectorND &b, const MulticolorOrdering &ordering,
+                              double sorFactor, VectorND *x);
+
 private:
   unsigned int _maxNumberOfIterations;
   unsigned int _lastNumberOfIterations;
@@ -68,6 +114,7 @@ private:
 
   // Compressed vectors
   VectorND _residualComp;
+  MulticolorOrdering _orderingComp;
 
   void clearUncompressedVectors();
   void clearCompressedVectors();
@@ -135,9 +135,9 @@ void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND &b, VectorND
 
 //
 
-FdmIccgSolver3::FdmIccgSolver3(unsigned int maxNumberOfIterations, double tolerance)
+FdmIccgSolver3::FdmIccgSolver3(unsigned int maxNumberOfIterations, double tolerance, bool useSellFormat)
     : _maxNumberOfIterations(maxNumberOfIterations), _lastNumberOfIterations(0), _tolerance(tolerance),
-      _lastResidualNorm(kMaxD) {}
+      _lastResidualNorm(kMaxD), _useSellFormat(useSellFormat) {}
 
 bool FdmIccgSolver3::solve(FdmLinearSystem3 *system) {
   FdmMatrix3 &matrix = system->A;
@@ -155,13 +155,20 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3 *system) {
   _q.resize(size);
   _s.resize(size);
 
-  system->x.fill(0.0);
+  if (!_useWarmStart) {
+    system->x.fill(0.0);
+  }
   _r.fill(0.0);
   _d.fill(0.0);
   _q.fill(0.0);
   _s.fill(0.0);
 
-  _precond.build(matrix);
+  if (_isMatrixUnchanged && _precond.d.size() == size) {
+    // The factorization is still valid, only re-point to the matrix
+    _precond.A = matrix.view();
+  } else {
+    _precond.build(matrix);
+  }
 
   pcg<FdmBlas3, Preconditioner>(matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, &solution, &_r, &_d, &_q,
                                 &_s, &_lastNumberOfIterations, &_lastResidualNorm);
@@ -185,17 +192,33 @@ bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3 *system) {
   _qComp.resize(size);
   _sComp.resize(size);
 
-  system->x.fill(0.0);
+  if (!_useWarmStart) {
+    system->x.fill(0.0);
+  }
   _rComp.fill(0.0);
   _dComp.fill(0.0);
   _qComp.fill(0.0);
   _sComp.fill(0.0);
 
-  _precondComp.build(matrix);
+  if (_isMatrixUnchanged && _precondComp.d.rows() == size) {
+    _precondComp.A = &matrix;
+  } else {
+    _precondComp.build(matrix);
+  }
+
+  if (_useSellFormat) {
+    if (!_isMatrixUnchanged || _sellComp.rows() != matrix.rows()) {
+      _sellComp.set(matrix);
+    }
 
-  pcg<FdmCompressedBlas3, PreconditionerCompressed>(matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondComp,
-                                                    &solution, &_rComp, &_dComp, &_qComp, &_sComp,
-                                                    &_lastNumberOfIterations, &_lastResidualNorm);
+    pcg<FdmCompressedSellBlas3, PreconditionerCompressed>(_sellComp, rhs, _maxNumberOfIterations, _tolerance,
+                                                          &_precondComp, &solution, &_rComp, &_dComp, &_qComp,
+                                                          &_sComp, &_lastNumberOfIterations, &_lastResidualNorm);
+  } else {
+    pcg<FdmCompressedBlas3, PreconditionerCompressed>(matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondComp,
+                                                      &solution, &_rComp, &_dComp, &_qComp, &_sComp,
+                                                      &_lastNumberOfIterations, &_lastResidualNorm);
+  }
 
   JET_INFO << "Residual after solving ICCG: " << _lastResidualNorm
            << " Number of ICCG iterations: " << _lastNumberOfIterations;
@@ -211,6 +234,8 @@ double FdmIccgSolver3::tolerance() const { return _tolerance; }
 
 double FdmIccgSolver3::lastResidual() const { return _lastResidualNorm; }
 
+bool FdmIccgSolver3::useSellFormat() const { return _useSellFormat; }
+
 void FdmIccgSolver3::clearUncompressedVectors() {
   _r.clear();
   _d.clear();
@@ -222,4 +247,5 @@ void FdmIccgSolver3::clearCompressedVectors() {
   _d.clear();
   _q.clear();
   _s.clear();
+  _sellComp.clear();
 }
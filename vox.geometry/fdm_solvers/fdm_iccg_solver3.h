@@ -18,8 +18,14 @@ namespace geometry {
 //!
 class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
 public:
-  //! Constructs the solver with given parameters.
-  FdmIccgSolver3(unsigned int maxNumberOfIterations, double tolerance);
+  //!
+  //! \brief Constructs the solver with given parameters.
+  //!
+  //! If \p useSellFormat is true, the compressed system matrix is converted to
+  //! SELL-C-sigma format before the iterations so that the matrix-vector
+  //! products run with SIMD-friendly chunks.
+  //!
+  FdmIccgSolver3(unsigned int maxNumberOfIterations, double tolerance, bool useSellFormat = false);
 
   //! Solves the given linear system.
   bool solve(FdmLinearSystem3 *system) override;
@@ -39,6 +45,9 @@ public:
   //! Returns the last residual after the ICCG iterations.
   [[nodiscard]] double lastResidual() const;
 
+  //! Returns true if the compressed solve uses SELL-C-sigma matrix format.
+  [[nodiscard]] bool useSellFormat() const;
+
 private:
   struct Preconditioner final {
     ConstArrayView3<FdmMatrixRow3> A;
@@ -64,6 +73,7 @@ private:
   unsigned int _lastNumberOfIterations;
   double _tolerance;
   double _lastResidualNorm;
+  bool _useSellFormat;
 
   // Uncompressed vectors and preconditioner
   FdmVector3 _r;
@@ -77,6 +87,7 @@ private:
   VectorND _dComp;
   VectorND _qComp;
   VectorND _sComp;
+  MatrixSellD _sellComp;
   PreconditionerCompressed _precondComp;
 
   void clearUncompressedVectors();
@@ -128,6 +128,52 @@ void FdmJacobiSolver3::relax(const MatrixCsrD &A, const VectorND &b, VectorND *x
   });
 }
 
+void FdmJacobiSolver3::relaxChebyshev(const FdmMatrix3 &A, const FdmVector3 &b, unsigned int numberOfIterations,
+                                      FdmVector3 *x_, FdmVector3 *d_, double maxEigenvalue, double smoothingRange) {
+  if (numberOfIterations == 0) {
+    return;
+  }
+
+  Vector3UZ size = A.size();
+  FdmVector3 &x = *x_;
+  FdmVector3 &d = *d_;
+
+  d.resize(size);
+
+  const double minEigenvalue = maxEigenvalue / smoothingRange;
+  const double theta = 0.5 * (maxEigenvalue + minEigenvalue);
+  const double delta = 0.5 * (maxEigenvalue - minEigenvalue);
+  const double sigma = theta / delta;
+  double rho = 1.0 / sigma;
+
+  // d = alpha * d + beta * D^-1 (b - Ax)
+  auto updateDirection = [&](double alpha, double beta) {
+    parallelForEachIndex(size, [&](size_t i, size_t j, size_t k) {
+      double r = ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
+                 ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
+                 ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
+                 ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
+                 ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
+                 ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
+
+      const double dij = (alpha != 0.0) ? alpha * d(i, j, k) : 0.0;
+      d(i, j, k) = dij + beta * (b(i, j, k) - r - A(i, j, k).center * x(i, j, k)) / A(i, j, k).center;
+    });
+  };
+
+  updateDirection(0.0, 1.0 / theta);
+
+  for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
+    FdmBlas3::axpy(1.0, d, x, &x);
+
+    if (iter + 1 < numberOfIterations) {
+      const double rhoNew = 1.0 / (2.0 * sigma - rho);
+      updateDirection(rhoNew * rho, 2.0 * rhoNew / delta);
+      rho = rhoNew;
+    }
+  }
+}
+
 void FdmJacobiSolver3::clearUncompressedVectors() {
   _xTempComp.clear();
   _residualComp.clear();
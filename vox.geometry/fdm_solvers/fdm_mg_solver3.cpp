@@ -7,6 +7,7 @@
 #include "../common.h"
 
 #include "fdm_gauss_seidel_solver3.h"
+#include "fdm_jacobi_solver3.h"
 #include "fdm_mg_solver3.h"
 
 using namespace vox;
@@ -15,14 +16,29 @@ using namespace geometry;
 FdmMgSolver3::FdmMgSolver3(size_t maxNumberOfLevels, unsigned int numberOfRestrictionIter,
                            unsigned int numberOfCorrectionIter, unsigned int numberOfCoarsestIter,
                            unsigned int numberOfFinalIter, double maxTolerance, double sorFactor,
-                           bool useRedBlackOrdering) {
+                           bool useRedBlackOrdering, bool useChebyshevSmoothing, bool useCacheBlocking) {
   _mgParams.maxNumberOfLevels = maxNumberOfLevels;
   _mgParams.numberOfRestrictionIter = numberOfRestrictionIter;
   _mgParams.numberOfCorrectionIter = numberOfCorrectionIter;
   _mgParams.numberOfCoarsestIter = numberOfCoarsestIter;
   _mgParams.numberOfFinalIter = numberOfFinalIter;
   _mgParams.maxTolerance = maxTolerance;
-  if (useRedBlackOrdering) {
+  if (useChebyshevSmoothing) {
+    _mgParams.relaxFunc = [](const FdmMatrix3 &A, const FdmVector3 &b, unsigned int numberOfIterations,
+                             double maxTolerance, FdmVector3 *x, FdmVector3 *buffer) {
+      UNUSED_VARIABLE(maxTolerance);
+
+      FdmJacobiSolver3::relaxChebyshev(A, b, numberOfIterations, x, buffer);
+    };
+  } else if (useRedBlackOrdering && useCacheBlocking) {
+    _mgParams.relaxFunc = [sorFactor](const FdmMatrix3 &A, const FdmVector3 &b, unsigned int numberOfIterations,
+                                      double maxTolerance, FdmVector3 *x, FdmVector3 *buffer) {
+      UNUSED_VARIABLE(buffer);
+      UNUSED_VARIABLE(maxTolerance);
+
+      FdmGaussSeidelSolver3::relaxRedBlackWavefront(A, b, numberOfIterations, sorFactor, x);
+    };
+  } else if (useRedBlackOrdering) {
     _mgParams.relaxFunc = [sorFactor](const FdmMatrix3 &A, const FdmVector3 &b, unsigned int numberOfIterations,
                                       double maxTolerance, FdmVector3 *x, FdmVector3 *buffer) {
       UNUSED_VARIABLE(buffer);
@@ -45,9 +61,14 @@ FdmMgSolver3::FdmMgSolver3(size_t maxNumberOfLevels, unsigned int numberOfRestri
   }
   _mgParams.restrictFunc = FdmMgUtils3::restrict;
   _mgParams.correctFunc = FdmMgUtils3::correct;
+  if (useCacheBlocking) {
+    _mgParams.residualRestrictFunc = FdmMgUtils3::residualRestrict;
+  }
 
   _sorFactor = sorFactor;
   _useRedBlackOrdering = useRedBlackOrdering;
+  _useChebyshevSmoothing = useChebyshevSmoothing;
+  _useCacheBlocking = useCacheBlocking;
 }
 
 const MgParameters<FdmBlas3> &FdmMgSolver3::params() const { return _mgParams; }
@@ -56,6 +77,10 @@ double FdmMgSolver3::sorFactor() const { return _sorFactor; }
 
 bool FdmMgSolver3::useRedBlackOrdering() const { return _useRedBlackOrdering; }
 
+bool FdmMgSolver3::useChebyshevSmoothing() const { return _useChebyshevSmoothing; }
+
+bool FdmMgSolver3::useCacheBlocking() const { return _useCacheBlocking; }
+
 bool FdmMgSolver3::solve(FdmLinearSystem3 *system) {
   UNUSED_VARIABLE(system);
   return false;
@@ -18,14 +18,21 @@ using namespace geometry;
 void FdmMgpcgSolver3::Preconditioner::build(FdmMgLinearSystem3 *system_, MgParameters<FdmBlas3> mgParams_) {
   system = system_;
   mgParams = std::move(mgParams_);
-}
 
-void FdmMgpcgSolver3::Preconditioner::solve(const FdmVector3 &b, FdmVector3 *x) const {
-  // Copy dimension
-  FdmMgVector3 mgX = system->x;
-  FdmMgVector3 mgB = system->x;
-  FdmMgVector3 mgBuffer = system->x;
+  // Allocate the hierarchy only when the level dimensions have changed
+  bool isSameHierarchy = mgX.levels.size() == system->x.levels.size();
+  for (size_t l = 0; isSameHierarchy && l < mgX.levels.size(); ++l) {
+    isSameHierarchy = mgX[l].size() == system->x[l].size();
+  }
+
+  if (!isSameHierarchy) {
+    mgX = system->x;
+    mgB = system->x;
+    mgBuffer = system->x;
+  }
+}
 
+void FdmMgpcgSolver3::Preconditioner::solve(const FdmVector3 &b, FdmVector3 *x) {
   // Copy input to the top
   mgX.levels.front().copyFrom(*x);
   mgB.levels.front().copyFrom(b);
@@ -41,9 +48,11 @@ void FdmMgpcgSolver3::Preconditioner::solve(const FdmVector3 &b, FdmVector3 *x)
 FdmMgpcgSolver3::FdmMgpcgSolver3(unsigned int numberOfCgIter, size_t maxNumberOfLevels,
                                  unsigned int numberOfRestrictionIter, unsigned int numberOfCorrectionIter,
                                  unsigned int numberOfCoarsestIter, unsigned int numberOfFinalIter, double maxTolerance,
-                                 double sorFactor, bool useRedBlackOrdering)
+                                 double sorFactor, bool useRedBlackOrdering, bool useChebyshevSmoothing,
+                                 bool useCacheBlocking)
     : FdmMgSolver3(maxNumberOfLevels, numberOfRestrictionIter, numberOfCorrectionIter, numberOfCoarsestIter,
-                   numberOfFinalIter, maxTolerance, sorFactor, useRedBlackOrdering),
+                   numberOfFinalIter, maxTolerance, sorFactor, useRedBlackOrdering, useChebyshevSmoothing,
+                   useCacheBlocking),
       _maxNumberOfIterations(numberOfCgIter), _lastNumberOfIterations(0), _tolerance(maxTolerance),
       _lastResidualNorm(kMaxD) {}
 
@@ -54,7 +63,9 @@ bool FdmMgpcgSolver3::solve(FdmMgLinearSystem3 *system) {
   _q.resize(size);
   _s.resize(size);
 
-  system->x.levels.front().fill(0.0);
+  if (!_useWarmStart) {
+    system->x.levels.front().fill(0.0);
+  }
   _r.fill(0.0);
   _d.fill(0.0);
   _q.fill(0.0);
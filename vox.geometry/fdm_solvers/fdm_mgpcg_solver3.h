@@ -33,10 +33,15 @@ public:
   //! \param numberOfCoarsestIter - Number of iterations at the coarsest grid.
   //! \param numberOfFinalIter - Number of final iterations.
   //! \param maxTolerance - Number of max residual tolerance.
+  //! \param sorFactor - SOR factor of the Gauss-Seidel smoother.
+  //! \param useRedBlackOrdering - Use red-black Gauss-Seidel smoother.
+  //! \param useChebyshevSmoothing - Use Chebyshev-accelerated Jacobi smoother.
+  //! \param useCacheBlocking - Use fused and temporally blocked MG kernels.
   FdmMgpcgSolver3(unsigned int numberOfCgIter, size_t maxNumberOfLevels, unsigned int numberOfRestrictionIter = 5,
                   unsigned int numberOfCorrectionIter = 5, unsigned int numberOfCoarsestIter = 20,
                   unsigned int numberOfFinalIter = 20, double maxTolerance = 1e-9, double sorFactor = 1.5,
-                  bool useRedBlackOrdering = false);
+                  bool useRedBlackOrdering = false, bool useChebyshevSmoothing = false,
+                  bool useCacheBlocking = false);
 
   //! Solves the given linear system.
   bool solve(FdmMgLinearSystem3 *system) override;
@@ -58,9 +63,14 @@ private:
     FdmMgLinearSystem3 *system = nullptr;
     MgParameters<FdmBlas3> mgParams;
 
+    // Multigrid hierarchy used by each V-cycle, kept across the solves
+    FdmMgVector3 mgX;
+    FdmMgVector3 mgB;
+    FdmMgVector3 mgBuffer;
+
     void build(FdmMgLinearSystem3 *system, MgParameters<FdmBlas3> mgParams);
 
-    void solve(const FdmVector3 &b, FdmVector3 *x) const;
+    void solve(const FdmVector3 &b, FdmVector3 *x);
   };
 
   unsigned int _maxNumberOfIterations;
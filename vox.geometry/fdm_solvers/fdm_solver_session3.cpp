@@ -0,0 +1,190 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../common.h"
+
+#include "../parallel.h"
+#include "fdm_mg_solver3.h"
+#include "fdm_solver_session3.h"
+
+#include <cstring>
+#include <utility>
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+constexpr size_t kHashBlockSize = 1 << 14;
+
+// SplitMix64 finalizer
+inline uint64_t mixBits(uint64_t h) {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+// Position-dependent 64-bit fingerprint of the given bytes. Blocks are hashed
+// in parallel and combined with their index, so the result does not depend on
+// the number of threads.
+uint64_t hashBytes(const void *data, size_t numberOfBytes, uint64_t seed) {
+  // The data of an empty matrix can be null
+  if (numberOfBytes == 0) {
+    return mixBits(seed ^ mixBits(0));
+  }
+
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  const size_t numberOfWords = numberOfBytes / sizeof(uint64_t);
+  const size_t numberOfBlocks = (numberOfWords + kHashBlockSize - 1) / kHashBlockSize;
+
+  uint64_t hash = parallelReduce(
+      kZeroSize, numberOfBlocks, uint64_t(0),
+      [&](size_t begin, size_t end, uint64_t result) {
+        for (size_t block = begin; block < end; ++block) {
+          uint64_t h = mixBits(block + 1);
+          const size_t wordEnd = std::min((block + 1) * kHashBlockSize, numberOfWords);
+          for (size_t w = block * kHashBlockSize; w < wordEnd; ++w) {
+            uint64_t word;
+            std::memcpy(&word, bytes + w * sizeof(uint64_t), sizeof(uint64_t));
+            h = (h ^ word) * 0x100000001b3ULL;
+          }
+          result ^= mixBits(h);
+        }
+        return result;
+      },
+      [](uint64_t a, uint64_t b) { return a ^ b; });
+
+  uint64_t tail = 0;
+  std::memcpy(&tail, bytes + numberOfWords * sizeof(uint64_t), numberOfBytes - numberOfWords * sizeof(uint64_t));
+
+  return mixBits(seed ^ hash ^ mixBits(tail ^ numberOfBytes));
+}
+
+uint64_t hashMatrix(const FdmMatrix3 &A, uint64_t seed) {
+  const Vector3UZ size = A.size();
+  seed = mixBits(seed ^ size.x);
+  seed = mixBits(seed ^ size.y);
+  seed = mixBits(seed ^ size.z);
+  return hashBytes(A.data(), A.length() * sizeof(FdmMatrixRow3), seed);
+}
+
+uint64_t hashMatrix(const MatrixCsrD &A) {
+  uint64_t seed = mixBits(A.rows() ^ mixBits(A.cols()));
+  seed = hashBytes(A.rowPointersData(), (A.rows() + 1) * sizeof(size_t), seed);
+  seed = hashBytes(A.columnIndicesData(), A.numberOfNonZeros() * sizeof(size_t), seed);
+  return hashBytes(A.nonZeroData(), A.numberOfNonZeros() * sizeof(double), seed);
+}
+
+// Sets the warm start and matrix reuse flags of a solver for one solve and
+// restores the flags of the caller afterwards.
+class SolverFlagsScope {
+public:
+  SolverFlagsScope(FdmLinearSystemSolver3 *solver, bool isMatrixUnchanged)
+      : _solver(solver), _useWarmStart(solver->useWarmStart()), _isMatrixUnchanged(solver->isMatrixUnchanged()) {
+    _solver->setUseWarmStart(true);
+    _solver->setMatrixUnchanged(isMatrixUnchanged);
+  }
+
+  ~SolverFlagsScope() {
+    _solver->setUseWarmStart(_useWarmStart);
+    _solver->setMatrixUnchanged(_isMatrixUnchanged);
+  }
+
+  SolverFlagsScope(const SolverFlagsScope &) = delete;
+
+  SolverFlagsScope &operator=(const SolverFlagsScope &) = delete;
+
+private:
+  FdmLinearSystemSolver3 *_solver;
+  bool _useWarmStart;
+  bool _isMatrixUnchanged;
+};
+
+} // namespace
+
+FdmSolverSession3::FdmSolverSession3(FdmLinearSystemSolver3Ptr solver) : _solver(std::move(solver)) {
+  JET_THROW_INVALID_ARG_IF(_solver == nullptr);
+}
+
+bool FdmSolverSession3::solve(FdmLinearSystem3 *system) {
+  beginSolve(SystemType::kUncompressed, hashMatrix(system->A, 0));
+
+  if (_previousSolution.size() == system->x.size()) {
+    system->x.copyFrom(_previousSolution);
+  }
+
+  SolverFlagsScope flags(_solver.get(), _wasMatrixUnchanged);
+  bool result = _solver->solve(system);
+
+  _previousSolution.copyFrom(system->x);
+  return result;
+}
+
+bool FdmSolverSession3::solveCompressed(FdmCompressedLinearSystem3 *system) {
+  beginSolve(SystemType::kCompressed, hashMatrix(system->A));
+
+  if (_previousSolutionComp.rows() == system->x.rows()) {
+    system->x = _previousSolutionComp;
+  }
+
+  SolverFlagsScope flags(_solver.get(), _wasMatrixUnchanged);
+  bool result = _solver->solveCompressed(system);
+
+  _previousSolutionComp = system->x;
+  return result;
+}
+
+bool FdmSolverSession3::solve(FdmMgLinearSystem3 *system) {
+  auto mgSolver = std::dynamic_pointer_cast<FdmMgSolver3>(_solver);
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(mgSolver == nullptr, "Multigrid system requires a multigrid solver.");
+
+  uint64_t hash = 0;
+  for (size_t l = 0; l < system->numberOfLevels(); ++l) {
+    hash = hashMatrix(system->A[l], hash);
+  }
+  beginSolve(SystemType::kMultigrid, hash);
+
+  FdmVector3 &x = system->x.finest();
+  if (_previousSolution.size() == x.size()) {
+    x.copyFrom(_previousSolution);
+  }
+
+  SolverFlagsScope flags(_solver.get(), _wasMatrixUnchanged);
+  bool result = mgSolver->solve(system);
+
+  _previousSolution.copyFrom(x);
+  return result;
+}
+
+void FdmSolverSession3::reset() {
+  _lastSystemType = SystemType::kNone;
+  _matrixHash = 0;
+  _wasMatrixUnchanged = false;
+  _numberOfSolves = 0;
+  _previousSolution.clear();
+  _previousSolutionComp.clear();
+}
+
+const FdmLinearSystemSolver3Ptr &FdmSolverSession3::solver() const { return _solver; }
+
+bool FdmSolverSession3::wasMatrixUnchanged() const { return _wasMatrixUnchanged; }
+
+size_t FdmSolverSession3::numberOfSolves() const { return _numberOfSolves; }
+
+void FdmSolverSession3::beginSolve(SystemType type, uint64_t matrixHash) {
+  if (type != _lastSystemType) {
+    _previousSolution.clear();
+    _previousSolutionComp.clear();
+  }
+
+  _wasMatrixUnchanged = type == _lastSystemType && matrixHash == _matrixHash;
+  _lastSystemType = type;
+  _matrixHash = matrixHash;
+  ++_numberOfSolves;
+}
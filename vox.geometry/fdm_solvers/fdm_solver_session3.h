@@ -0,0 +1,89 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_FDM_SOLVER_SESSION3_H_
+#define INCLUDE_JET_FDM_SOLVER_SESSION3_H_
+
+#include "../fdm_linear_system_solver3.h"
+#include "../fdm_mg_linear_system3.h"
+
+#include <cstdint>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief Solver session that carries state between consecutive 3-D FDM
+//!        solves.
+//!
+//! Systems such as the pressure projection of a running simulation change
+//! slowly from frame to frame. A session wraps a solver and, for each solve,
+//!
+//! - uses the solution of the previous solve as the initial guess when the
+//!   dimension matches, and
+//! - fingerprints the matrix to detect when it is unchanged, in which case
+//!   the solver reuses its matrix-dependent setup such as the ICCG
+//!   factorization or the SELL-C-sigma conversion.
+//!
+//! The solver instance, including its preconditioner and the MGPCG
+//! hierarchy, is kept alive by the session, so the work buffers are only
+//! reallocated when the dimension changes. The session enables the warm start
+//! and the matrix reuse of the solver only during its own solves, so the
+//! solver can still be shared and used directly with its own settings.
+//!
+class FdmSolverSession3 {
+public:
+  //! Constructs a session with the given solver.
+  explicit FdmSolverSession3(FdmLinearSystemSolver3Ptr solver);
+
+  //! Solves the given linear system. The initial guess in \p system->x is
+  //! overwritten by the previous solution when the dimension matches.
+  bool solve(FdmLinearSystem3 *system);
+
+  //! Solves the given compressed linear system. The initial guess in
+  //! \p system->x is overwritten by the previous solution when the dimension
+  //! matches.
+  bool solveCompressed(FdmCompressedLinearSystem3 *system);
+
+  //! Solves the given multigrid linear system. The solver must be a
+  //! FdmMgSolver3 or one of its subclasses. The initial guess at the finest
+  //! level is overwritten by the previous solution when the dimension matches.
+  bool solve(FdmMgLinearSystem3 *system);
+
+  //! Forgets the previous solution and the matrix fingerprint.
+  void reset();
+
+  //! Returns the solver.
+  [[nodiscard]] const FdmLinearSystemSolver3Ptr &solver() const;
+
+  //! Returns true if the matrix was unchanged at the last solve.
+  [[nodiscard]] bool wasMatrixUnchanged() const;
+
+  //! Returns the number of solves made with this session.
+  [[nodiscard]] size_t numberOfSolves() const;
+
+private:
+  enum class SystemType { kNone, kUncompressed, kCompressed, kMultigrid };
+
+  FdmLinearSystemSolver3Ptr _solver;
+  SystemType _lastSystemType = SystemType::kNone;
+  uint64_t _matrixHash = 0;
+  bool _wasMatrixUnchanged = false;
+  size_t _numberOfSolves = 0;
+
+  FdmVector3 _previousSolution;
+  VectorND _previousSolutionComp;
+
+  void beginSolve(SystemType type, uint64_t matrixHash);
+};
+
+//! Shared pointer type for the FdmSolverSession3.
+using FdmSolverSession3Ptr = std::shared_ptr<FdmSolverSession3>;
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_FDM_SOLVER_SESSION3_H_
@@ -32,16 +32,6 @@ template <size_t N> GridDataPositionFunc<N> Grid<N>::cellCenterPosition() const
   });
 }
 
-template <size_t N> void Grid<N>::forEachCellIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  forEachIndex(_resolution, [&func](auto... indices) { func(Vector<size_t, N>(indices...)); });
-}
-
-template <size_t N>
-void Grid<N>::parallelForEachCellIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  parallelForEachIndex(Vector<size_t, N>::makeZero(), _resolution,
-                       [&func](auto... indices) { func(Vector<size_t, N>(indices...)); });
-}
-
 template <size_t N> bool Grid<N>::hasSameShape(const Grid &other) const {
   return _resolution == other._resolution && _gridSpacing.isSimilar(other._gridSpacing) &&
          _origin.isSimilar(other._origin);
@@ -8,6 +8,7 @@
 #define INCLUDE_JET_GRID_H_
 
 #include "bounding_box.h"
+#include "iteration_utils.h"
 #include "matrix.h"
 #include "serialization.h"
 
@@ -74,18 +75,11 @@ public:
   //!
   //! This function invokes the given function object \p func for each grid
   //! cell in serial manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a grid cell. The order of execution is i-first, j-next.
+  //! indices of a grid cell, or the index vector. The order of execution is
+  //! i-first, j-next.
   //!
-  void forEachCellIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
-
-  template <size_t M = N>
-  std::enable_if_t<M == 2, void> forEachCellIndex(const std::function<void(size_t, size_t)> &func) const {
-    forEachCellIndex([&func](const Vector2UZ &idx) { func(idx.x, idx.y); });
-  }
-
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void> forEachCellIndex(const std::function<void(size_t, size_t, size_t)> &func) const {
-    forEachCellIndex([&func](const Vector3UZ &idx) { func(idx.x, idx.y, idx.z); });
+  template <typename Callback> void forEachCellIndex(const Callback &func) const {
+    forEachIndex(_resolution, unrollIndices<N>(func));
   }
 
   //!
@@ -94,20 +88,11 @@ public:
   //!
   //! This function invokes the given function object \p func for each grid
   //! cell in parallel manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a grid cell. The order of execution can be arbitrary since
-  //! it's multi-threaded.
+  //! indices of a grid cell, or the index vector. The order of execution can
+  //! be arbitrary since it's multi-threaded.
   //!
-  void parallelForEachCellIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
-
-  template <size_t M = N>
-  std::enable_if_t<M == 2, void> parallelForEachCellIndex(const std::function<void(size_t, size_t)> &func) const {
-    parallelForEachCellIndex([&func](const Vector2UZ &idx) { func(idx.x, idx.y); });
-  }
-
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void>
-  parallelForEachCellIndex(const std::function<void(size_t, size_t, size_t)> &func) const {
-    parallelForEachCellIndex([&func](const Vector3UZ &idx) { func(idx.x, idx.y, idx.z); });
+  template <typename Callback> void parallelForEachCellIndex(const Callback &func) const {
+    parallelForEachIndex(_resolution, unrollIndices<N>(func));
   }
 
   //! Returns true if resolution, grid-spacing and origin are same.
@@ -55,13 +55,8 @@ template <size_t N> void CellCenteredVectorGrid<N>::fill(const Vector<double, N>
 
 template <size_t N>
 void CellCenteredVectorGrid<N>::fill(const std::function<Vector<double, N>(const Vector<double, N> &)> &func,
-                                     ExecutionPolicy policy) {
-  Vector<size_t, N> size = dataSize();
-  auto view = dataView();
-  auto pos = dataPosition();
-  parallelForEachIndex(
-      Vector<size_t, N>::makeZero(), size,
-      [&func, &view, &pos](auto... indices) { view(indices...) = func(pos(indices...)); }, policy);
+                                        ExecutionPolicy policy) {
+  this->template fill<std::function<Vector<double, N>(const Vector<double, N> &)>>(func, policy);
 }
 
 template <size_t N> std::shared_ptr<VectorGrid<N>> CellCenteredVectorGrid<N>::clone() const {
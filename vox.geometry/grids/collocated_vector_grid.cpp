@@ -74,6 +74,15 @@ std::function<Vector<double, N>(const Vector<double, N> &)> CollocatedVectorGrid
   return _sampler;
 }
 
+template <size_t N>
+void CollocatedVectorGrid<N>::sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<Vector<double, N>> result,
+                                     ExecutionPolicy policy) const {
+  JET_THROW_INVALID_ARG_IF(x.length() != result.length());
+
+  parallelFor(
+      kZeroSize, x.length(), [&](size_t i) { result[i] = _linearSampler(x[i]); }, policy);
+}
+
 template <size_t N> typename CollocatedVectorGrid<N>::VectorDataView CollocatedVectorGrid<N>::dataView() {
   return CollocatedVectorGrid<N>::VectorDataView{_data};
 }
@@ -90,17 +99,6 @@ template <size_t N> GridDataPositionFunc<N> CollocatedVectorGrid<N>::dataPositio
   });
 }
 
-template <size_t N>
-void CollocatedVectorGrid<N>::forEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  forEachIndex(_data.size(), GetUnroll<void, N>::unroll(func));
-}
-
-template <size_t N>
-void CollocatedVectorGrid<N>::parallelForEachDataPointIndex(
-    const std::function<void(const Vector<size_t, N> &)> &func) const {
-  parallelForEachIndex(_data.size(), GetUnroll<void, N>::unroll(func));
-}
-
 template <size_t N> void CollocatedVectorGrid<N>::swapCollocatedVectorGrid(CollocatedVectorGrid *other) {
   swapGrid(other);
 
@@ -9,6 +9,7 @@
 
 #include "../array.h"
 #include "../array_samplers.h"
+#include "../iteration_utils.h"
 #include "vector_grid.h"
 
 namespace vox {
@@ -84,18 +85,11 @@ public:
   //!
   //! This function invokes the given function object \p func for each data
   //! point in serial manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a data point. The order of execution is i-first, j-next.
+  //! indices of a data point, or the index vector. The order of execution is
+  //! i-first, j-next.
   //!
-  void forEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
-
-  template <size_t M = N>
-  std::enable_if_t<M == 2, void> forEachDataPointIndex(const std::function<void(size_t, size_t)> &func) const {
-    forEachDataPointIndex([&func](const Vector2UZ &idx) { func(idx.x, idx.y); });
-  }
-
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void> forEachDataPointIndex(const std::function<void(size_t, size_t, size_t)> &func) const {
-    forEachDataPointIndex([&func](const Vector3UZ &idx) { func(idx.x, idx.y, idx.z); });
+  template <typename Callback> void forEachDataPointIndex(const Callback &func) const {
+    forEachIndex(_data.size(), unrollIndices<N>(func));
   }
 
   //!
@@ -104,20 +98,11 @@ public:
   //!
   //! This function invokes the given function object \p func for each data
   //! point in parallel manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a data point. The order of execution can be arbitrary since
-  //! it's multi-threaded.
+  //! indices of a data point, or the index vector. The order of execution can
+  //! be arbitrary since it's multi-threaded.
   //!
-  void parallelForEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
-
-  template <size_t M = N>
-  std::enable_if_t<M == 2, void> parallelForEachDataPointIndex(const std::function<void(size_t, size_t)> &func) const {
-    parallelForEachDataPointIndex([&func](const Vector2UZ &idx) { func(idx.x, idx.y); });
-  }
-
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void>
-  parallelForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)> &func) const {
-    parallelForEachDataPointIndex([&func](const Vector3UZ &idx) { func(idx.x, idx.y, idx.z); });
+  template <typename Callback> void parallelForEachDataPointIndex(const Callback &func) const {
+    parallelForEachIndex(_data.size(), unrollIndices<N>(func));
   }
 
   // VectorField implementations
@@ -139,6 +124,10 @@ public:
   //!
   std::function<Vector<double, N>(const Vector<double, N> &)> sampler() const override;
 
+  //! Samples the grid at every position in \p x into \p result.
+  void sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<Vector<double, N>> result,
+              ExecutionPolicy policy = ExecutionPolicy::kParallel) const override;
+
 protected:
   using VectorGrid<N>::swapGrid;
   using VectorGrid<N>::setGrid;
@@ -366,38 +366,13 @@ template <size_t N> void FaceCenteredGrid<N>::fill(const Vector<double, N> &valu
 template <size_t N>
 void FaceCenteredGrid<N>::fill(const std::function<Vector<double, N>(const Vector<double, N> &)> &func,
                                ExecutionPolicy policy) {
-  for (size_t i = 0; i < N; ++i) {
-    auto pos = dataPosition(i);
-    parallelForEachIndex(
-        dataSize(i), [this, &func, &pos, i](auto... indices) { _data[i](indices...) = func(pos(indices...))[i]; },
-        policy);
-  }
+  this->template fill<std::function<Vector<double, N>(const Vector<double, N> &)>>(func, policy);
 }
 
 template <size_t N> std::shared_ptr<VectorGrid<N>> FaceCenteredGrid<N>::clone() const {
   return CLONE_W_CUSTOM_DELETER(FaceCenteredGrid);
 }
 
-template <size_t N>
-void FaceCenteredGrid<N>::forEachUIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  forEachIndex(dataSize(0), GetUnroll<void, N>::unroll(func));
-}
-
-template <size_t N>
-void FaceCenteredGrid<N>::parallelForEachUIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  parallelForEachIndex(dataSize(0), GetUnroll<void, N>::unroll(func));
-}
-
-template <size_t N>
-void FaceCenteredGrid<N>::forEachVIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  forEachIndex(dataSize(1), GetUnroll<void, N>::unroll(func));
-}
-
-template <size_t N>
-void FaceCenteredGrid<N>::parallelForEachVIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  parallelForEachIndex(dataSize(1), GetUnroll<void, N>::unroll(func));
-}
-
 template <size_t N> Vector<double, N> FaceCenteredGrid<N>::sample(const Vector<double, N> &x) const {
   return _sampler(x);
 }
@@ -406,6 +381,21 @@ template <size_t N> std::function<Vector<double, N>(const Vector<double, N> &)>
   return _sampler;
 }
 
+template <size_t N>
+void FaceCenteredGrid<N>::sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<Vector<double, N>> result,
+                                 ExecutionPolicy policy) const {
+  JET_THROW_INVALID_ARG_IF(x.length() != result.length());
+
+  parallelFor(
+      kZeroSize, x.length(),
+      [&](size_t i) {
+        for (size_t j = 0; j < N; ++j) {
+          result[i][j] = _linearSamplers[j](x[i]);
+        }
+      },
+      policy);
+}
+
 template <size_t N> double FaceCenteredGrid<N>::divergence(const Vector<double, N> &x) const {
   return internal::divergence(*this, x);
 }
@@ -9,6 +9,7 @@
 
 #include "../array.h"
 #include "../array_samplers.h"
+#include "../iteration_utils.h"
 #include "../parallel.h"
 #include "vector_grid.h"
 
@@ -225,6 +226,25 @@ public:
   void fill(const std::function<Vector<double, N>(const Vector<double, N> &)> &func,
             ExecutionPolicy policy = ExecutionPolicy::kParallel) override;
 
+  //!
+  //! \brief Fills the grid with given function without type erasure.
+  //!
+  //! \p func is callable as Vector<double, N>(const Vector<double, N> &).
+  //!
+  template <typename Func, typename = std::enable_if_t<std::is_invocable_v<const Func &, const Vector<double, N> &>>>
+  void fill(const Func &func, ExecutionPolicy policy = ExecutionPolicy::kParallel) {
+    const Vector<double, N> h = gridSpacing();
+    for (size_t i = 0; i < N; ++i) {
+      const Vector<double, N> o = _dataOrigins[i];
+      parallelForEachIndex(
+          dataSize(i),
+          [this, &func, &o, &h, i](auto... indices) {
+            _data[i](indices...) = func(o + elemMul(h, Vector<size_t, N>(indices...).template castTo<double>()))[i];
+          },
+          policy);
+    }
+  }
+
   //! Returns the copy of the grid instance.
   std::shared_ptr<VectorGrid<N>> clone() const override;
 
@@ -233,9 +253,12 @@ public:
   //!
   //! This function invokes the given function object \p func for each u-data
   //! point in serial manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a u-data point. The order of execution is i-first, j-next.
+  //! indices of a u-data point, or the index vector. The order
+  //! of execution is i-first, j-next.
   //!
-  void forEachUIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
+  template <typename Callback> void forEachUIndex(const Callback &func) const {
+    forEachIndex(dataSize(0), unrollIndices<N>(func));
+  }
 
   //!
   //! \brief Invokes the given function \p func for each u-data point in
@@ -243,19 +266,24 @@ public:
   //!
   //! This function invokes the given function object \p func for each u-data
   //! point in parallel manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a u-data point. The order of execution can be arbitrary since
-  //! it's multi-threaded.
+  //! indices of a u-data point, or the index vector. The order
+  //! of execution can be arbitrary since it's multi-threaded.
   //!
-  void parallelForEachUIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
+  template <typename Callback> void parallelForEachUIndex(const Callback &func) const {
+    parallelForEachIndex(dataSize(0), unrollIndices<N>(func));
+  }
 
   //!
   //! \brief Invokes the given function \p func for each v-data point.
   //!
   //! This function invokes the given function object \p func for each v-data
   //! point in serial manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a v-data point. The order of execution is i-first, j-next.
+  //! indices of a v-data point, or the index vector. The order
+  //! of execution is i-first, j-next.
   //!
-  void forEachVIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
+  template <typename Callback> void forEachVIndex(const Callback &func) const {
+    forEachIndex(dataSize(1), unrollIndices<N>(func));
+  }
 
   //!
   //! \brief Invokes the given function \p func for each v-data point
@@ -263,21 +291,24 @@ public:
   //!
   //! This function invokes the given function object \p func for each v-data
   //! point in parallel manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a v-data point. The order of execution can be arbitrary since
-  //! it's multi-threaded.
+  //! indices of a v-data point, or the index vector. The order
+  //! of execution can be arbitrary since it's multi-threaded.
   //!
-  void parallelForEachVIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
+  template <typename Callback> void parallelForEachVIndex(const Callback &func) const {
+    parallelForEachIndex(dataSize(1), unrollIndices<N>(func));
+  }
 
   //!
   //! \brief Invokes the given function \p func for each w-data point.
   //!
   //! This function invokes the given function object \p func for each w-data
   //! point in serial manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a w-data point. The order of execution is i-first, j-next.
+  //! indices of a w-data point, or the index vector. The order
+  //! of execution is i-first, j-next.
   //!
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void> forEachWIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-    forEachIndex(dataSize(2), GetUnroll<void, N>::unroll(func));
+  template <typename Callback, size_t M = N>
+  std::enable_if_t<M == 3, void> forEachWIndex(const Callback &func) const {
+    forEachIndex(dataSize(2), unrollIndices<N>(func));
   }
 
   //!
@@ -286,13 +317,12 @@ public:
   //!
   //! This function invokes the given function object \p func for each w-data
   //! point in parallel manner. The input parameters are i, j (and k for 3-D)
-  //! indices of a w-data point. The order of execution can be arbitrary since
-  //! it's multi-threaded.
+  //! indices of a w-data point, or the index vector. The order
+  //! of execution can be arbitrary since it's multi-threaded.
   //!
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void>
-  parallelForEachWIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-    parallelForEachIndex(dataSize(2), GetUnroll<void, N>::unroll(func));
+  template <typename Callback, size_t M = N>
+  std::enable_if_t<M == 3, void> parallelForEachWIndex(const Callback &func) const {
+    parallelForEachIndex(dataSize(2), unrollIndices<N>(func));
   }
 
   // VectorField implementations
@@ -314,6 +344,10 @@ public:
   //!
   std::function<Vector<double, N>(const Vector<double, N> &)> sampler() const override;
 
+  //! Samples the grid at every position in \p x into \p result.
+  void sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<Vector<double, N>> result,
+              ExecutionPolicy policy = ExecutionPolicy::kParallel) const override;
+
   //! Returns builder fox FaceCenteredGrid.
   static Builder builder();
 
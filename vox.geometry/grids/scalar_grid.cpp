@@ -25,6 +25,9 @@ namespace geometry {
 
 // MARK: Serialization helpers
 
+// The grid data is read from the flat buffers in place
+static_assert(FLATBUFFERS_LITTLEENDIAN, "Mapped grid data requires a little-endian target.");
+
 template <size_t N> struct GetFlatbuffersScalarGrid {};
 
 template <> struct GetFlatbuffersScalarGrid<2> {
@@ -88,6 +91,15 @@ template <size_t N> double ScalarGrid<N>::sample(const Vector<double, N> &x) con
 
 template <size_t N> std::function<double(const Vector<double, N> &)> ScalarGrid<N>::sampler() const { return _sampler; }
 
+template <size_t N>
+void ScalarGrid<N>::sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<double> result,
+                           ExecutionPolicy policy) const {
+  JET_THROW_INVALID_ARG_IF(x.length() != result.length());
+
+  parallelFor(
+      kZeroSize, x.length(), [&](size_t i) { result[i] = _linearSampler(x[i]); }, policy);
+}
+
 template <size_t N> Vector<double, N> ScalarGrid<N>::gradient(const Vector<double, N> &x) const {
   constexpr size_t kNumPoints = 1u << N;
   std::array<Vector<size_t, N>, kNumPoints> indices;
@@ -137,39 +149,9 @@ template <size_t N> void ScalarGrid<N>::fill(double value, ExecutionPolicy polic
       Vector<size_t, N>(), _data.size(), [this, value](auto... indices) { _data(indices...) = value; }, policy);
 }
 
-template <size_t N>
-void ScalarGrid<N>::fill(const std::function<double(const Vector<double, N> &)> &func, ExecutionPolicy policy) {
-  auto pos = dataPosition();
-  parallelForEachIndex(
-      Vector<size_t, N>(), _data.size(),
-      [this, &func, &pos](auto... indices) { _data(indices...) = func(pos(Vector<size_t, N>(indices...))); }, policy);
-}
-
-template <size_t N>
-void ScalarGrid<N>::forEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  forEachIndex(_data.size(), GetUnroll<void, N>::unroll(func));
-}
-
-template <size_t N>
-void ScalarGrid<N>::parallelForEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const {
-  parallelForEachIndex(_data.size(), GetUnroll<void, N>::unroll(func));
-}
-
 template <size_t N> void ScalarGrid<N>::serialize(std::vector<uint8_t> *buffer) const {
-  flatbuffers::FlatBufferBuilder builder(1024);
-
-  auto fbsResolution = jetToFbs(resolution());
-  auto fbsGridSpacing = jetToFbs(gridSpacing());
-  auto fbsOrigin = jetToFbs(origin());
-
-  Array1<double> gridData;
-  getData(gridData);
-  auto data = builder.CreateVector(gridData.data(), gridData.length());
-
-  auto fbsGrid =
-      GetFlatbuffersScalarGrid<N>::createScalarGrid(builder, &fbsResolution, &fbsGridSpacing, &fbsOrigin, data);
-
-  builder.Finish(fbsGrid);
+  flatbuffers::FlatBufferBuilder builder(1024 + sizeof(double) * _data.length());
+  buildScalarGrid(&builder);
 
   uint8_t *buf = builder.GetBufferPointer();
   size_t size = builder.GetSize();
@@ -179,15 +161,57 @@ template <size_t N> void ScalarGrid<N>::serialize(std::vector<uint8_t> *buffer)
 }
 
 template <size_t N> void ScalarGrid<N>::deserialize(const std::vector<uint8_t> &buffer) {
+  deserializeFromMemory(ConstArrayView1<uint8_t>(buffer.data(), buffer.size()));
+}
+
+template <size_t N> void ScalarGrid<N>::serializeToFile(int fd) const {
+  flatbuffers::FlatBufferBuilder builder(1024 + sizeof(double) * _data.length());
+  buildScalarGrid(&builder);
+
+  internal::writeToFile(fd, builder.GetBufferPointer(), builder.GetSize());
+}
+
+template <size_t N> void ScalarGrid<N>::deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) {
   auto fbsGrid = GetFlatbuffersScalarGrid<N>::getScalarGrid(buffer.data());
 
   resize(fbsToJet(*fbsGrid->resolution()), fbsToJet(*fbsGrid->gridSpacing()), fbsToJet(*fbsGrid->origin()));
 
   auto data = fbsGrid->data();
-  Array1<double> gridData(data->size());
-  std::copy(data->begin(), data->end(), gridData.begin());
+  setData(ConstArrayView1<double>(data->data(), data->size()));
+}
+
+template <size_t N>
+typename ScalarGrid<N>::ConstScalarDataView ScalarGrid<N>::mappedDataView(const ConstArrayView1<uint8_t> &buffer) {
+  auto fbsGrid = GetFlatbuffersScalarGrid<N>::getScalarGrid(buffer.data());
+
+  const Vector<size_t, N> resolution = fbsToJet(*fbsGrid->resolution());
+  const Vector<size_t, N> vertexResolution = resolution + Vector<size_t, N>::makeConstant(1);
+  const size_t length = fbsGrid->data()->size();
+
+  Vector<size_t, N> size;
+  if (product(resolution, kOneSize) == length) {
+    size = resolution;
+  } else if (product(vertexResolution, kOneSize) == length) {
+    size = vertexResolution;
+  } else {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(true, "Data length does not match the grid resolution.");
+  }
+
+  return ConstScalarDataView(fbsGrid->data()->data(), size);
+}
+
+template <size_t N> void ScalarGrid<N>::buildScalarGrid(flatbuffers::FlatBufferBuilder *builder) const {
+  auto fbsResolution = jetToFbs(resolution());
+  auto fbsGridSpacing = jetToFbs(gridSpacing());
+  auto fbsOrigin = jetToFbs(origin());
+
+  // The data array is contiguous, so it is copied into the builder directly
+  auto data = builder->CreateVector(_data.data(), _data.length());
+
+  auto fbsGrid =
+      GetFlatbuffersScalarGrid<N>::createScalarGrid(*builder, &fbsResolution, &fbsGridSpacing, &fbsOrigin, data);
 
-  setData(gridData);
+  builder->Finish(fbsGrid);
 }
 
 template <size_t N> void ScalarGrid<N>::swapScalarGrid(ScalarGrid *other) {
@@ -12,8 +12,19 @@
 #include "../array_view.h"
 #include "../fields/scalar_field.h"
 #include "../grid.h"
+#include "../iteration_utils.h"
 #include "../parallel.h"
 
+#ifndef JET_DOXYGEN
+
+namespace flatbuffers {
+
+class FlatBufferBuilder;
+
+} // namespace flatbuffers
+
+#endif // JET_DOXYGEN
+
 namespace vox {
 namespace geometry {
 
@@ -112,27 +123,34 @@ public:
   //! Fills the grid with given value.
   void fill(double value, ExecutionPolicy policy = ExecutionPolicy::kParallel);
 
-  //! Fills the grid with given position-to-value mapping function.
-  void fill(const std::function<double(const Vector<double, N> &)> &func,
-            ExecutionPolicy policy = ExecutionPolicy::kParallel);
+  //!
+  //! \brief Fills the grid with given position-to-value mapping function.
+  //!
+  //! \p func is callable as double(const Vector<double, N> &) and is invoked
+  //! directly without type erasure.
+  //!
+  template <typename Func, typename = std::enable_if_t<std::is_invocable_v<const Func &, const Vector<double, N> &>>>
+  void fill(const Func &func, ExecutionPolicy policy = ExecutionPolicy::kParallel) {
+    const Vector<double, N> o = dataOrigin();
+    const Vector<double, N> gs = gridSpacing();
+    parallelForEachIndex(
+        Vector<size_t, N>(), _data.size(),
+        [this, &func, &o, &gs](auto... indices) {
+          _data(indices...) = func(o + elemMul(gs, Vector<size_t, N>(indices...).template castTo<double>()));
+        },
+        policy);
+  }
 
   //!
   //! \brief Invokes the given function \p func for each data point.
   //!
   //! This function invokes the given function object \p func for each data
   //! point in serial manner. The input parameters are i, j, ... indices of a
-  //! data point. The order of execution is i-first, j-next.
+  //! data point, or the index vector. The order of execution is i-first,
+  //! j-next.
   //!
-  void forEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
-
-  template <size_t M = N>
-  std::enable_if_t<M == 2, void> forEachDataPointIndex(const std::function<void(size_t, size_t)> &func) const {
-    forEachDataPointIndex([&func](const Vector2UZ &idx) { func(idx.x, idx.y); });
-  }
-
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void> forEachDataPointIndex(const std::function<void(size_t, size_t, size_t)> &func) const {
-    forEachDataPointIndex([&func](const Vector3UZ &idx) { func(idx.x, idx.y, idx.z); });
+  template <typename Callback> void forEachDataPointIndex(const Callback &func) const {
+    forEachIndex(_data.size(), unrollIndices<N>(func));
   }
 
   //!
@@ -141,20 +159,11 @@ public:
   //!
   //! This function invokes the given function object \p func for each data
   //! point in parallel manner. The input parameters are i, j, ... indices of
-  //! a data point. The order of execution can be arbitrary since it's
-  //! multi-threaded.
+  //! a data point, or the index vector. The order of execution can be
+  //! arbitrary since it's multi-threaded.
   //!
-  void parallelForEachDataPointIndex(const std::function<void(const Vector<size_t, N> &)> &func) const;
-
-  template <size_t M = N>
-  std::enable_if_t<M == 2, void> parallelForEachDataPointIndex(const std::function<void(size_t, size_t)> &func) const {
-    parallelForEachDataPointIndex([&func](const Vector2UZ &idx) { func(idx.x, idx.y); });
-  }
-
-  template <size_t M = N>
-  std::enable_if_t<M == 3, void>
-  parallelForEachDataPointIndex(const std::function<void(size_t, size_t, size_t)> &func) const {
-    parallelForEachDataPointIndex([&func](const Vector3UZ &idx) { func(idx.x, idx.y, idx.z); });
+  template <typename Callback> void parallelForEachDataPointIndex(const Callback &func) const {
+    parallelForEachIndex(_data.size(), unrollIndices<N>(func));
   }
 
   // ScalarField implementations
@@ -175,6 +184,16 @@ public:
   //!
   std::function<double(const Vector<double, N> &)> sampler() const override;
 
+  //!
+  //! \brief Samples the grid at every position in \p x into \p result.
+  //!
+  //! This function returns the same values as sample, but the linear
+  //! sampling is inlined into the loop instead of being called through the
+  //! virtual function and the std::function for each position.
+  //!
+  virtual void sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<double> result,
+                      ExecutionPolicy policy = ExecutionPolicy::kParallel) const;
+
   //! Returns the gradient vector at given position \p x.
   Vector<double, N> gradient(const Vector<double, N> &x) const override;
 
@@ -187,6 +206,22 @@ public:
   //! Deserializes the input buffer to the grid instance.
   void deserialize(const std::vector<uint8_t> &buffer) override;
 
+  //! Serializes the grid instance to \p fd without an intermediate buffer.
+  void serializeToFile(int fd) const override;
+
+  //! Deserializes the input buffer, which can be memory mapped, to the grid instance.
+  void deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) override;
+
+  //!
+  //! \brief Returns the view of the data in a serialized grid without copying.
+  //!
+  //! The returned view points into \p buffer, typically a MappedFile, and is
+  //! only valid as long as the buffer is. The size of the data is resolved
+  //! from the resolution stored in the buffer, either the resolution itself
+  //! (cell-centered grids) or the resolution plus one (vertex-centered grids).
+  //!
+  static ConstScalarDataView mappedDataView(const ConstArrayView1<uint8_t> &buffer);
+
 protected:
   using Grid<N>::setSizeParameters;
   using Grid<N>::swapGrid;
@@ -210,6 +245,8 @@ private:
   std::function<double(const Vector<double, N> &)> _sampler;
 
   void resetSampler();
+
+  void buildScalarGrid(flatbuffers::FlatBufferBuilder *builder) const;
 };
 
 //! 2-D ScalarGrid type.
@@ -0,0 +1,425 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../common.h"
+
+#include "../level_set_utils.h"
+#include "../parallel.h"
+#include "sparse_scalar_grid3.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+constexpr size_t kLeafSize = SparseScalarGrid3::kLeafSize;
+constexpr size_t kNodeSize = SparseScalarGrid3::kNodeSize;
+constexpr size_t kNodeSpan = kLeafSize * kNodeSize;
+constexpr size_t kLeafLength = kLeafSize * kLeafSize * kLeafSize;
+constexpr size_t kNodeLength = kNodeSize * kNodeSize * kNodeSize;
+
+inline size_t leafSlot(const Vector3UZ &idx) {
+  return (idx.x / kLeafSize) % kNodeSize +
+         kNodeSize * ((idx.y / kLeafSize) % kNodeSize + kNodeSize * ((idx.z / kLeafSize) % kNodeSize));
+}
+
+inline size_t leafOffset(const Vector3UZ &idx) {
+  return idx.x % kLeafSize + kLeafSize * (idx.y % kLeafSize + kLeafSize * (idx.z % kLeafSize));
+}
+
+inline Vector3UZ leafSlotOrigin(const Vector3UZ &nodeOrigin, size_t slot) {
+  return nodeOrigin +
+         kLeafSize * Vector3UZ(slot % kNodeSize, (slot / kNodeSize) % kNodeSize, slot / (kNodeSize * kNodeSize));
+}
+
+} // namespace
+
+struct SparseScalarGrid3::Leaf {
+  std::array<double, kLeafLength> values;
+};
+
+struct SparseScalarGrid3::Node {
+  std::array<std::unique_ptr<Leaf>, kNodeLength> leaves;
+  std::array<double, kNodeLength> tiles;
+};
+
+SparseScalarGrid3::SparseScalarGrid3() = default;
+
+SparseScalarGrid3::SparseScalarGrid3(const Vector3UZ &resolution, const Vector3D &gridSpacing, const Vector3D &origin,
+                                     double background) {
+  resize(resolution, gridSpacing, origin, background);
+}
+
+SparseScalarGrid3::SparseScalarGrid3(const SparseScalarGrid3 &other) { *this = other; }
+
+SparseScalarGrid3::~SparseScalarGrid3() = default;
+
+SparseScalarGrid3 &SparseScalarGrid3::operator=(const SparseScalarGrid3 &other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  _resolution = other._resolution;
+  _gridSpacing = other._gridSpacing;
+  _origin = other._origin;
+  _background = other._background;
+  _rootSize = other._rootSize;
+  _nodeTiles = other._nodeTiles;
+
+  _nodes.clear();
+  _nodes.resize(other._nodes.size());
+  for (size_t n = 0; n < _nodes.size(); ++n) {
+    const Node *otherNode = other._nodes[n].get();
+    if (otherNode == nullptr) {
+      continue;
+    }
+
+    _nodes[n] = std::make_unique<Node>();
+    _nodes[n]->tiles = otherNode->tiles;
+    for (size_t l = 0; l < kNodeLength; ++l) {
+      if (otherNode->leaves[l] != nullptr) {
+        _nodes[n]->leaves[l] = std::make_unique<Leaf>(*otherNode->leaves[l]);
+      }
+    }
+  }
+
+  return *this;
+}
+
+void SparseScalarGrid3::resize(const Vector3UZ &resolution, const Vector3D &gridSpacing, const Vector3D &origin,
+                               double background) {
+  _resolution = resolution;
+  _gridSpacing = gridSpacing;
+  _origin = origin;
+  _background = background;
+  _rootSize = (resolution + Vector3UZ(kNodeSpan - 1, kNodeSpan - 1, kNodeSpan - 1)) / kNodeSpan;
+
+  _nodes.clear();
+  _nodes.resize(_rootSize.x * _rootSize.y * _rootSize.z);
+  _nodeTiles.assign(_nodes.size(), background);
+}
+
+const Vector3UZ &SparseScalarGrid3::resolution() const { return _resolution; }
+
+const Vector3D &SparseScalarGrid3::gridSpacing() const { return _gridSpacing; }
+
+const Vector3D &SparseScalarGrid3::origin() const { return _origin; }
+
+Vector3UZ SparseScalarGrid3::dataSize() const { return _resolution; }
+
+Vector3D SparseScalarGrid3::dataOrigin() const { return _origin + 0.5 * _gridSpacing; }
+
+GridDataPositionFunc<3> SparseScalarGrid3::dataPosition() const {
+  Vector3D o = dataOrigin();
+  Vector3D gs = _gridSpacing;
+  return GridDataPositionFunc<3>(
+      [o, gs](const Vector3UZ &idx) -> Vector3D { return o + elemMul(gs, idx.castTo<double>()); });
+}
+
+double SparseScalarGrid3::background() const { return _background; }
+
+double SparseScalarGrid3::operator()(const Vector3UZ &idx) const {
+  JET_ASSERT(idx.x < _resolution.x && idx.y < _resolution.y && idx.z < _resolution.z);
+
+  const size_t nodeIndex =
+      idx.x / kNodeSpan + _rootSize.x * (idx.y / kNodeSpan + _rootSize.y * (idx.z / kNodeSpan));
+  const Node *node = _nodes[nodeIndex].get();
+  if (node == nullptr) {
+    return _nodeTiles[nodeIndex];
+  }
+
+  const size_t slot = leafSlot(idx);
+  const Leaf *leaf = node->leaves[slot].get();
+  if (leaf == nullptr) {
+    return node->tiles[slot];
+  }
+
+  return leaf->values[leafOffset(idx)];
+}
+
+double SparseScalarGrid3::operator()(size_t i, size_t j, size_t k) const { return (*this)(Vector3UZ(i, j, k)); }
+
+void SparseScalarGrid3::setValue(const Vector3UZ &idx, double value) {
+  JET_ASSERT(idx.x < _resolution.x && idx.y < _resolution.y && idx.z < _resolution.z);
+
+  const size_t nodeIndex =
+      idx.x / kNodeSpan + _rootSize.x * (idx.y / kNodeSpan + _rootSize.y * (idx.z / kNodeSpan));
+  std::unique_ptr<Node> &node = _nodes[nodeIndex];
+  if (node == nullptr) {
+    node = std::make_unique<Node>();
+    node->tiles.fill(_nodeTiles[nodeIndex]);
+  }
+
+  const size_t slot = leafSlot(idx);
+  std::unique_ptr<Leaf> &leaf = node->leaves[slot];
+  if (leaf == nullptr) {
+    leaf = std::make_unique<Leaf>();
+    leaf->values.fill(node->tiles[slot]);
+  }
+
+  leaf->values[leafOffset(idx)] = value;
+}
+
+bool SparseScalarGrid3::isAllocated(const Vector3UZ &idx) const { return findLeaf(idx) != nullptr; }
+
+void SparseScalarGrid3::fill(double value) {
+  for (auto &node : _nodes) {
+    node.reset();
+  }
+  std::fill(_nodeTiles.begin(), _nodeTiles.end(), value);
+}
+
+void SparseScalarGrid3::fill(const std::function<double(const Vector3D &)> &func, double bandWidth) {
+  _background = bandWidth;
+  fill(bandWidth);
+
+  const Vector3D o = dataOrigin();
+
+  // Returns the value at the center of the data points [begin, end) and sets
+  // the tile value if the region is out of the band
+  auto testRegion = [&](const Vector3UZ &begin, const Vector3UZ &end, double *tile) {
+    const Vector3D lower = elemMul(_gridSpacing, begin.castTo<double>());
+    const Vector3D upper = elemMul(_gridSpacing, (end - Vector3UZ(1, 1, 1)).castTo<double>());
+    const double f = func(o + 0.5 * (lower + upper));
+    *tile = isInsideSdf(f) ? -bandWidth : bandWidth;
+    return std::fabs(f) <= bandWidth + 0.5 * (upper - lower).length();
+  };
+
+  auto clampedEnd = [&](const Vector3UZ &begin, size_t span) -> Vector3UZ {
+    return Vector3UZ(std::min(begin.x + span, _resolution.x), std::min(begin.y + span, _resolution.y),
+                     std::min(begin.z + span, _resolution.z));
+  };
+
+  auto nodeOrigin = [&](size_t nodeIndex) -> Vector3UZ {
+    return kNodeSpan * Vector3UZ(nodeIndex % _rootSize.x, (nodeIndex / _rootSize.x) % _rootSize.y,
+                                 nodeIndex / (_rootSize.x * _rootSize.y));
+  };
+
+  // Nodes
+  parallelFor(kZeroSize, _nodes.size(), [&](size_t nodeIndex) {
+    const Vector3UZ begin = nodeOrigin(nodeIndex);
+    double tile = bandWidth;
+    if (testRegion(begin, clampedEnd(begin, kNodeSpan), &tile)) {
+      _nodes[nodeIndex] = std::make_unique<Node>();
+      _nodes[nodeIndex]->tiles.fill(tile);
+    }
+    _nodeTiles[nodeIndex] = tile;
+  });
+
+  std::vector<std::pair<size_t, size_t>> leafSlots;
+  for (size_t nodeIndex = 0; nodeIndex < _nodes.size(); ++nodeIndex) {
+    if (_nodes[nodeIndex] == nullptr) {
+      continue;
+    }
+
+    const Vector3UZ begin = nodeOrigin(nodeIndex);
+    for (size_t slot = 0; slot < kNodeLength; ++slot) {
+      const Vector3UZ leafBegin = leafSlotOrigin(begin, slot);
+      if (leafBegin.x < _resolution.x && leafBegin.y < _resolution.y && leafBegin.z < _resolution.z) {
+        leafSlots.emplace_back(nodeIndex, slot);
+      }
+    }
+  }
+
+  // Leaves
+  parallelFor(kZeroSize, leafSlots.size(), [&](size_t n) {
+    Node &node = *_nodes[leafSlots[n].first];
+    const size_t slot = leafSlots[n].second;
+    const Vector3UZ begin = leafSlotOrigin(nodeOrigin(leafSlots[n].first), slot);
+    const Vector3UZ end = clampedEnd(begin, kLeafSize);
+
+    double tile = bandWidth;
+    const bool isInBand = testRegion(begin, end, &tile);
+    node.tiles[slot] = tile;
+    if (!isInBand) {
+      return;
+    }
+
+    auto leaf = std::make_unique<Leaf>();
+    leaf->values.fill(tile);
+    for (size_t k = begin.z; k < end.z; ++k) {
+      for (size_t j = begin.y; j < end.y; ++j) {
+        for (size_t i = begin.x; i < end.x; ++i) {
+          const Vector3D x = o + elemMul(_gridSpacing, Vector3D(static_cast<double>(i), static_cast<double>(j),
+                                                                static_cast<double>(k)));
+          leaf->values[leafOffset(Vector3UZ(i, j, k))] = func(x);
+        }
+      }
+    }
+    node.leaves[slot] = std::move(leaf);
+  });
+}
+
+size_t SparseScalarGrid3::numberOfLeaves() const { return leafOrigins().size(); }
+
+size_t SparseScalarGrid3::numberOfAllocatedDataPoints() const {
+  size_t count = 0;
+  forEachLeaf([&](const Vector3UZ &begin, const Vector3UZ &end) {
+    const Vector3UZ size = end - begin;
+    count += size.x * size.y * size.z;
+  });
+  return count;
+}
+
+Vector3D SparseScalarGrid3::gradientAtDataPoint(const Vector3UZ &idx) const {
+  const size_t i = idx.x;
+  const size_t j = idx.y;
+  const size_t k = idx.z;
+  const Vector3UZ &ds = _resolution;
+
+  double left = (*this)((i > 0) ? i - 1 : i, j, k);
+  double right = (*this)((i + 1 < ds.x) ? i + 1 : i, j, k);
+  double down = (*this)(i, (j > 0) ? j - 1 : j, k);
+  double up = (*this)(i, (j + 1 < ds.y) ? j + 1 : j, k);
+  double back = (*this)(i, j, (k > 0) ? k - 1 : k);
+  double front = (*this)(i, j, (k + 1 < ds.z) ? k + 1 : k);
+
+  return 0.5 * elemDiv(Vector3D(right - left, up - down, front - back), _gridSpacing);
+}
+
+double SparseScalarGrid3::laplacianAtDataPoint(const Vector3UZ &idx) const {
+  const size_t i = idx.x;
+  const size_t j = idx.y;
+  const size_t k = idx.z;
+  const Vector3UZ &ds = _resolution;
+  const double center = (*this)(idx);
+
+  double dleft = 0.0;
+  double dright = 0.0;
+  double ddown = 0.0;
+  double dup = 0.0;
+  double dback = 0.0;
+  double dfront = 0.0;
+
+  if (i > 0) {
+    dleft = center - (*this)(i - 1, j, k);
+  }
+  if (i + 1 < ds.x) {
+    dright = (*this)(i + 1, j, k) - center;
+  }
+
+  if (j > 0) {
+    ddown = center - (*this)(i, j - 1, k);
+  }
+  if (j + 1 < ds.y) {
+    dup = (*this)(i, j + 1, k) - center;
+  }
+
+  if (k > 0) {
+    dback = center - (*this)(i, j, k - 1);
+  }
+  if (k + 1 < ds.z) {
+    dfront = (*this)(i, j, k + 1) - center;
+  }
+
+  return (dright - dleft) / square(_gridSpacing.x) + (dup - ddown) / square(_gridSpacing.y) +
+         (dfront - dback) / square(_gridSpacing.z);
+}
+
+double SparseScalarGrid3::sample(const Vector3D &x) const {
+  std::array<Vector3UZ, 8> indices;
+  std::array<double, 8> weights{};
+  getCoordinatesAndWeights(x, indices, weights);
+
+  double result = 0.0;
+  for (size_t n = 0; n < 8; ++n) {
+    result += weights[n] * (*this)(indices[n]);
+  }
+
+  return result;
+}
+
+std::function<double(const Vector3D &)> SparseScalarGrid3::sampler() const {
+  return [this](const Vector3D &x) { return sample(x); };
+}
+
+Vector3D SparseScalarGrid3::gradient(const Vector3D &x) const {
+  std::array<Vector3UZ, 8> indices;
+  std::array<double, 8> weights{};
+  getCoordinatesAndWeights(x, indices, weights);
+
+  Vector3D result;
+  for (size_t n = 0; n < 8; ++n) {
+    result += weights[n] * gradientAtDataPoint(indices[n]);
+  }
+
+  return result;
+}
+
+double SparseScalarGrid3::laplacian(const Vector3D &x) const {
+  std::array<Vector3UZ, 8> indices;
+  std::array<double, 8> weights{};
+  getCoordinatesAndWeights(x, indices, weights);
+
+  double result = 0.0;
+  for (size_t n = 0; n < 8; ++n) {
+    result += weights[n] * laplacianAtDataPoint(indices[n]);
+  }
+
+  return result;
+}
+
+void SparseScalarGrid3::getCoordinatesAndWeights(const Vector3D &x, std::array<Vector3UZ, 8> &indices,
+                                                 std::array<double, 8> &weights) const {
+  JET_ASSERT(_resolution.x > 0 && _resolution.y > 0 && _resolution.z > 0);
+
+  const Vector3D npt = elemDiv(x - dataOrigin(), _gridSpacing);
+
+  Vector3UZ i0;
+  Vector3UZ i1;
+  Vector3D t;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    ssize_t i = 0;
+    const auto size = static_cast<ssize_t>(_resolution[axis]);
+    getBarycentric(npt[axis], 0, size, i, t[axis]);
+    i0[axis] = static_cast<size_t>(i);
+    i1[axis] = std::min(i0[axis] + 1, _resolution[axis] - 1);
+  }
+
+  // x-first ordering, as in LinearArraySampler
+  for (size_t n = 0; n < 8; ++n) {
+    const bool isUpperX = (n & 1) != 0;
+    const bool isUpperY = (n & 2) != 0;
+    const bool isUpperZ = (n & 4) != 0;
+    indices[n] = Vector3UZ(isUpperX ? i1.x : i0.x, isUpperY ? i1.y : i0.y, isUpperZ ? i1.z : i0.z);
+    weights[n] = (isUpperX ? t.x : 1.0 - t.x) * (isUpperY ? t.y : 1.0 - t.y) * (isUpperZ ? t.z : 1.0 - t.z);
+  }
+}
+
+const SparseScalarGrid3::Leaf *SparseScalarGrid3::findLeaf(const Vector3UZ &idx) const {
+  const size_t nodeIndex =
+      idx.x / kNodeSpan + _rootSize.x * (idx.y / kNodeSpan + _rootSize.y * (idx.z / kNodeSpan));
+  const Node *node = _nodes[nodeIndex].get();
+  return (node != nullptr) ? node->leaves[leafSlot(idx)].get() : nullptr;
+}
+
+std::vector<Vector3UZ> SparseScalarGrid3::leafOrigins() const {
+  std::vector<Vector3UZ> origins;
+  for (size_t nodeIndex = 0; nodeIndex < _nodes.size(); ++nodeIndex) {
+    const Node *node = _nodes[nodeIndex].get();
+    if (node == nullptr) {
+      continue;
+    }
+
+    const Vector3UZ nodeOrigin = kNodeSpan * Vector3UZ(nodeIndex % _rootSize.x, (nodeIndex / _rootSize.x) % _rootSize.y,
+                                                      nodeIndex / (_rootSize.x * _rootSize.y));
+    for (size_t slot = 0; slot < kNodeLength; ++slot) {
+      if (node->leaves[slot] != nullptr) {
+        origins.push_back(leafSlotOrigin(nodeOrigin, slot));
+      }
+    }
+  }
+
+  return origins;
+}
+
+Vector3UZ SparseScalarGrid3::leafEnd(const Vector3UZ &begin) const {
+  return {std::min(begin.x + kLeafSize, _resolution.x), std::min(begin.y + kLeafSize, _resolution.y),
+          std::min(begin.z + kLeafSize, _resolution.z)};
+}
@@ -0,0 +1,215 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SPARSE_SCALAR_GRID3_H_
+#define INCLUDE_JET_SPARSE_SCALAR_GRID3_H_
+
+#include "../fields/scalar_field.h"
+#include "../grid.h"
+#include "../iteration_utils.h"
+#include "../parallel.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief 3-D sparse cell-centered scalar grid for narrow-band level sets.
+//!
+//! The data points are stored in a shallow tree, similar to VDB. The leaves
+//! are dense bricks of kLeafSize^3 data points. The nodes hold kNodeSize^3
+//! leaf slots, and the root is a dense array of node slots. An empty slot is
+//! a tile that stores a single value for all of its data points, so the
+//! memory scales with the number of allocated leaves instead of the
+//! resolution. For a level set, only the leaves within a band around the
+//! surface are allocated, and the tiles store +/- the background value
+//! depending on the side.
+//!
+//! The data points are located at the cell centers, as in
+//! CellCenteredScalarGrid3, and the sampling, the gradient and the Laplacian
+//! match those of the dense grid with the same values. The iteration
+//! functions visit the data points of the allocated leaves only.
+//!
+//! This grid is not a ScalarGrid3, so it cannot be passed to the level set
+//! solvers; LevelSetSolver3::reinitialize only takes dense grids. To
+//! reinitialize, rebuild the band with fill() from a distance field instead.
+//!
+class SparseScalarGrid3 final : public ScalarField3 {
+public:
+  //! Number of data points along each axis of a leaf.
+  static constexpr size_t kLeafSize = 8;
+
+  //! Number of leaves along each axis of a node.
+  static constexpr size_t kNodeSize = 16;
+
+  //! Constructs zero-sized grid.
+  SparseScalarGrid3();
+
+  //! Constructs a grid with given resolution, grid spacing, origin and
+  //! background value. No leaf is allocated.
+  explicit SparseScalarGrid3(const Vector3UZ &resolution, const Vector3D &gridSpacing = Vector3D(1, 1, 1),
+                             const Vector3D &origin = Vector3D(), double background = 0.0);
+
+  //! Copy constructor.
+  SparseScalarGrid3(const SparseScalarGrid3 &other);
+
+  //! Default destructor.
+  ~SparseScalarGrid3() override;
+
+  //! Copy assignment operator.
+  SparseScalarGrid3 &operator=(const SparseScalarGrid3 &other);
+
+  //! Resizes the grid and removes all the leaves.
+  void resize(const Vector3UZ &resolution, const Vector3D &gridSpacing = Vector3D(1, 1, 1),
+              const Vector3D &origin = Vector3D(), double background = 0.0);
+
+  //! Returns the grid resolution.
+  [[nodiscard]] const Vector3UZ &resolution() const;
+
+  //! Returns the grid spacing.
+  [[nodiscard]] const Vector3D &gridSpacing() const;
+
+  //! Returns the grid origin, which is the lower corner of the bounding box.
+  [[nodiscard]] const Vector3D &origin() const;
+
+  //! Returns the size of the grid data, which is the resolution.
+  [[nodiscard]] Vector3UZ dataSize() const;
+
+  //! Returns data position for the grid point at (0, 0, 0).
+  [[nodiscard]] Vector3D dataOrigin() const;
+
+  //! Returns the function that maps data point to its position.
+  [[nodiscard]] GridDataPositionFunc<3> dataPosition() const;
+
+  //! Returns the background value.
+  [[nodiscard]] double background() const;
+
+  //! Returns the grid data at given data point.
+  double operator()(const Vector3UZ &idx) const;
+
+  //! Returns the grid data at given data point.
+  double operator()(size_t i, size_t j, size_t k) const;
+
+  //!
+  //! \brief Sets the grid data at given data point.
+  //!
+  //! If the data point is in a tile, a leaf is allocated and filled with the
+  //! tile value first. Setting the data points of allocated leaves is
+  //! thread-safe, allocating a leaf is not.
+  //!
+  void setValue(const Vector3UZ &idx, double value);
+
+  //! Returns true if the given data point belongs to an allocated leaf.
+  [[nodiscard]] bool isAllocated(const Vector3UZ &idx) const;
+
+  //! Removes all the leaves and sets all the data points to \p value.
+  void fill(double value);
+
+  //!
+  //! \brief Fills the narrow band of the given signed-distance function.
+  //!
+  //! This function removes all the leaves and sets the background value to
+  //! \p bandWidth. The function is then evaluated at the center of each node
+  //! and each leaf, top-down. A region whose center distance exceeds
+  //! \p bandWidth by more than its half diagonal lies outside the band, since
+  //! a signed-distance function changes by at most the distance, and becomes a
+  //! tile of +/- \p bandWidth. The other leaves are allocated and evaluated
+  //! at all of their data points. The leaves are filled in parallel.
+  //!
+  void fill(const std::function<double(const Vector3D &)> &func, double bandWidth);
+
+  //! Returns the number of allocated leaves.
+  [[nodiscard]] size_t numberOfLeaves() const;
+
+  //! Returns the number of data points in the allocated leaves.
+  [[nodiscard]] size_t numberOfAllocatedDataPoints() const;
+
+  //! Returns the gradient vector at given data point.
+  [[nodiscard]] Vector3D gradientAtDataPoint(const Vector3UZ &idx) const;
+
+  //! Returns the Laplacian at given data point.
+  [[nodiscard]] double laplacianAtDataPoint(const Vector3UZ &idx) const;
+
+  //!
+  //! \brief Invokes the given function \p func for each allocated leaf.
+  //!
+  //! The input parameters are the lower (inclusive) and upper (exclusive)
+  //! data point indices of the leaf, clamped to the data size.
+  //!
+  template <typename Callback> void forEachLeaf(const Callback &func) const {
+    for (const Vector3UZ &begin : leafOrigins()) {
+      func(begin, leafEnd(begin));
+    }
+  }
+
+  //! Invokes the given function \p func for each data point of the allocated
+  //! leaves in serial manner. \p func takes the i, j, k indices or the index
+  //! vector.
+  template <typename Callback> void forEachDataPointIndex(const Callback &func) const {
+    forEachLeaf(
+        [&](const Vector3UZ &begin, const Vector3UZ &end) { forEachIndex(begin, end, unrollIndices<3>(func)); });
+  }
+
+  //! Invokes the given function \p func for each data point of the allocated
+  //! leaves in parallel. \p func takes the i, j, k indices or the index
+  //! vector.
+  template <typename Callback> void parallelForEachDataPointIndex(const Callback &func) const {
+    const std::vector<Vector3UZ> origins = leafOrigins();
+    parallelFor(kZeroSize, origins.size(), [&](size_t n) {
+      forEachIndex(origins[n], leafEnd(origins[n]), unrollIndices<3>(func));
+    });
+  }
+
+  // ScalarField implementations
+
+  //! Returns the linearly sampled value at given position \p x.
+  [[nodiscard]] double sample(const Vector3D &x) const override;
+
+  //! Returns the sampler function.
+  [[nodiscard]] std::function<double(const Vector3D &)> sampler() const override;
+
+  //! Returns the gradient vector at given position \p x.
+  [[nodiscard]] Vector3D gradient(const Vector3D &x) const override;
+
+  //! Returns the Laplacian at given position \p x.
+  [[nodiscard]] double laplacian(const Vector3D &x) const override;
+
+private:
+  struct Leaf;
+  struct Node;
+
+  Vector3UZ _resolution;
+  Vector3D _gridSpacing = Vector3D(1, 1, 1);
+  Vector3D _origin;
+  double _background = 0.0;
+
+  Vector3UZ _rootSize;
+  std::vector<std::unique_ptr<Node>> _nodes;
+  std::vector<double> _nodeTiles;
+
+  void getCoordinatesAndWeights(const Vector3D &x, std::array<Vector3UZ, 8> &indices,
+                                std::array<double, 8> &weights) const;
+
+  const Leaf *findLeaf(const Vector3UZ &idx) const;
+
+  [[nodiscard]] std::vector<Vector3UZ> leafOrigins() const;
+
+  // Upper (exclusive) data point index of the leaf at begin, clamped to the
+  // data size.
+  [[nodiscard]] Vector3UZ leafEnd(const Vector3UZ &begin) const;
+};
+
+//! Shared pointer for the SparseScalarGrid3 type.
+using SparseScalarGrid3Ptr = std::shared_ptr<SparseScalarGrid3>;
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_SPARSE_SCALAR_GRID3_H_
@@ -27,6 +27,7 @@ public:
   using Grid<N>::resolution;
   using Grid<N>::gridSpacing;
   using Grid<N>::origin;
+  using VectorField<N>::sample;
 
   //! Constructs an empty grid.
   VectorGrid() = default;
@@ -56,6 +57,16 @@ public:
   //! Returns the copy of the grid instance.
   virtual std::shared_ptr<VectorGrid<N>> clone() const = 0;
 
+  //!
+  //! \brief Samples the grid at every position in \p x into \p result.
+  //!
+  //! This function returns the same values as sample, but the sampling is
+  //! inlined into the loop, so there is one virtual call per batch instead of
+  //! indirect calls per position.
+  //!
+  virtual void sample(const ConstArrayView1<Vector<double, N>> &x, ArrayView1<Vector<double, N>> result,
+                      ExecutionPolicy policy = ExecutionPolicy::kParallel) const = 0;
+
   //! Serializes the grid instance to the output buffer.
   void serialize(std::vector<uint8_t> *buffer) const override;
 
@@ -75,6 +75,24 @@ public:
   void fill(const std::function<Vector<double, N>(const Vector<double, N> &)> &func,
             ExecutionPolicy policy = ExecutionPolicy::kParallel) override;
 
+  //!
+  //! \brief Fills the grid with given function without type erasure.
+  //!
+  //! \p func is callable as Vector<double, N>(const Vector<double, N> &).
+  //!
+  template <typename Func, typename = std::enable_if_t<std::is_invocable_v<const Func &, const Vector<double, N> &>>>
+  void fill(const Func &func, ExecutionPolicy policy = ExecutionPolicy::kParallel) {
+    const Vector<double, N> o = this->dataOrigin();
+    const Vector<double, N> h = this->gridSpacing();
+    auto view = this->dataView();
+    parallelForEachIndex(
+        Vector<size_t, N>(), this->dataSize(),
+        [&func, &view, &o, &h](auto... indices) {
+          view(indices...) = func(o + elemMul(h, Vector<size_t, N>(indices...).template castTo<double>()));
+        },
+        policy);
+  }
+
   //! Returns the copy of the grid instance.
   std::shared_ptr<VectorGrid<N>> clone() const override;
 
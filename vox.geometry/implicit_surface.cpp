@@ -6,6 +6,7 @@
 
 #include "common.h"
 
+#include "array.h"
 #include "implicit_surface.h"
 
 namespace vox {
@@ -22,6 +23,32 @@ template <size_t N> double ImplicitSurface<N>::signedDistance(const Vector<doubl
   return (isNormalFlipped) ? -sd : sd;
 }
 
+template <size_t N>
+void ImplicitSurface<N>::signedDistances(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                                         ArrayView1<double> distances) const {
+  JET_THROW_INVALID_ARG_IF(otherPoints.length() != distances.length());
+
+  Array1<Vector<double, N>> otherPointsLocal(otherPoints.length());
+  for (size_t i = 0; i < otherPoints.length(); ++i) {
+    otherPointsLocal[i] = transform.toLocal(otherPoints[i]);
+  }
+  signedDistancesLocal(otherPointsLocal, distances);
+
+  if (isNormalFlipped) {
+    for (double &d : distances) {
+      d = -d;
+    }
+  }
+}
+
+template <size_t N>
+void ImplicitSurface<N>::signedDistancesLocal(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                                              ArrayView1<double> distances) const {
+  for (size_t i = 0; i < otherPoints.length(); ++i) {
+    distances[i] = signedDistanceLocal(otherPoints[i]);
+  }
+}
+
 template <size_t N> double ImplicitSurface<N>::closestDistanceLocal(const Vector<double, N> &otherPoint) const {
   return std::fabs(signedDistanceLocal(otherPoint));
 }
@@ -30,11 +30,21 @@ public:
   //! Returns signed distance from the given point \p otherPoint.
   double signedDistance(const Vector<double, N> &otherPoint) const;
 
+  //! Returns signed distances from the given points \p otherPoints. Nearby
+  //! points should be next to each other since some surfaces query them in
+  //! packets.
+  void signedDistances(const ConstArrayView1<Vector<double, N>> &otherPoints, ArrayView1<double> distances) const;
+
 protected:
   //! Returns signed distance from the given point \p otherPoint in local
   //! space.
   virtual double signedDistanceLocal(const Vector<double, N> &otherPoint) const = 0;
 
+  //! Returns signed distances from the given points \p otherPoints in local
+  //! space.
+  virtual void signedDistancesLocal(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                                    ArrayView1<double> distances) const;
+
 private:
   double closestDistanceLocal(const Vector<double, N> &otherPoint) const override;
 };
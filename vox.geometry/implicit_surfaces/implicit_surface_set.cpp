@@ -41,6 +41,14 @@ template <size_t N> void ImplicitSurfaceSet<N>::updateQueryEngine() {
   buildBvh();
 }
 
+template <size_t N> void ImplicitSurfaceSet<N>::refitQueryEngine() {
+  for (const auto &surface : _surfaces) {
+    surface->refitQueryEngine();
+  }
+
+  updateQueryEngine();
+}
+
 template <size_t N> bool ImplicitSurfaceSet<N>::isBounded() const {
   // All surfaces should be bounded.
   for (const auto &surface : _surfaces) {
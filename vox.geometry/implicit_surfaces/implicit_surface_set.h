@@ -45,6 +45,9 @@ public:
   //! Updates internal spatial query engine.
   void updateQueryEngine() override;
 
+  //! Refits the query engines of the surfaces and rebuilds the BVH over them.
+  void refitQueryEngine() override;
+
   //! Returns true if bounding box can be defined.
   bool isBounded() const override;
 
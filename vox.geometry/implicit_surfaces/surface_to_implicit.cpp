@@ -22,6 +22,8 @@ SurfaceToImplicit<N>::SurfaceToImplicit(const SurfaceToImplicit &other)
 
 template <size_t N> void SurfaceToImplicit<N>::updateQueryEngine() { _surface->updateQueryEngine(); }
 
+template <size_t N> void SurfaceToImplicit<N>::refitQueryEngine() { _surface->refitQueryEngine(); }
+
 template <size_t N> bool SurfaceToImplicit<N>::isBounded() const { return _surface->isBounded(); }
 
 template <size_t N> bool SurfaceToImplicit<N>::isValidGeometry() const { return _surface->isValidGeometry(); }
@@ -63,6 +65,17 @@ template <size_t N> double SurfaceToImplicit<N>::signedDistanceLocal(const Vecto
   return inside ? -x.distanceTo(otherPoint) : x.distanceTo(otherPoint);
 }
 
+template <size_t N>
+void SurfaceToImplicit<N>::signedDistancesLocal(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                                                ArrayView1<double> distances) const {
+  _surface->closestDistances(otherPoints, distances);
+  for (size_t i = 0; i < otherPoints.length(); ++i) {
+    if (_surface->isInside(otherPoints[i])) {
+      distances[i] = -distances[i];
+    }
+  }
+}
+
 template <size_t N>
 typename SurfaceToImplicit<N>::Builder &
 SurfaceToImplicit<N>::Builder::withSurface(const std::shared_ptr<Surface<N>> &surface) {
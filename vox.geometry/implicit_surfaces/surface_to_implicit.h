@@ -38,6 +38,9 @@ public:
   //! Updates internal spatial query engine.
   void updateQueryEngine() override;
 
+  //! Refits the query engine of the raw surface.
+  void refitQueryEngine() override;
+
   //! Returns true if bounding box can be defined.
   [[nodiscard]] bool isBounded() const override;
 
@@ -63,6 +66,9 @@ protected:
 
   double signedDistanceLocal(const Vector<double, N> &otherPoint) const override;
 
+  void signedDistancesLocal(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                            ArrayView1<double> distances) const override;
+
   SurfaceRayIntersection<N> closestIntersectionLocal(const Ray<double, N> &ray) const override;
 
 private:
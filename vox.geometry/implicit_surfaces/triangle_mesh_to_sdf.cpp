@@ -31,6 +31,7 @@
 #include "../array.h"
 #include "../array_utils.h"
 #include "../common.h"
+#include "../parallel.h"
 #include <algorithm>
 #include <vector>
 
@@ -45,16 +46,123 @@ void triangleMeshToSdf(const TriangleMesh3 &mesh, ScalarGrid3 *sdf) {
     return;
   }
 
+  // Query the rows in packets of neighboring data points
+  const GridDataPositionFunc<3> pos = sdf->dataPosition();
+  mesh.updateQueryEngine();
+  parallelFor(kZeroSize, size.y, kZeroSize, size.z, [&](size_t j, size_t k) {
+    Array1<Vector3D> points(size.x);
+    Array1<double> distances(size.x);
+    for (size_t i = 0; i < size.x; ++i) {
+      points[i] = pos(i, j, k);
+    }
+    mesh.closestDistances(points, distances);
+
+    for (size_t i = 0; i < size.x; ++i) {
+      const double d = distances[i];
+      const double sd = mesh.isInside(points[i]) ? -d : d;
+
+      (*sdf)(i, j, k) = sd;
+    }
+  });
+}
+
+void triangleMeshToSdf(const TriangleMesh3 &mesh, double bandWidth, ScalarGrid3 *sdf) {
+  const Vector3UZ size = sdf->dataSize();
+  if (size.x * size.y * size.z == 0) {
+    return;
+  }
+
+  const Vector3D &h = sdf->gridSpacing();
+  const Vector3D o = sdf->dataOrigin();
+  bandWidth = std::max(bandWidth, max3(h.x, h.y, h.z));
+
+  // Rasterize the triangle bounding boxes, expanded by the band. The flood
+  // fill below marks the data points it visits as well.
+  Array3<char> isInBand(size, 0);
+  auto lowerIndex = [&](double x, size_t axis) {
+    return static_cast<size_t>(std::clamp(std::ceil((x - o[axis]) / h[axis]), 0.0, static_cast<double>(size[axis])));
+  };
+  auto upperIndex = [&](double x, size_t axis) {
+    return static_cast<size_t>(
+        std::clamp(std::floor((x - o[axis]) / h[axis]) + 1.0, 0.0, static_cast<double>(size[axis])));
+  };
+  for (size_t t = 0; t < mesh.numberOfTriangles(); ++t) {
+    BoundingBox3D box = mesh.triangle(t).boundingBox();
+    box.expand(bandWidth);
+
+    const Vector3UZ begin(lowerIndex(box.lowerCorner.x, 0), lowerIndex(box.lowerCorner.y, 1),
+                          lowerIndex(box.lowerCorner.z, 2));
+    const Vector3UZ end(upperIndex(box.upperCorner.x, 0), upperIndex(box.upperCorner.y, 1),
+                        upperIndex(box.upperCorner.z, 2));
+    forEachIndex(begin, end, [&](size_t i, size_t j, size_t k) { isInBand(i, j, k) = 1; });
+  }
+
+  // Exact signed distance within the band
   const GridDataPositionFunc<3> pos = sdf->dataPosition();
   mesh.updateQueryEngine();
   sdf->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+    if (!isInBand(i, j, k)) {
+      return;
+    }
+
     const Vector3D p = pos(i, j, k);
-    const double d = mesh.closestDistance(p);
-    const double sd = mesh.isInside(p) ? -d : d;
+    const double d = std::min(mesh.closestDistance(p), bandWidth);
+
+    (*sdf)(i, j, k) = mesh.isInside(p) ? -d : d;
+  });
 
-    (*sdf)(i, j, k) = sd;
+  // Flood-fill the rest. Two neighboring data points out of the band cannot
+  // be on different sides of the surface since the band is wider than the
+  // grid spacing.
+  std::vector<Vector3UZ> stack;
+  forEachIndex(size, [&](size_t i, size_t j, size_t k) {
+    if (isInBand(i, j, k)) {
+      return;
+    }
+
+    const double d = mesh.isInside(pos(i, j, k)) ? -bandWidth : bandWidth;
+    isInBand(i, j, k) = 1;
+    stack.emplace_back(i, j, k);
+    while (!stack.empty()) {
+      const Vector3UZ idx = stack.back();
+      stack.pop_back();
+      (*sdf)(idx) = d;
+
+      for (size_t axis = 0; axis < 3; ++axis) {
+        for (size_t side = 0; side < 2; ++side) {
+          Vector3UZ n = idx;
+          if (side == 0 && n[axis] > 0) {
+            --n[axis];
+          } else if (side == 1 && n[axis] + 1 < size[axis]) {
+            ++n[axis];
+          } else {
+            continue;
+          }
+
+          if (!isInBand(n)) {
+            isInBand(n) = 1;
+            stack.push_back(n);
+          }
+        }
+      }
+    }
   });
 }
 
+void triangleMeshToSdf(const TriangleMesh3 &mesh, double bandWidth, SparseScalarGrid3 *sdf) {
+  const Vector3UZ size = sdf->dataSize();
+  if (size.x * size.y * size.z == 0) {
+    return;
+  }
+
+  mesh.updateQueryEngine();
+  sdf->fill(
+      [&](const Vector3D &p) {
+        const double d = mesh.closestDistance(p);
+        return mesh.isInside(p) ? -d : d;
+      },
+      bandWidth);
+}
+
 } // namespace vox
 } // namespace geometry
@@ -31,6 +31,7 @@
 #define INCLUDE_JET_TRIANGLE_MESH_TO_SDF_H_
 
 #include "../grids/scalar_grid.h"
+#include "../grids/sparse_scalar_grid3.h"
 #include "../surfaces/triangle_mesh3.h"
 
 namespace vox {
@@ -43,6 +44,35 @@ namespace geometry {
 //! \param[in,out]  sdf     The output signed-distance field.
 //!
 void triangleMeshToSdf(const TriangleMesh3 &mesh, ScalarGrid3 *sdf);
+
+//! \brief Generates narrow-band signed-distance field out of given triangle
+//! mesh.
+//! This function computes the exact signed distance only for the data points
+//! within the bounding boxes of the triangles, expanded by \p bandWidth. The
+//! remaining data points are farther than \p bandWidth from the surface, and
+//! are flood-filled region by region. Since such a region does not cross the
+//! surface, its sign is determined with a single TriangleMesh3::isInside call.
+//! The output is clamped to +/- \p bandWidth, which is at least the largest
+//! grid spacing.
+//!
+//! \param[in]      mesh	   The mesh.
+//! \param[in]      bandWidth The width of the band.
+//! \param[in,out]  sdf       The output signed-distance field.
+//!
+void triangleMeshToSdf(const TriangleMesh3 &mesh, double bandWidth, ScalarGrid3 *sdf);
+
+//! \brief Generates narrow-band signed-distance field out of given triangle
+//! mesh.
+//! This function generates signed-distance field from a triangle mesh within
+//! \p bandWidth from the surface, using SparseScalarGrid3::fill. Only the
+//! leaves within the band are allocated and evaluated, and the rest of the
+//! grid is tiled with +/- \p bandWidth.
+//!
+//! \param[in]      mesh	   The mesh.
+//! \param[in]      bandWidth The width of the band.
+//! \param[in,out]  sdf       The output signed-distance field.
+//!
+void triangleMeshToSdf(const TriangleMesh3 &mesh, double bandWidth, SparseScalarGrid3 *sdf);
 } // namespace vox
 } // namespace geometry
 
@@ -10,6 +10,8 @@
 #include "iteration_utils.h"
 #include "parallel.h"
 
+#include <type_traits>
+
 namespace vox {
 namespace geometry {
 
@@ -108,6 +110,20 @@ void parallelForEachIndex(IndexType size, Func func, ExecutionPolicy policy) {
   parallelForEachIndex(IndexType{}, size, func, policy);
 }
 
+//----------------------------------------------------------------------------------------------------------------------
+// MARK: Iteration Adapters
+
+template <size_t N, typename Func> auto unrollIndices(const Func &func) {
+  return [&func](auto... indices) {
+    static_assert(sizeof...(indices) == N, "Invalid number of indices.");
+    if constexpr (std::is_invocable_v<const Func &, decltype(indices)...>) {
+      func(indices...);
+    } else {
+      func(Vector<size_t, N>(indices...));
+    }
+  };
+}
+
 } // namespace vox
 } // namespace geometry
 
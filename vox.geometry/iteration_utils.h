@@ -77,6 +77,16 @@ unroll3(const std::function<ReturnType(const Vector3UZ &)> &func) {
   return [func](size_t i, size_t j, size_t k) { return func(Vector3UZ(i, j, k)); };
 }
 
+//!
+//! \brief Adapts \p func to a function of N size_t indices.
+//!
+//! \p func can take either N size_t indices or a single Vector<size_t, N>.
+//! Unlike GetUnroll, the returned function object is not type-erased, so the
+//! call to \p func can be inlined into the loop. The returned object refers to
+//! \p func which should outlive it.
+//!
+template <size_t N, typename Func> auto unrollIndices(const Func &func);
+
 template <typename ReturnType, size_t N> struct GetUnroll {};
 
 template <typename ReturnType> struct GetUnroll<ReturnType, 1> {
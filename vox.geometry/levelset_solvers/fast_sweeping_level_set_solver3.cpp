@@ -0,0 +1,479 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "../common.h"
+
+#include "../level_set_utils.h"
+#include "../parallel.h"
+#include "fast_sweeping_level_set_solver3.h"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+using namespace vox;
+using namespace geometry;
+
+namespace {
+
+// Largest change of a sweep iteration below which the solution is converged,
+// relative to the grid spacing
+constexpr double kRelativeTolerance = 1e-12;
+
+// States of the cells during the reinitialization
+constexpr char kInactive = 0;
+constexpr char kActive = 1;
+constexpr char kFixed = 2;
+
+// Edge length of the blocks of cells that are swept together
+constexpr size_t kBlockSize = 8;
+
+// Visits the grid in one of the 8 sweeping directions. Bit 0, 1 and 2 of the
+// direction flip the x, y and z order. The grid is split into blocks that are
+// visited hyperplane by hyperplane, bi + bj + bk = level in the flipped block
+// coordinates, and the cells of a block are visited in the flipped
+// lexicographic order. Every cell is visited after its upwind neighbors and
+// before its downwind ones, which gives the same result as the plain
+// Gauss-Seidel sweep. The blocks of a hyperplane only depend on the previous
+// hyperplanes, so they are updated in parallel, while the cells of a block
+// stay close in memory. Returns the largest change returned by
+// update(i, j, k).
+template <typename Function>
+double sweep(const Vector3UZ &size, unsigned int direction, const Function &update) {
+  const Vector3UZ numberOfBlocks = (size + Vector3UZ(kBlockSize - 1, kBlockSize - 1, kBlockSize - 1)) / kBlockSize;
+  const size_t maxBi = numberOfBlocks.x - 1;
+  const size_t maxBj = numberOfBlocks.y - 1;
+  const size_t maxBk = numberOfBlocks.z - 1;
+
+  // Maps a coordinate of the flipped grid back to the grid
+  const bool isBackwardX = (direction & 1) != 0;
+  const bool isBackwardY = (direction & 2) != 0;
+  const bool isBackwardZ = (direction & 4) != 0;
+  auto flip = [](size_t n, size_t index, bool isBackward) { return isBackward ? n - 1 - index : index; };
+
+  auto sweepBlock = [&](size_t bi, size_t bj, size_t bk, double result) {
+    const size_t iEnd = std::min((bi + 1) * kBlockSize, size.x);
+    const size_t jEnd = std::min((bj + 1) * kBlockSize, size.y);
+    const size_t kEnd = std::min((bk + 1) * kBlockSize, size.z);
+
+    for (size_t kk = bk * kBlockSize; kk < kEnd; ++kk) {
+      const size_t k = flip(size.z, kk, isBackwardZ);
+      for (size_t jj = bj * kBlockSize; jj < jEnd; ++jj) {
+        const size_t j = flip(size.y, jj, isBackwardY);
+        for (size_t ii = bi * kBlockSize; ii < iEnd; ++ii) {
+          result = std::max(result, update(flip(size.x, ii, isBackwardX), j, k));
+        }
+      }
+    }
+    return result;
+  };
+
+  double maxChange = 0.0;
+  for (size_t level = 0; level <= maxBi + maxBj + maxBk; ++level) {
+    const size_t bjBegin = (level > maxBi + maxBk) ? level - (maxBi + maxBk) : 0;
+    const size_t bjEnd = std::min(level, maxBj) + 1;
+
+    const double change = parallelReduce(
+        bjBegin, bjEnd, 0.0,
+        [&](size_t begin, size_t end, double result) {
+          for (size_t bj = begin; bj < end; ++bj) {
+            const size_t rest = level - bj;
+            const size_t biBegin = (rest > maxBk) ? rest - maxBk : 0;
+            const size_t biEnd = std::min(rest, maxBi) + 1;
+
+            for (size_t bi = biBegin; bi < biEnd; ++bi) {
+              result = sweepBlock(bi, bj, rest - bi, result);
+            }
+          }
+          return result;
+        },
+        [](double a, double b) { return std::max(a, b); });
+
+    maxChange = std::max(maxChange, change);
+  }
+
+  return maxChange;
+}
+
+// Runs sets of 8 sweeps until the solution stops changing. Returns the number
+// of sets.
+template <typename Function>
+unsigned int sweepUntilConverged(const Vector3UZ &size, unsigned int maxNumberOfIterations, double tolerance,
+                                 const Function &update) {
+  if (size.x == 0 || size.y == 0 || size.z == 0) {
+    return 0;
+  }
+
+  unsigned int iter = 0;
+  while (iter < maxNumberOfIterations) {
+    double change = 0.0;
+    for (unsigned int direction = 0; direction < 8; ++direction) {
+      change = std::max(change, sweep(size, direction, update));
+    }
+
+    ++iter;
+    if (change <= tolerance) {
+      break;
+    }
+  }
+
+  return iter;
+}
+
+// Solves the first-order Godunov discretization of |grad(u)| = 1 for the
+// smallest neighbor values phi along each axis with the grid spacings h and
+// their inverse squares.
+double solveEikonal(std::array<double, 3> phi, std::array<double, 3> h, std::array<double, 3> invHSqr) {
+  // Sort the axes by their neighbor value
+  for (size_t a = 0; a < 2; ++a) {
+    for (size_t b = 2; b > a; --b) {
+      if (phi[b] < phi[b - 1]) {
+        std::swap(phi[b], phi[b - 1]);
+        std::swap(h[b], h[b - 1]);
+        std::swap(invHSqr[b], invHSqr[b - 1]);
+      }
+    }
+  }
+
+  // One-sided solution along the closest axis
+  double solution = phi[0] + h[0];
+
+  // Add the other axes as long as they are upwind of the solution
+  double a = invHSqr[0];
+  double b = -phi[0] * invHSqr[0];
+  double c = square(phi[0]) * invHSqr[0] - 1.0;
+  for (size_t axis = 1; axis < 3 && phi[axis] < solution; ++axis) {
+    a += invHSqr[axis];
+    b -= phi[axis] * invHSqr[axis];
+    c += square(phi[axis]) * invHSqr[axis];
+
+    const double det = b * b - a * c;
+    if (det < 0.0) {
+      break;
+    }
+
+    solution = (-b + std::sqrt(det)) / a;
+  }
+
+  return solution;
+}
+
+// Distance to the interface of a cell next to it, found geometrically from
+// the linear interpolation of the SDF toward the neighbors across the
+// interface.
+double distanceNearInterface(const ConstArrayView3<double> &sdf, const Vector3D &gridSpacing, size_t i, size_t j,
+                             size_t k) {
+  const Vector3UZ size = sdf.size();
+  const double center = sdf(i, j, k);
+  const double absCenter = std::fabs(center);
+  const bool isInside = isInsideSdf(center);
+
+  auto axisDistance = [&](double neighbor, double h, double *distance) {
+    if (isInsideSdf(neighbor) != isInside) {
+      *distance = std::min(*distance, h * absCenter / (absCenter + std::fabs(neighbor)));
+    }
+  };
+
+  Vector3D distance(kMaxD, kMaxD, kMaxD);
+  if (i > 0) {
+    axisDistance(sdf(i - 1, j, k), gridSpacing.x, &distance.x);
+  }
+  if (i + 1 < size.x) {
+    axisDistance(sdf(i + 1, j, k), gridSpacing.x, &distance.x);
+  }
+  if (j > 0) {
+    axisDistance(sdf(i, j - 1, k), gridSpacing.y, &distance.y);
+  }
+  if (j + 1 < size.y) {
+    axisDistance(sdf(i, j + 1, k), gridSpacing.y, &distance.y);
+  }
+  if (k > 0) {
+    axisDistance(sdf(i, j, k - 1), gridSpacing.z, &distance.z);
+  }
+  if (k + 1 < size.z) {
+    axisDistance(sdf(i, j, k + 1), gridSpacing.z, &distance.z);
+  }
+
+  double invDistanceSqr = 0.0;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    if (distance[axis] <= 0.0) {
+      return 0.0;
+    }
+    if (distance[axis] < kMaxD) {
+      invDistanceSqr += 1.0 / square(distance[axis]);
+    }
+  }
+
+  return (invDistanceSqr > 0.0) ? 1.0 / std::sqrt(invDistanceSqr) : kMaxD;
+}
+
+} // namespace
+
+void FastSweepingLevelSetSolver3::reinitialize(const ScalarGrid3 &inputSdf, double maxDistance,
+                                               ScalarGrid3 *outputSdf) {
+  JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
+
+  const Vector3UZ size = inputSdf.dataSize();
+  const Vector3D gridSpacing = inputSdf.gridSpacing();
+  const std::array<double, 3> h = {gridSpacing.x, gridSpacing.y, gridSpacing.z};
+  const std::array<double, 3> invHSqr = {1.0 / square(h[0]), 1.0 / square(h[1]), 1.0 / square(h[2])};
+  const auto input = inputSdf.dataView();
+
+  // Unsigned distance. The cells next to the interface are initialized
+  // geometrically and stay fixed, the others start from infinity. The sweeps
+  // only compare each cell with its neighbors, which have the same sign
+  // except next to the interface.
+  Array3<double> distance(size);
+  Array3<char> states(size);
+  parallelForEachIndex(size, [&](size_t i, size_t j, size_t k) {
+    distance(i, j, k) = distanceNearInterface(input, gridSpacing, i, j, k);
+    states(i, j, k) = (distance(i, j, k) < kMaxD) ? kFixed : kActive;
+  });
+
+  // Only the cells with a changed neighbor since their last update are
+  // active, which makes the sweeps cheap once the solution settles. The
+  // neighbors of a cell are swept in the same block or in the blocks of the
+  // adjacent hyperplanes, so they are never updated concurrently.
+  auto activate = [&](size_t i, size_t j, size_t k) {
+    if (states(i, j, k) != kFixed) {
+      states(i, j, k) = kActive;
+    }
+  };
+
+  auto update = [&](size_t i, size_t j, size_t k) {
+    if (states(i, j, k) != kActive) {
+      return 0.0;
+    }
+    states(i, j, k) = kInactive;
+
+    std::array<double, 3> phi = {kMaxD, kMaxD, kMaxD};
+    if (i > 0) {
+      phi[0] = distance(i - 1, j, k);
+    }
+    if (i + 1 < size.x) {
+      phi[0] = std::min(phi[0], distance(i + 1, j, k));
+    }
+    if (j > 0) {
+      phi[1] = distance(i, j - 1, k);
+    }
+    if (j + 1 < size.y) {
+      phi[1] = std::min(phi[1], distance(i, j + 1, k));
+    }
+    if (k > 0) {
+      phi[2] = distance(i, j, k - 1);
+    }
+    if (k + 1 < size.z) {
+      phi[2] = std::min(phi[2], distance(i, j, k + 1));
+    }
+
+    // The solution is larger than the neighbors, so there is nothing to do
+    // when they are out of range or not closer than the current distance
+    const double oldDistance = distance(i, j, k);
+    const double minPhi = std::min({phi[0], phi[1], phi[2]});
+    if (minPhi > maxDistance || minPhi >= oldDistance) {
+      return 0.0;
+    }
+
+    const double newDistance = solveEikonal(phi, h, invHSqr);
+    if (newDistance < oldDistance) {
+      distance(i, j, k) = newDistance;
+
+      if (i > 0) {
+        activate(i - 1, j, k);
+      }
+      if (i + 1 < size.x) {
+        activate(i + 1, j, k);
+      }
+      if (j > 0) {
+        activate(i, j - 1, k);
+      }
+      if (j + 1 < size.y) {
+        activate(i, j + 1, k);
+      }
+      if (k > 0) {
+        activate(i, j, k - 1);
+      }
+      if (k + 1 < size.z) {
+        activate(i, j, k + 1);
+      }
+
+      return (oldDistance < kMaxD) ? oldDistance - newDistance : kMaxD;
+    }
+
+    return 0.0;
+  };
+
+  const double tolerance = kRelativeTolerance * std::min({h[0], h[1], h[2]});
+  _lastNumberOfIterations = sweepUntilConverged(size, _maxNumberOfIterations, tolerance, update);
+
+  // Out of the given range, keep the input as the fast marching method does
+  auto output = outputSdf->dataView();
+  parallelForEachIndex(size, [&](size_t i, size_t j, size_t k) {
+    const double d = distance(i, j, k);
+    if (d <= maxDistance) {
+      output(i, j, k) = isInsideSdf(input(i, j, k)) ? -d : d;
+    } else {
+      output(i, j, k) = input(i, j, k);
+    }
+  });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const ScalarGrid3 &input, const ScalarField3 &sdf, double maxDistance,
+                                              ScalarGrid3 *output) {
+  JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+  Array3<double> sdfGrid(input.dataSize());
+  auto pos = input.dataPosition();
+  parallelForEachIndex(sdfGrid.size(),
+                       [&](size_t i, size_t j, size_t k) { sdfGrid(i, j, k) = sdf.sample(pos(i, j, k)); });
+
+  extrapolate(input.dataView(), sdfGrid, input.gridSpacing(), maxDistance, output->dataView());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const CollocatedVectorGrid3 &input, const ScalarField3 &sdf,
+                                              double maxDistance, CollocatedVectorGrid3 *output) {
+  JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+  Array3<double> sdfGrid(input.dataSize());
+  auto pos = input.dataPosition();
+  parallelForEachIndex(sdfGrid.size(),
+                       [&](size_t i, size_t j, size_t k) { sdfGrid(i, j, k) = sdf.sample(pos(i, j, k)); });
+
+  const Vector3D gridSpacing = input.gridSpacing();
+
+  Array3<double> u(input.dataSize());
+  Array3<double> u0(input.dataSize());
+  Array3<double> v(input.dataSize());
+  Array3<double> v0(input.dataSize());
+  Array3<double> w(input.dataSize());
+  Array3<double> w0(input.dataSize());
+
+  input.parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+    u(i, j, k) = input(i, j, k).x;
+    v(i, j, k) = input(i, j, k).y;
+    w(i, j, k) = input(i, j, k).z;
+  });
+
+  extrapolate(u, sdfGrid, gridSpacing, maxDistance, u0);
+
+  extrapolate(v, sdfGrid, gridSpacing, maxDistance, v0);
+
+  extrapolate(w, sdfGrid, gridSpacing, maxDistance, w0);
+
+  output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+    (*output)(i, j, k).x = u0(i, j, k);
+    (*output)(i, j, k).y = v0(i, j, k);
+    (*output)(i, j, k).z = w0(i, j, k);
+  });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const FaceCenteredGrid3 &input, const ScalarField3 &sdf,
+                                              double maxDistance, FaceCenteredGrid3 *output) {
+  JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+  const Vector3D &gridSpacing = input.gridSpacing();
+
+  auto u = input.uView();
+  auto uPos = input.uPosition();
+  Array3<double> sdfAtU(u.size());
+  input.parallelForEachUIndex([&](const Vector3UZ &idx) { sdfAtU(idx) = sdf.sample(uPos(idx)); });
+
+  extrapolate(u, sdfAtU, gridSpacing, maxDistance, output->uView());
+
+  auto v = input.vView();
+  auto vPos = input.vPosition();
+  Array3<double> sdfAtV(v.size());
+  input.parallelForEachVIndex([&](const Vector3UZ &idx) { sdfAtV(idx) = sdf.sample(vPos(idx)); });
+
+  extrapolate(v, sdfAtV, gridSpacing, maxDistance, output->vView());
+
+  auto w = input.wView();
+  auto wPos = input.wPosition();
+  Array3<double> sdfAtW(w.size());
+  input.parallelForEachWIndex([&](const Vector3UZ &idx) { sdfAtW(idx) = sdf.sample(wPos(idx)); });
+
+  extrapolate(w, sdfAtW, gridSpacing, maxDistance, output->wView());
+}
+
+unsigned int FastSweepingLevelSetSolver3::maxNumberOfIterations() const { return _maxNumberOfIterations; }
+
+void FastSweepingLevelSetSolver3::setMaxNumberOfIterations(unsigned int newMaxNumberOfIterations) {
+  _maxNumberOfIterations = std::max(newMaxNumberOfIterations, 1u);
+}
+
+unsigned int FastSweepingLevelSetSolver3::lastNumberOfIterations() const { return _lastNumberOfIterations; }
+
+void FastSweepingLevelSetSolver3::extrapolate(const ConstArrayView3<double> &input, const ConstArrayView3<double> &sdf,
+                                              const Vector3D &gridSpacing, double maxDistance,
+                                              ArrayView3<double> output) {
+  if (input.length() == 0) {
+    _lastNumberOfIterations = 0;
+    return;
+  }
+
+  const Vector3UZ size = input.size();
+  const Vector3D invGridSpacingSqr(1.0 / square(gridSpacing.x), 1.0 / square(gridSpacing.y),
+                                   1.0 / square(gridSpacing.z));
+
+  // The values inside the SDF are known. The others are solved from the
+  // upwind discretization of grad(f) . grad(sdf) = 0, which is a weighted
+  // average of the neighbors with a smaller SDF value.
+  Array3<char> isKnown(size);
+  parallelForEachIndex(size, [&](size_t i, size_t j, size_t k) {
+    isKnown(i, j, k) = isInsideSdf(sdf(i, j, k));
+    output(i, j, k) = input(i, j, k);
+  });
+  Array3<char> isValid(isKnown);
+
+  auto update = [&](size_t i, size_t j, size_t k) {
+    const double center = sdf(i, j, k);
+    if (isKnown(i, j, k) || center > maxDistance) {
+      return 0.0;
+    }
+
+    double sum = 0.0;
+    double weightSum = 0.0;
+    auto addAxis = [&](bool hasMinus, size_t im, size_t jm, size_t km, bool hasPlus, size_t ip, size_t jp, size_t kp,
+                       double invHSqr) {
+      // The upwind neighbor is the one with the smaller SDF value
+      bool useMinus = hasMinus && isValid(im, jm, km) && sdf(im, jm, km) < center;
+      bool usePlus = hasPlus && isValid(ip, jp, kp) && sdf(ip, jp, kp) < center;
+      if (useMinus && usePlus) {
+        useMinus = sdf(im, jm, km) <= sdf(ip, jp, kp);
+        usePlus = !useMinus;
+      }
+
+      if (useMinus) {
+        const double weight = (center - sdf(im, jm, km)) * invHSqr;
+        sum += weight * output(im, jm, km);
+        weightSum += weight;
+      } else if (usePlus) {
+        const double weight = (center - sdf(ip, jp, kp)) * invHSqr;
+        sum += weight * output(ip, jp, kp);
+        weightSum += weight;
+      }
+    };
+
+    addAxis(i > 0, i - 1, j, k, i + 1 < size.x, i + 1, j, k, invGridSpacingSqr.x);
+    addAxis(j > 0, i, j - 1, k, j + 1 < size.y, i, j + 1, k, invGridSpacingSqr.y);
+    addAxis(k > 0, i, j, k - 1, k + 1 < size.z, i, j, k + 1, invGridSpacingSqr.z);
+
+    if (weightSum <= 0.0) {
+      return 0.0;
+    }
+
+    const double newValue = sum / weightSum;
+    const double change = isValid(i, j, k) ? std::fabs(newValue - output(i, j, k)) : kMaxD;
+    output(i, j, k) = newValue;
+    isValid(i, j, k) = 1;
+    return change;
+  };
+
+  const double tolerance =
+      kRelativeTolerance * std::max(std::fabs(*std::max_element(input.begin(), input.end())),
+                                    std::fabs(*std::min_element(input.begin(), input.end())));
+  _lastNumberOfIterations = sweepUntilConverged(size, _maxNumberOfIterations, tolerance, update);
+}
@@ -0,0 +1,110 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
+#define INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
+
+#include "../level_set_solver3.h"
+#include <memory>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief Three-dimensional fast sweeping method (FSM) implementation.
+//!
+//! This class solves the Eikonal equation with Gauss-Seidel iterations that
+//! alternate between the 8 sweeping directions of the grid. First-order
+//! Godunov upwind differencing is used, as in FmmLevelSetSolver3. Each sweep
+//! visits the grid hyperplane by hyperplane (i + j + k = const), and the cells
+//! of a hyperplane only depend on the previous one, so they are updated in
+//! parallel. Unlike the fast marching method, there is no priority queue and
+//! the cost is O(N) per sweep.
+//!
+//! \see Zhao, Hongkai. "A fast sweeping method for eikonal equations."
+//!      Mathematics of computation 74.250 (2005): 603-627.
+//! \see Detrixhe, Miles, Frederic Gibou, and Chohong Min. "A parallel fast
+//!      sweeping method for the Eikonal equation." Journal of Computational
+//!      Physics 237 (2013): 46-55.
+//!
+class FastSweepingLevelSetSolver3 final : public LevelSetSolver3 {
+public:
+  //! Default constructor.
+  FastSweepingLevelSetSolver3() = default;
+
+  //!
+  //! Reinitialize given scalar field to signed-distance field.
+  //!
+  //! \param inputSdf Input signed-distance field which can be distorted.
+  //! \param maxDistance Max range of reinitialization.
+  //! \param outputSdf Output signed-distance field.
+  //!
+  void reinitialize(const ScalarGrid3 &inputSdf, double maxDistance, ScalarGrid3 *outputSdf) override;
+
+  //!
+  //! Extrapolates given scalar field from negative to positive SDF region.
+  //!
+  //! \param input Input scalar field to be extrapolated.
+  //! \param sdf Reference signed-distance field.
+  //! \param maxDistance Max range of extrapolation.
+  //! \param output Output scalar field.
+  //!
+  void extrapolate(const ScalarGrid3 &input, const ScalarField3 &sdf, double maxDistance, ScalarGrid3 *output) override;
+
+  //!
+  //! Extrapolates given collocated vector field from negative to positive SDF
+  //! region.
+  //!
+  //! \param input Input collocated vector field to be extrapolated.
+  //! \param sdf Reference signed-distance field.
+  //! \param maxDistance Max range of extrapolation.
+  //! \param output Output collocated vector field.
+  //!
+  void extrapolate(const CollocatedVectorGrid3 &input, const ScalarField3 &sdf, double maxDistance,
+                   CollocatedVectorGrid3 *output) override;
+
+  //!
+  //! Extrapolates given face-centered vector field from negative to positive
+  //! SDF region.
+  //!
+  //! \param input Input face-centered field to be extrapolated.
+  //! \param sdf Reference signed-distance field.
+  //! \param maxDistance Max range of extrapolation.
+  //! \param output Output face-centered vector field.
+  //!
+  void extrapolate(const FaceCenteredGrid3 &input, const ScalarField3 &sdf, double maxDistance,
+                   FaceCenteredGrid3 *output) override;
+
+  //! Returns the maximum number of iterations, each made of 8 sweeps.
+  [[nodiscard]] unsigned int maxNumberOfIterations() const;
+
+  //!
+  //! \brief Sets the maximum number of iterations.
+  //!
+  //! The iterations stop earlier once a full set of 8 sweeps leaves the
+  //! solution unchanged. Simple shapes converge after the first iteration, so
+  //! most solves take two. The input will be clamped to 1.
+  //!
+  void setMaxNumberOfIterations(unsigned int newMaxNumberOfIterations);
+
+  //! Returns the number of iterations of the last solve.
+  [[nodiscard]] unsigned int lastNumberOfIterations() const;
+
+private:
+  unsigned int _maxNumberOfIterations = 8;
+  unsigned int _lastNumberOfIterations = 0;
+
+  void extrapolate(const ConstArrayView3<double> &input, const ConstArrayView3<double> &sdf,
+                   const Vector3D &gridSpacing, double maxDistance, ArrayView3<double> output);
+};
+
+//! Shared pointer type for the FastSweepingLevelSetSolver3.
+using FastSweepingLevelSetSolver3Ptr = std::shared_ptr<FastSweepingLevelSetSolver3>;
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
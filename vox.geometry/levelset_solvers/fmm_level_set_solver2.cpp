@@ -8,8 +8,10 @@
 #include "../common.h"
 #include "../fdm_utils.h"
 #include "../level_set_utils.h"
+#include "../untidy_priority_queue.h"
 
 #include <algorithm>
+#include <cmath>
 #include <queue>
 #include <vector>
 
@@ -20,6 +22,9 @@ static const char kUnknown = 0;
 static const char kKnown = 1;
 static const char kTrial = 2;
 
+// Width of the buckets of the narrow-band queue relative to the grid spacing
+static const double kBucketWidthRatio = 0.1;
+
 // Find geometric solution near the boundary
 inline double solveQuadNearBoundary(const Array2<char> &markers, ArrayView2<double> output, const Vector2D &gridSpacing,
                                     const Vector2D &invGridSpacingSqr, double sign, size_t i, size_t j) {
@@ -157,6 +162,118 @@ inline double solveQuad(const Array2<char> &markers, ArrayView2<double> output,
   return solution;
 }
 
+// Reinitializes the cells up to maxDistance from the interface in the order of
+// an untidy priority queue. Both sides are marched at once on the unsigned
+// distance, and the trial values are updated whenever a neighbor is accepted.
+// The cells beyond maxDistance are accepted without visiting their neighbors,
+// so after the scan for the interface, the cost scales with the area of the
+// band.
+static void reinitializeNarrowBand(ArrayView2<double> output, const Vector2D &gridSpacing,
+                                   const Vector2D &invGridSpacingSqr, double maxDistance) {
+  Vector2UZ size = output.size();
+  Array2<char> markers(size, kUnknown);
+
+  // Visited cells, whose output holds the unsigned distance until the end
+  std::vector<Vector2UZ> band;
+  std::vector<char> isBandInside;
+
+  // Solve geometrically near the boundary
+  std::vector<double> distToBnd;
+  forEachIndex(size, [&](size_t i, size_t j) {
+    const bool isInside = isInsideSdf(output(i, j));
+    if ((i > 0 && isInsideSdf(output(i - 1, j)) != isInside) ||
+        (i + 1 < size.x && isInsideSdf(output(i + 1, j)) != isInside) ||
+        (j > 0 && isInsideSdf(output(i, j - 1)) != isInside) ||
+        (j + 1 < size.y && isInsideSdf(output(i, j + 1)) != isInside)) {
+      band.emplace_back(i, j);
+      isBandInside.push_back(isInside);
+      distToBnd.push_back(std::fabs(
+          solveQuadNearBoundary(markers, output, gridSpacing, invGridSpacingSqr, isInside ? -1.0 : 1.0, i, j)));
+    }
+  });
+
+  const size_t numberOfBoundaryCells = band.size();
+  for (size_t n = 0; n < numberOfBoundaryCells; ++n) {
+    output(band[n]) = distToBnd[n];
+    markers(band[n]) = kKnown;
+  }
+
+  // A new trial value exceeds the accepted one by at most a grid spacing, and
+  // the initial ones are within two grid spacings from zero
+  const double bucketWidth = kBucketWidthRatio * std::min(gridSpacing.x, gridSpacing.y);
+  const auto numberOfBuckets =
+      static_cast<size_t>(std::ceil(2.0 * std::max(gridSpacing.x, gridSpacing.y) / bucketWidth)) + 2;
+  UntidyPriorityQueue<Vector2UZ> trial(bucketWidth, numberOfBuckets);
+
+  auto updateTrial = [&](size_t i, size_t j) {
+    if (markers(i, j) == kKnown) {
+      return;
+    }
+
+    double value = solveQuad(markers, output, gridSpacing, invGridSpacingSqr, i, j);
+    if (markers(i, j) == kUnknown) {
+      band.emplace_back(i, j);
+      isBandInside.push_back(isInsideSdf(output(i, j)));
+    } else if (value >= output(i, j)) {
+      return;
+    }
+
+    markers(i, j) = kTrial;
+    output(i, j) = value;
+    trial.push(Vector2UZ(i, j), value);
+  };
+
+  auto updateNeighbors = [&](size_t i, size_t j) {
+    if (i > 0) {
+      updateTrial(i - 1, j);
+    }
+    if (i + 1 < size.x) {
+      updateTrial(i + 1, j);
+    }
+    if (j > 0) {
+      updateTrial(i, j - 1);
+    }
+    if (j + 1 < size.y) {
+      updateTrial(i, j + 1);
+    }
+  };
+
+  // Enqueue initial candidates
+  for (size_t n = 0; n < numberOfBoundaryCells; ++n) {
+    const Vector2UZ idx = band[n];
+    updateNeighbors(idx.x, idx.y);
+  }
+
+  // Propagate
+  while (!trial.empty()) {
+    Vector2UZ idx = trial.pop();
+
+    size_t i = idx.x;
+    size_t j = idx.y;
+
+    // Skip the entries of the values that were updated later
+    if (markers(i, j) == kKnown) {
+      continue;
+    }
+
+    markers(i, j) = kKnown;
+    output(i, j) = solveQuad(markers, output, gridSpacing, invGridSpacingSqr, i, j);
+
+    if (output(i, j) <= maxDistance) {
+      updateNeighbors(i, j);
+    }
+  }
+
+  // Restore the sign
+  for (size_t n = 0; n < band.size(); ++n) {
+    if (isBandInside[n]) {
+      output(band[n]) = -output(band[n]);
+    }
+  }
+}
+
+FmmLevelSetSolver2::FmmLevelSetSolver2(bool useNarrowBand) : _useNarrowBand(useNarrowBand) {}
+
 void FmmLevelSetSolver2::reinitialize(const ScalarGrid2 &inputSdf, double maxDistance, ScalarGrid2 *outputSdf) {
   JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
 
@@ -164,11 +281,17 @@ void FmmLevelSetSolver2::reinitialize(const ScalarGrid2 &inputSdf, double maxDis
   Vector2D gridSpacing = inputSdf.gridSpacing();
   Vector2D invGridSpacing = 1.0 / gridSpacing;
   Vector2D invGridSpacingSqr = elemMul(invGridSpacing, invGridSpacing);
-  Array2<char> markers(size);
 
   auto output = outputSdf->dataView();
 
-  parallelForEachIndex(markers.size(), [&](size_t i, size_t j) { output(i, j) = inputSdf(i, j); });
+  parallelForEachIndex(size, [&](size_t i, size_t j) { output(i, j) = inputSdf(i, j); });
+
+  if (_useNarrowBand) {
+    reinitializeNarrowBand(output, gridSpacing, invGridSpacingSqr, maxDistance);
+    return;
+  }
+
+  Array2<char> markers(size);
 
   // Solve geometrically near the boundary
   forEachIndex(markers.size(), [&](size_t i, size_t j) {
@@ -321,6 +444,8 @@ void FmmLevelSetSolver2::extrapolate(const FaceCenteredGrid2 &input, const Scala
   extrapolate(v, sdfAtV, gridSpacing, maxDistance, output->vView());
 }
 
+bool FmmLevelSetSolver2::useNarrowBand() const { return _useNarrowBand; }
+
 void FmmLevelSetSolver2::extrapolate(const ConstArrayView2<double> &input, const ConstArrayView2<double> &sdf,
                                      const Vector2D &gridSpacing, double maxDistance, ArrayView2<double> output) {
   Vector2UZ size = input.size();
@@ -27,8 +27,19 @@ namespace geometry {
 //!
 class FmmLevelSetSolver2 final : public LevelSetSolver2 {
 public:
-  //! Default constructor.
-  FmmLevelSetSolver2() = default;
+  //!
+  //! \brief Constructs the solver.
+  //!
+  //! In the narrow-band mode, the marching stops at the max distance of the
+  //! reinitialization without visiting the far cells, and the heap is
+  //! replaced by an untidy bucketed priority queue with O(1) operations. The
+  //! cells are accepted out of order within a tenth of the grid spacing, and
+  //! the trial values are updated as their neighbors are accepted. The cost
+  //! then scales with the size of the band instead of the grid.
+  //!
+  //! \param useNarrowBand True to use the narrow-band mode.
+  //!
+  explicit FmmLevelSetSolver2(bool useNarrowBand = false);
 
   //!
   //! Reinitialize given scalar field to signed-distance field.
@@ -73,7 +84,12 @@ public:
   void extrapolate(const FaceCenteredGrid2 &input, const ScalarField2 &sdf, double maxDistance,
                    FaceCenteredGrid2 *output) override;
 
+  //! Returns true if the narrow-band mode is used.
+  [[nodiscard]] bool useNarrowBand() const;
+
 private:
+  bool _useNarrowBand = false;
+
   static void extrapolate(const ConstArrayView2<double> &input, const ConstArrayView2<double> &sdf,
                           const Vector2D &gridSpacing, double maxDistance, ArrayView2<double> output);
 };
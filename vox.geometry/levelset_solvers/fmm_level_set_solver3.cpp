@@ -8,9 +8,11 @@
 
 #include "../fdm_utils.h"
 #include "../level_set_utils.h"
+#include "../untidy_priority_queue.h"
 #include "fmm_level_set_solver3.h"
 
 #include <algorithm>
+#include <cmath>
 #include <queue>
 #include <vector>
 
@@ -21,6 +23,9 @@ static const char kUnknown = 0;
 static const char kKnown = 1;
 static const char kTrial = 2;
 
+// Width of the buckets of the narrow-band queue relative to the grid spacing
+static const double kBucketWidthRatio = 0.1;
+
 // Find geometric solution near the boundary
 inline double solveQuadNearBoundary(const Array3<char> &markers, ConstArrayView3<double> output,
                                     const Vector3D &gridSpacing, const Vector3D &invGridSpacingSqr, double sign,
@@ -208,6 +213,127 @@ inline double solveQuad(const Array3<char> &markers, ArrayView3<double> output,
   return solution;
 }
 
+// Reinitializes the cells up to maxDistance from the interface in the order of
+// an untidy priority queue. Both sides are marched at once on the unsigned
+// distance, and the trial values are updated whenever a neighbor is accepted.
+// The cells beyond maxDistance are accepted without visiting their neighbors,
+// so after the scan for the interface, the cost scales with the volume of the
+// band.
+static void reinitializeNarrowBand(ArrayView3<double> output, const Vector3D &gridSpacing,
+                                   const Vector3D &invGridSpacingSqr, double maxDistance) {
+  Vector3UZ size = output.size();
+  Array3<char> markers(size, kUnknown);
+
+  // Visited cells, whose output holds the unsigned distance until the end
+  std::vector<Vector3UZ> band;
+  std::vector<char> isBandInside;
+
+  // Solve geometrically near the boundary
+  std::vector<double> distToBnd;
+  forEachIndex(size, [&](size_t i, size_t j, size_t k) {
+    const bool isInside = isInsideSdf(output(i, j, k));
+    if ((i > 0 && isInsideSdf(output(i - 1, j, k)) != isInside) ||
+        (i + 1 < size.x && isInsideSdf(output(i + 1, j, k)) != isInside) ||
+        (j > 0 && isInsideSdf(output(i, j - 1, k)) != isInside) ||
+        (j + 1 < size.y && isInsideSdf(output(i, j + 1, k)) != isInside) ||
+        (k > 0 && isInsideSdf(output(i, j, k - 1)) != isInside) ||
+        (k + 1 < size.z && isInsideSdf(output(i, j, k + 1)) != isInside)) {
+      band.emplace_back(i, j, k);
+      isBandInside.push_back(isInside);
+      distToBnd.push_back(std::fabs(
+          solveQuadNearBoundary(markers, output, gridSpacing, invGridSpacingSqr, isInside ? -1.0 : 1.0, i, j, k)));
+    }
+  });
+
+  const size_t numberOfBoundaryCells = band.size();
+  for (size_t n = 0; n < numberOfBoundaryCells; ++n) {
+    output(band[n]) = distToBnd[n];
+    markers(band[n]) = kKnown;
+  }
+
+  // A new trial value exceeds the accepted one by at most a grid spacing, and
+  // the initial ones are within two grid spacings from zero
+  const double bucketWidth = kBucketWidthRatio * min3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+  const auto numberOfBuckets =
+      static_cast<size_t>(std::ceil(2.0 * max3(gridSpacing.x, gridSpacing.y, gridSpacing.z) / bucketWidth)) + 2;
+  UntidyPriorityQueue<Vector3UZ> trial(bucketWidth, numberOfBuckets);
+
+  auto updateTrial = [&](size_t i, size_t j, size_t k) {
+    if (markers(i, j, k) == kKnown) {
+      return;
+    }
+
+    double value = solveQuad(markers, output, gridSpacing, invGridSpacingSqr, i, j, k);
+    if (markers(i, j, k) == kUnknown) {
+      band.emplace_back(i, j, k);
+      isBandInside.push_back(isInsideSdf(output(i, j, k)));
+    } else if (value >= output(i, j, k)) {
+      return;
+    }
+
+    markers(i, j, k) = kTrial;
+    output(i, j, k) = value;
+    trial.push(Vector3UZ(i, j, k), value);
+  };
+
+  auto updateNeighbors = [&](size_t i, size_t j, size_t k) {
+    if (i > 0) {
+      updateTrial(i - 1, j, k);
+    }
+    if (i + 1 < size.x) {
+      updateTrial(i + 1, j, k);
+    }
+    if (j > 0) {
+      updateTrial(i, j - 1, k);
+    }
+    if (j + 1 < size.y) {
+      updateTrial(i, j + 1, k);
+    }
+    if (k > 0) {
+      updateTrial(i, j, k - 1);
+    }
+    if (k + 1 < size.z) {
+      updateTrial(i, j, k + 1);
+    }
+  };
+
+  // Enqueue initial candidates
+  for (size_t n = 0; n < numberOfBoundaryCells; ++n) {
+    const Vector3UZ idx = band[n];
+    updateNeighbors(idx.x, idx.y, idx.z);
+  }
+
+  // Propagate
+  while (!trial.empty()) {
+    Vector3UZ idx = trial.pop();
+
+    size_t i = idx.x;
+    size_t j = idx.y;
+    size_t k = idx.z;
+
+    // Skip the entries of the values that were updated later
+    if (markers(i, j, k) == kKnown) {
+      continue;
+    }
+
+    markers(i, j, k) = kKnown;
+    output(i, j, k) = solveQuad(markers, output, gridSpacing, invGridSpacingSqr, i, j, k);
+
+    if (output(i, j, k) <= maxDistance) {
+      updateNeighbors(i, j, k);
+    }
+  }
+
+  // Restore the sign
+  for (size_t n = 0; n < band.size(); ++n) {
+    if (isBandInside[n]) {
+      output(band[n]) = -output(band[n]);
+    }
+  }
+}
+
+FmmLevelSetSolver3::FmmLevelSetSolver3(bool useNarrowBand) : _useNarrowBand(useNarrowBand) {}
+
 void FmmLevelSetSolver3::reinitialize(const ScalarGrid3 &inputSdf, double maxDistance, ScalarGrid3 *outputSdf) {
   JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
 
@@ -215,11 +341,17 @@ void FmmLevelSetSolver3::reinitialize(const ScalarGrid3 &inputSdf, double maxDis
   Vector3D gridSpacing = inputSdf.gridSpacing();
   Vector3D invGridSpacing = 1.0 / gridSpacing;
   Vector3D invGridSpacingSqr = elemMul(invGridSpacing, invGridSpacing);
-  Array3<char> markers(size);
 
   auto output = outputSdf->dataView();
 
-  parallelForEachIndex(markers.size(), [&](size_t i, size_t j, size_t k) { output(i, j, k) = inputSdf(i, j, k); });
+  parallelForEachIndex(size, [&](size_t i, size_t j, size_t k) { output(i, j, k) = inputSdf(i, j, k); });
+
+  if (_useNarrowBand) {
+    reinitializeNarrowBand(output, gridSpacing, invGridSpacingSqr, maxDistance);
+    return;
+  }
+
+  Array3<char> markers(size);
 
   // Solve geometrically near the boundary
   forEachIndex(markers.size(), [&](size_t i, size_t j, size_t k) {
@@ -414,6 +546,8 @@ void FmmLevelSetSolver3::extrapolate(const FaceCenteredGrid3 &input, const Scala
   extrapolate(w, sdfAtW, gridSpacing, maxDistance, output->wView());
 }
 
+bool FmmLevelSetSolver3::useNarrowBand() const { return _useNarrowBand; }
+
 void FmmLevelSetSolver3::extrapolate(const ConstArrayView3<double> &input, const ConstArrayView3<double> &sdf,
                                      const Vector3D &gridSpacing, double maxDistance, ArrayView3<double> output) {
   Vector3UZ size = input.size();
@@ -27,8 +27,19 @@ namespace geometry {
 //!
 class FmmLevelSetSolver3 final : public LevelSetSolver3 {
 public:
-  //! Default constructor.
-  FmmLevelSetSolver3() = default;
+  //!
+  //! \brief Constructs the solver.
+  //!
+  //! In the narrow-band mode, the marching stops at the max distance of the
+  //! reinitialization without visiting the far cells, and the heap is
+  //! replaced by an untidy bucketed priority queue with O(1) operations. The
+  //! cells are accepted out of order within a tenth of the grid spacing, and
+  //! the trial values are updated as their neighbors are accepted. The cost
+  //! then scales with the size of the band instead of the grid.
+  //!
+  //! \param useNarrowBand True to use the narrow-band mode.
+  //!
+  explicit FmmLevelSetSolver3(bool useNarrowBand = false);
 
   //!
   //! Reinitialize given scalar field to signed-distance field.
@@ -73,7 +84,12 @@ public:
   void extrapolate(const FaceCenteredGrid3 &input, const ScalarField3 &sdf, double maxDistance,
                    FaceCenteredGrid3 *output) override;
 
+  //! Returns true if the narrow-band mode is used.
+  [[nodiscard]] bool useNarrowBand() const;
+
 private:
+  bool _useNarrowBand = false;
+
   static void extrapolate(const ConstArrayView3<double> &input, const ConstArrayView3<double> &sdf,
                           const Vector3D &gridSpacing, double maxDistance, ArrayView3<double> output);
 };
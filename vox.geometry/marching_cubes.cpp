@@ -22,12 +22,18 @@
 #include "marching_cubes_table.h"
 #include "marching_squares_table.h"
 
+#include "array.h"
 #include "bounding_box.h"
+#include "grids/sparse_scalar_grid3.h"
 #include "level_set_utils.h"
 #include "marching_cubes.h"
+#include "parallel.h"
 
+#include <algorithm>
 #include <array>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace vox {
 namespace geometry {
@@ -98,11 +104,12 @@ inline Vector3D SafeNormalize(const Vector3D &n) {
 // |----*----|    -->    |-----|-----|
 // i        i+1         2i   2i+1  2i+2
 //
-inline size_t globalEdgeID(size_t i, size_t j, size_t k, const Vector3UZ &dim, size_t localEdgeID) {
-  // See edgeConnection in marching_cubes_table.h for the edge ordering.
-  static const int edgeOffset3D[12][3] = {{1, 0, 0}, {2, 0, 1}, {1, 0, 2}, {0, 0, 1}, {1, 2, 0}, {2, 2, 1},
-                                          {1, 2, 2}, {0, 2, 1}, {0, 1, 0}, {2, 1, 0}, {2, 1, 2}, {0, 1, 2}};
+// Edge midpoints of a cell in doubled virtual vertex indices. See
+// edgeConnection in marching_cubes_table.h for the edge ordering.
+static const int edgeOffset3D[12][3] = {{1, 0, 0}, {2, 0, 1}, {1, 0, 2}, {0, 0, 1}, {1, 2, 0}, {2, 2, 1},
+                                        {1, 2, 2}, {0, 2, 1}, {0, 1, 0}, {2, 1, 0}, {2, 1, 2}, {0, 1, 2}};
 
+inline size_t globalEdgeID(size_t i, size_t j, size_t k, const Vector3UZ &dim, size_t localEdgeID) {
   return ((2 * k + edgeOffset3D[localEdgeID][2]) * 2 * dim.y + (2 * j + edgeOffset3D[localEdgeID][1])) * 2 * dim.x +
          (2 * i + edgeOffset3D[localEdgeID][0]);
 }
@@ -223,9 +230,14 @@ static void SingleSquare(const std::array<double, 4> &data, const std::array<siz
   }
 }
 
-static void SingleCube(const std::array<double, 8> &data, const std::array<size_t, 12> &edgeIDs,
-                       const std::array<Vector3D, 8> &normals, const BoundingBox3D &bound,
-                       MarchingCubeVertexMap *vertexMap, TriangleMesh3 *mesh, double isoValue) {
+// Triangulates a single cell. For each triangle corner, vertexFunc(edge,
+// position, normal) returns the index of the vertex on the given local edge,
+// adding the vertex if it does not exist yet. The triangles are passed to
+// triangleFunc.
+template <typename VertexFunc, typename TriangleFunc>
+static void SingleCube(const std::array<double, 8> &data, const std::array<Vector3D, 8> &normals,
+                       const BoundingBox3D &bound, double isoValue, const VertexFunc &vertexFunc,
+                       const TriangleFunc &triangleFunc) {
   int idxFlagSize = 0;
   int idxVertexOfTheEdge[2];
 
@@ -292,34 +304,67 @@ static void SingleCube(const std::array<double, 8> &data, const std::array<size_
     Vector3UZ face;
 
     for (int j = 0; j < 3; ++j) {
-      int k = 3 * iterTri + j;
-      MarchingCubeVertexHashKey vKey = edgeIDs[triangleConnectionTable3D[idxFlagSize][k]];
-      MarchingCubeVertexID vID;
-
-      if (QueryVertexID(*vertexMap, vKey, &vID)) {
-        face[j] = vID;
-      } else {
-        // If vertex does not exist from the map
-        face[j] = mesh->numberOfPoints();
-        mesh->addNormal(SafeNormalize(n[triangleConnectionTable3D[idxFlagSize][k]]));
-        mesh->addPoint(e[triangleConnectionTable3D[idxFlagSize][k]]);
-        mesh->addUv(Vector2D{});
-        vertexMap->insert(std::make_pair(vKey, face[j]));
-      }
+      const int edge = triangleConnectionTable3D[idxFlagSize][3 * iterTri + j];
+      face[j] = vertexFunc(edge, e[edge], SafeNormalize(n[edge]));
     }
 
-    mesh->addPointTriangle(face);
-    mesh->addNormalTriangle(face);
-    mesh->addUvTriangle(face);
+    triangleFunc(face);
   }
 }
 
-void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
-                   TriangleMesh3 *mesh, double isoValue, int bndClose, int bndConnectivity) {
-  MarchingCubeVertexMap vertexMap;
+// Returns true if the cell with the given corner values crosses the surface.
+inline bool IsCubeActive(const std::array<double, 8> &data, double isoValue) {
+  int numberOfInside = 0;
+  for (double d : data) {
+    numberOfInside += (d <= isoValue) ? 1 : 0;
+  }
 
+  return numberOfInside != 0 && numberOfInside != 8;
+}
+
+inline Vector3D CellCorner(const Vector3D &origin, const Vector3D &gridSize, size_t i, size_t j, size_t k) {
+  return origin + elemMul(gridSize, Vector3D{{static_cast<double>(i), static_cast<double>(j), static_cast<double>(k)}});
+}
+
+// Reads the corner values of the cell (i, j, k).
+inline void CubeData(const ConstArrayView3<double> &grid, size_t i, size_t j, size_t k, std::array<double, 8> *data) {
+  (*data)[0] = grid(i, j, k);
+  (*data)[1] = grid(i + 1, j, k);
+  (*data)[4] = grid(i, j + 1, k);
+  (*data)[5] = grid(i + 1, j + 1, k);
+  (*data)[3] = grid(i, j, k + 1);
+  (*data)[2] = grid(i + 1, j, k + 1);
+  (*data)[7] = grid(i, j + 1, k + 1);
+  (*data)[6] = grid(i + 1, j + 1, k + 1);
+}
+
+// Computes the corner gradients and the bounds of the cell (i, j, k).
+inline void CubeGeometry(const ConstArrayView3<double> &grid, size_t i, size_t j, size_t k, const Vector3D &gridSize,
+                         const Vector3D &invGridSize, const Vector3D &origin, std::array<Vector3D, 8> *normals,
+                         BoundingBox3D *bound) {
+  const auto si = static_cast<ssize_t>(i);
+  const auto sj = static_cast<ssize_t>(j);
+  const auto sk = static_cast<ssize_t>(k);
+
+  (*normals)[0] = Grad(grid, si, sj, sk, invGridSize);
+  (*normals)[1] = Grad(grid, si + 1, sj, sk, invGridSize);
+  (*normals)[4] = Grad(grid, si, sj + 1, sk, invGridSize);
+  (*normals)[5] = Grad(grid, si + 1, sj + 1, sk, invGridSize);
+  (*normals)[3] = Grad(grid, si, sj, sk + 1, invGridSize);
+  (*normals)[2] = Grad(grid, si + 1, sj, sk + 1, invGridSize);
+  (*normals)[7] = Grad(grid, si, sj + 1, sk + 1, invGridSize);
+  (*normals)[6] = Grad(grid, si + 1, sj + 1, sk + 1, invGridSize);
+
+  bound->lowerCorner = CellCorner(origin, gridSize, i, j, k);
+  bound->upperCorner = CellCorner(origin, gridSize, i + 1, j + 1, k + 1);
+}
+
+// Closes the grid boundaries with caps. The caps whose connectivity flag is
+// set share the vertices in vertexMap with the iso-surface.
+static void CloseBoundaries(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                            TriangleMesh3 *mesh, double isoValue, int bndClose, int bndConnectivity,
+                            MarchingCubeVertexMap *vertexMap) {
   const Vector3UZ &dim = grid.size();
-  const Vector3D invGridSize = 1.0 / gridSize;
 
   auto pos = [origin, gridSize](ssize_t i, ssize_t j, ssize_t k) -> Vector3D {
     return origin +
@@ -330,44 +375,6 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
   const auto dimY = static_cast<ssize_t>(dim.y);
   const auto dimZ = static_cast<ssize_t>(dim.z);
 
-  for (ssize_t k = 0; k < dimZ - 1; ++k) {
-    for (ssize_t j = 0; j < dimY - 1; ++j) {
-      for (ssize_t i = 0; i < dimX - 1; ++i) {
-        std::array<double, 8> data{};
-        std::array<size_t, 12> edgeIDs{};
-        std::array<Vector3D, 8> normals;
-        BoundingBox3D bound;
-
-        data[0] = grid(i, j, k);
-        data[1] = grid(i + 1, j, k);
-        data[4] = grid(i, j + 1, k);
-        data[5] = grid(i + 1, j + 1, k);
-        data[3] = grid(i, j, k + 1);
-        data[2] = grid(i + 1, j, k + 1);
-        data[7] = grid(i, j + 1, k + 1);
-        data[6] = grid(i + 1, j + 1, k + 1);
-
-        normals[0] = Grad(grid, i, j, k, invGridSize);
-        normals[1] = Grad(grid, i + 1, j, k, invGridSize);
-        normals[4] = Grad(grid, i, j + 1, k, invGridSize);
-        normals[5] = Grad(grid, i + 1, j + 1, k, invGridSize);
-        normals[3] = Grad(grid, i, j, k + 1, invGridSize);
-        normals[2] = Grad(grid, i + 1, j, k + 1, invGridSize);
-        normals[7] = Grad(grid, i, j + 1, k + 1, invGridSize);
-        normals[6] = Grad(grid, i + 1, j + 1, k + 1, invGridSize);
-
-        for (int e = 0; e < 12; ++e) {
-          edgeIDs[e] = globalEdgeID(i, j, k, dim, e);
-        }
-
-        bound.lowerCorner = pos(i, j, k);
-        bound.upperCorner = pos(i + 1, j + 1, k + 1);
-
-        SingleCube(data, edgeIDs, normals, bound, &vertexMap, mesh, isoValue);
-      }
-    }
-  }
-
   // Construct boundaries parallel to x-y plane
   if (bndClose & (kDirectionBack | kDirectionFront)) {
     MarchingCubeVertexMap vertexMapBack;
@@ -405,7 +412,7 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
           corners[3] = pos(i + 1, j + 1, k);
 
           SingleSquare(data, vertexAndEdgeIDs, normal, corners,
-                       (bndConnectivity & kDirectionBack) ? &vertexMap : &vertexMapBack, mesh, isoValue);
+                       (bndConnectivity & kDirectionBack) ? vertexMap : &vertexMapBack, mesh, isoValue);
         }
 
         k = dimZ - 2;
@@ -432,7 +439,7 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
           corners[3] = pos(i, j + 1, k + 1);
 
           SingleSquare(data, vertexAndEdgeIDs, normal, corners,
-                       (bndConnectivity & kDirectionFront) ? &vertexMap : &vertexMapFront, mesh, isoValue);
+                       (bndConnectivity & kDirectionFront) ? vertexMap : &vertexMapFront, mesh, isoValue);
         }
       }
     }
@@ -475,7 +482,7 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
           corners[3] = pos(i, j + 1, k);
 
           SingleSquare(data, vertexAndEdgeIDs, normal, corners,
-                       (bndConnectivity & kDirectionLeft) ? &vertexMap : &vertexMapLeft, mesh, isoValue);
+                       (bndConnectivity & kDirectionLeft) ? vertexMap : &vertexMapLeft, mesh, isoValue);
         }
 
         i = dimX - 2;
@@ -502,7 +509,7 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
           corners[3] = pos(i + 1, j + 1, k + 1);
 
           SingleSquare(data, vertexAndEdgeIDs, normal, corners,
-                       (bndConnectivity & kDirectionRight) ? &vertexMap : &vertexMapRight, mesh, isoValue);
+                       (bndConnectivity & kDirectionRight) ? vertexMap : &vertexMapRight, mesh, isoValue);
         }
       }
     }
@@ -545,7 +552,7 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
           corners[3] = pos(i, j, k + 1);
 
           SingleSquare(data, vertexAndEdgeIDs, normal, corners,
-                       (bndConnectivity & kDirectionDown) ? &vertexMap : &vertexMapDown, mesh, isoValue);
+                       (bndConnectivity & kDirectionDown) ? vertexMap : &vertexMapDown, mesh, isoValue);
         }
 
         j = dimY - 2;
@@ -572,12 +579,479 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
           corners[3] = pos(i + 1, j + 1, k + 1);
 
           SingleSquare(data, vertexAndEdgeIDs, normal, corners,
-                       (bndConnectivity & kDirectionUp) ? &vertexMap : &vertexMapUp, mesh, isoValue);
+                       (bndConnectivity & kDirectionUp) ? vertexMap : &vertexMapUp, mesh, isoValue);
         }
       }
     }
   }
 }
 
+void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                   TriangleMesh3 *mesh, double isoValue, int bndClose, int bndConnectivity) {
+  MarchingCubeVertexMap vertexMap;
+
+  const Vector3UZ &dim = grid.size();
+  const Vector3D invGridSize = 1.0 / gridSize;
+
+  auto vertexFunc = [&](size_t i, size_t j, size_t k, int edge, const Vector3D &point, const Vector3D &normal) {
+    const MarchingCubeVertexHashKey vKey = globalEdgeID(i, j, k, dim, edge);
+    MarchingCubeVertexID vID;
+
+    if (!QueryVertexID(vertexMap, vKey, &vID)) {
+      // If vertex does not exist from the map
+      vID = mesh->numberOfPoints();
+      mesh->addNormal(normal);
+      mesh->addPoint(point);
+      mesh->addUv(Vector2D{});
+      vertexMap.insert(std::make_pair(vKey, vID));
+    }
+
+    return vID;
+  };
+
+  auto triangleFunc = [mesh](const Vector3UZ &face) {
+    mesh->addPointTriangle(face);
+    mesh->addNormalTriangle(face);
+    mesh->addUvTriangle(face);
+  };
+
+  for (size_t k = 0; k + 1 < dim.z; ++k) {
+    for (size_t j = 0; j + 1 < dim.y; ++j) {
+      for (size_t i = 0; i + 1 < dim.x; ++i) {
+        std::array<double, 8> data{};
+        CubeData(grid, i, j, k, &data);
+        if (!IsCubeActive(data, isoValue)) {
+          continue;
+        }
+
+        std::array<Vector3D, 8> normals;
+        BoundingBox3D bound;
+        CubeGeometry(grid, i, j, k, gridSize, invGridSize, origin, &normals, &bound);
+
+        SingleCube(
+            data, normals, bound, isoValue,
+            [&](int edge, const Vector3D &point, const Vector3D &normal) {
+              return vertexFunc(i, j, k, edge, point, normal);
+            },
+            triangleFunc);
+      }
+    }
+  }
+
+  CloseBoundaries(grid, gridSize, origin, mesh, isoValue, bndClose, bndConnectivity, &vertexMap);
+}
+
+namespace {
+
+// Number of cell layers per slab of the parallel marching cubes
+constexpr size_t kSlabThickness = 8;
+
+// Marks a slab-local vertex index as an index into the ghost vertices
+constexpr size_t kGhostVertexBit = size_t(1) << (8 * sizeof(size_t) - 1);
+
+// Vertices and triangles of a z-slab. The triangles use slab-local vertex
+// indices, except for the ghost vertices: the vertices on the bottom plane of
+// the slab, which are owned by the slab below. Those are marked with
+// kGhostVertexBit and refer to ghostSlots.
+struct MarchingCubesSlab {
+  std::vector<Vector3D> points;
+  std::vector<Vector3D> normals;
+  std::vector<Vector3UZ> triangles;
+
+  //! Edge slots of the bottom plane referenced by the slab.
+  std::vector<size_t> ghostSlots;
+
+  //! Vertices on the edges of the top plane, sorted by edge slot.
+  std::vector<std::pair<size_t, size_t>> topPlane;
+
+  //! Vertices on the grid boundary with their global edge IDs.
+  std::vector<std::pair<MarchingCubeVertexHashKey, MarchingCubeVertexID>> boundaryVertices;
+};
+
+// Triangulates the cells of a slab, one layer after another. The vertices are
+// welded through arrays with one slot per cell edge: the x- and y-edges of the
+// planes below and above the current layer, and the z-edges of the layer. Only
+// the written slots are cleared between layers, so a layer costs in
+// proportion to the surface it contains.
+class MarchingCubesSlabBuilder {
+public:
+  MarchingCubesSlabBuilder(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                           double isoValue, bool recordBoundary)
+      : _grid(grid), _dim(grid.size()), _gridSize(gridSize), _invGridSize(1.0 / gridSize), _origin(origin),
+        _isoValue(isoValue), _recordBoundary(recordBoundary), _lowerPlane(2 * _dim.x * _dim.y, kMaxSize),
+        _upperPlane(2 * _dim.x * _dim.y, kMaxSize), _zEdges(_dim.x * _dim.y, kMaxSize) {}
+
+  void begin(size_t kBegin, size_t kEnd, MarchingCubesSlab *slab) {
+    clearSlots(&_lowerPlane, &_touchedLowerPlane);
+    _kBegin = kBegin;
+    _kEnd = kEnd;
+    _slab = slab;
+  }
+
+  void processCell(size_t i, size_t j, size_t k) {
+    std::array<double, 8> data{};
+    CubeData(_grid, i, j, k, &data);
+    if (!IsCubeActive(data, _isoValue)) {
+      return;
+    }
+
+    std::array<Vector3D, 8> normals;
+    BoundingBox3D bound;
+    CubeGeometry(_grid, i, j, k, _gridSize, _invGridSize, _origin, &normals, &bound);
+
+    SingleCube(
+        data, normals, bound, _isoValue,
+        [&](int edge, const Vector3D &point, const Vector3D &normal) { return vertex(i, j, k, edge, point, normal); },
+        [&](const Vector3UZ &face) { _slab->triangles.push_back(face); });
+  }
+
+  void endLayer(size_t k) {
+    if (k + 1 == _kEnd) {
+      for (size_t slot : _touchedUpperPlane) {
+        _slab->topPlane.emplace_back(slot, _upperPlane[slot]);
+      }
+      std::sort(_slab->topPlane.begin(), _slab->topPlane.end());
+    }
+
+    clearSlots(&_lowerPlane, &_touchedLowerPlane);
+    std::swap(_lowerPlane, _upperPlane);
+    std::swap(_touchedLowerPlane, _touchedUpperPlane);
+    clearSlots(&_zEdges, &_touchedZEdges);
+  }
+
+private:
+  const ConstArrayView3<double> &_grid;
+  Vector3UZ _dim;
+  Vector3D _gridSize;
+  Vector3D _invGridSize;
+  Vector3D _origin;
+  double _isoValue;
+  bool _recordBoundary;
+
+  size_t _kBegin = 0;
+  size_t _kEnd = 0;
+  MarchingCubesSlab *_slab = nullptr;
+
+  std::vector<size_t> _lowerPlane;
+  std::vector<size_t> _upperPlane;
+  std::vector<size_t> _zEdges;
+  std::vector<size_t> _touchedLowerPlane;
+  std::vector<size_t> _touchedUpperPlane;
+  std::vector<size_t> _touchedZEdges;
+
+  static void clearSlots(std::vector<size_t> *slots, std::vector<size_t> *touched) {
+    for (size_t slot : *touched) {
+      (*slots)[slot] = kMaxSize;
+    }
+    touched->clear();
+  }
+
+  size_t vertex(size_t i, size_t j, size_t k, int edge, const Vector3D &point, const Vector3D &normal) {
+    const int *offset = edgeOffset3D[edge];
+    const size_t vi = i + (offset[0] >> 1);
+    const size_t vj = j + (offset[1] >> 1);
+
+    std::vector<size_t> *slots;
+    std::vector<size_t> *touched;
+    size_t slot;
+    if (offset[2] == 1) {
+      slot = vj * _dim.x + vi;
+      slots = &_zEdges;
+      touched = &_touchedZEdges;
+    } else {
+      slot = 2 * (vj * _dim.x + vi) + ((offset[1] == 1) ? 1 : 0);
+      slots = (offset[2] == 0) ? &_lowerPlane : &_upperPlane;
+      touched = (offset[2] == 0) ? &_touchedLowerPlane : &_touchedUpperPlane;
+    }
+
+    size_t &id = (*slots)[slot];
+    if (id != kMaxSize) {
+      return id;
+    }
+
+    if (offset[2] == 0 && k == _kBegin && _kBegin > 0) {
+      id = kGhostVertexBit | _slab->ghostSlots.size();
+      _slab->ghostSlots.push_back(slot);
+    } else {
+      id = _slab->points.size();
+      _slab->points.push_back(point);
+      _slab->normals.push_back(normal);
+
+      if (_recordBoundary && isOnBoundary(i, j, k, offset)) {
+        _slab->boundaryVertices.emplace_back(globalEdgeID(i, j, k, _dim, edge), id);
+      }
+    }
+
+    touched->push_back(slot);
+    return id;
+  }
+
+  bool isOnBoundary(size_t i, size_t j, size_t k, const int *offset) const {
+    const size_t x = 2 * i + offset[0];
+    const size_t y = 2 * j + offset[1];
+    const size_t z = 2 * k + offset[2];
+    return x == 0 || y == 0 || z == 0 || x == 2 * (_dim.x - 1) || y == 2 * (_dim.y - 1) || z == 2 * (_dim.z - 1);
+  }
+};
+
+// Triangulates the z-slabs of the given thickness in parallel and stitches
+// them into the mesh. processSlab(builder, kBegin, kEnd) feeds the cells of a
+// slab to the builder, one layer after another.
+template <typename ProcessSlabFunc>
+void TriangulateSlabs(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                      TriangleMesh3 *mesh, double isoValue, int bndClose, int bndConnectivity, size_t slabThickness,
+                      const ProcessSlabFunc &processSlab) {
+  // The caps only need the surface vertices on the grid boundary
+  const bool recordBoundary = (bndClose & bndConnectivity) != 0;
+
+  const size_t numberOfLayers = grid.size().z - 1;
+  const size_t numberOfSlabs = (numberOfLayers + slabThickness - 1) / slabThickness;
+  std::vector<MarchingCubesSlab> slabs(numberOfSlabs);
+
+  parallelRangeFor(kZeroSize, numberOfSlabs, [&](size_t begin, size_t end) {
+    MarchingCubesSlabBuilder builder(grid, gridSize, origin, isoValue, recordBoundary);
+
+    for (size_t s = begin; s < end; ++s) {
+      const size_t kBegin = s * slabThickness;
+      const size_t kEnd = std::min(kBegin + slabThickness, numberOfLayers);
+
+      builder.begin(kBegin, kEnd, &slabs[s]);
+      processSlab(&builder, kBegin, kEnd);
+    }
+  });
+
+  // Offsets of the slab-local vertex indices
+  std::vector<size_t> offsets(numberOfSlabs + 1, mesh->numberOfPoints());
+  for (size_t s = 0; s < numberOfSlabs; ++s) {
+    offsets[s + 1] = offsets[s] + slabs[s].points.size();
+  }
+
+  // Stitch the ghost vertices to the top plane of the slab below
+  std::vector<std::vector<size_t>> ghostVertices(numberOfSlabs);
+  parallelFor(kOneSize, numberOfSlabs, [&](size_t s) {
+    const auto &topPlane = slabs[s - 1].topPlane;
+    for (size_t slot : slabs[s].ghostSlots) {
+      auto iter = std::lower_bound(topPlane.begin(), topPlane.end(), std::make_pair(slot, kZeroSize));
+      JET_ASSERT(iter != topPlane.end() && iter->first == slot);
+      ghostVertices[s].push_back(offsets[s - 1] + iter->second);
+    }
+  });
+
+  for (size_t s = 0; s < numberOfSlabs; ++s) {
+    const MarchingCubesSlab &slab = slabs[s];
+
+    for (size_t v = 0; v < slab.points.size(); ++v) {
+      mesh->addNormal(slab.normals[v]);
+      mesh->addPoint(slab.points[v]);
+      mesh->addUv(Vector2D{});
+    }
+
+    for (const Vector3UZ &triangle : slab.triangles) {
+      Vector3UZ face;
+      for (size_t c = 0; c < 3; ++c) {
+        face[c] = (triangle[c] & kGhostVertexBit) ? ghostVertices[s][triangle[c] & ~kGhostVertexBit]
+                                                  : offsets[s] + triangle[c];
+      }
+
+      mesh->addPointTriangle(face);
+      mesh->addNormalTriangle(face);
+      mesh->addUvTriangle(face);
+    }
+  }
+
+  MarchingCubeVertexMap vertexMap;
+  for (size_t s = 0; s < numberOfSlabs; ++s) {
+    for (const auto &boundaryVertex : slabs[s].boundaryVertices) {
+      vertexMap.insert(std::make_pair(boundaryVertex.first, offsets[s] + boundaryVertex.second));
+    }
+  }
+
+  CloseBoundaries(grid, gridSize, origin, mesh, isoValue, bndClose, bndConnectivity, &vertexMap);
+}
+
+} // namespace
+
+void marchingCubesParallel(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                           TriangleMesh3 *mesh, double isoValue, int bndClose, int bndConnectivity) {
+  const Vector3UZ &dim = grid.size();
+  if (dim.x < 2 || dim.y < 2 || dim.z < 2) {
+    marchingCubes(grid, gridSize, origin, mesh, isoValue, bndClose, bndConnectivity);
+    return;
+  }
+
+  // Each slab visits its cells in the serial order and thus creates its
+  // vertices in the same order, so concatenating the slabs reproduces the
+  // serial vertex indices.
+  TriangulateSlabs(grid, gridSize, origin, mesh, isoValue, bndClose, bndConnectivity, kSlabThickness,
+                   [&](MarchingCubesSlabBuilder *builder, size_t kBegin, size_t kEnd) {
+                     for (size_t k = kBegin; k < kEnd; ++k) {
+                       for (size_t j = 0; j + 1 < dim.y; ++j) {
+                         for (size_t i = 0; i + 1 < dim.x; ++i) {
+                           builder->processCell(i, j, k);
+                         }
+                       }
+                       builder->endLayer(k);
+                     }
+                   });
+}
+
+void marchingCubesSparse(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                         TriangleMesh3 *mesh, double isoValue, int bndClose, int bndConnectivity, size_t brickSize) {
+  JET_THROW_INVALID_ARG_IF(brickSize == 0);
+
+  const Vector3UZ &dim = grid.size();
+  if (dim.x < 2 || dim.y < 2 || dim.z < 2) {
+    marchingCubes(grid, gridSize, origin, mesh, isoValue, bndClose, bndConnectivity);
+    return;
+  }
+
+  const Vector3UZ numberOfCells(dim.x - 1, dim.y - 1, dim.z - 1);
+  const Vector3UZ numberOfBricks((numberOfCells.x + brickSize - 1) / brickSize,
+                                 (numberOfCells.y + brickSize - 1) / brickSize,
+                                 (numberOfCells.z + brickSize - 1) / brickSize);
+
+  // Occupancy pass: a brick is active if the iso-value lies within the range
+  // of the values at its cell corners. A cell of an inactive brick cannot
+  // cross the surface.
+  std::vector<char> isBrickActive(numberOfBricks.x * numberOfBricks.y * numberOfBricks.z, 0);
+  parallelFor(kZeroSize, numberOfBricks.x, kZeroSize, numberOfBricks.y, kZeroSize, numberOfBricks.z,
+              [&](size_t bi, size_t bj, size_t bk) {
+                const size_t iEnd = std::min((bi + 1) * brickSize, numberOfCells.x);
+                const size_t jEnd = std::min((bj + 1) * brickSize, numberOfCells.y);
+                const size_t kEnd = std::min((bk + 1) * brickSize, numberOfCells.z);
+
+                double minValue = kMaxD;
+                double maxValue = -kMaxD;
+                for (size_t k = bk * brickSize; k <= kEnd; ++k) {
+                  for (size_t j = bj * brickSize; j <= jEnd; ++j) {
+                    const double *row = &grid(kZeroSize, j, k);
+                    for (size_t i = bi * brickSize; i <= iEnd; ++i) {
+                      minValue = std::min(minValue, row[i]);
+                      maxValue = std::max(maxValue, row[i]);
+                    }
+                  }
+                }
+
+                isBrickActive[(bk * numberOfBricks.y + bj) * numberOfBricks.x + bi] =
+                    minValue <= isoValue && maxValue > isoValue;
+              });
+
+  // Triangulation pass over the active bricks only. The slabs are one brick
+  // thick, and the layers of a slab are visited brick by brick.
+  TriangulateSlabs(
+      grid, gridSize, origin, mesh, isoValue, bndClose, bndConnectivity, brickSize,
+      [&](MarchingCubesSlabBuilder *builder, size_t kBegin, size_t kEnd) {
+        const size_t bk = kBegin / brickSize;
+
+        std::vector<Vector2UZ> activeBricks;
+        for (size_t bj = 0; bj < numberOfBricks.y; ++bj) {
+          for (size_t bi = 0; bi < numberOfBricks.x; ++bi) {
+            if (isBrickActive[(bk * numberOfBricks.y + bj) * numberOfBricks.x + bi]) {
+              activeBricks.emplace_back(bi, bj);
+            }
+          }
+        }
+
+        for (size_t k = kBegin; k < kEnd; ++k) {
+          for (const Vector2UZ &brick : activeBricks) {
+            const size_t iEnd = std::min((brick.x + 1) * brickSize, numberOfCells.x);
+            const size_t jEnd = std::min((brick.y + 1) * brickSize, numberOfCells.y);
+            for (size_t j = brick.y * brickSize; j < jEnd; ++j) {
+              for (size_t i = brick.x * brickSize; i < iEnd; ++i) {
+                builder->processCell(i, j, k);
+              }
+            }
+          }
+          builder->endLayer(k);
+        }
+      });
+}
+
+void marchingCubes(const SparseScalarGrid3 &grid, TriangleMesh3 *mesh, double isoValue) {
+  MarchingCubeVertexMap vertexMap;
+
+  const Vector3UZ dim = grid.dataSize();
+  const Vector3D &gridSize = grid.gridSpacing();
+  const Vector3D invGridSize = 1.0 / gridSize;
+  if (dim.x < 2 || dim.y < 2 || dim.z < 2) {
+    return;
+  }
+
+  // The leaf that triangulates the cell (i, j, k), which is the one of the
+  // first allocated corner.
+  auto ownerLeaf = [&](size_t i, size_t j, size_t k) -> Vector3UZ {
+    for (size_t c = 0; c < 8; ++c) {
+      const Vector3UZ corner(i + (c & 1), j + ((c >> 1) & 1), k + ((c >> 2) & 1));
+      if (grid.isAllocated(corner)) {
+        return corner / SparseScalarGrid3::kLeafSize;
+      }
+    }
+    return Vector3UZ(kMaxSize, kMaxSize, kMaxSize);
+  };
+
+  auto triangleFunc = [mesh](const Vector3UZ &face) {
+    mesh->addPointTriangle(face);
+    mesh->addNormalTriangle(face);
+    mesh->addUvTriangle(face);
+  };
+
+  // The gradients of the corners need one more data point on each side
+  Array3<double> scratch;
+  grid.forEachLeaf([&](const Vector3UZ &lo, const Vector3UZ &hi) {
+    const Vector3UZ leaf = lo / SparseScalarGrid3::kLeafSize;
+    const Vector3UZ cubeBegin(std::max(lo.x, kOneSize) - 1, std::max(lo.y, kOneSize) - 1,
+                              std::max(lo.z, kOneSize) - 1);
+    const Vector3UZ cubeEnd(std::min(hi.x, dim.x - 1), std::min(hi.y, dim.y - 1), std::min(hi.z, dim.z - 1));
+    const Vector3UZ begin(std::max(cubeBegin.x, kOneSize) - 1, std::max(cubeBegin.y, kOneSize) - 1,
+                          std::max(cubeBegin.z, kOneSize) - 1);
+    const Vector3UZ end(std::min(hi.x + 2, dim.x), std::min(hi.y + 2, dim.y), std::min(hi.z + 2, dim.z));
+
+    scratch.resize(end - begin);
+    forEachIndex(scratch.size(), [&](size_t i, size_t j, size_t k) {
+      scratch(i, j, k) = grid(begin.x + i, begin.y + j, begin.z + k);
+    });
+
+    const ConstArrayView3<double> view(scratch);
+    const Vector3D origin = grid.dataOrigin() + elemMul(gridSize, begin.castTo<double>());
+    for (size_t k = cubeBegin.z; k < cubeEnd.z; ++k) {
+      for (size_t j = cubeBegin.y; j < cubeEnd.y; ++j) {
+        for (size_t i = cubeBegin.x; i < cubeEnd.x; ++i) {
+          const size_t li = i - begin.x;
+          const size_t lj = j - begin.y;
+          const size_t lk = k - begin.z;
+
+          std::array<double, 8> data{};
+          CubeData(view, li, lj, lk, &data);
+          if (!IsCubeActive(data, isoValue) || ownerLeaf(i, j, k) != leaf) {
+            continue;
+          }
+
+          std::array<Vector3D, 8> normals;
+          BoundingBox3D bound;
+          CubeGeometry(view, li, lj, lk, gridSize, invGridSize, origin, &normals, &bound);
+
+          SingleCube(
+              data, normals, bound, isoValue,
+              [&](int edge, const Vector3D &point, const Vector3D &normal) {
+                const MarchingCubeVertexHashKey vKey = globalEdgeID(i, j, k, dim, edge);
+                MarchingCubeVertexID vID;
+
+                if (!QueryVertexID(vertexMap, vKey, &vID)) {
+                  vID = mesh->numberOfPoints();
+                  mesh->addNormal(normal);
+                  mesh->addPoint(point);
+                  mesh->addUv(Vector2D{});
+                  vertexMap.insert(std::make_pair(vKey, vID));
+                }
+
+                return vID;
+              },
+              triangleFunc);
+        }
+      }
+    }
+  });
+}
+
 } // namespace vox
 } // namespace geometry
@@ -14,6 +14,8 @@
 namespace vox {
 namespace geometry {
 
+class SparseScalarGrid3;
+
 //!
 //! \brief      Computes marching cubes and extract triangle mesh from grid.
 //!
@@ -36,6 +38,75 @@ void marchingCubes(const ConstArrayView3<double> &grid, const Vector3D &gridSize
                    TriangleMesh3 *mesh, double isoValue = 0, int bndClose = kDirectionAll,
                    int bndConnectivity = kDirectionNone);
 
+//!
+//! \brief      Computes marching cubes in parallel and extract triangle mesh
+//!             from grid.
+//!
+//! This function produces the same mesh as marchingCubes, including the order
+//! of the vertices and triangles, but triangulates the grid in parallel. The
+//! grid is split into z-slabs. Each slab welds its vertices through arrays
+//! indexed by the cell edges instead of a hash map, and the vertices on the
+//! planes between slabs are stitched to the slab below once all the slabs are
+//! done. The boundary caps are added afterwards.
+//!
+//! \param[in]  grid            The grid.
+//! \param[in]  gridSize        The grid size.
+//! \param[in]  origin          The origin.
+//! \param[out] mesh            The output triangle mesh.
+//! \param[in]  isoValue        The iso-surface value.
+//! \param[in]  bndClose        The boundary open flag.
+//! \param[in]  bndConnectivity The boundary connectivity flag.
+//!
+void marchingCubesParallel(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                           TriangleMesh3 *mesh, double isoValue = 0, int bndClose = kDirectionAll,
+                           int bndConnectivity = kDirectionNone);
+
+//!
+//! \brief      Computes marching cubes only around the iso-surface and extract
+//!             triangle mesh from grid.
+//!
+//! This function is meant for narrow-band level sets, whose values only matter
+//! in a thin band around the surface. It runs in two phases. The first one is
+//! a parallel occupancy pass over bricks of \p brickSize^3 cells which marks a
+//! brick active if the iso-value lies between the minimum and the maximum of
+//! its values. The second one triangulates the cells of the active bricks only,
+//! in parallel as marchingCubesParallel does, so its cost scales with the
+//! surface area instead of the grid volume.
+//!
+//! The mesh has the same vertices and triangles as the one from marchingCubes,
+//! but in a different order.
+//!
+//! \param[in]  grid            The grid.
+//! \param[in]  gridSize        The grid size.
+//! \param[in]  origin          The origin.
+//! \param[out] mesh            The output triangle mesh.
+//! \param[in]  isoValue        The iso-surface value.
+//! \param[in]  bndClose        The boundary open flag.
+//! \param[in]  bndConnectivity The boundary connectivity flag.
+//! \param[in]  brickSize       The number of cells along each side of a brick.
+//!
+void marchingCubesSparse(const ConstArrayView3<double> &grid, const Vector3D &gridSize, const Vector3D &origin,
+                         TriangleMesh3 *mesh, double isoValue = 0, int bndClose = kDirectionAll,
+                         int bndConnectivity = kDirectionNone, size_t brickSize = 8);
+
+//!
+//! \brief      Computes marching cubes and extract triangle mesh from sparse
+//!             grid.
+//!
+//! This function triangulates the cells that touch the allocated leaves of the
+//! sparse grid, leaf by leaf, and skips the tiles. Each cell is triangulated
+//! once, by the first allocated leaf among its corners, and the vertices are
+//! welded across the leaves. The data points are the cell corners of the
+//! marching cubes, as with the dense version fed with the grid data. The mesh
+//! has the same vertices and triangles as the one from marchingCubes without
+//! the boundary caps, but in a different order.
+//!
+//! \param[in]  grid            The sparse grid.
+//! \param[out] mesh            The output triangle mesh.
+//! \param[in]  isoValue        The iso-surface value.
+//!
+void marchingCubes(const SparseScalarGrid3 &grid, TriangleMesh3 *mesh, double isoValue = 0);
+
 } // namespace vox
 } // namespace geometry
 
@@ -0,0 +1,257 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_MATRIX_SELL_INL_H_
+#define INCLUDE_JET_DETAIL_MATRIX_SELL_INL_H_
+
+#include "constants.h"
+#include "macros.h"
+#include "matrix_sell.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace vox {
+namespace geometry {
+
+namespace internal {
+
+// Computes the row sums of one chunk with C lanes. The inner loop runs over
+// contiguous lanes so that the compiler can vectorize it.
+template <typename T, size_t C>
+inline void sellChunkProduct(const T *nnz, const uint32_t *ci, size_t length, const T *v, T *sums) {
+  T acc[C] = {};
+  for (size_t k = 0; k < length; ++k) {
+    const T *val = nnz + k * C;
+    const uint32_t *col = ci + k * C;
+    for (size_t l = 0; l < C; ++l) {
+      acc[l] += val[l] * v[col[l]];
+    }
+  }
+  for (size_t l = 0; l < C; ++l) {
+    sums[l] = acc[l];
+  }
+}
+
+template <typename T>
+inline void sellChunkProduct(const T *nnz, const uint32_t *ci, size_t length, size_t chunkSize, const T *v, T *sums) {
+  std::fill(sums, sums + chunkSize, T(0));
+  for (size_t k = 0; k < length; ++k) {
+    const T *val = nnz + k * chunkSize;
+    const uint32_t *col = ci + k * chunkSize;
+    for (size_t l = 0; l < chunkSize; ++l) {
+      sums[l] += val[l] * v[col[l]];
+    }
+  }
+}
+
+#if defined(__AVX2__)
+
+inline __m256d sellMultiplyAdd(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__)
+  return _mm256_fmadd_pd(a, b, c);
+#else
+  return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+
+template <>
+inline void sellChunkProduct<double, 4>(const double *nnz, const uint32_t *ci, size_t length, const double *v,
+                                        double *sums) {
+  __m256d acc = _mm256_setzero_pd();
+  for (size_t k = 0; k < length; ++k) {
+    const __m128i col = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ci + k * 4));
+    acc = sellMultiplyAdd(_mm256_loadu_pd(nnz + k * 4), _mm256_i32gather_pd(v, col, 8), acc);
+  }
+  _mm256_storeu_pd(sums, acc);
+}
+
+template <>
+inline void sellChunkProduct<double, 8>(const double *nnz, const uint32_t *ci, size_t length, const double *v,
+                                        double *sums) {
+  __m256d acc0 = _mm256_setzero_pd();
+  __m256d acc1 = _mm256_setzero_pd();
+  for (size_t k = 0; k < length; ++k) {
+    const __m128i col0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ci + k * 8));
+    const __m128i col1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ci + k * 8 + 4));
+    acc0 = sellMultiplyAdd(_mm256_loadu_pd(nnz + k * 8), _mm256_i32gather_pd(v, col0, 8), acc0);
+    acc1 = sellMultiplyAdd(_mm256_loadu_pd(nnz + k * 8 + 4), _mm256_i32gather_pd(v, col1, 8), acc1);
+  }
+  _mm256_storeu_pd(sums, acc0);
+  _mm256_storeu_pd(sums + 4, acc1);
+}
+
+#endif // defined(__AVX2__)
+
+} // namespace internal
+
+//
+
+template <typename T> MatrixSell<T>::MatrixSell() { clear(); }
+
+template <typename T> MatrixSell<T>::MatrixSell(const MatrixCsr<T> &csr, size_t chunkSize, size_t sortingScope) {
+  set(csr, chunkSize, sortingScope);
+}
+
+template <typename T> void MatrixSell<T>::clear() {
+  _size = {0, 0};
+  _numNonZeros = 0;
+  _nonZeros.clear();
+  _columnIndices.clear();
+  _chunkPointers.clear();
+  _rowPermutation.clear();
+  _chunkPointers.push_back(0);
+}
+
+template <typename T> void MatrixSell<T>::set(const MatrixCsr<T> &csr, size_t chunkSize, size_t sortingScope) {
+  JET_THROW_INVALID_ARG_IF(chunkSize == 0);
+  // The gathers of the AVX2 kernels take the column indices as signed 32-bit offsets
+  JET_THROW_INVALID_ARG_IF(csr.cols() > static_cast<size_t>(std::numeric_limits<int32_t>::max()));
+
+  clear();
+
+  _size = csr.size();
+  _chunkSize = chunkSize;
+  _sortingScope = std::max(sortingScope, size_t(1));
+  _numNonZeros = csr.numberOfNonZeros();
+
+  const size_t n = _size.x;
+  const size_t numChunks = (n + _chunkSize - 1) / _chunkSize;
+  const size_t *rp = csr.rowPointersData();
+  const size_t *ci = csr.columnIndicesData();
+  const T *nnz = csr.nonZeroData();
+
+  auto rowLength = [&](size_t row) { return (row < n) ? rp[row + 1] - rp[row] : kZeroSize; };
+
+  // Sort rows by descending length within each sigma-window
+  _rowPermutation.resize(numChunks * _chunkSize, n);
+  std::iota(_rowPermutation.begin(), _rowPermutation.begin() + n, kZeroSize);
+  if (_sortingScope > 1) {
+    parallelFor(kZeroSize, (n + _sortingScope - 1) / _sortingScope, [&](size_t w) {
+      auto begin = _rowPermutation.begin() + w * _sortingScope;
+      auto end = _rowPermutation.begin() + std::min((w + 1) * _sortingScope, n);
+      std::stable_sort(begin, end, [&](size_t a, size_t b) { return rowLength(a) > rowLength(b); });
+    });
+  }
+
+  // Each chunk is as long as its longest row
+  _chunkPointers.resize(numChunks + 1);
+  for (size_t c = 0; c < numChunks; ++c) {
+    size_t length = 0;
+    for (size_t l = 0; l < _chunkSize; ++l) {
+      length = std::max(length, rowLength(_rowPermutation[c * _chunkSize + l]));
+    }
+    _chunkPointers[c + 1] = _chunkPointers[c] + length * _chunkSize;
+  }
+
+  _nonZeros.resize(_chunkPointers.back());
+  _columnIndices.resize(_chunkPointers.back());
+
+  parallelFor(kZeroSize, numChunks, [&](size_t c) {
+    const size_t offset = _chunkPointers[c];
+    const size_t length = (_chunkPointers[c + 1] - offset) / _chunkSize;
+
+    for (size_t l = 0; l < _chunkSize; ++l) {
+      const size_t row = _rowPermutation[c * _chunkSize + l];
+      const size_t len = rowLength(row);
+
+      // Padding refers to the last column of the row to keep the gather local
+      const size_t padColumn = (len > 0) ? ci[rp[row] + len - 1] : kZeroSize;
+
+      for (size_t k = 0; k < length; ++k) {
+        const size_t idx = offset + k * _chunkSize + l;
+        if (k < len) {
+          _nonZeros[idx] = nnz[rp[row] + k];
+          _columnIndices[idx] = static_cast<uint32_t>(ci[rp[row] + k]);
+        } else {
+          _nonZeros[idx] = 0;
+          _columnIndices[idx] = static_cast<uint32_t>(padColumn);
+        }
+      }
+    }
+  });
+}
+
+template <typename T> Vector2UZ MatrixSell<T>::size() const { return _size; }
+
+template <typename T> size_t MatrixSell<T>::rows() const { return _size.x; }
+
+template <typename T> size_t MatrixSell<T>::cols() const { return _size.y; }
+
+template <typename T> size_t MatrixSell<T>::chunkSize() const { return _chunkSize; }
+
+template <typename T> size_t MatrixSell<T>::sortingScope() const { return _sortingScope; }
+
+template <typename T> size_t MatrixSell<T>::numberOfChunks() const { return _chunkPointers.size() - 1; }
+
+template <typename T> size_t MatrixSell<T>::numberOfNonZeros() const { return _numNonZeros; }
+
+template <typename T> size_t MatrixSell<T>::numberOfStoredElements() const { return _nonZeros.size(); }
+
+template <typename T> void MatrixSell<T>::mvm(const VectorN<T> &v, VectorN<T> *result) const {
+  JET_ASSERT(v.rows() == cols());
+  JET_ASSERT(result->rows() == rows());
+
+  multiply(v, [&](size_t row, T sum) { (*result)[row] = sum; });
+}
+
+template <typename T> void MatrixSell<T>::residual(const VectorN<T> &x, const VectorN<T> &b, VectorN<T> *result) const {
+  JET_ASSERT(x.rows() == cols());
+  JET_ASSERT(b.rows() == rows());
+  JET_ASSERT(result->rows() == rows());
+
+  multiply(x, [&](size_t row, T sum) { (*result)[row] = b[row] - sum; });
+}
+
+template <typename T> template <typename Op> void MatrixSell<T>::multiply(const VectorN<T> &v, const Op &op) const {
+  const T *x = v.data();
+  const size_t *perm = _rowPermutation.data();
+  const size_t n = _size.x;
+
+  parallelRangeFor(kZeroSize, numberOfChunks(), [&](size_t begin, size_t end) {
+    std::vector<T> sums(_chunkSize);
+
+    for (size_t c = begin; c < end; ++c) {
+      const size_t offset = _chunkPointers[c];
+      const size_t length = (_chunkPointers[c + 1] - offset) / _chunkSize;
+      const T *nnz = _nonZeros.data() + offset;
+      const uint32_t *ci = _columnIndices.data() + offset;
+
+      switch (_chunkSize) {
+      case 4:
+        internal::sellChunkProduct<T, 4>(nnz, ci, length, x, sums.data());
+        break;
+      case 8:
+        internal::sellChunkProduct<T, 8>(nnz, ci, length, x, sums.data());
+        break;
+      case 16:
+        internal::sellChunkProduct<T, 16>(nnz, ci, length, x, sums.data());
+        break;
+      default:
+        internal::sellChunkProduct<T>(nnz, ci, length, _chunkSize, x, sums.data());
+        break;
+      }
+
+      for (size_t l = 0; l < _chunkSize; ++l) {
+        const size_t row = perm[c * _chunkSize + l];
+        if (row < n) {
+          op(row, sums[l]);
+        }
+      }
+    }
+  });
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_MATRIX_SELL_INL_H_
@@ -0,0 +1,138 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_MATRIX_SELL_H_
+#define INCLUDE_JET_MATRIX_SELL_H_
+
+#include "matrix_csr.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief Sliced ELLPACK (SELL-C-sigma) sparse matrix class.
+//!
+//! This class stores a sparse matrix as a sequence of chunks of C rows. Inside
+//! a chunk, the rows are padded to the same length and stored column-major so
+//! that the i-th non-zero of all C rows is contiguous in memory. This lets the
+//! matrix-vector product process C rows at once with SIMD lanes. To reduce
+//! the padding, rows are sorted by their length within windows of sigma rows
+//! before being sliced into chunks.
+//!
+//! The matrix is read-only and meant to be built from a MatrixCsr once the
+//! system is assembled. Column indices are stored with 32 bits to reduce the
+//! memory traffic of the bandwidth-bound matrix-vector product.
+//!
+//! \see M. Kreutzer et al., "A unified sparse matrix data format for efficient
+//!      general sparse matrix-vector multiplication on modern processors with
+//!      wide SIMD units", SIAM J. Sci. Comput. 36(5), 2014.
+//!
+//! \tparam T Type of the element.
+//!
+template <typename T> class MatrixSell final {
+public:
+  static_assert(std::is_floating_point<T>::value, "MatrixSell only can be instantiated with floating point types");
+
+  //! Default number of rows per chunk (C).
+  static constexpr size_t kDefaultChunkSize = 8;
+
+  //! Default sorting window size (sigma).
+  static constexpr size_t kDefaultSortingScope = 256;
+
+  // MARK: Constructors
+
+  //! Constructs an empty matrix.
+  MatrixSell();
+
+  //!
+  //! \brief Converts given CSR matrix into SELL-C-sigma format.
+  //!
+  //! \param csr          The input CSR matrix.
+  //! \param chunkSize    Number of rows per chunk (C).
+  //! \param sortingScope Size of the row-sorting window (sigma). Use 1 to
+  //!                     keep the original row order.
+  //!
+  explicit MatrixSell(const MatrixCsr<T> &csr, size_t chunkSize = kDefaultChunkSize,
+                      size_t sortingScope = kDefaultSortingScope);
+
+  // MARK: Basic setters
+
+  //! Clears the matrix and make it zero-dimensional.
+  void clear();
+
+  //! Converts given CSR matrix into SELL-C-sigma format.
+  void set(const MatrixCsr<T> &csr, size_t chunkSize = kDefaultChunkSize, size_t sortingScope = kDefaultSortingScope);
+
+  // MARK: Basic getters
+
+  //! Returns the size of this matrix.
+  Vector2UZ size() const;
+
+  //! Returns number of rows of this matrix.
+  size_t rows() const;
+
+  //! Returns number of columns of this matrix.
+  size_t cols() const;
+
+  //! Returns number of rows per chunk (C).
+  size_t chunkSize() const;
+
+  //! Returns size of the row-sorting window (sigma).
+  size_t sortingScope() const;
+
+  //! Returns number of chunks.
+  size_t numberOfChunks() const;
+
+  //! Returns the number of non-zero elements of the original matrix.
+  size_t numberOfNonZeros() const;
+
+  //! Returns the number of stored elements including the padding.
+  size_t numberOfStoredElements() const;
+
+  // MARK: Operations
+
+  //! Computes \p result = this matrix * \p v.
+  void mvm(const VectorN<T> &v, VectorN<T> *result) const;
+
+  //! Computes \p result = \p b - this matrix * \p x.
+  void residual(const VectorN<T> &x, const VectorN<T> &b, VectorN<T> *result) const;
+
+private:
+  Vector2UZ _size;
+  size_t _chunkSize = kDefaultChunkSize;
+  size_t _sortingScope = kDefaultSortingScope;
+  size_t _numNonZeros = 0;
+
+  //! Non-zeros, column-major within each chunk.
+  std::vector<T> _nonZeros;
+
+  //! Column indices with the same layout as the non-zeros.
+  std::vector<uint32_t> _columnIndices;
+
+  //! Offset of the first element of each chunk (numberOfChunks() + 1).
+  std::vector<size_t> _chunkPointers;
+
+  //! Original row index of each chunk slot. Padding slots store rows().
+  std::vector<size_t> _rowPermutation;
+
+  template <typename Op> void multiply(const VectorN<T> &v, const Op &op) const;
+};
+
+//! Float-type SELL-C-sigma matrix.
+using MatrixSellF = MatrixSell<float>;
+
+//! Double-type SELL-C-sigma matrix.
+using MatrixSellD = MatrixSell<double>;
+
+} // namespace vox
+} // namespace geometry
+
+#include "matrix_sell-inl.h"
+
+#endif // INCLUDE_JET_MATRIX_SELL_H_
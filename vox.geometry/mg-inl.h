@@ -23,9 +23,13 @@ MgResult mgVCycle(const MgMatrix<BlasType> &A, MgParameters<BlasType> params, un
 
   // 2) if currentLevel is the coarsest grid, goto 5)
   if (currentLevel < A.levels.size() - 1) {
-    auto r = buffer;
-    BlasType::residual(A[currentLevel], (*x)[currentLevel], (*b)[currentLevel], &(*r)[currentLevel]);
-    params.restrictFunc((*r)[currentLevel], &(*b)[currentLevel + 1]);
+    if (params.residualRestrictFunc) {
+      params.residualRestrictFunc(A[currentLevel], (*x)[currentLevel], (*b)[currentLevel], &(*b)[currentLevel + 1]);
+    } else {
+      auto r = buffer;
+      BlasType::residual(A[currentLevel], (*x)[currentLevel], (*b)[currentLevel], &(*r)[currentLevel]);
+      params.restrictFunc((*r)[currentLevel], &(*b)[currentLevel + 1]);
+    }
 
     BlasType::set(0.0, &(*x)[currentLevel + 1]);
 
@@ -49,6 +49,12 @@ template <typename BlasType>
 using MgCorrectFunc =
     std::function<void(const typename BlasType::VectorType &coarser, typename BlasType::VectorType *finer)>;
 
+//! Multigrid fused residual and restriction function type.
+template <typename BlasType>
+using MgResidualRestrictFunc =
+    std::function<void(const typename BlasType::MatrixType &A, const typename BlasType::VectorType &x,
+                       const typename BlasType::VectorType &b, typename BlasType::VectorType *coarser)>;
+
 //! Multigrid input parameter set.
 template <typename BlasType> struct MgParameters {
   //! Max number of multigrid levels.
@@ -75,6 +81,11 @@ template <typename BlasType> struct MgParameters {
   //! Correction function that maps coarser to finer grid.
   MgCorrectFunc<BlasType> correctFunc;
 
+  //! Optional function that computes the residual b - Ax and restricts it to
+  //! the coarser grid in a single pass. If empty, BlasType::residual followed
+  //! by restrictFunc is used.
+  MgResidualRestrictFunc<BlasType> residualRestrictFunc;
+
   //! Max error tolerance.
   double maxTolerance = 1e-9;
 };
@@ -7,6 +7,7 @@
 #include "common.h"
 
 #include "particle_emitter.h"
+#include "solver_checkpoint.h"
 
 namespace vox {
 namespace geometry {
@@ -39,6 +40,15 @@ template <size_t N> void ParticleEmitter<N>::setOnBeginUpdateCallback(const OnBe
   _onBeginUpdateCallback = callback;
 }
 
+template <size_t N>
+void ParticleEmitter<N>::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  checkpoint->setValue(prefix + "isEnabled", static_cast<uint8_t>(_isEnabled));
+}
+
+template <size_t N> void ParticleEmitter<N>::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  _isEnabled = checkpoint.value<uint8_t>(prefix + "isEnabled") != 0;
+}
+
 template class ParticleEmitter<2>;
 
 template class ParticleEmitter<3>;
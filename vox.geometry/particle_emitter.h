@@ -72,6 +72,19 @@ public:
   //!
   void setOnBeginUpdateCallback(const OnBeginUpdateCallback &callback);
 
+  //!
+  //! \brief      Stores the internal state into \p checkpoint.
+  //!
+  //! The state, such as the random number generator and the number of
+  //! emitted particles, is stored in channels with names starting with
+  //! \p prefix. Emitters with their own state override this function and call
+  //! the one of the base class.
+  //!
+  virtual void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const;
+
+  //! Restores the internal state stored by saveState.
+  virtual void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint);
+
 protected:
   //! Called when ParticleEmitter3::setTarget is executed.
   virtual void onSetTarget(const ParticleSystemDataPtr<N> &particles);
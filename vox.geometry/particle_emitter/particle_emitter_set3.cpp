@@ -6,6 +6,8 @@
 
 #include "particle_emitter_set3.h"
 #include "../common.h"
+#include "../solver_checkpoint.h"
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -32,6 +34,22 @@ void ParticleEmitterSet3::onUpdate(double currentTimeInSeconds, double timeInter
   }
 }
 
+void ParticleEmitterSet3::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  ParticleEmitter3::saveState(prefix, checkpoint);
+
+  for (size_t i = 0; i < _emitters.size(); ++i) {
+    _emitters[i]->saveState(prefix + std::to_string(i) + ".", checkpoint);
+  }
+}
+
+void ParticleEmitterSet3::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  ParticleEmitter3::loadState(prefix, checkpoint);
+
+  for (size_t i = 0; i < _emitters.size(); ++i) {
+    _emitters[i]->loadState(prefix + std::to_string(i) + ".", checkpoint);
+  }
+}
+
 ParticleEmitterSet3::Builder ParticleEmitterSet3::builder() { return Builder(); }
 
 ParticleEmitterSet3::Builder &
@@ -45,6 +45,12 @@ public:
   //! Adds sub-emitter.
   void addEmitter(const ParticleEmitter3Ptr &emitter);
 
+  //! Stores the state of the emitters into \p checkpoint, each with its own prefix.
+  void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state of the emitters stored by saveState.
+  void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) override;
+
   //! Returns builder fox ParticleEmitterSet3.
   static Builder builder();
 
@@ -7,6 +7,9 @@
 #include "point_particle_emitter3.h"
 #include "../common.h"
 #include "../samplers.h"
+#include "../solver_checkpoint.h"
+
+#include <sstream>
 
 namespace vox {
 namespace geometry {
@@ -80,6 +83,26 @@ double PointParticleEmitter3::random() {
   return d(_rng);
 }
 
+void PointParticleEmitter3::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  ParticleEmitter3::saveState(prefix, checkpoint);
+
+  std::ostringstream rng;
+  rng << _rng;
+  checkpoint->setText(prefix + "rng", rng.str());
+  checkpoint->setValue(prefix + "firstFrameTimeInSeconds", _firstFrameTimeInSeconds);
+  checkpoint->setValue(prefix + "numberOfEmittedParticles", static_cast<uint64_t>(_numberOfEmittedParticles));
+}
+
+void PointParticleEmitter3::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  ParticleEmitter3::loadState(prefix, checkpoint);
+
+  std::istringstream rng(checkpoint.text(prefix + "rng"));
+  rng >> _rng;
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(rng.fail(), "Invalid random number generator state.");
+  _firstFrameTimeInSeconds = checkpoint.value<double>(prefix + "firstFrameTimeInSeconds");
+  _numberOfEmittedParticles = static_cast<size_t>(checkpoint.value<uint64_t>(prefix + "numberOfEmittedParticles"));
+}
+
 PointParticleEmitter3::Builder PointParticleEmitter3::builder() { return Builder(); }
 
 PointParticleEmitter3::Builder &PointParticleEmitter3::Builder::withOrigin(const Vector3D &origin) {
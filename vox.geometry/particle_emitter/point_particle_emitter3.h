@@ -55,6 +55,12 @@ public:
   //! Sets max number of particles to be emitted.
   void setMaxNumberOfParticles(size_t maxNumberOfParticles);
 
+  //! Stores the random number generator and the number of emitted particles into \p checkpoint.
+  void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state stored by saveState.
+  void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) override;
+
   //! Returns builder fox PointParticleEmitter3.
   static Builder builder();
 
@@ -11,8 +11,10 @@
 #include "../point_generators/bcc_lattice_point_generator.h"
 #include "../point_searchers/point_hash_grid_searcher.h"
 #include "../samplers.h"
+#include "../solver_checkpoint.h"
 #include "volume_particle_emitter3.h"
 
+#include <sstream>
 #include <utility>
 
 using namespace vox;
@@ -179,6 +181,24 @@ double VolumeParticleEmitter3::random() {
   return d(_rng);
 }
 
+void VolumeParticleEmitter3::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  ParticleEmitter3::saveState(prefix, checkpoint);
+
+  std::ostringstream rng;
+  rng << _rng;
+  checkpoint->setText(prefix + "rng", rng.str());
+  checkpoint->setValue(prefix + "numberOfEmittedParticles", static_cast<uint64_t>(_numberOfEmittedParticles));
+}
+
+void VolumeParticleEmitter3::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  ParticleEmitter3::loadState(prefix, checkpoint);
+
+  std::istringstream rng(checkpoint.text(prefix + "rng"));
+  rng >> _rng;
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(rng.fail(), "Invalid random number generator state.");
+  _numberOfEmittedParticles = static_cast<size_t>(checkpoint.value<uint64_t>(prefix + "numberOfEmittedParticles"));
+}
+
 Vector3D VolumeParticleEmitter3::velocityAt(const Vector3D &point) const {
   Vector3D r = point - _implicitSurface->transform.translation();
   return _linearVel + _angularVel.cross(r) + _initialVel;
@@ -138,6 +138,12 @@ public:
   //! Sets the linear velocity of the emitter.
   void setAngularVelocity(const Vector3D &newAngularVel);
 
+  //! Stores the random number generator and the number of emitted particles into \p checkpoint.
+  void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state stored by saveState.
+  void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) override;
+
   //! Returns builder fox VolumeParticleEmitter3.
   static Builder builder();
 
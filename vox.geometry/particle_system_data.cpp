@@ -18,6 +18,7 @@
 #include "parallel.h"
 #include "particle_system_data.h"
 #include "point_searchers/point_parallel_hash_grid_searcher.h"
+#include "solver_checkpoint.h"
 #include "timer.h"
 
 namespace vox {
@@ -45,6 +46,22 @@ template <> struct GetFlatbuffersParticleSystemData<3> {
   }
 };
 
+template <size_t N> struct GetPointNeighborSearcher {};
+
+template <> struct GetPointNeighborSearcher<2> {
+  static PointNeighborSearcher2Ptr build(const std::string &name) { return Factory::buildPointNeighborSearcher2(name); }
+};
+
+template <> struct GetPointNeighborSearcher<3> {
+  static PointNeighborSearcher3Ptr build(const std::string &name) { return Factory::buildPointNeighborSearcher3(name); }
+};
+
+// The particle data arrays are written to and read from the flat buffers as
+// they are, which relies on the matching layout of the vector types.
+static_assert(FLATBUFFERS_LITTLEENDIAN, "Mapped particle data requires a little-endian target.");
+static_assert(sizeof(fbs::Vector2D) == sizeof(Vector2D), "Mismatching layout of Vector2D.");
+static_assert(sizeof(fbs::Vector3D) == sizeof(Vector3D), "Mismatching layout of Vector3D.");
+
 // MARK: ParticleSystemData implementations
 
 template <size_t N> ParticleSystemData<N>::ParticleSystemData() : ParticleSystemData(0) {}
@@ -77,6 +94,10 @@ template <size_t N> void ParticleSystemData<N>::resize(size_t newNumberOfParticl
 
 template <size_t N> size_t ParticleSystemData<N>::numberOfParticles() const { return _numberOfParticles; }
 
+template <size_t N> size_t ParticleSystemData<N>::numberOfScalarData() const { return _scalarDataList.length(); }
+
+template <size_t N> size_t ParticleSystemData<N>::numberOfVectorData() const { return _vectorDataList.length(); }
+
 template <size_t N> size_t ParticleSystemData<N>::addScalarData(double initialVal) {
   size_t attrIdx = _scalarDataList.length();
   _scalarDataList.append(ScalarData(numberOfParticles(), initialVal));
@@ -216,7 +237,7 @@ template <size_t N> void ParticleSystemData<N>::buildNeighborLists(double maxSea
 }
 
 template <size_t N> void ParticleSystemData<N>::serialize(std::vector<uint8_t> *buffer) const {
-  flatbuffers::FlatBufferBuilder builder(1024);
+  flatbuffers::FlatBufferBuilder builder(serializedSizeHint());
   typename GetFlatbuffersParticleSystemData<N>::Offset fbsParticleSystemData;
 
   serialize(*this, &builder, &fbsParticleSystemData);
@@ -231,10 +252,138 @@ template <size_t N> void ParticleSystemData<N>::serialize(std::vector<uint8_t> *
 }
 
 template <size_t N> void ParticleSystemData<N>::deserialize(const std::vector<uint8_t> &buffer) {
+  deserializeFromMemory(ConstArrayView1<uint8_t>(buffer.data(), buffer.size()));
+}
+
+template <size_t N> void ParticleSystemData<N>::serializeToFile(int fd) const {
+  flatbuffers::FlatBufferBuilder builder(serializedSizeHint());
+  typename GetFlatbuffersParticleSystemData<N>::Offset fbsParticleSystemData;
+
+  serialize(*this, &builder, &fbsParticleSystemData);
+
+  builder.Finish(fbsParticleSystemData);
+
+  internal::writeToFile(fd, builder.GetBufferPointer(), builder.GetSize());
+}
+
+template <size_t N> void ParticleSystemData<N>::deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) {
   auto fbsParticleSystemData = GetFlatbuffersParticleSystemData<N>::getParticleSystemData(buffer.data());
   deserialize(fbsParticleSystemData, *this);
 }
 
+template <size_t N>
+ConstArrayView1<double> ParticleSystemData<N>::mappedScalarDataAt(const ConstArrayView1<uint8_t> &buffer, size_t idx) {
+  return scalarDataView(GetFlatbuffersParticleSystemData<N>::getParticleSystemData(buffer.data()), idx);
+}
+
+template <size_t N>
+ConstArrayView1<Vector<double, N>> ParticleSystemData<N>::mappedVectorDataAt(const ConstArrayView1<uint8_t> &buffer,
+                                                                             size_t idx) {
+  return vectorDataView(GetFlatbuffersParticleSystemData<N>::getParticleSystemData(buffer.data()), idx);
+}
+
+template <size_t N>
+ConstArrayView1<Vector<double, N>> ParticleSystemData<N>::mappedPositions(const ConstArrayView1<uint8_t> &buffer) {
+  auto fbsParticleSystemData = GetFlatbuffersParticleSystemData<N>::getParticleSystemData(buffer.data());
+  return vectorDataView(fbsParticleSystemData, static_cast<size_t>(fbsParticleSystemData->positionIdx()));
+}
+
+template <size_t N>
+void ParticleSystemData<N>::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  checkpoint->setValue(prefix + "radius", _radius);
+  checkpoint->setValue(prefix + "mass", _mass);
+  checkpoint->setValue(prefix + "numberOfParticles", static_cast<uint64_t>(_numberOfParticles));
+  checkpoint->setValue(prefix + "numberOfScalarData", static_cast<uint64_t>(_scalarDataList.length()));
+  checkpoint->setValue(prefix + "numberOfVectorData", static_cast<uint64_t>(_vectorDataList.length()));
+
+  for (size_t i = 0; i < _scalarDataList.length(); ++i) {
+    checkpoint->setValues(prefix + "scalarData." + std::to_string(i), _scalarDataList[i].view());
+  }
+  for (size_t i = 0; i < _vectorDataList.length(); ++i) {
+    checkpoint->setValues(prefix + "vectorData." + std::to_string(i), _vectorDataList[i].view());
+  }
+
+  std::vector<uint8_t> neighborSearcherSerialized;
+  _neighborSearcher->serialize(&neighborSearcherSerialized);
+  checkpoint->setText(prefix + "neighborSearcher.type", _neighborSearcher->typeName());
+  checkpoint->setChannel(prefix + "neighborSearcher", std::move(neighborSearcherSerialized));
+
+  // The neighbor lists are flattened into their lengths and the concatenated indices
+  Array1<uint64_t> neighborListLengths(_neighborLists.length());
+  size_t numberOfNeighbors = 0;
+  for (size_t i = 0; i < _neighborLists.length(); ++i) {
+    neighborListLengths[i] = _neighborLists[i].length();
+    numberOfNeighbors += _neighborLists[i].length();
+  }
+  Array1<uint64_t> neighbors(numberOfNeighbors);
+  auto neighborIter = neighbors.begin();
+  for (const auto &neighborList : _neighborLists) {
+    neighborIter = std::copy(neighborList.begin(), neighborList.end(), neighborIter);
+  }
+  checkpoint->setValues<uint64_t>(prefix + "neighborListLengths", neighborListLengths.view());
+  checkpoint->setValues<uint64_t>(prefix + "neighborLists", neighbors.view());
+}
+
+template <size_t N>
+void ParticleSystemData<N>::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  const auto numberOfScalarData = static_cast<size_t>(checkpoint.value<uint64_t>(prefix + "numberOfScalarData"));
+  const auto numberOfVectorData = static_cast<size_t>(checkpoint.value<uint64_t>(prefix + "numberOfVectorData"));
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(numberOfScalarData < _scalarDataList.length() ||
+                                            numberOfVectorData < _vectorDataList.length(),
+                                        "Checkpoint has less particle data layers.");
+
+  _radius = checkpoint.value<double>(prefix + "radius");
+  _mass = checkpoint.value<double>(prefix + "mass");
+
+  resize(static_cast<size_t>(checkpoint.value<uint64_t>(prefix + "numberOfParticles")));
+  while (_scalarDataList.length() < numberOfScalarData) {
+    addScalarData();
+  }
+  while (_vectorDataList.length() < numberOfVectorData) {
+    addVectorData();
+  }
+
+  for (size_t i = 0; i < _scalarDataList.length(); ++i) {
+    auto data = checkpoint.values<double>(prefix + "scalarData." + std::to_string(i));
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(data.length() != _numberOfParticles, "Mismatching particle data size.");
+    std::copy(data.begin(), data.end(), _scalarDataList[i].begin());
+  }
+  for (size_t i = 0; i < _vectorDataList.length(); ++i) {
+    auto data = checkpoint.values<Vector<double, N>>(prefix + "vectorData." + std::to_string(i));
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(data.length() != _numberOfParticles, "Mismatching particle data size.");
+    std::copy(data.begin(), data.end(), _vectorDataList[i].begin());
+  }
+
+  // Reuses the current searcher if it has the same type, which keeps its settings
+  const std::string neighborSearcherType = checkpoint.text(prefix + "neighborSearcher.type");
+  if (_neighborSearcher == nullptr || _neighborSearcher->typeName() != neighborSearcherType) {
+    _neighborSearcher = GetPointNeighborSearcher<N>::build(neighborSearcherType);
+  }
+  _neighborSearcher->deserialize(checkpoint.channel(prefix + "neighborSearcher"));
+
+  auto neighborListLengths = checkpoint.values<uint64_t>(prefix + "neighborListLengths");
+  auto neighbors = checkpoint.values<uint64_t>(prefix + "neighborLists");
+  _neighborLists.resize(neighborListLengths.length());
+  size_t offset = 0;
+  for (size_t i = 0; i < neighborListLengths.length(); ++i) {
+    const auto length = static_cast<size_t>(neighborListLengths[i]);
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(offset + length > neighbors.length(), "Truncated neighbor lists.");
+    _neighborLists[i].resize(length);
+    std::transform(neighbors.begin() + offset, neighbors.begin() + offset + length, _neighborLists[i].begin(),
+                   [](uint64_t val) { return static_cast<size_t>(val); });
+    offset += length;
+  }
+}
+
+template <size_t N> size_t ParticleSystemData<N>::serializedSizeHint() const {
+  size_t size = 1024 + (sizeof(double) * _scalarDataList.length() +
+                        sizeof(Vector<double, N>) * _vectorDataList.length()) * _numberOfParticles;
+  for (const auto &neighbors : _neighborLists) {
+    size += sizeof(uint64_t) * (neighbors.length() + 1);
+  }
+  return size;
+}
+
 template <size_t N> void ParticleSystemData<N>::set(const ParticleSystemData &other) {
   _radius = other._radius;
   _mass = other._mass;
@@ -243,13 +392,9 @@ template <size_t N> void ParticleSystemData<N>::set(const ParticleSystemData &ot
   _forceIdx = other._forceIdx;
   _numberOfParticles = other._numberOfParticles;
 
-  for (auto &data : other._scalarDataList) {
-    _scalarDataList.append(data);
-  }
-
-  for (auto &data : other._vectorDataList) {
-    _vectorDataList.append(data);
-  }
+  // Replaces the data layers, reusing the storage of the existing ones
+  _scalarDataList = other._scalarDataList;
+  _vectorDataList = other._vectorDataList;
 
   _neighborSearcher = other._neighborSearcher->clone();
   _neighborLists = other._neighborLists;
@@ -276,13 +421,9 @@ ParticleSystemData<N>::serialize(const ParticleSystemData<2> &particles, flatbuf
 
   std::vector<flatbuffers::Offset<fbs::VectorParticleData2>> vectorDataList;
   for (const auto &vectorData : particles._vectorDataList) {
-    std::vector<fbs::Vector2D> newVectorData;
-    for (const auto &v : vectorData) {
-      newVectorData.push_back(jetToFbs(v));
-    }
-
     auto fbsVectorData = fbs::CreateVectorParticleData2(
-        *builder, builder->CreateVectorOfStructs(newVectorData.data(), newVectorData.size()));
+        *builder, builder->CreateVectorOfStructs(reinterpret_cast<const fbs::Vector2D *>(vectorData.data()),
+                                                 vectorData.length()));
     vectorDataList.push_back(fbsVectorData);
   }
   auto fbsVectorDataList = builder->CreateVector(vectorDataList);
@@ -328,13 +469,9 @@ ParticleSystemData<N>::serialize(const ParticleSystemData<3> &particles, flatbuf
 
   std::vector<flatbuffers::Offset<fbs::VectorParticleData3>> vectorDataList;
   for (const auto &vectorData : particles._vectorDataList) {
-    std::vector<fbs::Vector3D> newVectorData;
-    for (const auto &v : vectorData) {
-      newVectorData.push_back(jetToFbs(v));
-    }
-
     auto fbsVectorData = fbs::CreateVectorParticleData3(
-        *builder, builder->CreateVectorOfStructs(newVectorData.data(), newVectorData.size()));
+        *builder, builder->CreateVectorOfStructs(reinterpret_cast<const fbs::Vector3D *>(vectorData.data()),
+                                                 vectorData.length()));
     vectorDataList.push_back(fbsVectorData);
   }
   auto fbsVectorDataList = builder->CreateVector(vectorDataList);
@@ -386,10 +523,7 @@ std::enable_if_t<M == 2, void> ParticleSystemData<N>::deserialize(const fbs::Par
     particles._scalarDataList.append(ScalarData(data->size()));
 
     auto &newData = *(particles._scalarDataList.rbegin());
-
-    for (uint32_t i = 0; i < data->size(); ++i) {
-      newData[i] = data->Get(i);
-    }
+    std::copy(data->data(), data->data() + data->size(), newData.begin());
   }
   auto fbsVectorDataList = fbsParticleSystemData->vectorDataList();
   for (const auto &fbsVectorData : (*fbsVectorDataList)) {
@@ -397,9 +531,8 @@ std::enable_if_t<M == 2, void> ParticleSystemData<N>::deserialize(const fbs::Par
 
     particles._vectorDataList.append(VectorData(data->size()));
     auto &newData = *(particles._vectorDataList.rbegin());
-    for (uint32_t i = 0; i < data->size(); ++i) {
-      newData[i] = fbsToJet(*data->Get(i));
-    }
+    const auto *first = reinterpret_cast<const Vector2D *>(data->Data());
+    std::copy(first, first + data->size(), newData.begin());
   }
 
   particles._numberOfParticles = particles._vectorDataList[0].length();
@@ -444,10 +577,7 @@ std::enable_if_t<M == 3, void> ParticleSystemData<N>::deserialize(const fbs::Par
     particles._scalarDataList.append(ScalarData(data->size()));
 
     auto &newData = *(particles._scalarDataList.rbegin());
-
-    for (uint32_t i = 0; i < data->size(); ++i) {
-      newData[i] = data->Get(i);
-    }
+    std::copy(data->data(), data->data() + data->size(), newData.begin());
   }
 
   auto fbsVectorDataList = fbsParticleSystemData->vectorDataList();
@@ -456,9 +586,8 @@ std::enable_if_t<M == 3, void> ParticleSystemData<N>::deserialize(const fbs::Par
 
     particles._vectorDataList.append(VectorData(data->size()));
     auto &newData = *(particles._vectorDataList.rbegin());
-    for (uint32_t i = 0; i < data->size(); ++i) {
-      newData[i] = fbsToJet(*data->Get(i));
-    }
+    const auto *first = reinterpret_cast<const Vector3D *>(data->Data());
+    std::copy(first, first + data->size(), newData.begin());
   }
 
   particles._numberOfParticles = particles._vectorDataList[0].length();
@@ -32,6 +32,8 @@ struct ParticleSystemData3;
 namespace vox {
 namespace geometry {
 
+class SolverCheckpoint;
+
 //!
 //! \brief      N-D particle system data.
 //!
@@ -75,6 +77,12 @@ public:
   //! Returns the number of particles.
   [[nodiscard]] size_t numberOfParticles() const;
 
+  //! Returns the number of scalar data layers.
+  [[nodiscard]] size_t numberOfScalarData() const;
+
+  //! Returns the number of vector data layers, including positions, velocities and forces.
+  [[nodiscard]] size_t numberOfVectorData() const;
+
   //!
   //! \brief      Adds a scalar data layer and returns its index.
   //!
@@ -207,7 +215,57 @@ public:
   //! Deserializes this particle system data from the buffer.
   void deserialize(const std::vector<uint8_t> &buffer) override;
 
-  //! Copies from other particle system data.
+  //! Serializes this particle system data to \p fd without an intermediate buffer.
+  void serializeToFile(int fd) const override;
+
+  //! Deserializes this particle system data from the buffer, which can be memory mapped.
+  void deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) override;
+
+  //!
+  //! \brief Returns the view of the scalar data at \p idx in serialized particle system data.
+  //!
+  //! The view points into \p buffer, typically a MappedFile, so no data is
+  //! copied, and it is only valid as long as the buffer is.
+  //!
+  static ConstArrayView1<double> mappedScalarDataAt(const ConstArrayView1<uint8_t> &buffer, size_t idx);
+
+  //!
+  //! \brief Returns the view of the vector data at \p idx in serialized particle system data.
+  //!
+  //! The view points into \p buffer, typically a MappedFile, so no data is
+  //! copied, and it is only valid as long as the buffer is.
+  //!
+  static ConstArrayView1<Vector<double, N>> mappedVectorDataAt(const ConstArrayView1<uint8_t> &buffer, size_t idx);
+
+  //! Returns the view of the positions in serialized particle system data.
+  static ConstArrayView1<Vector<double, N>> mappedPositions(const ConstArrayView1<uint8_t> &buffer);
+
+  //!
+  //! \brief Stores the particles into \p checkpoint with channel names starting with \p prefix.
+  //!
+  //! Each data layer is a separate channel, so an incremental checkpoint
+  //! leaves out the layers that did not change. The neighbor searcher and
+  //! the neighbor lists are stored as well.
+  //!
+  virtual void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const;
+
+  //!
+  //! \brief Restores the particles stored by saveState.
+  //!
+  //! The neighbor searcher and the neighbor lists are restored instead of
+  //! rebuilt, so neighbor queries work right away. Missing data layers are
+  //! added, but the layers added after this data was constructed have to be
+  //! added in the same order as when the checkpoint was saved.
+  //!
+  virtual void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint);
+
+  //!
+  //! \brief Copies from other particle system data.
+  //!
+  //! The data layers and the neighbor lists reuse the existing storage when
+  //! the sizes match. The neighbor searcher is cloned, so it is allocated on
+  //! every call.
+  //!
   void set(const ParticleSystemData &other);
 
   //! Copies from other particle system data.
@@ -232,6 +290,25 @@ protected:
   static std::enable_if_t<M == 3, void> deserialize(const fbs::ParticleSystemData3 *fbsParticleSystemData,
                                                     ParticleSystemData<3> &particles);
 
+  //! Returns the rough size of the serialized data in bytes.
+  [[nodiscard]] size_t serializedSizeHint() const;
+
+  //! Returns the view of the scalar data at \p idx in a serialized flat buffer table.
+  template <typename FbsParticleSystemData>
+  static ConstArrayView1<double> scalarDataView(const FbsParticleSystemData *fbsParticleSystemData, size_t idx) {
+    auto data = fbsParticleSystemData->scalarDataList()->Get(static_cast<uint32_t>(idx))->data();
+    return ConstArrayView1<double>(data->data(), data->size());
+  }
+
+  //! Returns the view of the vector data at \p idx in a serialized flat buffer table.
+  template <typename FbsParticleSystemData>
+  static ConstArrayView1<Vector<double, N>> vectorDataView(const FbsParticleSystemData *fbsParticleSystemData,
+                                                           size_t idx) {
+    auto data = fbsParticleSystemData->vectorDataList()->Get(static_cast<uint32_t>(idx))->data();
+    return ConstArrayView1<Vector<double, N>>(reinterpret_cast<const Vector<double, N> *>(data->Data()),
+                                              data->size());
+  }
+
 private:
   double _radius = 1e-3;
   double _mass = 1e-3;
@@ -10,6 +10,7 @@
 #include "fields/constant_vector_field.h"
 #include "parallel.h"
 #include "particle_system_solver3.h"
+#include "solver_checkpoint.h"
 #include "timer.h"
 
 #include <algorithm>
@@ -135,6 +136,39 @@ void ParticleSystemSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) { U
 
 void ParticleSystemSolver3::onEndAdvanceTimeStep(double timeStepInSeconds) { UNUSED_VARIABLE(timeStepInSeconds); }
 
+void ParticleSystemSolver3::onSaveCheckpoint(SolverCheckpoint *checkpoint) const {
+    checkpoint->setValue("solver.dragCoefficient", _dragCoefficient);
+    checkpoint->setValue("solver.restitutionCoefficient", _restitutionCoefficient);
+    checkpoint->setValue("solver.gravity", _gravity);
+    
+    _particleSystemData->saveState("particles.", checkpoint);
+    
+    if (_emitter != nullptr) {
+        _emitter->saveState("emitter.", checkpoint);
+    }
+    
+    if (_collider != nullptr) {
+        _collider->saveState("collider.", checkpoint);
+    }
+}
+
+void ParticleSystemSolver3::onLoadCheckpoint(const SolverCheckpoint &checkpoint) {
+    _dragCoefficient = checkpoint.value<double>("solver.dragCoefficient");
+    _restitutionCoefficient = checkpoint.value<double>("solver.restitutionCoefficient");
+    _gravity = checkpoint.value<Vector3D>("solver.gravity");
+    
+    // The neighbor searcher and lists are restored as well, so nothing is rebuilt here
+    _particleSystemData->loadState("particles.", checkpoint);
+    
+    if (_emitter != nullptr) {
+        _emitter->loadState("emitter.", checkpoint);
+    }
+    
+    if (_collider != nullptr) {
+        _collider->loadState("collider.", checkpoint);
+    }
+}
+
 void ParticleSystemSolver3::resolveCollision() { resolveCollision(_newPositions, _newVelocities); }
 
 void ParticleSystemSolver3::resolveCollision(ArrayView1<Vector3D> newPositions, ArrayView1<Vector3D> newVelocities) {
@@ -145,6 +145,12 @@ protected:
     //! Called after a time-step is completed.
     virtual void onEndAdvanceTimeStep(double timeStepInSeconds);
     
+    //! Stores the particles, the emitter, the collider and the parameters into \p checkpoint.
+    void onSaveCheckpoint(SolverCheckpoint *checkpoint) const override;
+    
+    //! Restores the state stored by onSaveCheckpoint.
+    void onLoadCheckpoint(const SolverCheckpoint &checkpoint) override;
+    
     //! Resolves any collisions occurred by the particles.
     void resolveCollision();
     
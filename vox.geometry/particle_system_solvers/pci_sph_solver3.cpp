@@ -8,6 +8,7 @@
 #include "../common.h"
 #include "../parallel.h"
 #include "../point_generators/bcc_lattice_point_generator.h"
+#include "../solver_checkpoint.h"
 #include "../sph_kernels.h"
 
 #include <algorithm>
@@ -138,6 +139,20 @@ void PciSphSolver3::onBeginAdvanceTimeStep(double timeStepInSeconds) {
   _densityErrors.resize(numberOfParticles);
 }
 
+void PciSphSolver3::onSaveCheckpoint(SolverCheckpoint *checkpoint) const {
+  SphSolver3::onSaveCheckpoint(checkpoint);
+
+  checkpoint->setValue("solver.maxDensityErrorRatio", _maxDensityErrorRatio);
+  checkpoint->setValue("solver.maxNumberOfIterations", static_cast<uint32_t>(_maxNumberOfIterations));
+}
+
+void PciSphSolver3::onLoadCheckpoint(const SolverCheckpoint &checkpoint) {
+  SphSolver3::onLoadCheckpoint(checkpoint);
+
+  _maxDensityErrorRatio = checkpoint.value<double>("solver.maxDensityErrorRatio");
+  _maxNumberOfIterations = checkpoint.value<uint32_t>("solver.maxNumberOfIterations");
+}
+
 double PciSphSolver3::computeDelta(double timeStepInSeconds) {
   auto particles = sphSystemData();
   const double kernelRadius = particles->kernelRadius();
@@ -79,6 +79,12 @@ protected:
   //! Performs pre-processing step before the simulation.
   void onBeginAdvanceTimeStep(double timeStepInSeconds) override;
 
+  //! Stores the state of the base class and the PCISPH parameters into \p checkpoint.
+  void onSaveCheckpoint(SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state stored by onSaveCheckpoint.
+  void onLoadCheckpoint(const SolverCheckpoint &checkpoint) override;
+
 private:
   double _maxDensityErrorRatio = 0.01;
   unsigned int _maxNumberOfIterations = 5;
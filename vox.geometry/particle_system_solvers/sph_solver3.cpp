@@ -8,6 +8,7 @@
 #include "../common.h"
 #include "../parallel.h"
 #include "../physics_helpers.h"
+#include "../solver_checkpoint.h"
 #include "../sph_kernels.h"
 #include "../timer.h"
 
@@ -123,6 +124,28 @@ void SphSolver3::onEndAdvanceTimeStep(double timeStepInSeconds) {
            << "Max density / target density ratio: " << maxDensity / particles->targetDensity();
 }
 
+void SphSolver3::onSaveCheckpoint(SolverCheckpoint *checkpoint) const {
+  ParticleSystemSolver3::onSaveCheckpoint(checkpoint);
+
+  checkpoint->setValue("solver.eosExponent", _eosExponent);
+  checkpoint->setValue("solver.negativePressureScale", _negativePressureScale);
+  checkpoint->setValue("solver.viscosityCoefficient", _viscosityCoefficient);
+  checkpoint->setValue("solver.pseudoViscosityCoefficient", _pseudoViscosityCoefficient);
+  checkpoint->setValue("solver.speedOfSound", _speedOfSound);
+  checkpoint->setValue("solver.timeStepLimitScale", _timeStepLimitScale);
+}
+
+void SphSolver3::onLoadCheckpoint(const SolverCheckpoint &checkpoint) {
+  ParticleSystemSolver3::onLoadCheckpoint(checkpoint);
+
+  _eosExponent = checkpoint.value<double>("solver.eosExponent");
+  _negativePressureScale = checkpoint.value<double>("solver.negativePressureScale");
+  _viscosityCoefficient = checkpoint.value<double>("solver.viscosityCoefficient");
+  _pseudoViscosityCoefficient = checkpoint.value<double>("solver.pseudoViscosityCoefficient");
+  _speedOfSound = checkpoint.value<double>("solver.speedOfSound");
+  _timeStepLimitScale = checkpoint.value<double>("solver.timeStepLimitScale");
+}
+
 void SphSolver3::accumulateNonPressureForces(double timeStepInSeconds) {
   ParticleSystemSolver3::accumulateForces(timeStepInSeconds);
   accumulateViscosityForce();
@@ -144,6 +144,12 @@ protected:
   //! Performs post-processing step before the simulation.
   void onEndAdvanceTimeStep(double timeStepInSeconds) override;
 
+  //! Stores the state of the base class and the SPH parameters into \p checkpoint.
+  void onSaveCheckpoint(SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the state stored by onSaveCheckpoint.
+  void onLoadCheckpoint(const SolverCheckpoint &checkpoint) override;
+
   //! Accumulates the non-pressure forces to the forces array in the particle
   //! system.
   virtual void accumulateNonPressureForces(double timeStepInSeconds);
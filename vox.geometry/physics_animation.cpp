@@ -38,6 +38,43 @@ void PhysicsAnimation::setCurrentFrame(const Frame &frame) { _currentFrame = fra
 
 double PhysicsAnimation::currentTimeInSeconds() const { return _currentTime; }
 
+const AsyncFrameWriterPtr &PhysicsAnimation::frameWriter() const { return _frameWriter; }
+
+void PhysicsAnimation::setFrameWriter(const AsyncFrameWriterPtr &writer,
+                                      const std::function<AsyncFrameWriter::Job(const Frame &)> &snapshotFunc) {
+  _frameWriter = writer;
+  _frameSnapshotFunc = snapshotFunc;
+}
+
+void PhysicsAnimation::saveCheckpoint(SolverCheckpoint *checkpoint, const SolverCheckpoint *base) const {
+  JET_THROW_INVALID_ARG_IF(checkpoint == nullptr);
+
+  *checkpoint = SolverCheckpoint();
+  checkpoint->setFrameIndex(_currentFrame.index);
+  checkpoint->setValue("animation.frameIndex", static_cast<int32_t>(_currentFrame.index));
+  checkpoint->setValue("animation.timeIntervalInSeconds", _currentFrame.timeIntervalInSeconds);
+  checkpoint->setValue("animation.currentTimeInSeconds", _currentTime);
+  onSaveCheckpoint(checkpoint);
+
+  if (base != nullptr) {
+    checkpoint->removeUnchanged(*base);
+  }
+}
+
+void PhysicsAnimation::loadCheckpoint(const SolverCheckpoint &checkpoint, const SolverCheckpoint *base) {
+  // Copies share the channels, so resolving does not copy the data of the base
+  SolverCheckpoint state = checkpoint;
+  if (base != nullptr) {
+    state.resolve(*base);
+  }
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(state.isIncremental(), "Incremental checkpoint without its base.");
+
+  _currentFrame.index = state.value<int32_t>("animation.frameIndex");
+  _currentFrame.timeIntervalInSeconds = state.value<double>("animation.timeIntervalInSeconds");
+  _currentTime = state.value<double>("animation.currentTimeInSeconds");
+  onLoadCheckpoint(state);
+}
+
 unsigned int PhysicsAnimation::numberOfSubTimeSteps(double timeIntervalInSeconds) const {
   UNUSED_VARIABLE(timeIntervalInSeconds);
 
@@ -55,6 +92,11 @@ void PhysicsAnimation::onUpdate(const Frame &frame) {
 
     for (int32_t i = 0; i < numberOfFrames; ++i) {
       advanceTimeStep(frame.timeIntervalInSeconds);
+
+      if (_frameWriter && _frameSnapshotFunc) {
+        const Frame advancedFrame(_currentFrame.index + i + 1, frame.timeIntervalInSeconds);
+        _frameWriter->submit([&]() { return _frameSnapshotFunc(advancedFrame); });
+      }
     }
 
     _currentFrame = frame;
@@ -111,3 +153,7 @@ void PhysicsAnimation::initialize() { onInitialize(); }
 void PhysicsAnimation::onInitialize() {
   // Do nothing
 }
+
+void PhysicsAnimation::onSaveCheckpoint(SolverCheckpoint *checkpoint) const { UNUSED_VARIABLE(checkpoint); }
+
+void PhysicsAnimation::onLoadCheckpoint(const SolverCheckpoint &checkpoint) { UNUSED_VARIABLE(checkpoint); }
@@ -8,6 +8,8 @@
 #define INCLUDE_JET_PHYSICS_ANIMATION_H_
 
 #include "animation.h"
+#include "async_frame_writer.h"
+#include "solver_checkpoint.h"
 
 namespace vox {
 namespace geometry {
@@ -107,6 +109,52 @@ public:
   //!
   [[nodiscard]] double currentTimeInSeconds() const;
 
+  //!
+  //! \brief      Returns the writer of the frame output.
+  //!
+  [[nodiscard]] const AsyncFrameWriterPtr &frameWriter() const;
+
+  //!
+  //! \brief      Sets the asynchronous writer of the frame output.
+  //!
+  //! After every advanced frame, \p snapshotFunc is submitted to \p writer.
+  //! It should copy the simulation state, for example with a SnapshotPool,
+  //! and return the job which encodes and writes the copy. The job then runs
+  //! on the worker threads of the writer while the next frame is computed.
+  //! Pass nullptr to disable the output.
+  //!
+  //! \param[in]  writer        The frame writer.
+  //! \param[in]  snapshotFunc  Snapshots the given frame and returns the job writing it.
+  //!
+  void setFrameWriter(const AsyncFrameWriterPtr &writer,
+                      const std::function<AsyncFrameWriter::Job(const Frame &)> &snapshotFunc);
+
+  //!
+  //! \brief      Captures the simulation state into a checkpoint.
+  //!
+  //! The checkpoint holds the current frame and time as well as the state of
+  //! the subclass, so that a restarted simulation continues where it left
+  //! off. If \p base is given, the checkpoint becomes incremental and only
+  //! stores the channels that changed since \p base.
+  //!
+  //! \param[out] checkpoint    The checkpoint to overwrite.
+  //! \param[in]  base          The full checkpoint to compare with, or nullptr.
+  //!
+  void saveCheckpoint(SolverCheckpoint *checkpoint, const SolverCheckpoint *base = nullptr) const;
+
+  //!
+  //! \brief      Restores the simulation state from a checkpoint.
+  //!
+  //! The animation has to be set up the same way as when the checkpoint was
+  //! saved, for example with the same emitters and colliders, since only
+  //! their state is restored. An incremental checkpoint requires the \p base
+  //! it was saved with.
+  //!
+  //! \param[in]  checkpoint    The checkpoint to restore.
+  //! \param[in]  base          The base of an incremental checkpoint, or nullptr.
+  //!
+  void loadCheckpoint(const SolverCheckpoint &checkpoint, const SolverCheckpoint *base = nullptr);
+
 protected:
   //!
   //! \brief      Called when a single time-step should be advanced.
@@ -144,11 +192,26 @@ protected:
   //!
   virtual void onInitialize();
 
+  //!
+  //! \brief      Called to store the state of the subclass into \p checkpoint.
+  //!
+  //! Inheriting classes with their own state should override this function
+  //! and call the one of their base class.
+  //!
+  virtual void onSaveCheckpoint(SolverCheckpoint *checkpoint) const;
+
+  //!
+  //! \brief      Called to restore the state stored by onSaveCheckpoint.
+  //!
+  virtual void onLoadCheckpoint(const SolverCheckpoint &checkpoint);
+
 private:
   Frame _currentFrame;
   bool _isUsingFixedSubTimeSteps = true;
   unsigned int _numberOfFixedSubTimeSteps = 1;
   double _currentTime = 0.0;
+  AsyncFrameWriterPtr _frameWriter;
+  std::function<AsyncFrameWriter::Job(const Frame &)> _frameSnapshotFunc;
 
   void onUpdate(const Frame &frame) final;
 
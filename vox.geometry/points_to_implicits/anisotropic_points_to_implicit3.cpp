@@ -12,6 +12,7 @@
 #include "../sph_system_data.h"
 #include "../svd.h"
 #include "anisotropic_points_to_implicit3.h"
+#include "point_splatting.h"
 
 using namespace vox;
 using namespace geometry;
@@ -48,9 +49,9 @@ inline double w(const Vector3D &r, const Matrix3x3D &g, double gDet) {
 
 AnisotropicPointsToImplicit3::AnisotropicPointsToImplicit3(double kernelRadius, double cutOffDensity,
                                                            double positionSmoothingFactor, size_t minNumNeighbors,
-                                                           bool isOutputSdf)
+                                                           bool isOutputSdf, bool useScatter)
     : _kernelRadius(kernelRadius), _cutOffDensity(cutOffDensity), _positionSmoothingFactor(positionSmoothingFactor),
-      _minNumNeighbors(minNumNeighbors), _isOutputSdf(isOutputSdf) {}
+      _minNumNeighbors(minNumNeighbors), _isOutputSdf(isOutputSdf), _useScatter(useScatter) {}
 
 void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &points, ScalarGrid3 *output) const {
   if (output == nullptr) {
@@ -91,6 +92,10 @@ void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &poin
   std::vector<Matrix3x3D> gs(points.length());
   Array1<Vector3D> xMeans(points.length());
 
+  // Covariance matrices, where the isotropic points keep the scale matrix
+  Array1<Matrix3x3D> covs(points.length(), Matrix3x3D::makeScaleMatrix(h * h, h * h, h * h));
+  Array1<char> isAnisotropic(points.length(), 0);
+
   parallelFor(kZeroSize, points.length(), [&](size_t i) {
     const auto &x = points[i];
 
@@ -111,10 +116,7 @@ void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &poin
 
     xMeans[i] = lerp(x, xMean, _positionSmoothingFactor);
 
-    if (numNeighbors < _minNumNeighbors) {
-      const auto g = Matrix3x3D::makeScaleMatrix(invH, invH, invH);
-      gs[i] = g;
-    } else {
+    if (numNeighbors >= _minNumNeighbors) {
       // Compute covariance matrix
       // We start with small scale matrix (h*h) in order to
       // prevent zero covariance matrix when points are all
@@ -129,12 +131,24 @@ void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &poin
       meanNeighborSearcher->forEachNearbyPoint(x, r, getCov);
 
       cov /= wSum;
+      covs[i] = cov;
+      isAnisotropic[i] = 1;
+    }
+  });
 
-      // SVD
-      Matrix3x3D u;
-      Vector3D v;
-      Matrix3x3D w;
-      svd(cov, u, v, w);
+  // The covariance matrices are symmetric positive semi-definite, so their
+  // SVD is the eigen-decomposition.
+  Array1<Matrix3x3D> us(points.length());
+  Array1<Vector3D> vs(points.length());
+  symmetricEigen<double>(covs, us, vs);
+
+  parallelFor(kZeroSize, points.length(), [&](size_t i) {
+    if (!isAnisotropic[i]) {
+      const auto g = Matrix3x3D::makeScaleMatrix(invH, invH, invH);
+      gs[i] = g;
+    } else {
+      const Matrix3x3D &u = us[i];
+      Vector3D v = vs[i];
 
       // Take off the sign
       v.x = std::fabs(v.x);
@@ -152,7 +166,7 @@ void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &poin
 
       // Compute G
       const double scale = std::pow(v.x * v.y * v.z, 1.0 / 3.0); // volume preservation
-      const Matrix3x3D g = invH * scale * (w * invSigma * u.transposed());
+      const Matrix3x3D g = invH * scale * (u * invSigma * u.transposed());
       gs[i] = g;
     }
   });
@@ -165,19 +179,50 @@ void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &poin
   const auto d = meanParticles.densities();
   const double m = meanParticles.mass();
 
-  PointKdTreeSearcher3 meanNeighborSearcher2;
-  meanNeighborSearcher2.build(xMeans);
-
   // Compute SDF
   auto temp = output->clone();
-  temp->fill([&](const Vector3D &x) {
-    double sum = 0.0;
-    meanNeighborSearcher2.forEachNearbyPoint(x, r, [&](size_t i, const Vector3D &neighborPosition) {
-      sum += m / d[i] * w(neighborPosition - x, gs[i], gs[i].determinant());
-    });
+  if (_useScatter) {
+    Array1<double> gDets(points.length());
+    parallelFor(kZeroSize, points.length(), [&](size_t i) { gDets[i] = gs[i].determinant(); });
+
+    // The kernel of a point is non-zero inside the ellipsoid |G r| < 1, whose
+    // half extent along an axis is the norm of the row of G^-1. As in the
+    // gather, the contributions are also limited to the neighbor radius.
+    const auto support = [&](size_t i) {
+      const Matrix3x3D gInv = gs[i].inverse();
+      Vector3D extent;
+      for (size_t a = 0; a < 3; ++a) {
+        extent[a] = std::min(r, Vector3D(gInv(a, 0), gInv(a, 1), gInv(a, 2)).length());
+      }
+      return BoundingBox3D(xMeans[i] - extent, xMeans[i] + extent);
+    };
 
-    return _cutOffDensity - sum;
-  });
+    auto data = temp->dataView();
+    temp->fill(0.0);
+    splatPoints(
+        points.length(), temp->dataOrigin(), temp->gridSpacing(), support,
+        [&](size_t i, const Vector3D &x, double &sum) {
+          const Vector3D rx = xMeans[i] - x;
+          if (rx.lengthSquared() <= r * r) {
+            sum += m / d[i] * w(rx, gs[i], gDets[i]);
+          }
+        },
+        data);
+    parallelForEachIndex(data.size(),
+                         [&](size_t i, size_t j, size_t k) { data(i, j, k) = _cutOffDensity - data(i, j, k); });
+  } else {
+    PointKdTreeSearcher3 meanNeighborSearcher2;
+    meanNeighborSearcher2.build(xMeans);
+
+    temp->fill([&](const Vector3D &x) {
+      double sum = 0.0;
+      meanNeighborSearcher2.forEachNearbyPoint(x, r, [&](size_t i, const Vector3D &neighborPosition) {
+        sum += m / d[i] * w(neighborPosition - x, gs[i], gs[i].determinant());
+      });
+
+      return _cutOffDensity - sum;
+    });
+  }
 
   JET_INFO << "Computed SDF.";
 
@@ -192,3 +237,5 @@ void AnisotropicPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &poin
 
   JET_INFO << "Done converting points to implicit surface.";
 }
+
+bool AnisotropicPointsToImplicit3::useScatter() const { return _useScatter; }
@@ -34,20 +34,33 @@ public:
   //! \param positionSmoothingFactor Position smoothing factor.
   //! \param minNumNeighbors Minimum number of neighbors to enable anisotropic
   //!                        kernel.
+  //! \param isOutputSdf True to reinitialize the output to a signed distance.
+  //! \param useScatter True to splat the kernels into the grid instead of
+  //!                   gathering the neighbors at every grid point.
   //!
   explicit AnisotropicPointsToImplicit3(double kernelRadius = 1.0, double cutOffDensity = 0.5,
                                         double positionSmoothingFactor = 0.5, size_t minNumNeighbors = 25,
-                                        bool isOutputSdf = true);
+                                        bool isOutputSdf = true, bool useScatter = false);
 
   //! Converts the given points to implicit surface scalar field.
   void convert(const ConstArrayView1<Vector3D> &points, ScalarGrid3 *output) const override;
 
+  //!
+  //! \brief Returns true if the kernels are splatted into the grid.
+  //!
+  //! In the scatter mode, each point rasterizes its anisotropic kernel into
+  //! the grid points inside the bounding box of its ellipsoid, so the cost
+  //! scales with the number of points instead of the number of grid points.
+  //!
+  bool useScatter() const;
+
 private:
   double _kernelRadius = 1.0;
   double _cutOffDensity = 0.5;
   double _positionSmoothingFactor = 0.0;
   size_t _minNumNeighbors = 25;
   bool _isOutputSdf = true;
+  bool _useScatter = false;
 };
 
 //! Shared pointer for the AnisotropicPointsToImplicit3 type.
@@ -0,0 +1,117 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_SPLATTING_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_SPLATTING_INL_H_
+
+#include "../array.h"
+#include "../math_utils.h"
+#include "../parallel.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace vox {
+namespace geometry {
+
+namespace internal {
+
+//! Edge length (in data points) of the tiles processed by the splatting tasks.
+constexpr size_t kSplatTileSize = 8;
+
+} // namespace internal
+
+template <typename T, typename SupportFunc, typename SplatFunc>
+void splatPoints(size_t numberOfPoints, const Vector3D &dataOrigin, const Vector3D &gridSpacing,
+                 const SupportFunc &supportFunc, const SplatFunc &splatFunc, ArrayView3<T> output) {
+  constexpr size_t kTile = internal::kSplatTileSize;
+
+  const Vector3UZ dataSize = output.size();
+  if (numberOfPoints == 0 || dataSize.x * dataSize.y * dataSize.z == 0) {
+    return;
+  }
+
+  // Range [lower, upper) of the data points inside the support of each point
+  Array1<Vector3UZ> lowers(numberOfPoints);
+  Array1<Vector3UZ> uppers(numberOfPoints);
+  parallelFor(kZeroSize, numberOfPoints, [&](size_t i) {
+    const BoundingBox3D support = supportFunc(i);
+    for (size_t a = 0; a < 3; ++a) {
+      const double size = static_cast<double>(dataSize[a]);
+      const double lower = std::ceil((support.lowerCorner[a] - dataOrigin[a]) / gridSpacing[a]);
+      const double upper = std::floor((support.upperCorner[a] - dataOrigin[a]) / gridSpacing[a]) + 1.0;
+      lowers[i][a] = static_cast<size_t>(clamp(lower, 0.0, size));
+      uppers[i][a] = std::max(lowers[i][a], static_cast<size_t>(clamp(upper, 0.0, size)));
+    }
+  });
+
+  const Vector3UZ numberOfTiles{(dataSize.x + kTile - 1) / kTile, (dataSize.y + kTile - 1) / kTile,
+                                (dataSize.z + kTile - 1) / kTile};
+  const size_t totalNumberOfTiles = numberOfTiles.x * numberOfTiles.y * numberOfTiles.z;
+
+  const auto forEachOverlappingTile = [&](size_t i, const auto &func) {
+    const Vector3UZ &lower = lowers[i];
+    const Vector3UZ &upper = uppers[i];
+    if (lower.x == upper.x || lower.y == upper.y || lower.z == upper.z) {
+      return;
+    }
+    for (size_t k = lower.z / kTile; k <= (upper.z - 1) / kTile; ++k) {
+      for (size_t j = lower.y / kTile; j <= (upper.y - 1) / kTile; ++j) {
+        for (size_t ii = lower.x / kTile; ii <= (upper.x - 1) / kTile; ++ii) {
+          func(ii + numberOfTiles.x * (j + numberOfTiles.y * k));
+        }
+      }
+    }
+  };
+
+  // Bin the points to the tiles with a counting sort
+  Array1<size_t> tileStarts(totalNumberOfTiles + 1, 0);
+  for (size_t i = 0; i < numberOfPoints; ++i) {
+    forEachOverlappingTile(i, [&](size_t tile) { ++tileStarts[tile + 1]; });
+  }
+  for (size_t t = 0; t < totalNumberOfTiles; ++t) {
+    tileStarts[t + 1] += tileStarts[t];
+  }
+
+  Array1<size_t> tilePoints(tileStarts[totalNumberOfTiles]);
+  Array1<size_t> tileEnds(tileStarts);
+  for (size_t i = 0; i < numberOfPoints; ++i) {
+    forEachOverlappingTile(i, [&](size_t tile) { tilePoints[tileEnds[tile]++] = i; });
+  }
+
+  // Each task owns the data points of one tile
+  parallelFor(kZeroSize, totalNumberOfTiles, [&](size_t tile) {
+    const Vector3UZ tileIdx{tile % numberOfTiles.x, (tile / numberOfTiles.x) % numberOfTiles.y,
+                            tile / (numberOfTiles.x * numberOfTiles.y)};
+
+    for (size_t n = tileStarts[tile]; n < tileStarts[tile + 1]; ++n) {
+      const size_t i = tilePoints[n];
+
+      Vector3UZ begin;
+      Vector3UZ end;
+      for (size_t a = 0; a < 3; ++a) {
+        begin[a] = std::max(lowers[i][a], tileIdx[a] * kTile);
+        end[a] = std::min(uppers[i][a], (tileIdx[a] + 1) * kTile);
+      }
+
+      for (size_t k = begin.z; k < end.z; ++k) {
+        const double z = dataOrigin.z + gridSpacing.z * static_cast<double>(k);
+        for (size_t j = begin.y; j < end.y; ++j) {
+          const double y = dataOrigin.y + gridSpacing.y * static_cast<double>(j);
+          for (size_t ii = begin.x; ii < end.x; ++ii) {
+            const Vector3D x{dataOrigin.x + gridSpacing.x * static_cast<double>(ii), y, z};
+            splatFunc(i, x, output(ii, j, k));
+          }
+        }
+      }
+    }
+  });
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_POINT_SPLATTING_INL_H_
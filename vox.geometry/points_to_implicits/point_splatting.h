@@ -0,0 +1,49 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_POINT_SPLATTING_H_
+#define INCLUDE_JET_POINT_SPLATTING_H_
+
+#include "../array_view.h"
+#include "../bounding_box.h"
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief      Accumulates the kernels of the points into 3-D grid data.
+//!
+//! Instead of gathering the nearby points at every data point, this function
+//! scatters each point into the data points inside the bounding box of its
+//! kernel support. The data points are partitioned into cubic tiles and every
+//! point is binned to the tiles its support overlaps. The tiles are then
+//! processed in parallel, each task writing only to its own data points, so
+//! no atomic operations are needed. The points of a tile are visited in the
+//! increasing order of their indices, so the result is deterministic.
+//!
+//! \param[in]  numberOfPoints  The number of points.
+//! \param[in]  dataOrigin      The position of the data point at (0, 0, 0).
+//! \param[in]  gridSpacing     The spacing between the data points.
+//! \param[in]  supportFunc     Returns the bounding box of the kernel support
+//!                             of the i-th point.
+//! \param[in]  splatFunc       Adds the contribution of the i-th point at the
+//!                             given position to the given value.
+//! \param      output          The data to accumulate to.
+//!
+//! \tparam     T               Value type.
+//! \tparam     SupportFunc     Callable as BoundingBox3D(size_t).
+//! \tparam     SplatFunc       Callable as void(size_t, const Vector3D &, T &).
+//!
+template <typename T, typename SupportFunc, typename SplatFunc>
+void splatPoints(size_t numberOfPoints, const Vector3D &dataOrigin, const Vector3D &gridSpacing,
+                 const SupportFunc &supportFunc, const SplatFunc &splatFunc, ArrayView3<T> output);
+
+} // namespace vox
+} // namespace geometry
+
+#include "point_splatting-inl.h"
+
+#endif // INCLUDE_JET_POINT_SPLATTING_H_
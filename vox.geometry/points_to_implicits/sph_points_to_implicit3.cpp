@@ -7,14 +7,17 @@
 #include "../common.h"
 
 #include "../levelset_solvers/fmm_level_set_solver3.h"
+#include "../sph_kernels.h"
 #include "../sph_system_data.h"
+#include "point_splatting.h"
 #include "sph_points_to_implicit3.h"
 
 using namespace vox;
 using namespace geometry;
 
-SphPointsToImplicit3::SphPointsToImplicit3(double kernelRadius, double cutOffDensity, bool isOutputSdf)
-    : _kernelRadius(kernelRadius), _cutOffDensity(cutOffDensity), _isOutputSdf(isOutputSdf) {}
+SphPointsToImplicit3::SphPointsToImplicit3(double kernelRadius, double cutOffDensity, bool isOutputSdf,
+                                           bool useScatter)
+    : _kernelRadius(kernelRadius), _cutOffDensity(cutOffDensity), _isOutputSdf(isOutputSdf), _useScatter(useScatter) {}
 
 void SphPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &points, ScalarGrid3 *output) const {
   if (output == nullptr) {
@@ -40,12 +43,28 @@ void SphPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &points, Scal
   sphParticles.buildNeighborSearcher();
   sphParticles.updateDensities();
 
-  Array1<double> constData(sphParticles.numberOfParticles(), 1.0);
   auto temp = output->clone();
-  temp->fill([&](const Vector3D &x) {
-    double d = sphParticles.interpolate(x, constData);
-    return _cutOffDensity - d;
-  });
+  if (_useScatter) {
+    const auto d = sphParticles.densities();
+    const double m = sphParticles.mass();
+    const SphStdKernel3 kernel(_kernelRadius);
+    const Vector3D support = Vector3D::makeConstant(_kernelRadius);
+
+    auto data = temp->dataView();
+    temp->fill(0.0);
+    splatPoints(
+        points.length(), temp->dataOrigin(), temp->gridSpacing(),
+        [&](size_t i) { return BoundingBox3D(points[i] - support, points[i] + support); },
+        [&](size_t i, const Vector3D &x, double &sum) { sum += m / d[i] * kernel(x.distanceTo(points[i])); }, data);
+    parallelForEachIndex(data.size(),
+                         [&](size_t i, size_t j, size_t k) { data(i, j, k) = _cutOffDensity - data(i, j, k); });
+  } else {
+    Array1<double> constData(sphParticles.numberOfParticles(), 1.0);
+    temp->fill([&](const Vector3D &x) {
+      double d = sphParticles.interpolate(x, constData);
+      return _cutOffDensity - d;
+    });
+  }
 
   if (_isOutputSdf) {
     FmmLevelSetSolver3 solver;
@@ -54,3 +73,5 @@ void SphPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &points, Scal
     temp->swap(output);
   }
 }
+
+bool SphPointsToImplicit3::useScatter() const { return _useScatter; }
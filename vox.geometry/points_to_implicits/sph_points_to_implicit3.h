@@ -23,15 +23,21 @@ namespace geometry {
 class SphPointsToImplicit3 final : public PointsToImplicit3 {
 public:
   //! Constructs the converter with given kernel radius and cut-off density.
-  explicit SphPointsToImplicit3(double kernelRadius = 1.0, double cutOffDensity = 0.5, bool isOutputSdf = true);
+  explicit SphPointsToImplicit3(double kernelRadius = 1.0, double cutOffDensity = 0.5, bool isOutputSdf = true,
+                                bool useScatter = false);
 
   //! Converts the given points to implicit surface scalar field.
   void convert(const ConstArrayView1<Vector3D> &points, ScalarGrid3 *output) const override;
 
+  //! Returns true if the kernels are splatted into the grid instead of
+  //! gathering the neighbors at every grid point.
+  bool useScatter() const;
+
 private:
   double _kernelRadius = 1.0;
   double _cutOffDensity = 0.5;
   bool _isOutputSdf = true;
+  bool _useScatter = false;
 };
 
 //! Shared pointer type for SphPointsToImplicit3 class.
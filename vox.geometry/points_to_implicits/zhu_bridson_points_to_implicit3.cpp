@@ -8,6 +8,7 @@
 
 #include "../levelset_solvers/fmm_level_set_solver3.h"
 #include "../particle_system_data.h"
+#include "point_splatting.h"
 #include "zhu_bridson_points_to_implicit3.h"
 
 using namespace vox;
@@ -15,8 +16,10 @@ using namespace geometry;
 
 inline double k(double s) { return std::max(0.0, cubic(1.0 - s * s)); }
 
-ZhuBridsonPointsToImplicit3::ZhuBridsonPointsToImplicit3(double kernelRadius, double cutOffThreshold, bool isOutputSdf)
-    : _kernelRadius(kernelRadius), _cutOffThreshold(cutOffThreshold), _isOutputSdf(isOutputSdf) {}
+ZhuBridsonPointsToImplicit3::ZhuBridsonPointsToImplicit3(double kernelRadius, double cutOffThreshold, bool isOutputSdf,
+                                                         bool useScatter)
+    : _kernelRadius(kernelRadius), _cutOffThreshold(cutOffThreshold), _isOutputSdf(isOutputSdf),
+      _useScatter(useScatter) {}
 
 void ZhuBridsonPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &points, ScalarGrid3 *output) const {
   if (output == nullptr) {
@@ -36,31 +39,59 @@ void ZhuBridsonPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &point
     return;
   }
 
-  ParticleSystemData3 particles;
-  particles.addParticles(points);
-  particles.buildNeighborSearcher(_kernelRadius);
-
-  const auto neighborSearcher = particles.neighborSearcher();
   const double isoContValue = _cutOffThreshold * _kernelRadius;
 
   auto temp = output->clone();
-  temp->fill([&](const Vector3D &x) -> double {
-    Vector3D xAvg;
-    double wSum = 0.0;
-    const auto func = [&](size_t, const Vector3D &xi) {
-      const double wi = k((x - xi).length() / _kernelRadius);
-      wSum += wi;
-      xAvg += wi * xi;
-    };
-    neighborSearcher->forEachNearbyPoint(x, _kernelRadius, func);
-
-    if (wSum > 0.0) {
-      xAvg /= wSum;
-      return (x - xAvg).length() - isoContValue;
-    } else {
-      return output->boundingBox().diagonalLength();
-    }
-  });
+  if (_useScatter) {
+    const Vector3D support = Vector3D::makeConstant(_kernelRadius);
+    const double outsideValue = output->boundingBox().diagonalLength();
+
+    // Weighted sum of the positions (xyz) and the weights (w)
+    Array3<Vector4D> sums(temp->dataSize());
+    splatPoints(
+        points.length(), temp->dataOrigin(), temp->gridSpacing(),
+        [&](size_t i) { return BoundingBox3D(points[i] - support, points[i] + support); },
+        [&](size_t i, const Vector3D &x, Vector4D &sum) {
+          const double wi = k((x - points[i]).length() / _kernelRadius);
+          sum += Vector4D(wi * points[i].x, wi * points[i].y, wi * points[i].z, wi);
+        },
+        sums.view());
+
+    auto data = temp->dataView();
+    const auto pos = temp->dataPosition();
+    parallelForEachIndex(data.size(), [&](size_t i, size_t j, size_t k) {
+      const Vector4D &sum = sums(i, j, k);
+      if (sum.w > 0.0) {
+        const Vector3D xAvg = Vector3D(sum.x, sum.y, sum.z) / sum.w;
+        data(i, j, k) = (pos(Vector3UZ(i, j, k)) - xAvg).length() - isoContValue;
+      } else {
+        data(i, j, k) = outsideValue;
+      }
+    });
+  } else {
+    ParticleSystemData3 particles;
+    particles.addParticles(points);
+    particles.buildNeighborSearcher(_kernelRadius);
+
+    const auto neighborSearcher = particles.neighborSearcher();
+    temp->fill([&](const Vector3D &x) -> double {
+      Vector3D xAvg;
+      double wSum = 0.0;
+      const auto func = [&](size_t, const Vector3D &xi) {
+        const double wi = k((x - xi).length() / _kernelRadius);
+        wSum += wi;
+        xAvg += wi * xi;
+      };
+      neighborSearcher->forEachNearbyPoint(x, _kernelRadius, func);
+
+      if (wSum > 0.0) {
+        xAvg /= wSum;
+        return (x - xAvg).length() - isoContValue;
+      } else {
+        return output->boundingBox().diagonalLength();
+      }
+    });
+  }
 
   if (_isOutputSdf) {
     FmmLevelSetSolver3 solver;
@@ -69,3 +100,5 @@ void ZhuBridsonPointsToImplicit3::convert(const ConstArrayView1<Vector3D> &point
     temp->swap(output);
   }
 }
+
+bool ZhuBridsonPointsToImplicit3::useScatter() const { return _useScatter; }
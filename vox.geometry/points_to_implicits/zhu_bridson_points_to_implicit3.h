@@ -22,15 +22,20 @@ class ZhuBridsonPointsToImplicit3 final : public PointsToImplicit3 {
 public:
   //! Constructs the converter with given kernel radius and cut-off threshold.
   explicit ZhuBridsonPointsToImplicit3(double kernelRadius = 1.0, double cutOffThreshold = 0.25,
-                                       bool isOutputSdf = true);
+                                       bool isOutputSdf = true, bool useScatter = false);
 
   //! Converts the given points to implicit surface scalar field.
   void convert(const ConstArrayView1<Vector3D> &points, ScalarGrid3 *output) const override;
 
+  //! Returns true if the weights are splatted into the grid instead of
+  //! gathering the neighbors at every grid point.
+  bool useScatter() const;
+
 private:
   double _kernelRadius = 1.0;
   double _cutOffThreshold = 0.25;
   bool _isOutputSdf = true;
+  bool _useScatter = false;
 };
 
 //! Shared pointer type for ZhuBridsonPointsToImplicit3 class
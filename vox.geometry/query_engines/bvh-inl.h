@@ -8,10 +8,14 @@
 #define INCLUDE_JET_DETAIL_BVH_INL_H_
 
 #include "../constants.h"
+#include "../macros.h"
 #include "../math_utils.h"
+#include "../parallel.h"
 #include "bvh.h"
 
+#include <algorithm>
 #include <numeric>
+#include <stdexcept>
 
 namespace vox {
 namespace geometry {
@@ -35,7 +39,35 @@ template <typename T, size_t N> bool Bvh<T, N>::Node::isLeaf() const { return fl
 
 //
 
-template <typename T, size_t N> Bvh<T, N>::Bvh() {}
+namespace internal {
+
+// Number of bins per axis of the binned SAH.
+constexpr size_t kBvhSahNumberOfBins = 16;
+
+// The SAH subtrees with fewer items are built serially.
+constexpr size_t kBvhSahParallelThreshold = 4096;
+
+// Below this depth, the nodes are split at the median so that the depth of
+// the tree stays within the traversal stacks.
+constexpr size_t kBvhSahMaxDepth = 40;
+
+// Half the surface area of the box, or its perimeter in 2-D.
+template <size_t N> double bvhHalfArea(const BoundingBox<double, N> &box) {
+  const Vector<double, N> d = box.upperCorner - box.lowerCorner;
+  double area = 0.0;
+  for (size_t i = 0; i < N; ++i) {
+    double face = 1.0;
+    for (size_t j = 0; j < N; ++j) {
+      face *= (i == j) ? 1.0 : d[j];
+    }
+    area += face;
+  }
+  return area;
+}
+
+} // namespace internal
+
+template <typename T, size_t N> Bvh<T, N>::Bvh(bool useBinnedSah) : _useBinnedSah(useBinnedSah) {}
 
 template <typename T, size_t N>
 void Bvh<T, N>::build(const ConstArrayView1<T> &items, const ConstArrayView1<BoundingBox<double, N>> &itemsBounds) {
@@ -56,10 +88,87 @@ void Bvh<T, N>::build(const ConstArrayView1<T> &items, const ConstArrayView1<Bou
   Array1<size_t> itemIndices(_items.length());
   std::iota(std::begin(itemIndices), std::end(itemIndices), 0);
 
-  build(0, itemIndices.data(), _items.length(), 0);
+  if (_useBinnedSah) {
+    buildBinnedSah(itemIndices.data(), _items.length());
+  } else {
+    build(0, itemIndices.data(), _items.length(), 0);
+  }
+
+  _builtSurfaceAreaCost = surfaceAreaCost();
+}
+
+template <typename T, size_t N>
+bool Bvh<T, N>::refit(const ConstArrayView1<BoundingBox<double, N>> &itemsBounds, double maxCostRatio) {
+  JET_THROW_INVALID_ARG_IF(itemsBounds.length() != _items.length());
+
+  _itemBounds = itemsBounds;
+  if (_nodes.isEmpty()) {
+    return true;
+  }
+
+  // In the depth-first layout, the subtree of a node is the contiguous range
+  // from the node to the end of its right subtree. Split the top levels into
+  // such ranges, which are refitted in parallel, and a skeleton of the nodes
+  // above them, which is refitted last.
+  std::vector<std::pair<size_t, size_t>> ranges;
+  std::vector<size_t> skeleton;
+  const auto split = [&](const auto &self, size_t first, size_t last) -> void {
+    if (last - first < internal::kBvhSahParallelThreshold || _nodes[first].isLeaf()) {
+      ranges.emplace_back(first, last);
+      return;
+    }
+
+    skeleton.push_back(first);
+    self(self, first + 1, _nodes[first].child);
+    self(self, _nodes[first].child, last);
+  };
+  split(split, kZeroSize, _nodes.length());
+
+  std::vector<double> areaSums(ranges.size());
+  parallelFor(kZeroSize, ranges.size(),
+              [&](size_t i) { areaSums[i] = refitNodes(ranges[i].first, ranges[i].second); });
+
+  // Children come after their parents in pre-order
+  double areaSum = 0.0;
+  for (auto iter = skeleton.rbegin(); iter != skeleton.rend(); ++iter) {
+    Node &node = _nodes[*iter];
+    node.bound = _nodes[*iter + 1].bound;
+    node.bound.merge(_nodes[node.child].bound);
+    areaSum += internal::bvhHalfArea(node.bound);
+  }
+  for (double sum : areaSums) {
+    areaSum += sum;
+  }
+
+  _bound = _nodes[0].bound;
+
+  const double rootArea = internal::bvhHalfArea(_bound);
+  const double cost = (rootArea > 0.0) ? areaSum / rootArea : 0.0;
+  if (cost > maxCostRatio * _builtSurfaceAreaCost) {
+    const ContainerType items(_items);
+    build(items, itemsBounds);
+    return false;
+  }
+
+  return true;
+}
+
+template <typename T, size_t N> double Bvh<T, N>::surfaceAreaCost() const {
+  if (_nodes.isEmpty()) {
+    return 0.0;
+  }
+
+  double areaSum = 0.0;
+  for (const Node &node : _nodes) {
+    areaSum += internal::bvhHalfArea(node.bound);
+  }
+
+  const double rootArea = internal::bvhHalfArea(_nodes[0].bound);
+  return (rootArea > 0.0) ? areaSum / rootArea : 0.0;
 }
 
 template <typename T, size_t N> void Bvh<T, N>::clear() {
+  _builtSurfaceAreaCost = 0.0;
   _bound = BoundingBox<double, N>{};
   _items.clear();
   _itemBounds.clear();
@@ -69,6 +178,13 @@ template <typename T, size_t N> void Bvh<T, N>::clear() {
 template <typename T, size_t N>
 inline NearestNeighborQueryResult<T, N>
 Bvh<T, N>::nearest(const Vector<double, N> &pt, const NearestNeighborDistanceFunc<T, N> &distanceFunc) const {
+  return nearest<NearestNeighborDistanceFunc<T, N>>(pt, distanceFunc);
+}
+
+template <typename T, size_t N>
+template <typename DistanceFunc>
+NearestNeighborQueryResult<T, N> Bvh<T, N>::nearest(const Vector<double, N> &pt,
+                                                    const DistanceFunc &distanceFunc) const {
   NearestNeighborQueryResult<T, N> best;
   best.distance = kMaxD;
   best.item = nullptr;
@@ -366,6 +482,13 @@ inline void Bvh<T, N>::forEachIntersectingItem(const Ray<double, N> &ray, const
 template <typename T, size_t N>
 inline ClosestIntersectionQueryResult<T, N>
 Bvh<T, N>::closestIntersection(const Ray<double, N> &ray, const GetRayIntersectionFunc<T, N> &testFunc) const {
+  return closestIntersection<GetRayIntersectionFunc<T, N>>(ray, testFunc);
+}
+
+template <typename T, size_t N>
+template <typename TestFunc>
+ClosestIntersectionQueryResult<T, N> Bvh<T, N>::closestIntersection(const Ray<double, N> &ray,
+                                                                    const TestFunc &testFunc) const {
   ClosestIntersectionQueryResult<T, N> best;
   best.distance = kMaxD;
   best.item = nullptr;
@@ -427,6 +550,251 @@ Bvh<T, N>::closestIntersection(const Ray<double, N> &ray, const GetRayIntersecti
   return best;
 }
 
+template <typename T, size_t N>
+template <typename DistanceFunc>
+void Bvh<T, N>::nearest(const ConstArrayView1<Vector<double, N>> &pts, const DistanceFunc &distanceFunc,
+                        ArrayView1<NearestNeighborQueryResult<T, N>> results) const {
+  JET_THROW_INVALID_ARG_IF(pts.length() != results.length());
+
+  static const int kMaxTreeDepth = 8 * sizeof(size_t);
+  const Node *todo[kMaxTreeDepth];
+
+  // Packet in SoA layout. The unused lanes repeat the last point, and their
+  // negative best distance keeps them from visiting any node.
+  std::array<PacketScalars, N> p;
+  PacketScalars bestDist;
+  PacketScalars bestDistSqr;
+  std::array<const T *, kPacketSize> bestItem;
+
+  // Squared distances from the packet points to the box
+  auto boxDistanceSquared = [&p](const BoundingBox<double, N> &box, PacketScalars &distSqr) {
+    distSqr.fill(0.0);
+    for (size_t axis = 0; axis < N; ++axis) {
+      const double lower = box.lowerCorner[axis];
+      const double upper = box.upperCorner[axis];
+      for (size_t lane = 0; lane < kPacketSize; ++lane) {
+        const double d = std::max(std::max(lower - p[axis][lane], p[axis][lane] - upper), 0.0);
+        distSqr[lane] += d * d;
+      }
+    }
+  };
+
+  // Returns the minimum distance of the lanes if any lane should visit the
+  // box, and kMaxD otherwise.
+  PacketScalars distSqr;
+  auto visitDistanceSquared = [&](const BoundingBox<double, N> &box) {
+    boxDistanceSquared(box, distSqr);
+    double minDistSqr = kMaxD;
+    for (size_t lane = 0; lane < kPacketSize; ++lane) {
+      if (distSqr[lane] < bestDistSqr[lane]) {
+        minDistSqr = std::min(minDistSqr, distSqr[lane]);
+      }
+    }
+    return minDistSqr;
+  };
+
+  for (size_t begin = 0; begin < pts.length(); begin += kPacketSize) {
+    const size_t count = std::min(kPacketSize, pts.length() - begin);
+    for (size_t lane = 0; lane < kPacketSize; ++lane) {
+      const Vector<double, N> &pt = pts[begin + std::min(lane, count - 1)];
+      for (size_t axis = 0; axis < N; ++axis) {
+        p[axis][lane] = pt[axis];
+      }
+    }
+    // Start from the nearest items of the previous packet, which are close
+    // for coherent queries and prune most of the tree from the beginning.
+    for (size_t lane = 0; lane < kPacketSize; ++lane) {
+      bestDist[lane] = (lane < count) ? kMaxD : -1.0;
+      bestDistSqr[lane] = bestDist[lane];
+      if (lane < count && begin > 0 && results[begin - kPacketSize + lane].item != nullptr) {
+        const T *seed = results[begin - kPacketSize + lane].item;
+        bestDist[lane] = distanceFunc(*seed, pts[begin + lane]);
+        bestDistSqr[lane] = bestDist[lane] * bestDist[lane];
+        bestItem[lane] = seed;
+      } else {
+        bestItem[lane] = nullptr;
+      }
+    }
+
+    // Traverse BVH nodes
+    size_t todoPos = 0;
+    const Node *node = _nodes.isEmpty() ? nullptr : _nodes.data();
+    while (node != nullptr) {
+      if (node->isLeaf()) {
+        boxDistanceSquared(node->bound, distSqr);
+        for (size_t lane = 0; lane < count; ++lane) {
+          if (distSqr[lane] >= bestDistSqr[lane]) {
+            continue;
+          }
+
+          const double dist = distanceFunc(_items[node->item], pts[begin + lane]);
+          if (dist < bestDist[lane]) {
+            bestDist[lane] = dist;
+            bestDistSqr[lane] = dist * dist;
+            bestItem[lane] = &_items[node->item];
+          }
+        }
+      } else {
+        const Node *left = node + 1;
+        const Node *right = &_nodes[node->child];
+        const double distMinLeftSqr = visitDistanceSquared(left->bound);
+        const double distMinRightSqr = visitDistanceSquared(right->bound);
+        const bool shouldVisitLeft = distMinLeftSqr < kMaxD;
+        const bool shouldVisitRight = distMinRightSqr < kMaxD;
+
+        if (shouldVisitLeft && shouldVisitRight) {
+          // Enqueue the farther child in todo stack
+          const bool isLeftFirst = distMinLeftSqr < distMinRightSqr;
+          todo[todoPos] = isLeftFirst ? right : left;
+          ++todoPos;
+          node = isLeftFirst ? left : right;
+          continue;
+        } else if (shouldVisitLeft) {
+          node = left;
+          continue;
+        } else if (shouldVisitRight) {
+          node = right;
+          continue;
+        }
+      }
+
+      // Grab next node to process from todo stack
+      if (todoPos > 0) {
+        // Dequeue
+        --todoPos;
+        node = todo[todoPos];
+      } else {
+        break;
+      }
+    }
+
+    for (size_t lane = 0; lane < count; ++lane) {
+      results[begin + lane].item = bestItem[lane];
+      results[begin + lane].distance = bestDist[lane];
+    }
+  }
+}
+
+template <typename T, size_t N>
+template <typename TestFunc>
+void Bvh<T, N>::closestIntersection(const ConstArrayView1<Ray<double, N>> &rays, const TestFunc &testFunc,
+                                    ArrayView1<ClosestIntersectionQueryResult<T, N>> results) const {
+  JET_THROW_INVALID_ARG_IF(rays.length() != results.length());
+
+  static const int kMaxTreeDepth = 8 * sizeof(size_t);
+  const Node *todo[kMaxTreeDepth];
+
+  // Packet in SoA layout. The unused lanes repeat the last ray, and their
+  // negative best distance keeps them from visiting any node.
+  std::array<PacketScalars, N> origin;
+  std::array<PacketScalars, N> invDir;
+  PacketScalars bestDist;
+  std::array<const T *, kPacketSize> bestItem;
+
+  // Returns true if any lane enters the box before its closest intersection,
+  // using the slab test of BoundingBox::intersects.
+  PacketScalars tMin;
+  PacketScalars tMax;
+  auto isBoxVisited = [&](const BoundingBox<double, N> &box) {
+    tMin.fill(0.0);
+    tMax = bestDist;
+    for (size_t axis = 0; axis < N; ++axis) {
+      const double lower = box.lowerCorner[axis];
+      const double upper = box.upperCorner[axis];
+      for (size_t lane = 0; lane < kPacketSize; ++lane) {
+        const double t0 = (lower - origin[axis][lane]) * invDir[axis][lane];
+        const double t1 = (upper - origin[axis][lane]) * invDir[axis][lane];
+        const double tNear = t0 > t1 ? t1 : t0;
+        const double tFar = t0 > t1 ? t0 : t1;
+        tMin[lane] = tNear > tMin[lane] ? tNear : tMin[lane];
+        tMax[lane] = tFar < tMax[lane] ? tFar : tMax[lane];
+      }
+    }
+
+    bool isVisited = false;
+    for (size_t lane = 0; lane < kPacketSize; ++lane) {
+      isVisited |= !(tMin[lane] > tMax[lane]);
+    }
+    return isVisited;
+  };
+
+  for (size_t begin = 0; begin < rays.length(); begin += kPacketSize) {
+    const size_t count = std::min(kPacketSize, rays.length() - begin);
+    for (size_t lane = 0; lane < kPacketSize; ++lane) {
+      const Ray<double, N> &ray = rays[begin + std::min(lane, count - 1)];
+      for (size_t axis = 0; axis < N; ++axis) {
+        origin[axis][lane] = ray.origin[axis];
+        invDir[axis][lane] = 1.0 / ray.direction[axis];
+      }
+    }
+    for (size_t lane = 0; lane < kPacketSize; ++lane) {
+      bestDist[lane] = (lane < count) ? kMaxD : -1.0;
+    }
+    bestItem.fill(nullptr);
+
+    // Traverse BVH nodes, ordering the children by the first ray
+    const Ray<double, N> &firstRay = rays[begin];
+    size_t todoPos = 0;
+    const Node *node = (_nodes.isEmpty() || !isBoxVisited(_bound)) ? nullptr : _nodes.data();
+    while (node != nullptr) {
+      if (node->isLeaf()) {
+        isBoxVisited(node->bound);
+        for (size_t lane = 0; lane < count; ++lane) {
+          if (tMin[lane] > tMax[lane]) {
+            continue;
+          }
+
+          const double dist = testFunc(_items[node->item], rays[begin + lane]);
+          if (dist < bestDist[lane]) {
+            bestDist[lane] = dist;
+            bestItem[lane] = _items.data() + node->item;
+          }
+        }
+      } else {
+        const Node *firstChild;
+        const Node *secondChild;
+        if (firstRay.direction[node->flags] > 0.0) {
+          firstChild = node + 1;
+          secondChild = &_nodes[node->child];
+        } else {
+          firstChild = &_nodes[node->child];
+          secondChild = node + 1;
+        }
+
+        const bool shouldVisitFirst = isBoxVisited(firstChild->bound);
+        const bool shouldVisitSecond = isBoxVisited(secondChild->bound);
+        if (shouldVisitFirst && shouldVisitSecond) {
+          // Enqueue secondChild in todo stack
+          todo[todoPos] = secondChild;
+          ++todoPos;
+          node = firstChild;
+          continue;
+        } else if (shouldVisitFirst) {
+          node = firstChild;
+          continue;
+        } else if (shouldVisitSecond) {
+          node = secondChild;
+          continue;
+        }
+      }
+
+      // Grab next node to process from todo stack
+      if (todoPos > 0) {
+        // Dequeue
+        --todoPos;
+        node = todo[todoPos];
+      } else {
+        break;
+      }
+    }
+
+    for (size_t lane = 0; lane < count; ++lane) {
+      results[begin + lane].item = bestItem[lane];
+      results[begin + lane].distance = bestDist[lane];
+    }
+  }
+}
+
 template <typename T, size_t N> const BoundingBox<double, N> &Bvh<T, N>::boundingBox() const { return _bound; }
 
 template <typename T, size_t N> typename Bvh<T, N>::iterator Bvh<T, N>::begin() { return _items.begin(); }
@@ -508,6 +876,197 @@ size_t Bvh<T, N>::build(size_t nodeIndex, size_t *itemIndices, size_t nItems, si
   return std::max(d0, d1);
 }
 
+template <typename T, size_t N> bool Bvh<T, N>::useBinnedSah() const { return _useBinnedSah; }
+
+template <typename T, size_t N> void Bvh<T, N>::buildBinnedSah(size_t *itemIndices, size_t nItems) {
+  // Split the top levels serially. A skeleton node is either split further,
+  // or the root of a subtree built in parallel.
+  struct SkeletonNode {
+    BoundingBox<double, N> bound;
+    uint8_t axis = 0;
+    size_t right = kMaxSize;
+    size_t task = kMaxSize;
+  };
+  struct Task {
+    size_t *itemIndices;
+    size_t nItems;
+    size_t depth;
+  };
+
+  std::vector<SkeletonNode> skeleton;
+  std::vector<Task> tasks;
+  const auto split = [&](const auto &self, size_t *indices, size_t n, size_t depth) -> void {
+    const size_t skeletonIndex = skeleton.size();
+    skeleton.emplace_back();
+    if (n < internal::kBvhSahParallelThreshold) {
+      skeleton[skeletonIndex].task = tasks.size();
+      tasks.push_back(Task{indices, n, depth});
+      return;
+    }
+
+    BoundingBox<double, N> nodeBound;
+    for (size_t i = 0; i < n; ++i) {
+      nodeBound.merge(_itemBounds[indices[i]]);
+    }
+
+    uint8_t axis = 0;
+    const size_t midPoint = sahSplit(indices, n, depth, &axis);
+    skeleton[skeletonIndex].bound = nodeBound;
+    skeleton[skeletonIndex].axis = axis;
+    self(self, indices, midPoint, depth + 1);
+    skeleton[skeletonIndex].right = skeleton.size();
+    self(self, indices + midPoint, n - midPoint, depth + 1);
+  };
+  split(split, itemIndices, nItems, 0);
+
+  std::vector<std::vector<Node>> subtrees(tasks.size());
+  parallelFor(kZeroSize, tasks.size(), [&](size_t i) {
+    buildBinnedSah(tasks[i].itemIndices, tasks[i].nItems, tasks[i].depth, &subtrees[i]);
+  });
+
+  // Stitch the subtrees into the depth-first layout, where the left child
+  // follows its parent.
+  const auto stitch = [&](const auto &self, size_t skeletonIndex) -> void {
+    const SkeletonNode &node = skeleton[skeletonIndex];
+    if (node.task != kMaxSize) {
+      const size_t offset = _nodes.length();
+      for (Node subtreeNode : subtrees[node.task]) {
+        if (!subtreeNode.isLeaf()) {
+          subtreeNode.child += offset;
+        }
+        _nodes.append(subtreeNode);
+      }
+      return;
+    }
+
+    const size_t nodeIndex = _nodes.length();
+    _nodes.append(Node());
+    self(self, skeletonIndex + 1);
+    _nodes[nodeIndex].initInternal(node.axis, _nodes.length(), node.bound);
+    self(self, node.right);
+  };
+  stitch(stitch, 0);
+}
+
+template <typename T, size_t N>
+void Bvh<T, N>::buildBinnedSah(size_t *itemIndices, size_t nItems, size_t currentDepth,
+                               std::vector<Node> *nodes) const {
+  const size_t nodeIndex = nodes->size();
+  nodes->emplace_back();
+
+  if (nItems == 1) {
+    (*nodes)[nodeIndex].initLeaf(itemIndices[0], _itemBounds[itemIndices[0]]);
+    return;
+  }
+
+  BoundingBox<double, N> nodeBound;
+  for (size_t i = 0; i < nItems; ++i) {
+    nodeBound.merge(_itemBounds[itemIndices[i]]);
+  }
+
+  uint8_t axis = 0;
+  const size_t midPoint = sahSplit(itemIndices, nItems, currentDepth, &axis);
+
+  // Child indices are relative to the subtree root
+  buildBinnedSah(itemIndices, midPoint, currentDepth + 1, nodes);
+  (*nodes)[nodeIndex].initInternal(axis, nodes->size(), nodeBound);
+  buildBinnedSah(itemIndices + midPoint, nItems - midPoint, currentDepth + 1, nodes);
+}
+
+template <typename T, size_t N>
+size_t Bvh<T, N>::sahSplit(size_t *itemIndices, size_t nItems, size_t currentDepth, uint8_t *axis) const {
+  using internal::kBvhSahNumberOfBins;
+
+  BoundingBox<double, N> centroidBound;
+  for (size_t i = 0; i < nItems; ++i) {
+    const Vector<double, N> c = _itemBounds[itemIndices[i]].midPoint();
+    centroidBound.merge(c);
+  }
+
+  const auto binOf = [&](size_t item, size_t a) {
+    const double lower = centroidBound.lowerCorner[a];
+    const double extent = centroidBound.upperCorner[a] - lower;
+    const double c = 0.5 * (_itemBounds[item].lowerCorner[a] + _itemBounds[item].upperCorner[a]);
+    const auto bin = static_cast<size_t>(static_cast<double>(kBvhSahNumberOfBins) * (c - lower) / extent);
+    return std::min(bin, kBvhSahNumberOfBins - 1);
+  };
+
+  // Find the bin boundary with the lowest SAH cost
+  double bestCost = kMaxD;
+  size_t bestBin = 0;
+  *axis = static_cast<uint8_t>((centroidBound.upperCorner - centroidBound.lowerCorner).dominantAxis());
+  for (size_t a = 0; a < N && currentDepth < internal::kBvhSahMaxDepth; ++a) {
+    if (!(centroidBound.upperCorner[a] > centroidBound.lowerCorner[a])) {
+      continue;
+    }
+
+    std::array<size_t, kBvhSahNumberOfBins> counts{};
+    std::array<BoundingBox<double, N>, kBvhSahNumberOfBins> bounds;
+    for (size_t i = 0; i < nItems; ++i) {
+      const size_t bin = binOf(itemIndices[i], a);
+      ++counts[bin];
+      bounds[bin].merge(_itemBounds[itemIndices[i]]);
+    }
+
+    std::array<double, kBvhSahNumberOfBins> rightCosts{};
+    BoundingBox<double, N> rightBound;
+    size_t rightCount = 0;
+    for (size_t bin = kBvhSahNumberOfBins - 1; bin > 0; --bin) {
+      rightBound.merge(bounds[bin]);
+      rightCount += counts[bin];
+      rightCosts[bin] = (rightCount > 0) ? static_cast<double>(rightCount) * internal::bvhHalfArea(rightBound) : kMaxD;
+    }
+
+    BoundingBox<double, N> leftBound;
+    size_t leftCount = 0;
+    for (size_t bin = 0; bin + 1 < kBvhSahNumberOfBins; ++bin) {
+      leftBound.merge(bounds[bin]);
+      leftCount += counts[bin];
+      if (leftCount == 0 || rightCosts[bin + 1] == kMaxD) {
+        continue;
+      }
+
+      const double cost = static_cast<double>(leftCount) * internal::bvhHalfArea(leftBound) + rightCosts[bin + 1];
+      if (cost < bestCost) {
+        bestCost = cost;
+        bestBin = bin;
+        *axis = static_cast<uint8_t>(a);
+      }
+    }
+  }
+
+  // Coincident centroids or a deep tree; split at the median instead
+  if (bestCost == kMaxD) {
+    const size_t midPoint = nItems / 2;
+    const auto centroidOf = [&](size_t item) {
+      return _itemBounds[item].lowerCorner[*axis] + _itemBounds[item].upperCorner[*axis];
+    };
+    std::nth_element(itemIndices, itemIndices + midPoint, itemIndices + nItems,
+                     [&](size_t a, size_t b) { return centroidOf(a) < centroidOf(b); });
+    return midPoint;
+  }
+
+  size_t *mid = std::partition(itemIndices, itemIndices + nItems,
+                               [&](size_t item) { return binOf(item, *axis) <= bestBin; });
+  return static_cast<size_t>(mid - itemIndices);
+}
+
+template <typename T, size_t N> double Bvh<T, N>::refitNodes(size_t first, size_t last) {
+  // Children come after their parents, so a reverse sweep is bottom-up
+  double areaSum = 0.0;
+  for (size_t i = last; i > first; --i) {
+    Node &node = _nodes[i - 1];
+    if (node.isLeaf()) {
+      node.bound = _itemBounds[node.item];
+    } else {
+      node.bound = _nodes[i].bound;
+      node.bound.merge(_nodes[node.child].bound);
+    }
+    areaSum += internal::bvhHalfArea(node.bound);
+  }
+  return areaSum;
+}
+
 template <typename T, size_t N>
 size_t Bvh<T, N>::qsplit(size_t *itemIndices, size_t numItems, double pivot, uint8_t axis) {
   double centroid;
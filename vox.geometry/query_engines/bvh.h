@@ -12,6 +12,9 @@
 #include "../intersection_query_engine.h"
 #include "../nearest_neighbor_query_engine.h"
 
+#include <array>
+#include <vector>
+
 namespace vox {
 namespace geometry {
 
@@ -23,6 +26,18 @@ namespace geometry {
 //! intersection tests. Also, NearestNeighborQueryEngine is implemented to
 //! provide nearest neighbor query.
 //!
+//! By default, the nodes are split at the midpoint of their longest axis. The
+//! tree can be built with the binned surface area heuristic (SAH) instead,
+//! which takes longer but gives faster queries on uneven meshes. The top
+//! levels of the SAH tree are split serially, and the subtrees below are
+//! built in parallel. The tree can be collapsed into a WideBvh for queries.
+//!
+//! The queries can also be made with any callable object, which avoids the
+//! std::function calls of the query engine interfaces, and in packets of
+//! kPacketSize spatially coherent queries. A packet traverses the tree once,
+//! testing each node bounding box against all of its queries with loops that
+//! the compiler can vectorize, and visits a node if any of the queries does.
+//!
 template <typename T, size_t N>
 class Bvh final : public IntersectionQueryEngine<T, N>, public NearestNeighborQueryEngine<T, N> {
 public:
@@ -30,8 +45,15 @@ public:
   using iterator = typename ContainerType::iterator;
   using const_iterator = typename ContainerType::const_iterator;
 
-  //! Default constructor.
-  Bvh();
+  //! Number of queries traversing the tree together in batched queries.
+  static constexpr size_t kPacketSize = 4;
+
+  //! Default growth of surfaceAreaCost that triggers a rebuild in refit.
+  static constexpr double kDefaultMaxRefitCostRatio = 1.5;
+
+  //! Constructs an empty BVH. If \p useBinnedSah is true, the tree is built
+  //! with the binned SAH instead of the midpoint split.
+  explicit Bvh(bool useBinnedSah = false);
 
   //! Builds bounding volume hierarchy.
   void build(const ConstArrayView1<T> &items, const ConstArrayView1<BoundingBox<double, N>> &itemsBounds);
@@ -39,11 +61,55 @@ public:
   //! Clears all the contents of this instance.
   void clear();
 
+  //!
+  //! \brief Refits the tree to the new bounds of the items.
+  //!
+  //! The node bounds are recomputed bottom-up from \p itemsBounds, which
+  //! should be ordered as the items of the last build, while the topology is
+  //! kept. Disjoint subtrees are refitted in parallel. Since moving items can
+  //! make the nodes overlap more and more, the tree is rebuilt instead when
+  //! its surfaceAreaCost grows beyond \p maxCostRatio times the cost right
+  //! after the last build.
+  //!
+  //! \return True if the tree was refitted, false if it was rebuilt.
+  //!
+  bool refit(const ConstArrayView1<BoundingBox<double, N>> &itemsBounds,
+             double maxCostRatio = kDefaultMaxRefitCostRatio);
+
+  //!
+  //! \brief Returns the surface area cost of the tree.
+  //!
+  //! This is the sum of the surface areas of the nodes divided by the surface
+  //! area of the root, which is the expected number of nodes visited by a
+  //! random ray through the root. Lower is better.
+  //!
+  double surfaceAreaCost() const;
+
   //! Returns the nearest neighbor for given point and distance measure
   //! function.
   NearestNeighborQueryResult<T, N> nearest(const Vector<double, N> &pt,
                                            const NearestNeighborDistanceFunc<T, N> &distanceFunc) const override;
 
+  //! Returns the nearest neighbor for given point and distance measure
+  //! function, which can be any callable object.
+  template <typename DistanceFunc>
+  NearestNeighborQueryResult<T, N> nearest(const Vector<double, N> &pt, const DistanceFunc &distanceFunc) const;
+
+  //!
+  //! \brief Returns the nearest neighbors for given points and distance
+  //! measure function.
+  //!
+  //! The points are queried in packets of kPacketSize consecutive points, so
+  //! nearby points should be next to each other, such as the data points of
+  //! a grid row. Each query starts from the nearest item of the same lane in
+  //! the previous packet. The distance measure function should not be less
+  //! than the distance to the bounding box of the item, as in the single
+  //! query.
+  //!
+  template <typename DistanceFunc>
+  void nearest(const ConstArrayView1<Vector<double, N>> &pts, const DistanceFunc &distanceFunc,
+               ArrayView1<NearestNeighborQueryResult<T, N>> results) const;
+
   //! Returns true if given \p box intersects with any of the stored items.
   bool intersects(const BoundingBox<double, N> &box, const BoxIntersectionTestFunc<T, N> &testFunc) const override;
 
@@ -62,6 +128,24 @@ public:
   ClosestIntersectionQueryResult<T, N> closestIntersection(const Ray<double, N> &ray,
                                                            const GetRayIntersectionFunc<T, N> &testFunc) const override;
 
+  //! Returns the closest intersection for given \p ray and intersection test
+  //! function, which can be any callable object.
+  template <typename TestFunc>
+  ClosestIntersectionQueryResult<T, N> closestIntersection(const Ray<double, N> &ray, const TestFunc &testFunc) const;
+
+  //!
+  //! \brief Returns the closest intersections for given \p rays.
+  //!
+  //! The rays are queried in packets of kPacketSize consecutive rays, so
+  //! coherent rays should be next to each other. A node is skipped for a ray
+  //! if the ray enters its bounding box farther than the closest intersection
+  //! found so far, so the intersection test function should return the ray
+  //! parameter of the intersection, as the ray-surface intersections do.
+  //!
+  template <typename TestFunc>
+  void closestIntersection(const ConstArrayView1<Ray<double, N>> &rays, const TestFunc &testFunc,
+                           ArrayView1<ClosestIntersectionQueryResult<T, N>> results) const;
+
   //! Returns bounding box of every items.
   const BoundingBox<double, N> &boundingBox() const;
 
@@ -101,6 +185,9 @@ public:
   //! Returns item of \p i-th node.
   const_iterator itemOfNode(size_t i) const;
 
+  //! Returns true if the tree is built with the binned SAH.
+  bool useBinnedSah() const;
+
 private:
   struct Node {
     char flags;
@@ -116,14 +203,26 @@ private:
     bool isLeaf() const;
   };
 
+  bool _useBinnedSah = false;
+  double _builtSurfaceAreaCost = 0.0;
   BoundingBox<double, N> _bound;
   ContainerType _items;
   Array1<BoundingBox<double, N>> _itemBounds;
   Array1<Node> _nodes;
 
+  using PacketScalars = std::array<double, kPacketSize>;
+
   size_t build(size_t nodeIndex, size_t *itemIndices, size_t nItems, size_t currentDepth);
 
   size_t qsplit(size_t *itemIndices, size_t numItems, double pivot, uint8_t axis);
+
+  void buildBinnedSah(size_t *itemIndices, size_t nItems);
+
+  void buildBinnedSah(size_t *itemIndices, size_t nItems, size_t currentDepth, std::vector<Node> *nodes) const;
+
+  size_t sahSplit(size_t *itemIndices, size_t nItems, size_t currentDepth, uint8_t *axis) const;
+
+  double refitNodes(size_t first, size_t last);
 };
 
 //! 2-D BVH type.
@@ -0,0 +1,449 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_LINEAR_OCTREE_INL_H_
+#define INCLUDE_JET_DETAIL_LINEAR_OCTREE_INL_H_
+
+#include "../macros.h"
+#include "../math_utils.h"
+#include "../parallel.h"
+#include "linear_octree.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+namespace internal {
+
+// Spreads the lower 21 bits of v so that two zero bits follow each of them.
+inline uint64_t expandMortonBits(uint64_t v) {
+  v &= 0x1fffff;
+  v = (v | v << 32) & 0x1f00000000ffff;
+  v = (v | v << 16) & 0x1f0000ff0000ff;
+  v = (v | v << 8) & 0x100f00f00f00f00f;
+  v = (v | v << 4) & 0x10c30c30c30c30c3;
+  v = (v | v << 2) & 0x1249249249249249;
+  return v;
+}
+
+// Inverse of expandMortonBits.
+inline uint64_t compactMortonBits(uint64_t v) {
+  v &= 0x1249249249249249;
+  v = (v ^ (v >> 2)) & 0x10c30c30c30c30c3;
+  v = (v ^ (v >> 4)) & 0x100f00f00f00f00f;
+  v = (v ^ (v >> 8)) & 0x1f0000ff0000ff;
+  v = (v ^ (v >> 16)) & 0x1f00000000ffff;
+  v = (v ^ (v >> 32)) & 0x1fffff;
+  return v;
+}
+
+// Returns the Morton code of the coordinates, with x in the lowest bit.
+inline uint64_t mortonCode3(uint64_t x, uint64_t y, uint64_t z) {
+  return expandMortonBits(x) | (expandMortonBits(y) << 1) | (expandMortonBits(z) << 2);
+}
+
+// Returns the code of the cell at the level that contains the given code.
+inline uint64_t mortonCellCode(uint64_t code, size_t level, size_t maxDepth) {
+  return code & ~((uint64_t(1) << (3 * (maxDepth - level))) - 1);
+}
+
+// Returns the deepest level whose cells contain both codes.
+inline size_t mortonCommonLevel(uint64_t a, uint64_t b, size_t maxDepth) {
+  if (a == b) {
+    return maxDepth;
+  }
+
+  size_t highestBit = 0;
+  for (uint64_t x = a ^ b; x >>= 1;) {
+    ++highestBit;
+  }
+  return maxDepth - 1 - highestBit / 3;
+}
+
+} // namespace internal
+
+template <typename T>
+void LinearOctree<T>::build(const ConstArrayView1<T> &items, const ConstArrayView1<BoundingBox3D> &itemsBounds,
+                            size_t maxDepth) {
+  JET_THROW_INVALID_ARG_IF(items.length() != itemsBounds.length());
+  JET_THROW_INVALID_ARG_IF(maxDepth > kMaxDepth);
+
+  clear();
+  _maxDepth = maxDepth;
+
+  const size_t numItems = items.length();
+  if (numItems == 0) {
+    return;
+  }
+
+  // Normalize bounding box
+  for (size_t i = 0; i < numItems; ++i) {
+    _bbox.merge(itemsBounds[i]);
+  }
+  double maxEdgeLen = max3(_bbox.width(), _bbox.height(), _bbox.depth());
+  if (maxEdgeLen <= 0.0) {
+    maxEdgeLen = 1.0;
+  }
+  _bbox.upperCorner = _bbox.lowerCorner + Vector3D(maxEdgeLen, maxEdgeLen, maxEdgeLen);
+
+  // Key each item with the deepest cell that is no smaller than the item and
+  // contains its center
+  const auto resolution = static_cast<uint64_t>(1) << maxDepth;
+  Array1<uint64_t> codes(numItems);
+  Array1<size_t> levels(numItems);
+  parallelFor(kZeroSize, numItems, [&](size_t i) {
+    const BoundingBox3D &bound = itemsBounds[i];
+    const double extent = max3(bound.width(), bound.height(), bound.depth());
+
+    size_t level = maxDepth;
+    while (level > 0 && maxEdgeLen < extent * static_cast<double>(uint64_t(1) << level)) {
+      --level;
+    }
+
+    const Vector3D normalized = (bound.midPoint() - _bbox.lowerCorner) / maxEdgeLen;
+    uint64_t coords[3];
+    for (size_t axis = 0; axis < 3; ++axis) {
+      const double q = std::floor(normalized[axis] * static_cast<double>(resolution));
+      coords[axis] = static_cast<uint64_t>(clamp(q, 0.0, static_cast<double>(resolution - 1)));
+    }
+
+    codes[i] = internal::mortonCellCode(internal::mortonCode3(coords[0], coords[1], coords[2]), level, maxDepth);
+    levels[i] = level;
+  });
+
+  // Sort the items in pre-order of their cells
+  Array1<size_t> order(numItems);
+  std::iota(order.begin(), order.end(), kZeroSize);
+  parallelSort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (codes[a] != codes[b]) {
+      return codes[a] < codes[b];
+    }
+    return (levels[a] != levels[b]) ? levels[a] < levels[b] : a < b;
+  });
+
+  _items.resize(numItems);
+  parallelFor(kZeroSize, numItems, [&](size_t i) { _items[i] = items[order[i]]; });
+
+  // Occupied cells, as the first sorted item of each
+  std::vector<size_t> cellBegins;
+  for (size_t i = 0; i < numItems; ++i) {
+    if (i == 0 || codes[order[i]] != codes[order[i - 1]] || levels[order[i]] != levels[order[i - 1]]) {
+      cellBegins.push_back(i);
+    }
+  }
+  const size_t numCells = cellBegins.size();
+  cellBegins.push_back(numItems);
+
+  // The nodes are the occupied cells and their ancestors. In pre-order, the
+  // ancestors of a cell down to the deepest one shared with the previous
+  // cell are already listed, so each cell adds the rest of its chain.
+  std::vector<size_t> firstNewLevels(numCells);
+  std::vector<size_t> nodeOffsets(numCells + 1, 0);
+  parallelFor(kZeroSize, numCells, [&](size_t k) {
+    const size_t item = order[cellBegins[k]];
+    if (k == 0) {
+      firstNewLevels[k] = 0;
+    } else {
+      const size_t prevItem = order[cellBegins[k - 1]];
+      const size_t common = internal::mortonCommonLevel(codes[prevItem], codes[item], maxDepth);
+      firstNewLevels[k] = std::min({common, levels[prevItem], levels[item]}) + 1;
+    }
+    nodeOffsets[k + 1] = levels[item] + 1 - firstNewLevels[k];
+  });
+  std::partial_sum(nodeOffsets.begin(), nodeOffsets.end(), nodeOffsets.begin());
+
+  _nodes.resize(nodeOffsets[numCells]);
+  parallelFor(kZeroSize, numCells, [&](size_t k) {
+    const size_t item = order[cellBegins[k]];
+    for (size_t level = firstNewLevels[k]; level <= levels[item]; ++level) {
+      Node &node = _nodes[nodeOffsets[k] + level - firstNewLevels[k]];
+      node.code = internal::mortonCellCode(codes[item], level, maxDepth);
+      node.level = level;
+      node.itemBegin = cellBegins[k];
+      node.itemEnd = (level == levels[item]) ? cellBegins[k + 1] : cellBegins[k];
+      node.bound = looseCellBound(node.code, level);
+    }
+  });
+
+  // The subtree ends before the first node past the cell
+  const size_t numNodes = _nodes.length();
+  parallelFor(kZeroSize, numNodes, [&](size_t i) {
+    const uint64_t last = _nodes[i].code + (uint64_t(1) << (3 * (maxDepth - _nodes[i].level)));
+    const auto iter = std::lower_bound(_nodes.begin() + i + 1, _nodes.end(), last,
+                                       [](const Node &node, uint64_t code) { return node.code < code; });
+    _nodes[i].subtreeEnd = static_cast<size_t>(iter - _nodes.begin());
+  });
+}
+
+template <typename T> void LinearOctree<T>::clear() {
+  _maxDepth = 1;
+  _bbox = BoundingBox3D();
+  _items.clear();
+  _nodes.clear();
+}
+
+template <typename T>
+NearestNeighborQueryResult3<T> LinearOctree<T>::nearest(const Vector3D &pt,
+                                                        const NearestNeighborDistanceFunc3<T> &distanceFunc) const {
+  NearestNeighborQueryResult3<T> best;
+  best.distance = kMaxD;
+  best.item = nullptr;
+  double bestDistSqr = kMaxD;
+
+  if (_nodes.isEmpty()) {
+    return best;
+  }
+
+  // Pending nodes with their squared distances, nearest on top
+  std::pair<size_t, double> todo[8 * (kMaxDepth + 1)];
+  size_t todoPos = 0;
+  todo[todoPos++] = std::make_pair(kZeroSize, 0.0);
+
+  std::array<std::pair<size_t, double>, 8> children;
+  while (todoPos > 0) {
+    const auto entry = todo[--todoPos];
+    if (entry.second >= bestDistSqr) {
+      continue;
+    }
+
+    const Node &node = _nodes[entry.first];
+    for (size_t i = node.itemBegin; i < node.itemEnd; ++i) {
+      const double dist = distanceFunc(_items[i], pt);
+      if (dist < best.distance) {
+        best.distance = dist;
+        best.item = &_items[i];
+        bestDistSqr = dist * dist;
+      }
+    }
+
+    size_t numChildren = 0;
+    for (size_t child = entry.first + 1; child < node.subtreeEnd; child = _nodes[child].subtreeEnd) {
+      const double distSqr = _nodes[child].bound.clamp(pt).distanceSquaredTo(pt);
+      if (distSqr < bestDistSqr) {
+        children[numChildren++] = std::make_pair(child, distSqr);
+      }
+    }
+    std::sort(children.begin(), children.begin() + numChildren,
+              [](const auto &a, const auto &b) { return a.second > b.second; });
+    for (size_t i = 0; i < numChildren; ++i) {
+      todo[todoPos++] = children[i];
+    }
+  }
+
+  return best;
+}
+
+template <typename T>
+bool LinearOctree<T>::intersects(const BoundingBox3D &box, const BoxIntersectionTestFunc3<T> &testFunc) const {
+  size_t i = 0;
+  while (i < _nodes.length()) {
+    const Node &node = _nodes[i];
+    if (!box.overlaps(node.bound)) {
+      i = node.subtreeEnd;
+      continue;
+    }
+
+    for (size_t j = node.itemBegin; j < node.itemEnd; ++j) {
+      if (testFunc(_items[j], box)) {
+        return true;
+      }
+    }
+    ++i;
+  }
+
+  return false;
+}
+
+template <typename T>
+bool LinearOctree<T>::intersects(const Ray3D &ray, const RayIntersectionTestFunc3<T> &testFunc) const {
+  size_t i = 0;
+  double tEntry;
+  while (i < _nodes.length()) {
+    const Node &node = _nodes[i];
+    if (!rayEntry(node.bound, ray, kMaxD, &tEntry)) {
+      i = node.subtreeEnd;
+      continue;
+    }
+
+    for (size_t j = node.itemBegin; j < node.itemEnd; ++j) {
+      if (testFunc(_items[j], ray)) {
+        return true;
+      }
+    }
+    ++i;
+  }
+
+  return false;
+}
+
+template <typename T>
+void LinearOctree<T>::forEachIntersectingItem(const BoundingBox3D &box, const BoxIntersectionTestFunc3<T> &testFunc,
+                                              const IntersectionVisitorFunc<T> &visitorFunc) const {
+  size_t i = 0;
+  while (i < _nodes.length()) {
+    const Node &node = _nodes[i];
+    if (!box.overlaps(node.bound)) {
+      i = node.subtreeEnd;
+      continue;
+    }
+
+    for (size_t j = node.itemBegin; j < node.itemEnd; ++j) {
+      if (testFunc(_items[j], box)) {
+        visitorFunc(_items[j]);
+      }
+    }
+    ++i;
+  }
+}
+
+template <typename T>
+void LinearOctree<T>::forEachIntersectingItem(const Ray3D &ray, const RayIntersectionTestFunc3<T> &testFunc,
+                                              const IntersectionVisitorFunc<T> &visitorFunc) const {
+  size_t i = 0;
+  double tEntry;
+  while (i < _nodes.length()) {
+    const Node &node = _nodes[i];
+    if (!rayEntry(node.bound, ray, kMaxD, &tEntry)) {
+      i = node.subtreeEnd;
+      continue;
+    }
+
+    for (size_t j = node.itemBegin; j < node.itemEnd; ++j) {
+      if (testFunc(_items[j], ray)) {
+        visitorFunc(_items[j]);
+      }
+    }
+    ++i;
+  }
+}
+
+template <typename T>
+ClosestIntersectionQueryResult3<T>
+LinearOctree<T>::closestIntersection(const Ray3D &ray, const GetRayIntersectionFunc3<T> &testFunc) const {
+  ClosestIntersectionQueryResult3<T> best;
+  best.distance = kMaxD;
+  best.item = nullptr;
+
+  double tEntry;
+  if (_nodes.isEmpty() || !rayEntry(_nodes[0].bound, ray, kMaxD, &tEntry)) {
+    return best;
+  }
+
+  // Pending nodes with the ray parameters where the ray enters them, nearest
+  // on top
+  std::pair<size_t, double> todo[8 * (kMaxDepth + 1)];
+  size_t todoPos = 0;
+  todo[todoPos++] = std::make_pair(kZeroSize, tEntry);
+
+  std::array<std::pair<size_t, double>, 8> children;
+  while (todoPos > 0) {
+    const auto entry = todo[--todoPos];
+    if (entry.second > best.distance) {
+      continue;
+    }
+
+    const Node &node = _nodes[entry.first];
+    for (size_t i = node.itemBegin; i < node.itemEnd; ++i) {
+      const double dist = testFunc(_items[i], ray);
+      if (dist < best.distance) {
+        best.distance = dist;
+        best.item = &_items[i];
+      }
+    }
+
+    size_t numChildren = 0;
+    for (size_t child = entry.first + 1; child < node.subtreeEnd; child = _nodes[child].subtreeEnd) {
+      if (rayEntry(_nodes[child].bound, ray, best.distance, &tEntry)) {
+        children[numChildren++] = std::make_pair(child, tEntry);
+      }
+    }
+    std::sort(children.begin(), children.begin() + numChildren,
+              [](const auto &a, const auto &b) { return a.second > b.second; });
+    for (size_t i = 0; i < numChildren; ++i) {
+      todo[todoPos++] = children[i];
+    }
+  }
+
+  return best;
+}
+
+template <typename T> typename LinearOctree<T>::Iterator LinearOctree<T>::begin() { return _items.begin(); }
+
+template <typename T> typename LinearOctree<T>::Iterator LinearOctree<T>::end() { return _items.end(); }
+
+template <typename T> typename LinearOctree<T>::ConstIterator LinearOctree<T>::begin() const { return _items.begin(); }
+
+template <typename T> typename LinearOctree<T>::ConstIterator LinearOctree<T>::end() const { return _items.end(); }
+
+template <typename T> size_t LinearOctree<T>::numberOfItems() const { return _items.length(); }
+
+template <typename T> const T &LinearOctree<T>::item(size_t i) const { return _items[i]; }
+
+template <typename T> size_t LinearOctree<T>::numberOfNodes() const { return _nodes.length(); }
+
+template <typename T> uint64_t LinearOctree<T>::nodeCode(size_t nodeIdx) const { return _nodes[nodeIdx].code; }
+
+template <typename T> size_t LinearOctree<T>::nodeLevel(size_t nodeIdx) const { return _nodes[nodeIdx].level; }
+
+template <typename T> const BoundingBox3D &LinearOctree<T>::nodeBound(size_t nodeIdx) const {
+  return _nodes[nodeIdx].bound;
+}
+
+template <typename T> std::pair<size_t, size_t> LinearOctree<T>::itemRange(size_t nodeIdx) const {
+  return std::make_pair(_nodes[nodeIdx].itemBegin, _nodes[nodeIdx].itemEnd);
+}
+
+template <typename T> size_t LinearOctree<T>::subtreeEnd(size_t nodeIdx) const { return _nodes[nodeIdx].subtreeEnd; }
+
+template <typename T> const BoundingBox3D &LinearOctree<T>::boundingBox() const { return _bbox; }
+
+template <typename T> size_t LinearOctree<T>::maxDepth() const { return _maxDepth; }
+
+template <typename T> BoundingBox3D LinearOctree<T>::looseCellBound(uint64_t code, size_t level) const {
+  const double rootSize = _bbox.width();
+  const double unit = rootSize / static_cast<double>(uint64_t(1) << _maxDepth);
+  const double cellSize = rootSize / static_cast<double>(uint64_t(1) << level);
+
+  const Vector3D lower =
+      _bbox.lowerCorner + unit * Vector3D(static_cast<double>(internal::compactMortonBits(code)),
+                                          static_cast<double>(internal::compactMortonBits(code >> 1)),
+                                          static_cast<double>(internal::compactMortonBits(code >> 2)));
+  BoundingBox3D bound(lower, lower + Vector3D(cellSize, cellSize, cellSize));
+  bound.expand(0.5 * cellSize);
+  return bound;
+}
+
+template <typename T>
+bool LinearOctree<T>::rayEntry(const BoundingBox3D &bound, const Ray3D &ray, double maxDistance, double *tEntry) {
+  // Slab test of BoundingBox::intersects, clipped to maxDistance
+  double tMin = 0.0;
+  double tMax = maxDistance;
+  for (size_t axis = 0; axis < 3; ++axis) {
+    const double invDir = 1.0 / ray.direction[axis];
+    double tNear = (bound.lowerCorner[axis] - ray.origin[axis]) * invDir;
+    double tFar = (bound.upperCorner[axis] - ray.origin[axis]) * invDir;
+    if (tNear > tFar) {
+      std::swap(tNear, tFar);
+    }
+    tMin = tNear > tMin ? tNear : tMin;
+    tMax = tFar < tMax ? tFar : tMax;
+    if (tMin > tMax) {
+      return false;
+    }
+  }
+
+  *tEntry = tMin;
+  return true;
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_LINEAR_OCTREE_INL_H_
@@ -0,0 +1,157 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_LINEAR_OCTREE_H_
+#define INCLUDE_JET_LINEAR_OCTREE_H_
+
+#include "../array.h"
+#include "../array_view.h"
+#include "../intersection_query_engine.h"
+#include "../nearest_neighbor_query_engine.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief      Linear (pointerless) loose octree keyed by Morton codes.
+//!
+//! Unlike Octree, which stores per-node item lists, this class keeps every
+//! item exactly once in a flat array sorted by Morton code, and every node
+//! refers to a contiguous range of it. An item is stored at the deepest
+//! level whose cells are no smaller than the item, in the cell containing
+//! its center. The bound of a node is its cell expanded by half the cell
+//! size on each side, which contains all of its items and descendants.
+//!
+//! The nodes are stored in pre-order, which is the Morton order of the cells
+//! with the ancestors first, so the subtree of a node is the contiguous
+//! range up to subtreeEnd. The first child of a node is the next node, and
+//! the next sibling of a child is its subtreeEnd. Box and ray queries sweep
+//! the array and skip the rejected subtrees without a stack.
+//!
+//! The tree is built bottom-up from the sorted codes in parallel.
+//!
+//! \tparam     T     Value type.
+//!
+template <typename T>
+class LinearOctree final : public IntersectionQueryEngine3<T>, public NearestNeighborQueryEngine3<T> {
+public:
+  using ContainerType = Array1<T>;
+  using Iterator = typename ContainerType::iterator;
+  using ConstIterator = typename ContainerType::const_iterator;
+
+  //! Maximum depth of the tree, limited by the 64-bit Morton codes.
+  static constexpr size_t kMaxDepth = 21;
+
+  //! Default constructor.
+  LinearOctree() = default;
+
+  //!
+  //! \brief      Builds an octree with given list of items, bounding box of
+  //!             the items, and max depth of the tree.
+  //!
+  //! The items are stored in Morton order, so item(i) is not necessarily the
+  //! i-th input item.
+  //!
+  void build(const ConstArrayView1<T> &items, const ConstArrayView1<BoundingBox3D> &itemsBounds, size_t maxDepth);
+
+  //! Clears all the contents of this instance.
+  void clear();
+
+  //! Returns the nearest neighbor for given point and distance measure
+  //! function.
+  NearestNeighborQueryResult3<T> nearest(const Vector3D &pt,
+                                         const NearestNeighborDistanceFunc3<T> &distanceFunc) const override;
+
+  //! Returns true if given \p box intersects with any of the stored items.
+  bool intersects(const BoundingBox3D &box, const BoxIntersectionTestFunc3<T> &testFunc) const override;
+
+  //! Returns true if given \p ray intersects with any of the stored items.
+  bool intersects(const Ray3D &ray, const RayIntersectionTestFunc3<T> &testFunc) const override;
+
+  //! Invokes \p visitorFunc for every intersecting items.
+  void forEachIntersectingItem(const BoundingBox3D &box, const BoxIntersectionTestFunc3<T> &testFunc,
+                               const IntersectionVisitorFunc<T> &visitorFunc) const override;
+
+  //! Invokes \p visitorFunc for every intersecting items.
+  void forEachIntersectingItem(const Ray3D &ray, const RayIntersectionTestFunc3<T> &testFunc,
+                               const IntersectionVisitorFunc<T> &visitorFunc) const override;
+
+  //! Returns the closest intersection for given \p ray.
+  ClosestIntersectionQueryResult3<T> closestIntersection(const Ray3D &ray,
+                                                         const GetRayIntersectionFunc3<T> &testFunc) const override;
+
+  //! Returns the begin iterator of the item.
+  Iterator begin();
+
+  //! Returns the end iterator of the item.
+  Iterator end();
+
+  //! Returns the immutable begin iterator of the item.
+  ConstIterator begin() const;
+
+  //! Returns the immutable end iterator of the item.
+  ConstIterator end() const;
+
+  //! Returns the number of items.
+  size_t numberOfItems() const;
+
+  //! Returns the item at \p i.
+  const T &item(size_t i) const;
+
+  //! Returns the number of octree nodes.
+  size_t numberOfNodes() const;
+
+  //! Returns the Morton code of the lower corner of the node's cell at the
+  //! max depth.
+  uint64_t nodeCode(size_t nodeIdx) const;
+
+  //! Returns the depth of the node, where the root is 0.
+  size_t nodeLevel(size_t nodeIdx) const;
+
+  //! Returns the loose bounding box of the node.
+  const BoundingBox3D &nodeBound(size_t nodeIdx) const;
+
+  //! Returns the range [first, last) of the items stored at the node itself.
+  std::pair<size_t, size_t> itemRange(size_t nodeIdx) const;
+
+  //! Returns the index after the last node of the subtree of the node.
+  size_t subtreeEnd(size_t nodeIdx) const;
+
+  //! Returns the bounding box of this octree.
+  const BoundingBox3D &boundingBox() const;
+
+  //! Returns the maximum depth of the tree.
+  size_t maxDepth() const;
+
+private:
+  struct Node {
+    uint64_t code = 0;
+    size_t level = 0;
+    size_t itemBegin = 0;
+    size_t itemEnd = 0;
+    size_t subtreeEnd = 0;
+    BoundingBox3D bound;
+  };
+
+  size_t _maxDepth = 1;
+  BoundingBox3D _bbox;
+  ContainerType _items;
+  Array1<Node> _nodes;
+
+  BoundingBox3D looseCellBound(uint64_t code, size_t level) const;
+
+  static bool rayEntry(const BoundingBox3D &bound, const Ray3D &ray, double maxDistance, double *tEntry);
+};
+
+} // namespace vox
+} // namespace geometry
+
+#include "linear_octree-inl.h"
+
+#endif // INCLUDE_JET_LINEAR_OCTREE_H_
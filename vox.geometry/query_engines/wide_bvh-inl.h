@@ -0,0 +1,420 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_WIDE_BVH_INL_H_
+#define INCLUDE_JET_DETAIL_WIDE_BVH_INL_H_
+
+#include "../constants.h"
+#include "wide_bvh.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace vox {
+namespace geometry {
+
+namespace internal {
+
+// Maximum number of pending nodes of the wide BVH traversals, for a tree no
+// deeper than the binary one.
+template <size_t W> constexpr size_t kWideBvhMaxStackSize = 8 * sizeof(size_t) * W;
+
+// Sorts the first n (index, key) pairs by ascending key.
+template <size_t W> void sortLanes(std::array<std::pair<size_t, double>, W> &lanes, size_t n) {
+  for (size_t i = 1; i < n; ++i) {
+    const std::pair<size_t, double> lane = lanes[i];
+    size_t j = i;
+    while (j > 0 && lanes[j - 1].second > lane.second) {
+      lanes[j] = lanes[j - 1];
+      --j;
+    }
+    lanes[j] = lane;
+  }
+}
+
+} // namespace internal
+
+template <typename T, size_t N, size_t W> void WideBvh<T, N, W>::build(const Bvh<T, N> &bvh) {
+  clear();
+
+  if (bvh.numberOfItems() == 0) {
+    return;
+  }
+
+  _items.resize(bvh.numberOfItems());
+  std::copy(bvh.begin(), bvh.end(), _items.begin());
+  _bound = bvh.boundingBox();
+
+  if (bvh.isLeaf(0)) {
+    build(bvh, std::array<size_t, W>{0}, 1);
+  } else {
+    const auto children = bvh.children(0);
+    build(bvh, std::array<size_t, W>{children.first, children.second}, 2);
+  }
+}
+
+template <typename T, size_t N, size_t W> void WideBvh<T, N, W>::clear() {
+  _bound = BoundingBox<double, N>{};
+  _items.clear();
+  _nodes.clear();
+}
+
+template <typename T, size_t N, size_t W>
+NearestNeighborQueryResult<T, N>
+WideBvh<T, N, W>::nearest(const Vector<double, N> &pt, const NearestNeighborDistanceFunc<T, N> &distanceFunc) const {
+  return nearest<NearestNeighborDistanceFunc<T, N>>(pt, distanceFunc);
+}
+
+template <typename T, size_t N, size_t W>
+template <typename DistanceFunc>
+NearestNeighborQueryResult<T, N> WideBvh<T, N, W>::nearest(const Vector<double, N> &pt,
+                                                           const DistanceFunc &distanceFunc) const {
+  NearestNeighborQueryResult<T, N> best;
+  best.distance = kMaxD;
+  best.item = nullptr;
+  double bestDistSqr = kMaxD;
+
+  if (_nodes.isEmpty()) {
+    return best;
+  }
+
+  // Pending children with their squared distances, nearest on top
+  StackEntry todo[internal::kWideBvhMaxStackSize<W>];
+  size_t todoPos = 0;
+  todo[todoPos++] = StackEntry{kZeroSize, 0.0, false};
+
+  std::array<std::pair<size_t, double>, W> lanes;
+  while (todoPos > 0) {
+    const StackEntry entry = todo[--todoPos];
+    if (entry.key >= bestDistSqr) {
+      continue;
+    }
+
+    if (entry.isLeaf) {
+      const T &item = _items[entry.index];
+      const double dist = distanceFunc(item, pt);
+      if (dist < best.distance) {
+        best.distance = dist;
+        best.item = &item;
+        bestDistSqr = dist * dist;
+      }
+      continue;
+    }
+
+    const Node &node = _nodes[entry.index];
+
+    Lanes distSqr{};
+    for (size_t axis = 0; axis < N; ++axis) {
+      const double p = pt[axis];
+      for (size_t lane = 0; lane < W; ++lane) {
+        const double d =
+            std::max(std::max(node.lowerCorners[axis][lane] - p, p - node.upperCorners[axis][lane]), 0.0);
+        distSqr[lane] += d * d;
+      }
+    }
+
+    size_t numberOfLanes = 0;
+    for (size_t lane = 0; lane < node.numberOfChildren; ++lane) {
+      if (distSqr[lane] < bestDistSqr) {
+        lanes[numberOfLanes++] = std::make_pair(lane, distSqr[lane]);
+      }
+    }
+    internal::sortLanes(lanes, numberOfLanes);
+    todoPos = pushLanes(node, lanes, numberOfLanes, todo, todoPos);
+  }
+
+  return best;
+}
+
+template <typename T, size_t N, size_t W>
+bool WideBvh<T, N, W>::intersects(const BoundingBox<double, N> &box,
+                                  const BoxIntersectionTestFunc<T, N> &testFunc) const {
+  bool result = false;
+  traverse([&](const Node &node) { return overlappingLanes(node, box); },
+           [&](const T &item) {
+             result = testFunc(item, box);
+             return result;
+           });
+  return result;
+}
+
+template <typename T, size_t N, size_t W>
+bool WideBvh<T, N, W>::intersects(const Ray<double, N> &ray, const RayIntersectionTestFunc<T, N> &testFunc) const {
+  bool result = false;
+  traverse([&](const Node &node) { return intersectingLanes(node, ray, kMaxD, nullptr); },
+           [&](const T &item) {
+             result = testFunc(item, ray);
+             return result;
+           });
+  return result;
+}
+
+template <typename T, size_t N, size_t W>
+void WideBvh<T, N, W>::forEachIntersectingItem(const BoundingBox<double, N> &box,
+                                               const BoxIntersectionTestFunc<T, N> &testFunc,
+                                               const IntersectionVisitorFunc<T> &visitorFunc) const {
+  traverse([&](const Node &node) { return overlappingLanes(node, box); },
+           [&](const T &item) {
+             if (testFunc(item, box)) {
+               visitorFunc(item);
+             }
+             return false;
+           });
+}
+
+template <typename T, size_t N, size_t W>
+void WideBvh<T, N, W>::forEachIntersectingItem(const Ray<double, N> &ray, const RayIntersectionTestFunc<T, N> &testFunc,
+                                               const IntersectionVisitorFunc<T> &visitorFunc) const {
+  traverse([&](const Node &node) { return intersectingLanes(node, ray, kMaxD, nullptr); },
+           [&](const T &item) {
+             if (testFunc(item, ray)) {
+               visitorFunc(item);
+             }
+             return false;
+           });
+}
+
+template <typename T, size_t N, size_t W>
+ClosestIntersectionQueryResult<T, N>
+WideBvh<T, N, W>::closestIntersection(const Ray<double, N> &ray, const GetRayIntersectionFunc<T, N> &testFunc) const {
+  return closestIntersection<GetRayIntersectionFunc<T, N>>(ray, testFunc);
+}
+
+template <typename T, size_t N, size_t W>
+template <typename TestFunc>
+ClosestIntersectionQueryResult<T, N> WideBvh<T, N, W>::closestIntersection(const Ray<double, N> &ray,
+                                                                           const TestFunc &testFunc) const {
+  ClosestIntersectionQueryResult<T, N> best;
+  best.distance = kMaxD;
+  best.item = nullptr;
+
+  if (_nodes.isEmpty() || !_bound.intersects(ray)) {
+    return best;
+  }
+
+  // Pending children with the ray parameters where the ray enters them,
+  // nearest on top
+  StackEntry todo[internal::kWideBvhMaxStackSize<W>];
+  size_t todoPos = 0;
+  todo[todoPos++] = StackEntry{kZeroSize, 0.0, false};
+
+  std::array<std::pair<size_t, double>, W> lanes;
+  Lanes tMin;
+  while (todoPos > 0) {
+    const StackEntry entry = todo[--todoPos];
+    if (entry.key > best.distance) {
+      continue;
+    }
+
+    if (entry.isLeaf) {
+      const T &item = _items[entry.index];
+      const double dist = testFunc(item, ray);
+      if (dist < best.distance) {
+        best.distance = dist;
+        best.item = &item;
+      }
+      continue;
+    }
+
+    const Node &node = _nodes[entry.index];
+    const uint32_t mask = intersectingLanes(node, ray, best.distance, &tMin);
+
+    size_t numberOfLanes = 0;
+    for (size_t lane = 0; lane < node.numberOfChildren; ++lane) {
+      if ((mask & (1u << lane)) != 0) {
+        lanes[numberOfLanes++] = std::make_pair(lane, tMin[lane]);
+      }
+    }
+    internal::sortLanes(lanes, numberOfLanes);
+    todoPos = pushLanes(node, lanes, numberOfLanes, todo, todoPos);
+  }
+
+  return best;
+}
+
+template <typename T, size_t N, size_t W> const BoundingBox<double, N> &WideBvh<T, N, W>::boundingBox() const {
+  return _bound;
+}
+
+template <typename T, size_t N, size_t W> typename WideBvh<T, N, W>::iterator WideBvh<T, N, W>::begin() {
+  return _items.begin();
+}
+
+template <typename T, size_t N, size_t W> typename WideBvh<T, N, W>::iterator WideBvh<T, N, W>::end() {
+  return _items.end();
+}
+
+template <typename T, size_t N, size_t W> typename WideBvh<T, N, W>::const_iterator WideBvh<T, N, W>::begin() const {
+  return _items.begin();
+}
+
+template <typename T, size_t N, size_t W> typename WideBvh<T, N, W>::const_iterator WideBvh<T, N, W>::end() const {
+  return _items.end();
+}
+
+template <typename T, size_t N, size_t W> size_t WideBvh<T, N, W>::numberOfItems() const { return _items.length(); }
+
+template <typename T, size_t N, size_t W> const T &WideBvh<T, N, W>::item(size_t i) const { return _items[i]; }
+
+template <typename T, size_t N, size_t W> size_t WideBvh<T, N, W>::numberOfNodes() const { return _nodes.length(); }
+
+template <typename T, size_t N, size_t W>
+size_t WideBvh<T, N, W>::build(const Bvh<T, N> &bvh, const std::array<size_t, W> &binaryChildren,
+                               size_t numberOfChildren) {
+  // Open the internal child with the largest surface area until the node is
+  // full
+  std::array<size_t, W> children = binaryChildren;
+  while (numberOfChildren < W) {
+    size_t largest = kMaxSize;
+    double largestArea = -1.0;
+    for (size_t i = 0; i < numberOfChildren; ++i) {
+      if (!bvh.isLeaf(children[i])) {
+        const double area = internal::bvhHalfArea(bvh.nodeBound(children[i]));
+        if (area > largestArea) {
+          largestArea = area;
+          largest = i;
+        }
+      }
+    }
+
+    if (largest == kMaxSize) {
+      break;
+    }
+
+    const auto grandChildren = bvh.children(children[largest]);
+    children[largest] = grandChildren.first;
+    children[numberOfChildren++] = grandChildren.second;
+  }
+
+  const size_t nodeIndex = _nodes.length();
+  _nodes.append(Node());
+
+  // Empty lanes have inverted boxes
+  Node node;
+  for (size_t axis = 0; axis < N; ++axis) {
+    node.lowerCorners[axis].fill(kMaxD);
+    node.upperCorners[axis].fill(-kMaxD);
+  }
+  node.children.fill(kMaxSize);
+  node.numberOfChildren = numberOfChildren;
+
+  for (size_t i = 0; i < numberOfChildren; ++i) {
+    const BoundingBox<double, N> &bound = bvh.nodeBound(children[i]);
+    for (size_t axis = 0; axis < N; ++axis) {
+      node.lowerCorners[axis][i] = bound.lowerCorner[axis];
+      node.upperCorners[axis][i] = bound.upperCorner[axis];
+    }
+
+    if (bvh.isLeaf(children[i])) {
+      node.children[i] = static_cast<size_t>(bvh.itemOfNode(children[i]) - bvh.begin());
+      node.leafMask |= 1u << i;
+    } else {
+      const auto grandChildren = bvh.children(children[i]);
+      node.children[i] = build(bvh, std::array<size_t, W>{grandChildren.first, grandChildren.second}, 2);
+    }
+  }
+
+  _nodes[nodeIndex] = node;
+  return nodeIndex;
+}
+
+template <typename T, size_t N, size_t W>
+uint32_t WideBvh<T, N, W>::overlappingLanes(const Node &node, const BoundingBox<double, N> &box) {
+  std::array<bool, W> overlaps;
+  overlaps.fill(true);
+  for (size_t axis = 0; axis < N; ++axis) {
+    const double lower = box.lowerCorner[axis];
+    const double upper = box.upperCorner[axis];
+    for (size_t lane = 0; lane < W; ++lane) {
+      overlaps[lane] &= !(node.lowerCorners[axis][lane] > upper || node.upperCorners[axis][lane] < lower);
+    }
+  }
+
+  uint32_t mask = 0;
+  for (size_t lane = 0; lane < node.numberOfChildren; ++lane) {
+    mask |= overlaps[lane] ? (1u << lane) : 0u;
+  }
+  return mask;
+}
+
+template <typename T, size_t N, size_t W>
+uint32_t WideBvh<T, N, W>::intersectingLanes(const Node &node, const Ray<double, N> &ray, double maxDistance,
+                                             Lanes *tMinOut) {
+  // Slab test of BoundingBox::intersects, clipped to maxDistance
+  Lanes tMin;
+  Lanes tMax;
+  tMin.fill(0.0);
+  tMax.fill(maxDistance);
+  for (size_t axis = 0; axis < N; ++axis) {
+    const double origin = ray.origin[axis];
+    const double invDir = 1.0 / ray.direction[axis];
+    for (size_t lane = 0; lane < W; ++lane) {
+      const double t0 = (node.lowerCorners[axis][lane] - origin) * invDir;
+      const double t1 = (node.upperCorners[axis][lane] - origin) * invDir;
+      const double tNear = t0 > t1 ? t1 : t0;
+      const double tFar = t0 > t1 ? t0 : t1;
+      tMin[lane] = tNear > tMin[lane] ? tNear : tMin[lane];
+      tMax[lane] = tFar < tMax[lane] ? tFar : tMax[lane];
+    }
+  }
+
+  uint32_t mask = 0;
+  for (size_t lane = 0; lane < node.numberOfChildren; ++lane) {
+    mask |= (tMin[lane] > tMax[lane]) ? 0u : (1u << lane);
+  }
+
+  if (tMinOut != nullptr) {
+    *tMinOut = tMin;
+  }
+  return mask;
+}
+
+template <typename T, size_t N, size_t W>
+size_t WideBvh<T, N, W>::pushLanes(const Node &node, const std::array<std::pair<size_t, double>, W> &lanes,
+                                   size_t numberOfLanes, StackEntry *todo, size_t todoPos) {
+  // Push in reverse order so that the nearest child is popped first
+  for (size_t i = numberOfLanes; i > 0; --i) {
+    const size_t lane = lanes[i - 1].first;
+    todo[todoPos++] =
+        StackEntry{node.children[lane], lanes[i - 1].second, (node.leafMask & (1u << lane)) != 0};
+  }
+  return todoPos;
+}
+
+template <typename T, size_t N, size_t W>
+template <typename BoxTestFunc, typename ItemFunc>
+void WideBvh<T, N, W>::traverse(const BoxTestFunc &boxTest, const ItemFunc &itemFunc) const {
+  if (_nodes.isEmpty()) {
+    return;
+  }
+
+  size_t todo[internal::kWideBvhMaxStackSize<W>];
+  size_t todoPos = 0;
+  todo[todoPos++] = 0;
+
+  while (todoPos > 0) {
+    const Node &node = _nodes[todo[--todoPos]];
+    const uint32_t mask = boxTest(node);
+    for (size_t lane = 0; lane < node.numberOfChildren; ++lane) {
+      if ((mask & (1u << lane)) == 0) {
+        continue;
+      }
+
+      if ((node.leafMask & (1u << lane)) != 0) {
+        if (itemFunc(_items[node.children[lane]])) {
+          return;
+        }
+      } else {
+        todo[todoPos++] = node.children[lane];
+      }
+    }
+  }
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_WIDE_BVH_INL_H_
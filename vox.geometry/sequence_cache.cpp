@@ -0,0 +1,620 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "common.h"
+
+#include "bounding_box.h"
+#include "parallel.h"
+#include "sequence_cache.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <system_error>
+
+namespace vox {
+namespace geometry {
+
+namespace {
+
+const char kSequenceCacheMagic[8] = {'V', 'O', 'X', 'S', 'E', 'Q', '0', '1'};
+
+// Offset of the index followed by the number of frames and the magic
+constexpr size_t kFooterSize = 2 * sizeof(uint64_t) + sizeof(kSequenceCacheMagic);
+
+constexpr size_t kIndexEntrySize = 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+uint64_t toBits(double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double fromBits(uint64_t bits) {
+  double value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+uint64_t encodeZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t decodeZigZag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+// Shared by the writer and the reader, so both reconstruct the same positions
+double dequantize(double prediction, int64_t code, double step) {
+  return prediction + static_cast<double>(code) * step;
+}
+
+template <typename T> void putValue(const T &value, std::vector<uint8_t> *buffer) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+  buffer->insert(buffer->end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T> void putVector(const Vector<T, 3> &value, std::vector<uint8_t> *buffer) {
+  for (size_t a = 0; a < 3; ++a) {
+    putValue(value[a], buffer);
+  }
+}
+
+void putVarint(uint64_t value, std::vector<uint8_t> *buffer) {
+  while (value >= 0x80) {
+    buffer->push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer->push_back(static_cast<uint8_t>(value));
+}
+
+class ByteReader {
+public:
+  explicit ByteReader(const ConstArrayView1<uint8_t> &buffer) : _buffer(buffer) {}
+
+  template <typename T> T get() {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(sizeof(T) > remaining().length(), "Truncated sequence cache.");
+    T value;
+    std::memcpy(&value, _buffer.data() + _position, sizeof(T));
+    _position += sizeof(T);
+    return value;
+  }
+
+  template <typename T> Vector<T, 3> getVector() {
+    Vector<T, 3> value;
+    for (size_t a = 0; a < 3; ++a) {
+      value[a] = get<T>();
+    }
+    return value;
+  }
+
+  [[nodiscard]] ConstArrayView1<uint8_t> remaining() const {
+    return ConstArrayView1<uint8_t>(_buffer.data() + _position, _buffer.length() - _position);
+  }
+
+  void skip(size_t size) {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(size > remaining().length(), "Truncated sequence cache.");
+    _position += size;
+  }
+
+private:
+  ConstArrayView1<uint8_t> _buffer;
+  size_t _position = 0;
+};
+
+void encodeChunk(const uint64_t *words, size_t numberOfWords, std::vector<uint8_t> *buffer) {
+  // Byte planes: the p-th bytes of all the words are stored together
+  std::vector<uint8_t> shuffled(sizeof(uint64_t) * numberOfWords);
+  for (size_t i = 0; i < numberOfWords; ++i) {
+    for (size_t p = 0; p < sizeof(uint64_t); ++p) {
+      shuffled[p * numberOfWords + i] = static_cast<uint8_t>(words[i] >> (8 * p));
+    }
+  }
+
+  // Non-zero bytes are kept as they are, and a zero run becomes a zero byte followed by the run length
+  for (size_t i = 0; i < shuffled.size();) {
+    if (shuffled[i] != 0) {
+      buffer->push_back(shuffled[i++]);
+      continue;
+    }
+    const size_t begin = i;
+    while (i < shuffled.size() && shuffled[i] == 0) {
+      ++i;
+    }
+    buffer->push_back(0);
+    putVarint(i - begin, buffer);
+  }
+}
+
+bool decodeChunk(const uint8_t *data, size_t size, uint64_t *words, size_t numberOfWords) {
+  std::vector<uint8_t> shuffled(sizeof(uint64_t) * numberOfWords, 0);
+  size_t position = 0;
+  for (size_t i = 0; i < size;) {
+    const uint8_t byte = data[i++];
+    if (byte != 0) {
+      if (position == shuffled.size()) {
+        return false;
+      }
+      shuffled[position++] = byte;
+      continue;
+    }
+
+    uint64_t run = 0;
+    for (unsigned int shift = 0;; shift += 7) {
+      if (i == size || shift > 63) {
+        return false;
+      }
+      const uint8_t next = data[i++];
+      run |= static_cast<uint64_t>(next & 0x7f) << shift;
+      if ((next & 0x80) == 0) {
+        break;
+      }
+    }
+    if (run > shuffled.size() - position) {
+      return false;
+    }
+    position += run;
+  }
+  if (position != shuffled.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < numberOfWords; ++i) {
+    uint64_t word = 0;
+    for (size_t p = 0; p < sizeof(uint64_t); ++p) {
+      word |= static_cast<uint64_t>(shuffled[p * numberOfWords + i]) << (8 * p);
+    }
+    words[i] = word;
+  }
+  return true;
+}
+
+size_t numberOfChannels(const internal::SequenceCacheFrame &frame) {
+  return frame.type == SequenceCacheFrameType::kParticles ? 3 * frame.numberOfVectorData + frame.numberOfScalarData
+                                                          : 1;
+}
+
+size_t channelLength(const internal::SequenceCacheFrame &frame) {
+  return frame.type == SequenceCacheFrameType::kParticles ? frame.numberOfParticles
+                                                          : product(frame.dataSize, kOneSize);
+}
+
+// Returns the axis of the position channel at idx, or kMaxSize for the other channels
+size_t positionAxis(const internal::SequenceCacheFrame &frame, size_t idx) {
+  if (frame.type == SequenceCacheFrameType::kParticles && idx / 3 == frame.positionIdx &&
+      idx < 3 * frame.numberOfVectorData) {
+    return idx % 3;
+  }
+  return kMaxSize;
+}
+
+} // namespace
+
+namespace internal {
+
+void encodeSequenceCacheWords(const ConstArrayView1<uint64_t> &words, std::vector<uint8_t> *buffer) {
+  const size_t numberOfWords = words.length();
+  const size_t numberOfChunks = (numberOfWords + kSequenceCacheChunkSize - 1) / kSequenceCacheChunkSize;
+
+  Array1<std::vector<uint8_t>> chunks(numberOfChunks);
+  parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+    const size_t begin = c * kSequenceCacheChunkSize;
+    const size_t end = std::min(begin + kSequenceCacheChunkSize, numberOfWords);
+    encodeChunk(words.data() + begin, end - begin, &chunks[c]);
+  });
+
+  putValue<uint64_t>(numberOfWords, buffer);
+  putValue<uint64_t>(numberOfChunks, buffer);
+  for (const auto &chunk : chunks) {
+    putValue<uint64_t>(chunk.size(), buffer);
+  }
+  for (const auto &chunk : chunks) {
+    buffer->insert(buffer->end(), chunk.begin(), chunk.end());
+  }
+}
+
+size_t decodeSequenceCacheWords(const ConstArrayView1<uint8_t> &buffer, Array1<uint64_t> *words) {
+  ByteReader reader(buffer);
+  const auto numberOfWords = static_cast<size_t>(reader.get<uint64_t>());
+  const auto numberOfChunks = static_cast<size_t>(reader.get<uint64_t>());
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+      numberOfChunks != (numberOfWords + kSequenceCacheChunkSize - 1) / kSequenceCacheChunkSize,
+      "Corrupted sequence cache.");
+
+  Array1<size_t> offsets(numberOfChunks + 1, 0);
+  for (size_t c = 0; c < numberOfChunks; ++c) {
+    offsets[c + 1] = offsets[c] + static_cast<size_t>(reader.get<uint64_t>());
+  }
+  const ConstArrayView1<uint8_t> data = reader.remaining();
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(offsets[numberOfChunks] > data.length(), "Truncated sequence cache.");
+
+  words->resize(numberOfWords);
+  std::atomic<bool> corrupted{false};
+  parallelFor(kZeroSize, numberOfChunks, [&](size_t c) {
+    const size_t begin = c * kSequenceCacheChunkSize;
+    const size_t end = std::min(begin + kSequenceCacheChunkSize, numberOfWords);
+    if (!decodeChunk(data.data() + offsets[c], offsets[c + 1] - offsets[c], words->data() + begin, end - begin)) {
+      corrupted = true;
+    }
+  });
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(corrupted, "Corrupted sequence cache.");
+
+  return buffer.length() - data.length() + offsets[numberOfChunks];
+}
+
+} // namespace internal
+
+// MARK: SequenceCacheWriter
+
+SequenceCacheWriter::SequenceCacheWriter(const std::string &filename, unsigned int positionBits,
+                                         size_t keyframeInterval)
+    : _positionBits(positionBits), _keyframeInterval(keyframeInterval) {
+  JET_THROW_INVALID_ARG_IF(positionBits == 0 || positionBits > 52);
+  JET_THROW_INVALID_ARG_IF(keyframeInterval == 0);
+
+  _fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (_fd < 0) {
+    throw std::system_error(errno, std::generic_category(), filename);
+  }
+
+  internal::writeToFile(_fd, reinterpret_cast<const uint8_t *>(kSequenceCacheMagic), sizeof(kSequenceCacheMagic));
+  _offset = sizeof(kSequenceCacheMagic);
+}
+
+SequenceCacheWriter::~SequenceCacheWriter() {
+  try {
+    finish();
+  } catch (...) {
+  }
+}
+
+void SequenceCacheWriter::append(const ParticleSystemData3 &particles) {
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(_fd < 0, "The sequence cache is already finished.");
+
+  internal::SequenceCacheFrame frame;
+  frame.type = SequenceCacheFrameType::kParticles;
+  frame.numberOfParticles = particles.numberOfParticles();
+  frame.numberOfScalarData = particles.numberOfScalarData();
+  frame.numberOfVectorData = particles.numberOfVectorData();
+  frame.radius = particles.radius();
+  frame.mass = particles.mass();
+
+  const auto positions = particles.positions();
+  for (size_t v = 0; v < frame.numberOfVectorData; ++v) {
+    if (particles.vectorDataAt(v).data() == positions.data()) {
+      frame.positionIdx = v;
+    }
+  }
+
+  BoundingBox3D bound;
+  for (const auto &x : positions) {
+    bound.merge(x);
+  }
+  frame.lowerCorner = positions.length() > 0 ? bound.lowerCorner : Vector3D();
+
+  const double levels = std::ldexp(1.0, static_cast<int>(_positionBits)) - 1.0;
+  for (size_t a = 0; a < 3; ++a) {
+    const double extent = positions.length() > 0 ? bound.upperCorner[a] - bound.lowerCorner[a] : 0.0;
+    frame.quantizationStep[a] = (extent > 0.0 ? extent : 1.0) / levels;
+  }
+
+  frame.isKeyframe = !isDeltaCompatible(frame);
+
+  std::vector<uint8_t> buffer;
+  putValue(static_cast<uint32_t>(frame.type), &buffer);
+  putValue(static_cast<uint32_t>(frame.isKeyframe), &buffer);
+  putValue<uint64_t>(frame.numberOfParticles, &buffer);
+  putValue<uint64_t>(frame.numberOfScalarData, &buffer);
+  putValue<uint64_t>(frame.numberOfVectorData, &buffer);
+  putValue<uint64_t>(frame.positionIdx, &buffer);
+  putValue(frame.radius, &buffer);
+  putValue(frame.mass, &buffer);
+  putVector(frame.lowerCorner, &buffer);
+  putVector(frame.quantizationStep, &buffer);
+
+  const size_t n = frame.numberOfParticles;
+  frame.channels.resize(numberOfChannels(frame));
+  Array1<uint64_t> codes(n);
+  for (size_t c = 0; c < frame.channels.length(); ++c) {
+    auto &values = frame.channels[c];
+    values.resize(n);
+
+    const size_t axis = positionAxis(frame, c);
+    if (axis != kMaxSize) {
+      // Quantized residuals against the previous reconstructed positions
+      const double lower = frame.lowerCorner[axis];
+      const double step = frame.quantizationStep[axis];
+      parallelFor(kZeroSize, n, [&](size_t i) {
+        const double prediction = frame.isKeyframe ? lower : fromBits(_previous.channels[c][i]);
+        const auto code = static_cast<int64_t>(std::llround((positions[i][axis] - prediction) / step));
+        codes[i] = encodeZigZag(code);
+        values[i] = toBits(dequantize(prediction, code, step));
+      });
+    } else if (c < 3 * frame.numberOfVectorData) {
+      const auto data = particles.vectorDataAt(c / 3);
+      parallelFor(kZeroSize, n, [&](size_t i) {
+        values[i] = toBits(data[i][c % 3]);
+        codes[i] = frame.isKeyframe ? values[i] : values[i] ^ _previous.channels[c][i];
+      });
+    } else {
+      const auto data = particles.scalarDataAt(c - 3 * frame.numberOfVectorData);
+      parallelFor(kZeroSize, n, [&](size_t i) {
+        values[i] = toBits(data[i]);
+        codes[i] = frame.isKeyframe ? values[i] : values[i] ^ _previous.channels[c][i];
+      });
+    }
+
+    internal::encodeSequenceCacheWords(codes, &buffer);
+  }
+
+  write(frame, buffer);
+  _previous = std::move(frame);
+}
+
+void SequenceCacheWriter::append(const ScalarGrid3 &grid) {
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(_fd < 0, "The sequence cache is already finished.");
+
+  internal::SequenceCacheFrame frame;
+  frame.type = SequenceCacheFrameType::kScalarGrid;
+  frame.resolution = grid.resolution();
+  frame.dataSize = grid.dataSize();
+  frame.gridSpacing = grid.gridSpacing();
+  frame.origin = grid.origin();
+  frame.isKeyframe = !isDeltaCompatible(frame);
+
+  std::vector<uint8_t> buffer;
+  putValue(static_cast<uint32_t>(frame.type), &buffer);
+  putValue(static_cast<uint32_t>(frame.isKeyframe), &buffer);
+  putVector<uint64_t>(frame.resolution.castTo<uint64_t>(), &buffer);
+  putVector<uint64_t>(frame.dataSize.castTo<uint64_t>(), &buffer);
+  putVector(frame.gridSpacing, &buffer);
+  putVector(frame.origin, &buffer);
+
+  const auto data = grid.dataView();
+  const size_t n = data.length();
+  frame.channels.resize(1);
+  auto &values = frame.channels[0];
+  values.resize(n);
+  Array1<uint64_t> codes(n);
+  parallelFor(kZeroSize, n, [&](size_t i) {
+    values[i] = toBits(data[i]);
+    codes[i] = frame.isKeyframe ? values[i] : values[i] ^ _previous.channels[0][i];
+  });
+  internal::encodeSequenceCacheWords(codes, &buffer);
+
+  write(frame, buffer);
+  _previous = std::move(frame);
+}
+
+void SequenceCacheWriter::finish() {
+  if (_fd < 0) {
+    return;
+  }
+
+  std::vector<uint8_t> buffer;
+  for (const auto &entry : _index) {
+    putValue(entry.offset, &buffer);
+    putValue(entry.size, &buffer);
+    putValue(static_cast<uint32_t>(entry.type), &buffer);
+    putValue(entry.isKeyframe, &buffer);
+  }
+  putValue(_offset, &buffer);
+  putValue<uint64_t>(_index.size(), &buffer);
+  buffer.insert(buffer.end(), std::begin(kSequenceCacheMagic), std::end(kSequenceCacheMagic));
+
+  const int fd = _fd;
+  _fd = -1;
+  try {
+    internal::writeToFile(fd, buffer.data(), buffer.size());
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  _offset += buffer.size();
+
+  if (::close(fd) != 0) {
+    throw std::system_error(errno, std::generic_category(), "close");
+  }
+}
+
+size_t SequenceCacheWriter::numberOfFrames() const { return _index.size(); }
+
+size_t SequenceCacheWriter::bytesWritten() const { return static_cast<size_t>(_offset); }
+
+unsigned int SequenceCacheWriter::positionBits() const { return _positionBits; }
+
+size_t SequenceCacheWriter::keyframeInterval() const { return _keyframeInterval; }
+
+void SequenceCacheWriter::write(const internal::SequenceCacheFrame &frame, const std::vector<uint8_t> &buffer) {
+  internal::SequenceCacheFrameEntry entry;
+  entry.offset = _offset;
+  entry.size = buffer.size();
+  entry.type = frame.type;
+  entry.isKeyframe = frame.isKeyframe ? 1 : 0;
+
+  internal::writeToFile(_fd, buffer.data(), buffer.size());
+  _offset += buffer.size();
+  _index.push_back(entry);
+  _framesSinceKeyframe = frame.isKeyframe ? 0 : _framesSinceKeyframe + 1;
+}
+
+bool SequenceCacheWriter::isDeltaCompatible(const internal::SequenceCacheFrame &frame) const {
+  if (_index.empty() || _framesSinceKeyframe + 1 >= _keyframeInterval || _previous.type != frame.type) {
+    return false;
+  }
+  if (frame.type == SequenceCacheFrameType::kParticles) {
+    return frame.numberOfParticles == _previous.numberOfParticles &&
+           frame.numberOfScalarData == _previous.numberOfScalarData &&
+           frame.numberOfVectorData == _previous.numberOfVectorData && frame.positionIdx == _previous.positionIdx;
+  }
+  return frame.dataSize == _previous.dataSize;
+}
+
+// MARK: SequenceCacheReader
+
+SequenceCacheReader::SequenceCacheReader(const std::string &filename) : _file(filename), _decodedFrame(kMaxSize) {
+  const ConstArrayView1<uint8_t> buffer = _file.view();
+  const size_t size = buffer.length();
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+      size < sizeof(kSequenceCacheMagic) + kFooterSize ||
+          std::memcmp(buffer.data(), kSequenceCacheMagic, sizeof(kSequenceCacheMagic)) != 0 ||
+          std::memcmp(buffer.data() + size - sizeof(kSequenceCacheMagic), kSequenceCacheMagic,
+                      sizeof(kSequenceCacheMagic)) != 0,
+      "Not a sequence cache.");
+
+  ByteReader footer(ConstArrayView1<uint8_t>(buffer.data() + size - kFooterSize, kFooterSize));
+  const auto indexOffset = static_cast<size_t>(footer.get<uint64_t>());
+  const auto numberOfFrames = static_cast<size_t>(footer.get<uint64_t>());
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(indexOffset > size - kFooterSize ||
+                                            (size - kFooterSize - indexOffset) / kIndexEntrySize != numberOfFrames,
+                                        "Corrupted sequence cache.");
+
+  ByteReader reader(ConstArrayView1<uint8_t>(buffer.data() + indexOffset, numberOfFrames * kIndexEntrySize));
+  _index.resize(numberOfFrames);
+  for (auto &entry : _index) {
+    entry.offset = reader.get<uint64_t>();
+    entry.size = reader.get<uint64_t>();
+    entry.type = static_cast<SequenceCacheFrameType>(reader.get<uint32_t>());
+    entry.isKeyframe = reader.get<uint32_t>();
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(entry.offset > indexOffset || entry.size > indexOffset - entry.offset,
+                                          "Corrupted sequence cache.");
+  }
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(!_index.empty() && _index[0].isKeyframe == 0, "Corrupted sequence cache.");
+}
+
+size_t SequenceCacheReader::numberOfFrames() const { return _index.size(); }
+
+SequenceCacheFrameType SequenceCacheReader::frameType(size_t frame) const { return _index.at(frame).type; }
+
+bool SequenceCacheReader::isKeyframe(size_t frame) const { return _index.at(frame).isKeyframe != 0; }
+
+void SequenceCacheReader::load(size_t frame, ParticleSystemData3 *particles) {
+  JET_THROW_INVALID_ARG_IF(frame >= _index.size());
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(_index[frame].type != SequenceCacheFrameType::kParticles,
+                                        "Not a particle frame.");
+  decode(frame);
+
+  const auto &decoded = _decoded;
+  JET_THROW_INVALID_ARG_IF(particles->numberOfScalarData() > decoded.numberOfScalarData ||
+                           particles->numberOfVectorData() > decoded.numberOfVectorData);
+
+  particles->resize(decoded.numberOfParticles);
+  while (particles->numberOfScalarData() < decoded.numberOfScalarData) {
+    particles->addScalarData();
+  }
+  while (particles->numberOfVectorData() < decoded.numberOfVectorData) {
+    particles->addVectorData();
+  }
+  JET_THROW_INVALID_ARG_IF(particles->vectorDataAt(decoded.positionIdx).data() != particles->positions().data());
+
+  particles->setRadius(decoded.radius);
+  particles->setMass(decoded.mass);
+
+  for (size_t v = 0; v < decoded.numberOfVectorData; ++v) {
+    auto data = particles->vectorDataAt(v);
+    parallelFor(kZeroSize, decoded.numberOfParticles, [&](size_t i) {
+      for (size_t a = 0; a < 3; ++a) {
+        data[i][a] = fromBits(decoded.channels[3 * v + a][i]);
+      }
+    });
+  }
+  for (size_t s = 0; s < decoded.numberOfScalarData; ++s) {
+    auto data = particles->scalarDataAt(s);
+    const auto &values = decoded.channels[3 * decoded.numberOfVectorData + s];
+    parallelFor(kZeroSize, decoded.numberOfParticles, [&](size_t i) { data[i] = fromBits(values[i]); });
+  }
+}
+
+void SequenceCacheReader::load(size_t frame, ScalarGrid3 *grid) {
+  JET_THROW_INVALID_ARG_IF(frame >= _index.size());
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(_index[frame].type != SequenceCacheFrameType::kScalarGrid,
+                                        "Not a scalar grid frame.");
+  decode(frame);
+
+  grid->resize(_decoded.resolution, _decoded.gridSpacing, _decoded.origin);
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(grid->dataSize() != _decoded.dataSize, "Mismatching type of the grid.");
+
+  auto data = grid->dataView();
+  const auto &values = _decoded.channels[0];
+  parallelFor(kZeroSize, data.length(), [&](size_t i) { data[i] = fromBits(values[i]); });
+}
+
+void SequenceCacheReader::decode(size_t frame) {
+  // Start from the preceding keyframe, or continue from the last decoded frame
+  size_t begin = frame;
+  while (_index[begin].isKeyframe == 0) {
+    --begin;
+  }
+  if (_decodedFrame != kMaxSize && _decodedFrame >= begin && _decodedFrame <= frame) {
+    begin = _decodedFrame + 1;
+  }
+
+  for (size_t f = begin; f <= frame; ++f) {
+    const auto &entry = _index[f];
+    ByteReader reader(ConstArrayView1<uint8_t>(_file.data() + entry.offset, static_cast<size_t>(entry.size)));
+
+    internal::SequenceCacheFrame decoded;
+    decoded.type = static_cast<SequenceCacheFrameType>(reader.get<uint32_t>());
+    decoded.isKeyframe = reader.get<uint32_t>() != 0;
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(decoded.type != entry.type || decoded.isKeyframe != (entry.isKeyframe != 0),
+                                          "Corrupted sequence cache.");
+
+    if (decoded.type == SequenceCacheFrameType::kParticles) {
+      decoded.numberOfParticles = static_cast<size_t>(reader.get<uint64_t>());
+      decoded.numberOfScalarData = static_cast<size_t>(reader.get<uint64_t>());
+      decoded.numberOfVectorData = static_cast<size_t>(reader.get<uint64_t>());
+      decoded.positionIdx = static_cast<size_t>(reader.get<uint64_t>());
+      decoded.radius = reader.get<double>();
+      decoded.mass = reader.get<double>();
+      decoded.lowerCorner = reader.getVector<double>();
+      decoded.quantizationStep = reader.getVector<double>();
+      JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(decoded.positionIdx >= decoded.numberOfVectorData,
+                                            "Corrupted sequence cache.");
+    } else {
+      decoded.resolution = reader.getVector<uint64_t>().castTo<size_t>();
+      decoded.dataSize = reader.getVector<uint64_t>().castTo<size_t>();
+      decoded.gridSpacing = reader.getVector<double>();
+      decoded.origin = reader.getVector<double>();
+    }
+
+    const bool isDelta = !decoded.isKeyframe;
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(isDelta && (numberOfChannels(decoded) != _decoded.channels.length() ||
+                                                      channelLength(decoded) != channelLength(_decoded)),
+                                          "Corrupted sequence cache.");
+
+    const size_t n = channelLength(decoded);
+    decoded.channels.resize(numberOfChannels(decoded));
+    Array1<uint64_t> codes;
+    for (size_t c = 0; c < decoded.channels.length(); ++c) {
+      reader.skip(internal::decodeSequenceCacheWords(reader.remaining(), &codes));
+      JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(codes.length() != n, "Corrupted sequence cache.");
+
+      auto &values = decoded.channels[c];
+      values.resize(n);
+
+      const size_t axis = positionAxis(decoded, c);
+      if (axis != kMaxSize) {
+        const double lower = decoded.lowerCorner[axis];
+        const double step = decoded.quantizationStep[axis];
+        parallelFor(kZeroSize, n, [&](size_t i) {
+          const double prediction = isDelta ? fromBits(_decoded.channels[c][i]) : lower;
+          values[i] = toBits(dequantize(prediction, decodeZigZag(codes[i]), step));
+        });
+      } else {
+        parallelFor(kZeroSize, n,
+                    [&](size_t i) { values[i] = isDelta ? codes[i] ^ _decoded.channels[c][i] : codes[i]; });
+      }
+    }
+
+    _decoded = std::move(decoded);
+    _decodedFrame = f;
+  }
+}
+
+} // namespace vox
+} // namespace geometry
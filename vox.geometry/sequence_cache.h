@@ -0,0 +1,200 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SEQUENCE_CACHE_H_
+#define INCLUDE_JET_SEQUENCE_CACHE_H_
+
+#include "array.h"
+#include "grids/scalar_grid.h"
+#include "particle_system_data.h"
+#include "serialization.h"
+
+#include <string>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+//! Type of the frames stored in a sequence cache.
+enum class SequenceCacheFrameType : uint32_t { kParticles = 1, kScalarGrid = 2 };
+
+namespace internal {
+
+//! Location of a frame in a sequence cache file.
+struct SequenceCacheFrameEntry {
+  uint64_t offset = 0;
+  uint64_t size = 0;
+  SequenceCacheFrameType type = SequenceCacheFrameType::kParticles;
+  uint32_t isKeyframe = 0;
+};
+
+//! Decoded frame of a sequence cache, which is also the reference of the next delta frame.
+struct SequenceCacheFrame {
+  SequenceCacheFrameType type = SequenceCacheFrameType::kParticles;
+  bool isKeyframe = true;
+
+  // Particles
+  size_t numberOfParticles = 0;
+  size_t numberOfScalarData = 0;
+  size_t numberOfVectorData = 0;
+  size_t positionIdx = 0;
+  double radius = 0.0;
+  double mass = 0.0;
+  Vector3D lowerCorner;
+  Vector3D quantizationStep;
+
+  // Scalar grids
+  Vector3UZ resolution;
+  Vector3UZ dataSize;
+  Vector3D gridSpacing;
+  Vector3D origin;
+
+  //! Bit patterns of the reconstructed values, one array per channel.
+  Array1<Array1<uint64_t>> channels;
+};
+
+//! Number of 64-bit words compressed by a single task.
+constexpr size_t kSequenceCacheChunkSize = 1 << 16;
+
+//!
+//! \brief Compresses \p words and appends the result to \p buffer.
+//!
+//! The words are split into chunks which are compressed in parallel. Each
+//! chunk is byte-shuffled, so that the i-th bytes of all the words are stored
+//! together, and the runs of zero bytes are then replaced by their lengths.
+//! Small or delta-encoded values have zero high bytes, which are removed.
+//!
+void encodeSequenceCacheWords(const ConstArrayView1<uint64_t> &words, std::vector<uint8_t> *buffer);
+
+//! Decompresses the words at the beginning of \p buffer and returns the number of bytes read.
+size_t decodeSequenceCacheWords(const ConstArrayView1<uint8_t> &buffer, Array1<uint64_t> *words);
+
+} // namespace internal
+
+//!
+//! \brief Writes a compressed cache of particle and grid frames.
+//!
+//! Unlike the FlatBuffers serialization, which stores every value as a raw
+//! double, the frames are encoded as follows:
+//!
+//! - Particle positions are quantized with a step size of the frame bounding
+//!   box divided by 2^positionBits - 1, so the error is at most half a step.
+//! - Every frame but the keyframes is encoded as the difference to the previous
+//!   frame. The positions are predicted from the previous reconstructed
+//!   positions, so the quantization error does not accumulate, and the other
+//!   data is XOR-ed with the previous values, which keeps it lossless.
+//! - The resulting words are byte-shuffled and their zero runs are removed,
+//!   in parallel chunks.
+//!
+//! A keyframe is written every \p keyframeInterval frames and whenever the
+//! layout of the data changes. An index of all the frames is written at the
+//! end, so that the reader can seek to any frame. Neighbor searchers and lists
+//! of the particles are not stored.
+//!
+class SequenceCacheWriter {
+public:
+  //! Default number of bits of the quantized positions.
+  static constexpr unsigned int kDefaultPositionBits = 20;
+
+  //! Default number of frames between two keyframes.
+  static constexpr size_t kDefaultKeyframeInterval = 16;
+
+  //! Creates the cache file at \p filename. Throws std::system_error on failure.
+  explicit SequenceCacheWriter(const std::string &filename, unsigned int positionBits = kDefaultPositionBits,
+                               size_t keyframeInterval = kDefaultKeyframeInterval);
+
+  SequenceCacheWriter(const SequenceCacheWriter &) = delete;
+
+  //! Finishes the cache if finish() has not been called yet.
+  ~SequenceCacheWriter();
+
+  SequenceCacheWriter &operator=(const SequenceCacheWriter &) = delete;
+
+  //! Appends a particle frame.
+  void append(const ParticleSystemData3 &particles);
+
+  //! Appends a scalar grid frame.
+  void append(const ScalarGrid3 &grid);
+
+  //! Writes the frame index and closes the file.
+  void finish();
+
+  //! Returns the number of frames written so far.
+  [[nodiscard]] size_t numberOfFrames() const;
+
+  //! Returns the number of bytes written so far.
+  [[nodiscard]] size_t bytesWritten() const;
+
+  //! Returns the number of bits of the quantized positions.
+  [[nodiscard]] unsigned int positionBits() const;
+
+  //! Returns the number of frames between two keyframes.
+  [[nodiscard]] size_t keyframeInterval() const;
+
+private:
+  int _fd = -1;
+  unsigned int _positionBits;
+  size_t _keyframeInterval;
+  uint64_t _offset = 0;
+  size_t _framesSinceKeyframe = 0;
+  std::vector<internal::SequenceCacheFrameEntry> _index;
+  internal::SequenceCacheFrame _previous;
+
+  void write(const internal::SequenceCacheFrame &frame, const std::vector<uint8_t> &buffer);
+
+  [[nodiscard]] bool isDeltaCompatible(const internal::SequenceCacheFrame &frame) const;
+};
+
+//!
+//! \brief Reads the frames of a cache written by SequenceCacheWriter.
+//!
+//! The file is memory mapped. Loading a delta frame decodes the frames since
+//! the preceding keyframe, unless the previous frame was the last one loaded,
+//! so sequential playback decodes every frame once.
+//!
+class SequenceCacheReader {
+public:
+  //! Opens the cache file at \p filename. Throws std::system_error on failure.
+  explicit SequenceCacheReader(const std::string &filename);
+
+  //! Returns the number of frames.
+  [[nodiscard]] size_t numberOfFrames() const;
+
+  //! Returns the type of the frame at \p frame.
+  [[nodiscard]] SequenceCacheFrameType frameType(size_t frame) const;
+
+  //! Returns true if the frame at \p frame is encoded without the previous frame.
+  [[nodiscard]] bool isKeyframe(size_t frame) const;
+
+  //!
+  //! \brief Loads the particle frame at \p frame into \p particles.
+  //!
+  //! Data layers are added to \p particles as needed. It is an error if
+  //! \p particles already has more layers than the cached frame.
+  //!
+  void load(size_t frame, ParticleSystemData3 *particles);
+
+  //!
+  //! \brief Loads the scalar grid frame at \p frame into \p grid.
+  //!
+  //! The grid is resized to the cached resolution, so it should be of the same
+  //! type (cell-centered or vertex-centered) as the cached grid.
+  //!
+  void load(size_t frame, ScalarGrid3 *grid);
+
+private:
+  MappedFile _file;
+  std::vector<internal::SequenceCacheFrameEntry> _index;
+  size_t _decodedFrame;
+  internal::SequenceCacheFrame _decoded;
+
+  void decode(size_t frame);
+};
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_SEQUENCE_CACHE_H_
@@ -14,6 +14,14 @@
 
 #include "serialization.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 namespace vox {
@@ -37,11 +45,122 @@ void serialize(const uint8_t *data, size_t size, std::vector<uint8_t> *buffer) {
 
 void deserialize(const std::vector<uint8_t> &buffer, Serializable *serializable) { serializable->deserialize(buffer); }
 
+void serializeToFile(const Serializable *serializable, const std::string &filename) {
+  const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), filename);
+  }
+
+  try {
+    serializable->serializeToFile(fd);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+
+  if (::close(fd) != 0) {
+    throw std::system_error(errno, std::generic_category(), filename);
+  }
+}
+
+void deserializeFromFile(const std::string &filename, Serializable *serializable) {
+  const MappedFile file(filename);
+  serializable->deserializeFromMemory(file.view());
+}
+
 void deserialize(const std::vector<uint8_t> &buffer, std::vector<uint8_t> *data) {
   auto fbsData = fbs::GetFlatData(buffer.data());
   data->resize(fbsData->data()->size());
   std::copy(fbsData->data()->begin(), fbsData->data()->end(), data->begin());
 }
 
+// MARK: Serializable
+
+void Serializable::serializeToFile(int fd) const {
+  std::vector<uint8_t> buffer;
+  serialize(&buffer);
+  internal::writeToFile(fd, buffer.data(), buffer.size());
+}
+
+void Serializable::deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) {
+  deserialize(std::vector<uint8_t>(buffer.begin(), buffer.end()));
+}
+
+// MARK: MappedFile
+
+MappedFile::MappedFile(const std::string &filename) {
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), filename);
+  }
+
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), filename);
+  }
+
+  _size = static_cast<size_t>(info.st_size);
+  if (_size > 0) {
+    void *ptr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), filename);
+    }
+    _data = static_cast<const uint8_t *>(ptr);
+  }
+
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : _data(std::exchange(other._data, nullptr)), _size(std::exchange(other._size, 0)) {}
+
+MappedFile::~MappedFile() { unmap(); }
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this != &other) {
+    unmap();
+    _data = std::exchange(other._data, nullptr);
+    _size = std::exchange(other._size, 0);
+  }
+  return *this;
+}
+
+const uint8_t *MappedFile::data() const { return _data; }
+
+size_t MappedFile::size() const { return _size; }
+
+ConstArrayView1<uint8_t> MappedFile::view() const { return ConstArrayView1<uint8_t>(_data, _size); }
+
+void MappedFile::unmap() {
+  if (_data != nullptr) {
+    ::munmap(const_cast<uint8_t *>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+  }
+}
+
+namespace internal {
+
+void writeToFile(int fd, const uint8_t *data, size_t size) {
+  while (size > 0) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(), "write");
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+}
+
+} // namespace internal
+
 } // namespace vox
 } // namespace geometry
@@ -9,6 +9,7 @@
 
 #include "array_view.h"
 
+#include <string>
 #include <vector>
 
 namespace vox {
@@ -40,6 +41,62 @@ public:
 
   //! Deserializes this instance from the flat buffer.
   virtual void deserialize(const std::vector<uint8_t> &buffer) = 0;
+
+  //!
+  //! \brief Serializes this instance and writes the flat buffer to \p fd.
+  //!
+  //! The default implementation serializes into a temporary buffer first.
+  //! Subclasses with large data write the buffer of the flat buffer builder
+  //! directly instead.
+  //!
+  virtual void serializeToFile(int fd) const;
+
+  //!
+  //! \brief Deserializes this instance from the flat buffer in \p buffer.
+  //!
+  //! The buffer can be memory mapped, for example by MappedFile. The default
+  //! implementation copies it into a temporary buffer first.
+  //!
+  virtual void deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer);
+};
+
+//!
+//! \brief Read-only memory mapping of a whole file.
+//!
+//! The mapping is private to the process and is unmapped when the instance is
+//! destroyed, which invalidates all the views into it. The data starts at a
+//! page boundary, so the fields of a flat buffer written by serializeToFile()
+//! keep their alignment.
+//!
+class MappedFile final {
+public:
+  //! Maps the file at \p filename. Throws std::system_error on failure.
+  explicit MappedFile(const std::string &filename);
+
+  MappedFile(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept;
+
+  ~MappedFile();
+
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  //! Returns the mapped data.
+  [[nodiscard]] const uint8_t *data() const;
+
+  //! Returns the size of the file in bytes.
+  [[nodiscard]] size_t size() const;
+
+  //! Returns the view of the mapped data.
+  [[nodiscard]] ConstArrayView1<uint8_t> view() const;
+
+private:
+  const uint8_t *_data = nullptr;
+  size_t _size = 0;
+
+  void unmap();
 };
 
 //! Serializes serializable object.
@@ -54,12 +111,25 @@ template <typename T> void serialize(const ConstArrayView1<T> &array, std::vecto
 //! Deserializes buffer to serializable object.
 void deserialize(const std::vector<uint8_t> &buffer, Serializable *serializable);
 
+//! Serializes serializable object into the file at \p filename, replacing it.
+void serializeToFile(const Serializable *serializable, const std::string &filename);
+
+//! Deserializes the file at \p filename to serializable object by mapping it.
+void deserializeFromFile(const std::string &filename, Serializable *serializable);
+
 //! Deserializes buffer to data chunk using common schema.
 void deserialize(const std::vector<uint8_t> &buffer, std::vector<uint8_t> *data);
 
 //! Deserializes buffer to data chunk using common schema.
 template <typename T> void deserialize(const std::vector<uint8_t> &buffer, Array1<T> *array);
 
+namespace internal {
+
+//! Writes \p size bytes at \p data to \p fd. Throws std::system_error on failure.
+void writeToFile(int fd, const uint8_t *data, size_t size);
+
+} // namespace internal
+
 } // namespace vox
 } // namespace geometry
 
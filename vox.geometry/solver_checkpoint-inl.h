@@ -0,0 +1,56 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_SOLVER_CHECKPOINT_INL_H_
+#define INCLUDE_JET_DETAIL_SOLVER_CHECKPOINT_INL_H_
+
+#include "macros.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace vox {
+namespace geometry {
+
+template <typename T> void SolverCheckpoint::setValue(const std::string &name, const T &value) {
+  static_assert(std::is_standard_layout<T>::value, "Only plain data values can be checkpointed.");
+
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+  setChannel(name, std::vector<uint8_t>(bytes, bytes + sizeof(T)));
+}
+
+template <typename T> T SolverCheckpoint::value(const std::string &name) const {
+  static_assert(std::is_standard_layout<T>::value, "Only plain data values can be checkpointed.");
+
+  const std::vector<uint8_t> &data = channel(name);
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(data.size() != sizeof(T), "Mismatching checkpoint channel size.");
+
+  T result;
+  std::memcpy(static_cast<void *>(&result), data.data(), sizeof(T));
+  return result;
+}
+
+template <typename T> void SolverCheckpoint::setValues(const std::string &name, const ConstArrayView1<T> &values) {
+  static_assert(std::is_standard_layout<T>::value, "Only plain data values can be checkpointed.");
+
+  const auto *bytes = reinterpret_cast<const uint8_t *>(values.data());
+  setChannel(name, std::vector<uint8_t>(bytes, bytes + sizeof(T) * values.length()));
+}
+
+template <typename T> ConstArrayView1<T> SolverCheckpoint::values(const std::string &name) const {
+  static_assert(std::is_standard_layout<T>::value, "Only plain data values can be checkpointed.");
+
+  const std::vector<uint8_t> &data = channel(name);
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(data.size() % sizeof(T) != 0, "Mismatching checkpoint channel size.");
+
+  // The channels are allocated by std::vector, which aligns them for any fundamental type
+  return ConstArrayView1<T>(reinterpret_cast<const T *>(data.data()), data.size() / sizeof(T));
+}
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_SOLVER_CHECKPOINT_INL_H_
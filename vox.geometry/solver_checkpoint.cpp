@@ -0,0 +1,191 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "common.h"
+
+#include "solver_checkpoint.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace vox {
+namespace geometry {
+
+namespace {
+
+const char kSolverCheckpointMagic[8] = {'V', 'O', 'X', 'C', 'K', 'P', '0', '1'};
+
+template <typename T> void putValue(const T &value, std::vector<uint8_t> *buffer) {
+  const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+  buffer->insert(buffer->end(), bytes, bytes + sizeof(T));
+}
+
+class ByteReader {
+public:
+  explicit ByteReader(const ConstArrayView1<uint8_t> &buffer) : _buffer(buffer) {}
+
+  template <typename T> T get() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const uint8_t *take(size_t size) {
+    JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(size > _buffer.length() - _position, "Truncated solver checkpoint.");
+    const uint8_t *data = _buffer.data() + _position;
+    _position += size;
+    return data;
+  }
+
+private:
+  ConstArrayView1<uint8_t> _buffer;
+  size_t _position = 0;
+};
+
+} // namespace
+
+int SolverCheckpoint::frameIndex() const { return _frameIndex; }
+
+void SolverCheckpoint::setFrameIndex(int frameIndex) { _frameIndex = frameIndex; }
+
+bool SolverCheckpoint::isIncremental() const { return _isIncremental; }
+
+int SolverCheckpoint::baseFrameIndex() const { return _baseFrameIndex; }
+
+size_t SolverCheckpoint::numberOfChannels() const { return _channels.size(); }
+
+size_t SolverCheckpoint::numberOfStoredChannels() const {
+  return static_cast<size_t>(std::count_if(_channels.begin(), _channels.end(),
+                                           [](const auto &channel) { return channel.second != nullptr; }));
+}
+
+bool SolverCheckpoint::hasChannel(const std::string &name) const { return _channels.count(name) > 0; }
+
+const std::vector<uint8_t> &SolverCheckpoint::channel(const std::string &name) const {
+  auto iter = _channels.find(name);
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(iter == _channels.end(), "Missing checkpoint channel.");
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(iter->second == nullptr, "Checkpoint channel is left to the base.");
+  return *iter->second;
+}
+
+void SolverCheckpoint::setChannel(const std::string &name, std::vector<uint8_t> data) {
+  _channels[name] = std::make_shared<const std::vector<uint8_t>>(std::move(data));
+}
+
+void SolverCheckpoint::setText(const std::string &name, const std::string &text) {
+  setChannel(name, std::vector<uint8_t>(text.begin(), text.end()));
+}
+
+std::string SolverCheckpoint::text(const std::string &name) const {
+  const std::vector<uint8_t> &data = channel(name);
+  return std::string(data.begin(), data.end());
+}
+
+void SolverCheckpoint::removeUnchanged(const SolverCheckpoint &base) {
+  JET_THROW_INVALID_ARG_IF(base._isIncremental);
+
+  for (auto &channel : _channels) {
+    auto baseChannel = base._channels.find(channel.first);
+    if (channel.second == nullptr || baseChannel == base._channels.end()) {
+      continue;
+    }
+
+    if (channel.second == baseChannel->second || *channel.second == *baseChannel->second) {
+      channel.second = nullptr;
+    }
+  }
+
+  _isIncremental = true;
+  _baseFrameIndex = base._frameIndex;
+}
+
+void SolverCheckpoint::resolve(const SolverCheckpoint &base) {
+  if (!_isIncremental) {
+    return;
+  }
+
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(base._isIncremental || base._frameIndex != _baseFrameIndex,
+                                        "Mismatching base checkpoint.");
+
+  for (auto &channel : _channels) {
+    if (channel.second == nullptr) {
+      auto baseChannel = base._channels.find(channel.first);
+      JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(baseChannel == base._channels.end(), "Missing checkpoint channel.");
+      channel.second = baseChannel->second;
+    }
+  }
+
+  _isIncremental = false;
+  _baseFrameIndex = 0;
+}
+
+template <typename Callback> void SolverCheckpoint::forEachSerializedBlock(const Callback &callback) const {
+  std::vector<uint8_t> header(std::begin(kSolverCheckpointMagic), std::end(kSolverCheckpointMagic));
+  putValue(static_cast<uint32_t>(_isIncremental), &header);
+  putValue(static_cast<int32_t>(_frameIndex), &header);
+  putValue(static_cast<int32_t>(_baseFrameIndex), &header);
+  putValue(static_cast<uint64_t>(_channels.size()), &header);
+  callback(header.data(), header.size());
+
+  // The channel data is passed as it is, so the file output does not copy it
+  for (const auto &channel : _channels) {
+    header.clear();
+    putValue(static_cast<uint64_t>(channel.first.size()), &header);
+    putValue(static_cast<uint64_t>(channel.second != nullptr ? channel.second->size() : 0), &header);
+    putValue(static_cast<uint32_t>(channel.second != nullptr), &header);
+    header.insert(header.end(), channel.first.begin(), channel.first.end());
+    callback(header.data(), header.size());
+
+    if (channel.second != nullptr && !channel.second->empty()) {
+      callback(channel.second->data(), channel.second->size());
+    }
+  }
+}
+
+void SolverCheckpoint::serialize(std::vector<uint8_t> *buffer) const {
+  buffer->clear();
+  forEachSerializedBlock(
+      [buffer](const uint8_t *data, size_t size) { buffer->insert(buffer->end(), data, data + size); });
+}
+
+void SolverCheckpoint::deserialize(const std::vector<uint8_t> &buffer) {
+  deserializeFromMemory(ConstArrayView1<uint8_t>(buffer.data(), buffer.size()));
+}
+
+void SolverCheckpoint::serializeToFile(int fd) const {
+  forEachSerializedBlock([fd](const uint8_t *data, size_t size) { internal::writeToFile(fd, data, size); });
+}
+
+void SolverCheckpoint::deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) {
+  ByteReader reader(buffer);
+  JET_THROW_INVALID_ARG_WITH_MESSAGE_IF(
+      std::memcmp(reader.take(sizeof(kSolverCheckpointMagic)), kSolverCheckpointMagic,
+                  sizeof(kSolverCheckpointMagic)) != 0,
+      "Not a solver checkpoint.");
+
+  _isIncremental = reader.get<uint32_t>() != 0;
+  _frameIndex = reader.get<int32_t>();
+  _baseFrameIndex = reader.get<int32_t>();
+
+  _channels.clear();
+  const auto numberOfChannels = reader.get<uint64_t>();
+  for (uint64_t i = 0; i < numberOfChannels; ++i) {
+    const auto nameLength = static_cast<size_t>(reader.get<uint64_t>());
+    const auto dataSize = static_cast<size_t>(reader.get<uint64_t>());
+    const bool isStored = reader.get<uint32_t>() != 0;
+
+    const auto *name = reinterpret_cast<const char *>(reader.take(nameLength));
+    Channel &channel = _channels[std::string(name, name + nameLength)];
+    if (isStored) {
+      const uint8_t *data = reader.take(dataSize);
+      channel = std::make_shared<const std::vector<uint8_t>>(data, data + dataSize);
+    }
+  }
+}
+
+} // namespace vox
+} // namespace geometry
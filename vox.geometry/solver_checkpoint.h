@@ -0,0 +1,130 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SOLVER_CHECKPOINT_H_
+#define INCLUDE_JET_SOLVER_CHECKPOINT_H_
+
+#include "array_view.h"
+#include "serialization.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief Checkpoint of the state of a running solver.
+//!
+//! The state is stored as named channels of bytes, such as
+//! "particles.vectorData.0" for the positions of a particle solver, which are
+//! filled by PhysicsAnimation::saveCheckpoint. An incremental checkpoint only
+//! stores the channels that changed since its base checkpoint and refers to
+//! the base for the rest, so the base has to be kept to restore it.
+//!
+//! The channels are shared between copies of a checkpoint, so copying is
+//! cheap.
+//!
+class SolverCheckpoint final : public Serializable {
+public:
+  //! Constructs an empty checkpoint.
+  SolverCheckpoint() = default;
+
+  //! Returns the frame index of the checkpointed state.
+  [[nodiscard]] int frameIndex() const;
+
+  //! Sets the frame index of the checkpointed state.
+  void setFrameIndex(int frameIndex);
+
+  //! Returns true if some channels are left to the base checkpoint.
+  [[nodiscard]] bool isIncremental() const;
+
+  //! Returns the frame index of the base checkpoint of an incremental checkpoint.
+  [[nodiscard]] int baseFrameIndex() const;
+
+  //! Returns the number of channels, including those left to the base checkpoint.
+  [[nodiscard]] size_t numberOfChannels() const;
+
+  //! Returns the number of channels stored in this checkpoint.
+  [[nodiscard]] size_t numberOfStoredChannels() const;
+
+  //! Returns true if the channel \p name exists, even if it is left to the base checkpoint.
+  [[nodiscard]] bool hasChannel(const std::string &name) const;
+
+  //! Returns the bytes of the channel \p name, which has to be stored in this checkpoint.
+  [[nodiscard]] const std::vector<uint8_t> &channel(const std::string &name) const;
+
+  //! Sets the bytes of the channel \p name.
+  void setChannel(const std::string &name, std::vector<uint8_t> data);
+
+  //! Sets the channel \p name to a plain data value.
+  template <typename T> void setValue(const std::string &name, const T &value);
+
+  //! Returns the plain data value of the channel \p name.
+  template <typename T> [[nodiscard]] T value(const std::string &name) const;
+
+  //! Sets the channel \p name to an array of plain data values.
+  template <typename T> void setValues(const std::string &name, const ConstArrayView1<T> &values);
+
+  //! Returns the view of the values of the channel \p name, which is valid while the channel exists.
+  template <typename T> [[nodiscard]] ConstArrayView1<T> values(const std::string &name) const;
+
+  //! Sets the channel \p name to a text, such as a streamed random number engine.
+  void setText(const std::string &name, const std::string &text);
+
+  //! Returns the text of the channel \p name.
+  [[nodiscard]] std::string text(const std::string &name) const;
+
+  //!
+  //! \brief Leaves the channels equal to those of \p base to the base checkpoint.
+  //!
+  //! The channels are compared byte by byte, so only the channels that
+  //! changed since the base remain stored in this checkpoint.
+  //!
+  void removeUnchanged(const SolverCheckpoint &base);
+
+  //!
+  //! \brief Takes the channels left to the base checkpoint from \p base.
+  //!
+  //! Throws std::invalid_argument if \p base is incremental itself, has a
+  //! different frame index than the base of this checkpoint or lacks a
+  //! channel.
+  //!
+  void resolve(const SolverCheckpoint &base);
+
+  //! Serializes this checkpoint into the buffer.
+  void serialize(std::vector<uint8_t> *buffer) const override;
+
+  //! Deserializes this checkpoint from the buffer.
+  void deserialize(const std::vector<uint8_t> &buffer) override;
+
+  //! Writes the channels to \p fd one by one, without concatenating them first.
+  void serializeToFile(int fd) const override;
+
+  //! Deserializes this checkpoint from the buffer, which can be memory mapped.
+  void deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) override;
+
+private:
+  using Channel = std::shared_ptr<const std::vector<uint8_t>>;
+
+  int _frameIndex = 0;
+  int _baseFrameIndex = 0;
+  bool _isIncremental = false;
+
+  //! Channels by name, where nullptr is a channel left to the base checkpoint.
+  std::map<std::string, Channel> _channels;
+
+  template <typename Callback> void forEachSerializedBlock(const Callback &callback) const;
+};
+
+} // namespace vox
+} // namespace geometry
+
+#include "solver_checkpoint-inl.h"
+
+#endif // INCLUDE_JET_SOLVER_CHECKPOINT_H_
@@ -18,6 +18,7 @@
 #include "parallel.h"
 #include "point_generators/bcc_lattice_point_generator.h"
 #include "point_generators/triangle_point_generator.h"
+#include "solver_checkpoint.h"
 #include "sph_kernels.h"
 #include "sph_system_data.h"
 
@@ -286,16 +287,8 @@ template <size_t N> void SphSystemData<N>::computeMass() {
 }
 
 template <size_t N> void SphSystemData<N>::serialize(std::vector<uint8_t> *buffer) const {
-  flatbuffers::FlatBufferBuilder builder(1024);
-  typename GetFlatbuffersSphSystemData<N>::BaseOffset fbsParticleSystemData;
-
-  ParticleSystemData<N>::serialize(*this, &builder, &fbsParticleSystemData);
-
-  auto fbsSphSystemData = GetFlatbuffersSphSystemData<N>::createSphSystemData(
-      builder, fbsParticleSystemData, _targetDensity, _targetSpacing, _kernelRadiusOverTargetSpacing, _kernelRadius,
-      _pressureIdx, _densityIdx);
-
-  builder.Finish(fbsSphSystemData);
+  flatbuffers::FlatBufferBuilder builder(ParticleSystemData<N>::serializedSizeHint());
+  buildSphSystemData(&builder);
 
   uint8_t *buf = builder.GetBufferPointer();
   size_t size = builder.GetSize();
@@ -305,6 +298,52 @@ template <size_t N> void SphSystemData<N>::serialize(std::vector<uint8_t> *buffe
 }
 
 template <size_t N> void SphSystemData<N>::deserialize(const std::vector<uint8_t> &buffer) {
+  deserializeFromMemory(ConstArrayView1<uint8_t>(buffer.data(), buffer.size()));
+}
+
+template <size_t N> void SphSystemData<N>::serializeToFile(int fd) const {
+  flatbuffers::FlatBufferBuilder builder(ParticleSystemData<N>::serializedSizeHint());
+  buildSphSystemData(&builder);
+
+  internal::writeToFile(fd, builder.GetBufferPointer(), builder.GetSize());
+}
+
+template <size_t N>
+ConstArrayView1<double> SphSystemData<N>::mappedScalarDataAt(const ConstArrayView1<uint8_t> &buffer, size_t idx) {
+  return Base::scalarDataView(GetFlatbuffersSphSystemData<N>::getSphSystemData(buffer.data())->base(), idx);
+}
+
+template <size_t N>
+ConstArrayView1<Vector<double, N>> SphSystemData<N>::mappedVectorDataAt(const ConstArrayView1<uint8_t> &buffer,
+                                                                        size_t idx) {
+  return Base::vectorDataView(GetFlatbuffersSphSystemData<N>::getSphSystemData(buffer.data())->base(), idx);
+}
+
+template <size_t N>
+ConstArrayView1<Vector<double, N>> SphSystemData<N>::mappedPositions(const ConstArrayView1<uint8_t> &buffer) {
+  auto base = GetFlatbuffersSphSystemData<N>::getSphSystemData(buffer.data())->base();
+  return Base::vectorDataView(base, static_cast<size_t>(base->positionIdx()));
+}
+
+template <size_t N>
+ConstArrayView1<double> SphSystemData<N>::mappedDensities(const ConstArrayView1<uint8_t> &buffer) {
+  auto fbsSphSystemData = GetFlatbuffersSphSystemData<N>::getSphSystemData(buffer.data());
+  return Base::scalarDataView(fbsSphSystemData->base(), static_cast<size_t>(fbsSphSystemData->densityIdx()));
+}
+
+template <size_t N> void SphSystemData<N>::buildSphSystemData(flatbuffers::FlatBufferBuilder *builder) const {
+  typename GetFlatbuffersSphSystemData<N>::BaseOffset fbsParticleSystemData;
+
+  ParticleSystemData<N>::serialize(*this, builder, &fbsParticleSystemData);
+
+  auto fbsSphSystemData = GetFlatbuffersSphSystemData<N>::createSphSystemData(
+      *builder, fbsParticleSystemData, _targetDensity, _targetSpacing, _kernelRadiusOverTargetSpacing, _kernelRadius,
+      _pressureIdx, _densityIdx);
+
+  builder->Finish(fbsSphSystemData);
+}
+
+template <size_t N> void SphSystemData<N>::deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) {
   auto fbsSphSystemData = GetFlatbuffersSphSystemData<N>::getSphSystemData(buffer.data());
 
   auto base = fbsSphSystemData->base();
@@ -319,6 +358,26 @@ template <size_t N> void SphSystemData<N>::deserialize(const std::vector<uint8_t
   _densityIdx = static_cast<size_t>(fbsSphSystemData->densityIdx());
 }
 
+template <size_t N>
+void SphSystemData<N>::saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const {
+  ParticleSystemData<N>::saveState(prefix, checkpoint);
+
+  checkpoint->setValue(prefix + "targetDensity", _targetDensity);
+  checkpoint->setValue(prefix + "targetSpacing", _targetSpacing);
+  checkpoint->setValue(prefix + "kernelRadiusOverTargetSpacing", _kernelRadiusOverTargetSpacing);
+  checkpoint->setValue(prefix + "kernelRadius", _kernelRadius);
+}
+
+template <size_t N> void SphSystemData<N>::loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) {
+  ParticleSystemData<N>::loadState(prefix, checkpoint);
+
+  // Assigned directly, since the setters would recompute the restored mass
+  _targetDensity = checkpoint.value<double>(prefix + "targetDensity");
+  _targetSpacing = checkpoint.value<double>(prefix + "targetSpacing");
+  _kernelRadiusOverTargetSpacing = checkpoint.value<double>(prefix + "kernelRadiusOverTargetSpacing");
+  _kernelRadius = checkpoint.value<double>(prefix + "kernelRadius");
+}
+
 template <size_t N> void SphSystemData<N>::set(const SphSystemData &other) {
   ParticleSystemData<N>::set(other);
 
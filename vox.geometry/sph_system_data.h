@@ -198,6 +198,30 @@ public:
   //! Deserializes this SPH system data from the buffer.
   void deserialize(const std::vector<uint8_t> &buffer) override;
 
+  //! Serializes this SPH system data to \p fd without an intermediate buffer.
+  void serializeToFile(int fd) const override;
+
+  //! Deserializes this SPH system data from the buffer, which can be memory mapped.
+  void deserializeFromMemory(const ConstArrayView1<uint8_t> &buffer) override;
+
+  //! Returns the view of the scalar data at \p idx in serialized SPH system data without copying.
+  static ConstArrayView1<double> mappedScalarDataAt(const ConstArrayView1<uint8_t> &buffer, size_t idx);
+
+  //! Returns the view of the vector data at \p idx in serialized SPH system data without copying.
+  static ConstArrayView1<Vector<double, N>> mappedVectorDataAt(const ConstArrayView1<uint8_t> &buffer, size_t idx);
+
+  //! Returns the view of the positions in serialized SPH system data without copying.
+  static ConstArrayView1<Vector<double, N>> mappedPositions(const ConstArrayView1<uint8_t> &buffer);
+
+  //! Returns the view of the densities in serialized SPH system data without copying.
+  static ConstArrayView1<double> mappedDensities(const ConstArrayView1<uint8_t> &buffer);
+
+  //! Stores the particles and the SPH parameters into \p checkpoint.
+  void saveState(const std::string &prefix, SolverCheckpoint *checkpoint) const override;
+
+  //! Restores the particles and the SPH parameters stored by saveState.
+  void loadState(const std::string &prefix, const SolverCheckpoint &checkpoint) override;
+
   //! Copies from other SPH system data.
   void set(const SphSystemData &other);
 
@@ -224,6 +248,8 @@ private:
 
   //! Computes the mass based on the target density and spacing.
   void computeMass();
+
+  void buildSphSystemData(flatbuffers::FlatBufferBuilder *builder) const;
 };
 
 //! 2-D SphSystemData type.
@@ -6,6 +6,7 @@
 
 #include "common.h"
 
+#include "array.h"
 #include "surface.h"
 
 #include <algorithm>
@@ -36,6 +37,18 @@ template <size_t N> double Surface<N>::closestDistance(const Vector<double, N> &
   return closestDistanceLocal(transform.toLocal(otherPoint));
 }
 
+template <size_t N>
+void Surface<N>::closestDistances(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                                  ArrayView1<double> distances) const {
+  JET_THROW_INVALID_ARG_IF(otherPoints.length() != distances.length());
+
+  Array1<Vector<double, N>> otherPointsLocal(otherPoints.length());
+  for (size_t i = 0; i < otherPoints.length(); ++i) {
+    otherPointsLocal[i] = transform.toLocal(otherPoints[i]);
+  }
+  closestDistancesLocal(otherPointsLocal, distances);
+}
+
 template <size_t N> SurfaceRayIntersection<N> Surface<N>::closestIntersection(const Ray<double, N> &ray) const {
   auto result = closestIntersectionLocal(transform.toLocal(ray));
   result.point = transform.toWorld(result.point);
@@ -59,6 +72,8 @@ template <size_t N> void Surface<N>::updateQueryEngine() {
   // Do nothing
 }
 
+template <size_t N> void Surface<N>::refitQueryEngine() { updateQueryEngine(); }
+
 template <size_t N> bool Surface<N>::isBounded() const { return true; }
 
 template <size_t N> bool Surface<N>::isValidGeometry() const { return true; }
@@ -72,6 +87,14 @@ template <size_t N> double Surface<N>::closestDistanceLocal(const Vector<double,
   return otherPointLocal.distanceTo(closestPointLocal(otherPointLocal));
 }
 
+template <size_t N>
+void Surface<N>::closestDistancesLocal(const ConstArrayView1<Vector<double, N>> &otherPointsLocal,
+                                       ArrayView1<double> distances) const {
+  for (size_t i = 0; i < otherPointsLocal.length(); ++i) {
+    distances[i] = closestDistanceLocal(otherPointsLocal[i]);
+  }
+}
+
 template <size_t N> bool Surface<N>::isInsideLocal(const Vector<double, N> &otherPointLocal) const {
   Vector<double, N> cpLocal = closestPointLocal(otherPointLocal);
   Vector<double, N> normalLocal = closestNormalLocal(otherPointLocal);
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_SURFACE_H_
 #define INCLUDE_JET_SURFACE_H_
 
+#include "array_view.h"
 #include "bounding_box.h"
 #include "constants.h"
 #include "ray.h"
@@ -60,6 +61,11 @@ public:
   //! point on the surface.
   double closestDistance(const Vector<double, N> &otherPoint) const;
 
+  //! Returns the closest distances from the given points \p otherPoints to
+  //! the surface. Nearby points should be next to each other since some
+  //! surfaces query them in packets.
+  void closestDistances(const ConstArrayView1<Vector<double, N>> &otherPoints, ArrayView1<double> distances) const;
+
   //! Returns the closest intersection point for given \p ray.
   SurfaceRayIntersection<N> closestIntersection(const Ray<double, N> &ray) const;
 
@@ -70,6 +76,16 @@ public:
   //! Updates internal spatial query engine.
   virtual void updateQueryEngine();
 
+  //!
+  //! \brief Updates internal spatial query engine after the geometry moved.
+  //!
+  //! Call this when the geometry deformed in place without changing its
+  //! structure, such as the points of an animated mesh. The query engine may
+  //! then be refitted instead of rebuilt. The default implementation calls
+  //! updateQueryEngine.
+  //!
+  virtual void refitQueryEngine();
+
   //! Returns true if bounding box can be defined.
   [[nodiscard]] virtual bool isBounded() const;
 
@@ -103,6 +119,11 @@ protected:
   //! point on the surface in local frame.
   virtual double closestDistanceLocal(const Vector<double, N> &otherPoint) const;
 
+  //! Returns the closest distances from the given points \p otherPoints to
+  //! the surface in local frame.
+  virtual void closestDistancesLocal(const ConstArrayView1<Vector<double, N>> &otherPoints,
+                                     ArrayView1<double> distances) const;
+
   //! Returns true if \p otherPoint is inside by given \p depth the volume
   //! defined by the surface in local frame.
   virtual bool isInsideLocal(const Vector<double, N> &otherPoint) const;
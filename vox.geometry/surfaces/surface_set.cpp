@@ -33,6 +33,14 @@ template <size_t N> void SurfaceSet<N>::updateQueryEngine() {
   buildBvh();
 }
 
+template <size_t N> void SurfaceSet<N>::refitQueryEngine() {
+  for (const auto &surface : _surfaces) {
+    surface->refitQueryEngine();
+  }
+
+  updateQueryEngine();
+}
+
 template <size_t N> bool SurfaceSet<N>::isBounded() const {
   // All surfaces should be bounded.
   for (const auto &surface : _surfaces) {
@@ -15,6 +15,7 @@
 
 #include <cmath>
 #include <fstream>
+#include <numeric>
 #include <utility>
 
 namespace vox {
@@ -96,6 +97,11 @@ void TriangleMesh3::updateQueryEngine() const {
   buildWindingNumbers();
 }
 
+void TriangleMesh3::refitQueryEngine() {
+  invalidateBvhBounds();
+  updateQueryEngine();
+}
+
 void TriangleMesh3::clear() {
   _points.clear();
   _normals.clear();
@@ -363,12 +369,12 @@ void TriangleMesh3::setAngleWeightedVertexNormal() {
 
 void TriangleMesh3::scale(double factor) {
   parallelFor(kZeroSize, numberOfPoints(), [this, factor](size_t i) { _points[i] *= factor; });
-  invalidateBvh();
+  invalidateBvhBounds();
 }
 
 void TriangleMesh3::translate(const Vector3D &t) {
   parallelFor(kZeroSize, numberOfPoints(), [this, t](size_t i) { _points[i] += t; });
-  invalidateBvh();
+  invalidateBvhBounds();
 }
 
 void TriangleMesh3::rotate(const Quaternion<double> &q) {
@@ -376,7 +382,7 @@ void TriangleMesh3::rotate(const Quaternion<double> &q) {
 
   parallelFor(kZeroSize, numberOfNormals(), [this, q](size_t i) { _normals[i] = q * _normals[i]; });
 
-  invalidateBvh();
+  invalidateBvhBounds();
 }
 
 void TriangleMesh3::writeObj(std::ostream *strm) const {
@@ -551,6 +557,22 @@ double TriangleMesh3::closestDistanceLocal(const Vector3D &otherPoint) const {
   return queryResult.distance;
 }
 
+void TriangleMesh3::closestDistancesLocal(const ConstArrayView1<Vector3D> &otherPoints,
+                                          ArrayView1<double> distances) const {
+  buildBvh();
+
+  const auto distanceFunc = [this](const size_t &triIdx, const Vector3D &pt) {
+    Triangle3 tri = triangle(triIdx);
+    return tri.closestDistance(pt);
+  };
+
+  Array1<NearestNeighborQueryResult3<size_t>> queryResults(otherPoints.length());
+  _bvh.nearest(otherPoints, distanceFunc, queryResults);
+  for (size_t i = 0; i < otherPoints.length(); ++i) {
+    distances[i] = queryResults[i].distance;
+  }
+}
+
 bool TriangleMesh3::intersectsLocal(const Ray3D &ray) const {
   buildBvh();
 
@@ -611,26 +633,38 @@ void TriangleMesh3::invalidateCache() const {
 
 void TriangleMesh3::invalidateBvh() { _bvhInvalidated = true; }
 
+void TriangleMesh3::invalidateBvhBounds() { _bvhBoundsInvalidated = true; }
+
 void TriangleMesh3::buildBvh() const {
+  if (!_bvhInvalidated && !_bvhBoundsInvalidated) {
+    return;
+  }
+
+  size_t nTris = numberOfTriangles();
+  Array1<BoundingBox3D> bounds(nTris);
+  parallelFor(kZeroSize, nTris, [&](size_t i) { bounds[i] = triangle(i).boundingBox(); });
+
   if (_bvhInvalidated) {
-    size_t nTris = numberOfTriangles();
     Array1<size_t> ids(nTris);
-    Array1<BoundingBox3D> bounds(nTris);
-    for (size_t i = 0; i < nTris; ++i) {
-      ids[i] = i;
-      bounds[i] = triangle(i).boundingBox();
-    }
+    std::iota(ids.begin(), ids.end(), kZeroSize);
     _bvh.build(ids, bounds);
-    _bvhInvalidated = false;
+  } else {
+    _bvh.refit(bounds);
   }
+
+  _bvhInvalidated = false;
+  _bvhBoundsInvalidated = false;
+
+  // The winding numbers are gathered over the nodes
+  _wnInvalidated = true;
 }
 
 void TriangleMesh3::buildWindingNumbers() const {
   // Barill et al., Fast Winding Numbers for Soups and Clouds, ACM SIGGRAPH
   // 2018
-  if (_wnInvalidated) {
-    buildBvh();
+  buildBvh();
 
+  if (_wnInvalidated) {
     size_t nNodes = _bvh.numberOfNodes();
     _wnAreaWeightedNormalSums.resize(nNodes);
     _wnAreaWeightedAvgPositions.resize(nNodes);
@@ -65,6 +65,15 @@ public:
   //! Updates internal spatial query engine.
   void updateQueryEngine() const;
 
+  //!
+  //! \brief Updates internal spatial query engine after the points moved.
+  //!
+  //! Call this after moving the points with point(i) while keeping the
+  //! triangles. The BVH is refitted to the new triangle bounds instead of
+  //! rebuilt, unless its quality degrades too much (see Bvh::refit).
+  //!
+  void refitQueryEngine() override;
+
   //! Clears all content.
   void clear();
 
@@ -203,6 +212,8 @@ protected:
 
   double closestDistanceLocal(const Vector3D &otherPoint) const override;
 
+  void closestDistancesLocal(const ConstArrayView1<Vector3D> &otherPoints, ArrayView1<double> distances) const override;
+
   bool intersectsLocal(const Ray3D &ray) const override;
 
   BoundingBox3D boundingBoxLocal() const override;
@@ -221,8 +232,10 @@ private:
   IndexArray _normalIndices;
   IndexArray _uvIndices;
 
-  mutable Bvh3<size_t> _bvh;
+  // Binned SAH gives tighter trees than the midpoint split for mesh queries
+  mutable Bvh3<size_t> _bvh{true};
   mutable bool _bvhInvalidated = true;
+  mutable bool _bvhBoundsInvalidated = false;
 
   mutable Array1<Vector3D> _wnAreaWeightedNormalSums;
   mutable Array1<Vector3D> _wnAreaWeightedAvgPositions;
@@ -232,6 +245,8 @@ private:
 
   void invalidateBvh();
 
+  void invalidateBvhBounds();
+
   void buildBvh() const;
 
   void buildWindingNumbers() const;
@@ -13,6 +13,9 @@
 
 #include "math_utils.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace vox {
 namespace geometry {
 
@@ -559,6 +562,166 @@ void svd(const Matrix<T, M, N> &a, Matrix<T, M, N> &u, Vector<T, N> &w, Matrix<T
   }
 }
 
+namespace internal {
+
+//! Number of cyclic Jacobi sweeps of symmetricEigen.
+constexpr size_t kSymmetricEigenNumberOfSweeps = 4;
+
+//! Number of matrices decomposed together by the batched symmetricEigen.
+constexpr size_t kSymmetricEigenBatchSize = 8;
+
+// Symmetric matrices in the order of a00, a11, a22, a01, a02, a12, and the
+// eigenvectors in row-major order, for L lanes in SoA layout.
+template <typename T, size_t L> struct SymmetricEigenLanes {
+  T a[6][L];
+  T v[9][L];
+};
+
+// Applies the Jacobi rotation that zeroes a_pq, where r is the third index.
+template <size_t P, size_t Q, size_t PQ, size_t RP, size_t RQ, typename T, size_t L>
+inline void jacobiRotate(SymmetricEigenLanes<T, L> &m) {
+  for (size_t l = 0; l < L; ++l) {
+    const T app = m.a[P][l];
+    const T aqq = m.a[Q][l];
+    const T apq = m.a[PQ][l];
+
+    // Tangent of the rotation angle, which is zero if a_pq is zero. Its
+    // magnitude is at most one, which the clamp keeps under underflow.
+    const T tau = aqq - app;
+    T t = 2 * apq * std::copysign(T(1), tau) /
+          (std::fabs(tau) + std::sqrt(tau * tau + 4 * apq * apq) + std::numeric_limits<T>::min());
+    t = std::min(std::max(t, T(-1)), T(1));
+    const T c = 1 / std::sqrt(1 + t * t);
+    const T s = t * c;
+
+    m.a[P][l] = app - t * apq;
+    m.a[Q][l] = aqq + t * apq;
+    m.a[PQ][l] = 0;
+
+    const T arp = m.a[RP][l];
+    const T arq = m.a[RQ][l];
+    m.a[RP][l] = c * arp - s * arq;
+    m.a[RQ][l] = s * arp + c * arq;
+
+    for (size_t r = 0; r < 3; ++r) {
+      const T vrp = m.v[3 * r + P][l];
+      const T vrq = m.v[3 * r + Q][l];
+      m.v[3 * r + P][l] = c * vrp - s * vrq;
+      m.v[3 * r + Q][l] = s * vrp + c * vrq;
+    }
+  }
+}
+
+// Swaps the eigenpairs I and J where the eigenvalue I is smaller.
+template <size_t I, size_t J, typename T, size_t L> inline void sortEigenPair(SymmetricEigenLanes<T, L> &m) {
+  for (size_t l = 0; l < L; ++l) {
+    const bool swap = m.a[I][l] < m.a[J][l];
+    const T di = m.a[I][l];
+    const T dj = m.a[J][l];
+    m.a[I][l] = swap ? dj : di;
+    m.a[J][l] = swap ? di : dj;
+    for (size_t r = 0; r < 3; ++r) {
+      const T vi = m.v[3 * r + I][l];
+      const T vj = m.v[3 * r + J][l];
+      m.v[3 * r + I][l] = swap ? vj : vi;
+      m.v[3 * r + J][l] = swap ? vi : vj;
+    }
+  }
+}
+
+template <typename T, size_t L> void symmetricEigen(SymmetricEigenLanes<T, L> &m) {
+  // Normalize the entries so that the squares in the rotations neither
+  // overflow nor underflow.
+  T scales[L];
+  for (size_t l = 0; l < L; ++l) {
+    T scale = 0;
+    for (size_t e = 0; e < 6; ++e) {
+      scale = std::max(scale, std::fabs(m.a[e][l]));
+    }
+    scales[l] = scale > 0 ? scale : T(1);
+  }
+  for (size_t e = 0; e < 6; ++e) {
+    for (size_t l = 0; l < L; ++l) {
+      m.a[e][l] /= scales[l];
+    }
+  }
+  for (size_t e = 0; e < 9; ++e) {
+    for (size_t l = 0; l < L; ++l) {
+      m.v[e][l] = (e % 4 == 0) ? T(1) : T(0);
+    }
+  }
+
+  for (size_t sweep = 0; sweep < kSymmetricEigenNumberOfSweeps; ++sweep) {
+    jacobiRotate<0, 1, 3, 4, 5>(m);
+    jacobiRotate<0, 2, 4, 3, 5>(m);
+    jacobiRotate<1, 2, 5, 3, 4>(m);
+  }
+
+  for (size_t e = 0; e < 3; ++e) {
+    for (size_t l = 0; l < L; ++l) {
+      m.a[e][l] *= scales[l];
+    }
+  }
+
+  sortEigenPair<0, 1>(m);
+  sortEigenPair<0, 2>(m);
+  sortEigenPair<1, 2>(m);
+}
+
+template <typename T, size_t L>
+inline void loadSymmetricEigenLane(const Matrix<T, 3, 3> &a, size_t l, SymmetricEigenLanes<T, L> &m) {
+  m.a[0][l] = a(0, 0);
+  m.a[1][l] = a(1, 1);
+  m.a[2][l] = a(2, 2);
+  m.a[3][l] = a(0, 1);
+  m.a[4][l] = a(0, 2);
+  m.a[5][l] = a(1, 2);
+}
+
+template <typename T, size_t L>
+inline void storeSymmetricEigenLane(const SymmetricEigenLanes<T, L> &m, size_t l, Matrix<T, 3, 3> &v,
+                                    Vector<T, 3> &d) {
+  for (size_t e = 0; e < 9; ++e) {
+    v(e / 3, e % 3) = m.v[e][l];
+  }
+  d = Vector<T, 3>(m.a[0][l], m.a[1][l], m.a[2][l]);
+}
+
+} // namespace internal
+
+template <typename T> void symmetricEigen(const Matrix<T, 3, 3> &a, Matrix<T, 3, 3> &v, Vector<T, 3> &d) {
+  internal::SymmetricEigenLanes<T, 1> m;
+  internal::loadSymmetricEigenLane(a, 0, m);
+  internal::symmetricEigen(m);
+  internal::storeSymmetricEigenLane(m, 0, v, d);
+}
+
+template <typename T>
+void symmetricEigen(const ConstArrayView1<Matrix<T, 3, 3>> &a, ArrayView1<Matrix<T, 3, 3>> v,
+                    ArrayView1<Vector<T, 3>> d, ExecutionPolicy policy) {
+  JET_THROW_INVALID_ARG_IF(v.length() != a.length() || d.length() != a.length());
+
+  constexpr size_t kBatchSize = internal::kSymmetricEigenBatchSize;
+  const size_t n = a.length();
+  parallelFor(
+      kZeroSize, (n + kBatchSize - 1) / kBatchSize,
+      [&](size_t batch) {
+        const size_t begin = batch * kBatchSize;
+        const size_t count = std::min(kBatchSize, n - begin);
+
+        // The unused lanes of the last batch decompose zero matrices
+        internal::SymmetricEigenLanes<T, kBatchSize> m;
+        for (size_t l = 0; l < kBatchSize; ++l) {
+          internal::loadSymmetricEigenLane(l < count ? a[begin + l] : Matrix<T, 3, 3>(), l, m);
+        }
+        internal::symmetricEigen(m);
+        for (size_t l = 0; l < count; ++l) {
+          internal::storeSymmetricEigenLane(m, l, v[begin + l], d[begin + l]);
+        }
+      },
+      policy);
+}
+
 } // namespace vox
 } // namespace geometry
 
@@ -7,7 +7,9 @@
 #ifndef INCLUDE_JET_SVD_H_
 #define INCLUDE_JET_SVD_H_
 
+#include "array_view.h"
 #include "matrix.h"
+#include "parallel.h"
 
 namespace vox {
 namespace geometry {
@@ -41,6 +43,46 @@ template <typename T> void svd(const MatrixMxN<T> &a, MatrixMxN<T> &u, VectorN<T
 template <typename T, size_t M, size_t N>
 void svd(const Matrix<T, M, N> &a, Matrix<T, M, N> &u, Vector<T, N> &w, Matrix<T, N, N> &v);
 
+//!
+//! \brief Eigen-decomposition of a 3x3 symmetric matrix.
+//!
+//! This function decomposes the symmetric input matrix \p a to
+//! \p v * diag(\p d) * \p v^T, where the columns of \p v are the orthonormal
+//! eigenvectors and \p d holds the eigenvalues in descending order. Only the
+//! upper triangle of \p a is read.
+//!
+//! Unlike svd, which iterates until convergence, this function runs a fixed
+//! number of cyclic Jacobi sweeps without data-dependent branches. For a
+//! symmetric positive semi-definite matrix, such as a covariance matrix, the
+//! result is equivalent to the SVD with u = w = \p v.
+//!
+//! \tparam T Real-value type.
+//!
+//! \param a The input matrix to decompose.
+//! \param v The matrix of eigenvectors.
+//! \param d The vector of eigenvalues.
+//!
+template <typename T> void symmetricEigen(const Matrix<T, 3, 3> &a, Matrix<T, 3, 3> &v, Vector<T, 3> &d);
+
+//!
+//! \brief Eigen-decomposition of an array of 3x3 symmetric matrices.
+//!
+//! This function computes the same decomposition as the single-matrix
+//! version for every element of \p a. The matrices are processed in batches
+//! whose entries are transposed to SoA layout, so that every step of the
+//! Jacobi sweeps runs across the batch with vectorizable loops.
+//!
+//! \tparam T Real-value type.
+//!
+//! \param a The input matrices to decompose.
+//! \param v The matrices of eigenvectors.
+//! \param d The vectors of eigenvalues.
+//! \param policy The execution policy (parallel or serial).
+//!
+template <typename T>
+void symmetricEigen(const ConstArrayView1<Matrix<T, 3, 3>> &a, ArrayView1<Matrix<T, 3, 3>> v,
+                    ArrayView1<Vector<T, 3>> d, ExecutionPolicy policy = ExecutionPolicy::kParallel);
+
 } // namespace vox
 } // namespace geometry
 
@@ -0,0 +1,67 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_UNTIDY_PRIORITY_QUEUE_INL_H_
+#define INCLUDE_JET_DETAIL_UNTIDY_PRIORITY_QUEUE_INL_H_
+
+#include "macros.h"
+#include "untidy_priority_queue.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vox {
+namespace geometry {
+
+template <typename T>
+UntidyPriorityQueue<T>::UntidyPriorityQueue(double bucketWidth, size_t numberOfBuckets, double minPriority)
+    : _bucketWidth(bucketWidth), _invBucketWidth(1.0 / bucketWidth), _currentPriority(minPriority) {
+  JET_THROW_INVALID_ARG_IF(!(bucketWidth > 0.0));
+  JET_THROW_INVALID_ARG_IF(numberOfBuckets == 0);
+
+  _buckets.resize(numberOfBuckets);
+}
+
+template <typename T> void UntidyPriorityQueue<T>::push(const T &element, double priority) {
+  const double offset = std::max(priority - _currentPriority, 0.0) * _invBucketWidth;
+  const size_t lastOffset = _buckets.size() - 1;
+  const size_t bucketOffset = (offset < static_cast<double>(lastOffset)) ? static_cast<size_t>(offset) : lastOffset;
+
+  size_t bucket = _currentBucket + bucketOffset;
+  if (bucket >= _buckets.size()) {
+    bucket -= _buckets.size();
+  }
+
+  _buckets[bucket].push_back(element);
+  ++_size;
+}
+
+template <typename T> T UntidyPriorityQueue<T>::pop() {
+  JET_ASSERT(_size > 0);
+
+  while (_buckets[_currentBucket].empty()) {
+    _currentBucket = (_currentBucket + 1 == _buckets.size()) ? 0 : _currentBucket + 1;
+    _currentPriority += _bucketWidth;
+  }
+
+  std::vector<T> &bucket = _buckets[_currentBucket];
+  T element = bucket.back();
+  bucket.pop_back();
+  --_size;
+
+  return element;
+}
+
+template <typename T> bool UntidyPriorityQueue<T>::empty() const { return _size == 0; }
+
+template <typename T> size_t UntidyPriorityQueue<T>::size() const { return _size; }
+
+template <typename T> double UntidyPriorityQueue<T>::currentPriority() const { return _currentPriority; }
+
+} // namespace vox
+} // namespace geometry
+
+#endif // INCLUDE_JET_DETAIL_UNTIDY_PRIORITY_QUEUE_INL_H_
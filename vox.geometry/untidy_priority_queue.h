@@ -0,0 +1,74 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_UNTIDY_PRIORITY_QUEUE_H_
+#define INCLUDE_JET_UNTIDY_PRIORITY_QUEUE_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace vox {
+namespace geometry {
+
+//!
+//! \brief Bucketed priority queue with O(1) push and amortized O(1) pop.
+//!
+//! The priorities are quantized into buckets of the given width, stored in a
+//! circular array, and the elements of a bucket are popped in any order. The
+//! popped element is therefore not the minimum, but its priority is at most
+//! one bucket width larger. The pushed priorities must stay within
+//! numberOfBuckets * bucketWidth of the last popped one, as in the fast
+//! marching method where a new trial value exceeds the accepted one by at
+//! most a grid spacing. Priorities below the current bucket go to the current
+//! bucket, and priorities beyond the last bucket go to the last one.
+//!
+//! \see Yatziv, Liron, Alberto Bartesaghi, and Guillermo Sapiro. "O(N)
+//!      implementation of the fast marching algorithm." Journal of
+//!      computational physics 212.2 (2006): 393-399.
+//!
+//! \tparam T - The element type.
+//!
+template <typename T> class UntidyPriorityQueue {
+public:
+  //!
+  //! Constructs an empty queue.
+  //!
+  //! \param bucketWidth Range of the priorities in a bucket.
+  //! \param numberOfBuckets Number of buckets in the circular array.
+  //! \param minPriority Lower bound of the first bucket.
+  //!
+  UntidyPriorityQueue(double bucketWidth, size_t numberOfBuckets, double minPriority = 0.0);
+
+  //! Adds an element with the given priority.
+  void push(const T &element, double priority);
+
+  //! Removes and returns an element of the lowest non-empty bucket.
+  T pop();
+
+  //! Returns true if the queue is empty.
+  [[nodiscard]] bool empty() const;
+
+  //! Returns the number of elements.
+  [[nodiscard]] size_t size() const;
+
+  //! Returns the lower bound of the current bucket.
+  [[nodiscard]] double currentPriority() const;
+
+private:
+  double _bucketWidth;
+  double _invBucketWidth;
+  double _currentPriority;
+  size_t _currentBucket = 0;
+  size_t _size = 0;
+  std::vector<std::vector<T>> _buckets;
+};
+
+} // namespace vox
+} // namespace geometry
+
+#include "untidy_priority_queue-inl.h"
+
+#endif // INCLUDE_JET_UNTIDY_PRIORITY_QUEUE_H_